@@ -46,6 +46,71 @@ platetype_from_pb = {
     api_pb2.PlateType.WELLPLATE384: "wellplate384",
 }
 
+correction_map_type_to_pb = {
+    "dark": api_pb2.CorrectionMapType.DARK,
+    "flat": api_pb2.CorrectionMapType.FLAT,
+}
+
+correction_statistic_to_pb = {
+    "median": api_pb2.CorrectionStatistic.MEDIAN,
+    "mean": api_pb2.CorrectionStatistic.MEAN,
+}
+
+focus_metric_to_pb = {
+    "brenner": api_pb2.FocusMetric.BRENNER,
+    "tenengrad": api_pb2.FocusMetric.TENENGRAD,
+    "laplacian_variance": api_pb2.FocusMetric.LAPLACIAN_VARIANCE,
+}
+
+scan_focus_mode_to_pb = {
+    "focus_map": api_pb2.ScanFocusMode.FOCUS_MAP,
+    "autofocus_per_well": api_pb2.ScanFocusMode.AUTOFOCUS_PER_WELL,
+    "none": api_pb2.ScanFocusMode.NONE,
+}
+
+site_order_to_pb = {
+    "as_created": api_pb2.SiteOrder.AS_CREATED,
+    "serpentine": api_pb2.SiteOrder.SERPENTINE,
+    "nearest_neighbor": api_pb2.SiteOrder.NEAREST_NEIGHBOR,
+    "nearest_neighbor_2opt": api_pb2.SiteOrder.NEAREST_NEIGHBOR_2OPT,
+}
+
+channel_order_to_pb = {
+    "as_given": api_pb2.ChannelOrder.AS_GIVEN,
+    "min_moves": api_pb2.ChannelOrder.MIN_MOVES,
+    "ping_pong": api_pb2.ChannelOrder.PING_PONG,
+}
+
+overrun_policy_to_pb = {
+    "skip": api_pb2.OverrunPolicy.SKIP,
+    "compress": api_pb2.OverrunPolicy.COMPRESS,
+}
+
+zstack_order_to_pb = {
+    "channels_per_plane": api_pb2.ZStackOrder.CHANNELS_PER_PLANE,
+    "planes_per_channel": api_pb2.ZStackOrder.PLANES_PER_CHANNEL,
+}
+
+def channel_to_pb(ch: Channel):
+    if len(ch) == 2:
+        return api_pb2.Channel(preset_name=ch[0], exposure_ms=ch[1])
+    elif len(ch) == 3:
+        return api_pb2.Channel(
+            preset_name=ch[0], exposure_ms=ch[1], illumination_intensity=ch[2])
+    raise ValueError("invalid channels")
+
+def live_recording_stats_from_pb(stats_pb):
+    return {
+        "name": stats_pb.name,
+        "running": stats_pb.running,
+        "n_frames": stats_pb.n_frames,
+        "n_dropped_camera": stats_pb.n_dropped_camera,
+        "n_dropped_writer": stats_pb.n_dropped_writer,
+        "elapsed_s": stats_pb.elapsed_s,
+        "fps": stats_pb.fps,
+        "write_mb_per_s": stats_pb.write_mb_per_s,
+    }
+
 class API():
     def __init__(self, server_addr='localhost:50051'):
         self.rpc_channel = grpc.insecure_channel(server_addr, options=[
@@ -159,6 +224,173 @@ class API():
 
         self.stub.AcquireMultiChannel(req)
 
+    def acquire_z_stack(self, ndimage_name: str, channels: List[Channel], n_z: int, step_um: float, z_center: Optional[float] = None, order: str = "channels_per_plane", max_projection: bool = False, mean_projection: bool = False, i_t: int = 0, site_uuid=None, metadata: Dict[str, str] = None):
+        req = api_pb2.AcquireZStackRequest(
+            ndimage_name=ndimage_name, n_z=n_z, step_um=step_um,
+            order=zstack_order_to_pb[order],
+            max_projection=max_projection, mean_projection=mean_projection,
+            i_t=i_t)
+        for ch in channels:
+            req.channels.append(channel_to_pb(ch))
+        if z_center is not None:
+            req.z_center = z_center
+        if site_uuid:
+            req.site_uuid = site_uuid
+        if metadata:
+            req.metadata = json.dumps(metadata)
+        self.stub.AcquireZStack(req)
+
+    def autofocus(self, channel: Channel, metric: str = "brenner", range_um: float = 0, coarse_step_um: float = 0, fine_step_um: float = 0, stride: int = 0) -> Tuple[float, float]:
+        req = api_pb2.AutofocusRequest()
+        if len(channel) == 2:
+            req.channel.CopyFrom(api_pb2.Channel(
+                preset_name=channel[0], exposure_ms=channel[1]))
+        elif len(channel) == 3:
+            req.channel.CopyFrom(api_pb2.Channel(
+                preset_name=channel[0], exposure_ms=channel[1], illumination_intensity=channel[2]))
+        else:
+            raise ValueError("invalid channel")
+        req.metric = focus_metric_to_pb[metric]
+        req.range_um = range_um
+        req.coarse_step_um = coarse_step_um
+        req.fine_step_um = fine_step_um
+        req.stride = stride
+        resp = self.stub.Autofocus(req)
+        return resp.z, resp.score
+
+    def _scan_request(self, plate_uuid: str, channels: List[Channel], i_t: int = 0, well_ids: Optional[List[str]] = None, focus_mode: str = "focus_map", autofocus: Optional[Dict] = None, ndimage_prefix: str = "", metadata: Dict[str, str] = None, site_order: str = "as_created", speed_model: Optional[Dict[str, float]] = None, channel_order: str = "as_given"):
+        req = api_pb2.StartScanRequest(plate_uuid=plate_uuid, i_t=i_t)
+        if well_ids:
+            req.well_id.extend(well_ids)
+        for ch in channels:
+            req.channels.append(channel_to_pb(ch))
+        req.focus_mode = scan_focus_mode_to_pb[focus_mode]
+        if autofocus:
+            # same keys as the arguments of autofocus(), without the channel
+            af = dict(autofocus)
+            if "metric" in af:
+                af["metric"] = focus_metric_to_pb[af["metric"]]
+            req.autofocus.CopyFrom(api_pb2.AutofocusRequest(**af))
+        req.ndimage_prefix = ndimage_prefix
+        if metadata:
+            req.metadata = json.dumps(metadata)
+        req.site_order = site_order_to_pb[site_order]
+        req.channel_order = channel_order_to_pb[channel_order]
+        if speed_model:
+            # speed_x, speed_y, accel_x, accel_y, settle_ms
+            req.speed_model.CopyFrom(api_pb2.StageSpeedModel(**speed_model))
+        return req
+
+    def plan_scan(self, plate_uuid: str, channels: List[Channel], **kwargs):
+        resp = self.stub.PlanScan(self._scan_request(plate_uuid, channels, **kwargs))
+        return {
+            "travel_um": resp.travel_um,
+            "travel_s": resp.travel_s,
+            "site_uuid": list(resp.site_uuid),
+        }
+
+    def start_scan(self, plate_uuid: str, channels: List[Channel], **kwargs):
+        self.stub.StartScan(self._scan_request(plate_uuid, channels, **kwargs))
+
+    def pause_scan(self):
+        self.stub.PauseScan(empty_pb2.Empty())
+
+    def resume_scan(self):
+        self.stub.ResumeScan(empty_pb2.Empty())
+
+    def stop_scan(self):
+        self.stub.StopScan(empty_pb2.Empty())
+
+    def watch_scan(self):
+        # yields a dict on every progress update until the scan finishes
+        for p in self.stub.WatchScan(empty_pb2.Empty()):
+            yield {
+                "state": p.state,
+                "n_sites_total": p.n_sites_total,
+                "n_sites_done": p.n_sites_done,
+                "n_wells_total": p.n_wells_total,
+                "n_wells_done": p.n_wells_done,
+                "well_id": p.well_id,
+                "site_id": p.site_id,
+                "elapsed_s": p.elapsed_s,
+                "remaining_s": p.remaining_s,
+                "message": p.message,
+                "predicted_travel_um": p.predicted_travel_um,
+                "predicted_travel_s": p.predicted_travel_s,
+            }
+
+    def start_timelapse(self, groups: List[Dict], overrun_policy: str = "skip"):
+        # each group: name, interval_s, n_rounds (0 until stopped),
+        # start_offset_s, plate_uuid, channels and the other start_scan
+        # arguments; i_t is set to the round number by the server
+        req = api_pb2.StartTimelapseRequest(
+            overrun_policy=overrun_policy_to_pb[overrun_policy])
+        for g in groups:
+            scan_kwargs = dict(g)
+            group_pb = api_pb2.TimelapseGroup(
+                name=scan_kwargs.pop("name"),
+                interval_s=scan_kwargs.pop("interval_s"),
+                n_rounds=scan_kwargs.pop("n_rounds", 0),
+                start_offset_s=scan_kwargs.pop("start_offset_s", 0))
+            group_pb.scan.CopyFrom(self._scan_request(
+                scan_kwargs.pop("plate_uuid"), scan_kwargs.pop("channels"),
+                **scan_kwargs))
+            req.groups.append(group_pb)
+        self.stub.StartTimelapse(req)
+
+    def stop_timelapse(self):
+        self.stub.StopTimelapse(empty_pb2.Empty())
+
+    def get_timelapse_status(self):
+        resp = self.stub.GetTimelapseStatus(empty_pb2.Empty())
+        df = []
+        for g in resp.groups:
+            next_round_in_s = g.next_round_in_s if g.HasField("next_round_in_s") else None
+            df.append([g.name, g.interval_s, g.n_rounds_done, g.n_rounds_skipped, g.n_rounds_failed, g.mean_round_s, g.max_round_s, g.mean_late_s, g.max_late_s, next_round_in_s])
+        df = pd.DataFrame(df, columns=["name", "interval_s", "n_rounds_done", "n_rounds_skipped", "n_rounds_failed", "mean_round_s", "max_round_s", "mean_late_s", "max_late_s", "next_round_in_s"])
+        return {
+            "running": resp.running,
+            "elapsed_s": resp.elapsed_s,
+            "busy_s": resp.busy_s,
+            "utilization": resp.utilization,
+            "message": resp.message,
+            "groups": df,
+        }
+
+    def start_live_recording(self, name: str, ch_name: str = "", duration_s: float = 0):
+        req = api_pb2.StartLiveRecordingRequest(
+            name=name, ch_name=ch_name, duration_s=duration_s)
+        self.stub.StartLiveRecording(req)
+
+    def stop_live_recording(self):
+        resp = self.stub.StopLiveRecording(empty_pb2.Empty())
+        return live_recording_stats_from_pb(resp)
+
+    def get_live_recording_stats(self):
+        resp = self.stub.GetLiveRecordingStats(empty_pb2.Empty())
+        return live_recording_stats_from_pb(resp)
+
+    def import_live_recording(self, name: str, ndimage_name: str):
+        req = api_pb2.ImportLiveRecordingRequest(
+            name=name, ndimage_name=ndimage_name)
+        self.stub.ImportLiveRecording(req)
+
+    def watch_live_frames(self, every_frame: bool = False):
+        # yields (frame, n_dropped) until the live view stops; by default
+        # skips to the latest frame when the client falls behind
+        req = api_pb2.WatchLiveFramesRequest(every_frame=every_frame)
+        for f in self.stub.WatchLiveFrames(req):
+            data_dtype = dtype_from_pb[f.data.dtype]
+            frame = np.frombuffer(f.data.buf, dtype=data_dtype).reshape(f.data.height, f.data.width)
+            yield frame, f.n_dropped
+
+    def get_live_frame_stats(self):
+        resp = self.stub.GetLiveFrameStats(empty_pb2.Empty())
+        df = []
+        for c in resp.consumer:
+            df.append([c.name, c.mode, c.n_read, c.n_dropped])
+        return resp.n_published, pd.DataFrame(df, columns=["name", "mode", "n_read", "n_dropped"])
+
     def list_ndimage(self):
         resp = self.stub.ListNDImage(empty_pb2.Empty())
         ndimage_list = []
@@ -202,6 +434,8 @@ class API():
 
         for ch in resp.raw_intensity:
             df["raw_intensity_%s" % ch.ch_name] = np.array(ch.values)
+        for ch in resp.corrected_intensity:
+            df["corrected_intensity_%s" % ch.ch_name] = np.array(ch.values)
         return df
 
     def get_quantification(self, ndimage_name, i_t):
@@ -215,8 +449,37 @@ class API():
 
         for ch in resp.raw_intensity:
             df["raw_intensity_%s" % ch.ch_name] = np.array(ch.values)
+        for ch in resp.corrected_intensity:
+            df["corrected_intensity_%s" % ch.ch_name] = np.array(ch.values)
         return df
 
+    def get_cell_table(self, plate_id: str = "", ndimage_name: str = "", i_t: int = 0) -> pd.DataFrame:
+        req = api_pb2.GetCellTableRequest(
+            plate_id=plate_id, ndimage_name=ndimage_name, i_t=i_t)
+        resp = self.stub.GetCellTable(req)
+        dtype = np.dtype({
+            "names": [f.name for f in resp.field],
+            "formats": [np.dtype(f.dtype).newbyteorder("<") for f in resp.field],
+            "offsets": [f.offset for f in resp.field],
+            "itemsize": resp.itemsize,
+        })
+        arr = np.frombuffer(resp.buf, dtype=dtype, count=resp.n_rows)
+        return pd.DataFrame(arr)
+
+    def build_correction_map(self, map_type: str, ch_name: str, ndimage_name: str, calib_ch: str, statistic: str = "median"):
+        req = api_pb2.BuildCorrectionMapRequest(
+            type=correction_map_type_to_pb[map_type], ch_name=ch_name,
+            ndimage_name=ndimage_name, calib_ch=calib_ch,
+            statistic=correction_statistic_to_pb[statistic])
+        self.stub.BuildCorrectionMap(req)
+
+    def get_span_stats(self):
+        resp = self.stub.GetSpanStats(empty_pb2.Empty())
+        df = []
+        for span in resp.span:
+            df.append([span.name, span.count, span.p50_ms, span.p90_ms, span.p99_ms, span.max_ms, list(span.histogram)])
+        return pd.DataFrame(df, columns=["name", "count", "p50_ms", "p90_ms", "p99_ms", "max_ms", "histogram"])
+
     def get_xy_stage_position(self) -> Tuple[float, float]:
         x, y = self.get_property("/PriorProScan/XYPosition").split(',')
         return float(x), float(y)
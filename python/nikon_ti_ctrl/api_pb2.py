@@ -2,10 +2,9 @@
 # Generated by the protocol buffer compiler.  DO NOT EDIT!
 # source: api.proto
 """Generated protocol buffer code."""
-from google.protobuf.internal import enum_type_wrapper
+from google.protobuf.internal import builder as _builder
 from google.protobuf import descriptor as _descriptor
-from google.protobuf import message as _message
-from google.protobuf import reflection as _reflection
+from google.protobuf import descriptor_pool as _descriptor_pool
 from google.protobuf import symbol_database as _symbol_database
 # @@protoc_insertion_point(imports)
 
@@ -16,2489 +15,173 @@ from google.protobuf import empty_pb2 as google_dot_protobuf_dot_empty__pb2
 from google.protobuf import duration_pb2 as google_dot_protobuf_dot_duration__pb2
 
 
-DESCRIPTOR = _descriptor.FileDescriptor(
-  name='api.proto',
-  package='api',
-  syntax='proto3',
-  serialized_options=None,
-  create_key=_descriptor._internal_create_key,
-  serialized_pb=b'\n\tapi.proto\x12\x03\x61pi\x1a\x1bgoogle/protobuf/empty.proto\x1a\x1egoogle/protobuf/duration.proto\",\n\rPropertyValue\x12\x0c\n\x04name\x18\x01 \x01(\t\x12\r\n\x05value\x18\x02 \x01(\t\"S\n\x07\x43hannel\x12\x13\n\x0bpreset_name\x18\x01 \x01(\t\x12\x13\n\x0b\x65xposure_ms\x18\x02 \x01(\x01\x12\x1e\n\x16illumination_intensity\x18\x03 \x01(\x01\"#\n\x13ListPropertyRequest\x12\x0c\n\x04name\x18\x01 \x01(\t\"$\n\x14ListPropertyResponse\x12\x0c\n\x04name\x18\x01 \x03(\t\"\"\n\x12GetPropertyRequest\x12\x0c\n\x04name\x18\x01 \x03(\t\";\n\x13GetPropertyResponse\x12$\n\x08property\x18\x01 \x03(\x0b\x32\x12.api.PropertyValue\":\n\x12SetPropertyRequest\x12$\n\x08property\x18\x01 \x03(\x0b\x32\x12.api.PropertyValue\"O\n\x13WaitPropertyRequest\x12\x0c\n\x04name\x18\x01 \x03(\t\x12*\n\x07timeout\x18\x02 \x01(\x0b\x32\x19.google.protobuf.Duration\"5\n\x13ListChannelResponse\x12\x1e\n\x08\x63hannels\x18\x01 \x03(\x0b\x32\x0c.api.Channel\"5\n\x14SwitchChannelRequest\x12\x1d\n\x07\x63hannel\x18\x01 \x01(\x0b\x32\x0c.api.Channel\"I\n\x15OpenExperimentRequest\x12\x0c\n\x04name\x18\x01 \x01(\t\x12\x15\n\x08\x62\x61se_dir\x18\x02 \x01(\tH\x00\x88\x01\x01\x42\x0b\n\t_base_dir\"\x1d\n\x05Pos2D\x12\t\n\x01x\x18\x01 \x01(\x01\x12\t\n\x01y\x18\x02 \x01(\x01\"\xa6\x01\n\tPlateInfo\x12\x0c\n\x04uuid\x18\x01 \x01(\t\x12\x1c\n\x04type\x18\x02 \x01(\x0e\x32\x0e.api.PlateType\x12\n\n\x02id\x18\x03 \x01(\t\x12#\n\npos_origin\x18\x04 \x01(\x0b\x32\n.api.Pos2DH\x00\x88\x01\x01\x12\x10\n\x08metadata\x18\x05 \x01(\t\x12\x1b\n\x04well\x18\x06 \x03(\x0b\x32\r.api.WellInfoB\r\n\x0b_pos_origin\"\x81\x01\n\x08WellInfo\x12\x0c\n\x04uuid\x18\x01 \x01(\t\x12\n\n\x02id\x18\x02 \x01(\t\x12\x1b\n\x07rel_pos\x18\x03 \x01(\x0b\x32\n.api.Pos2D\x12\x0f\n\x07\x65nabled\x18\x04 \x01(\x08\x12\x10\n\x08metadata\x18\x05 \x01(\t\x12\x1b\n\x04site\x18\x06 \x03(\x0b\x32\r.api.SiteInfo\"d\n\x08SiteInfo\x12\x0c\n\x04uuid\x18\x01 \x01(\t\x12\n\n\x02id\x18\x02 \x01(\t\x12\x1b\n\x07rel_pos\x18\x03 \x01(\x0b\x32\n.api.Pos2D\x12\x0f\n\x07\x65nabled\x18\x04 \x01(\x08\x12\x10\n\x08metadata\x18\x05 \x01(\t\"2\n\x11ListPlateResponse\x12\x1d\n\x05plate\x18\x01 \x03(\x0b\x32\x0e.api.PlateInfo\"G\n\x0f\x41\x64\x64PlateRequest\x12\"\n\nplate_type\x18\x01 \x01(\x0e\x32\x0e.api.PlateType\x12\x10\n\x08plate_id\x18\x02 \x01(\t\"I\n\x1dSetPlatePositionOriginRequest\x12\x12\n\nplate_uuid\x18\x01 \x01(\t\x12\t\n\x01x\x18\x02 \x01(\x01\x12\t\n\x01y\x18\x03 \x01(\x01\"N\n\x17SetPlateMetadataRequest\x12\x12\n\nplate_uuid\x18\x01 \x01(\t\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\x12\n\njson_value\x18\x03 \x01(\t\"N\n\x16SetWellsEnabledRequest\x12\x12\n\nplate_uuid\x18\x01 \x01(\t\x12\x0f\n\x07well_id\x18\x02 \x03(\t\x12\x0f\n\x07\x65nabled\x18\x03 \x01(\x08\"_\n\x17SetWellsMetadataRequest\x12\x12\n\nplate_uuid\x18\x01 \x01(\t\x12\x0f\n\x07well_id\x18\x02 \x03(\t\x12\x0b\n\x03key\x18\x03 \x01(\t\x12\x12\n\njson_value\x18\x04 \x01(\t\"y\n\x12\x43reateSitesRequest\x12\x12\n\nplate_uuid\x18\x01 \x01(\t\x12\x0f\n\x07well_id\x18\x02 \x03(\t\x12\x0b\n\x03n_x\x18\x03 \x01(\x05\x12\x0b\n\x03n_y\x18\x04 \x01(\x05\x12\x11\n\tspacing_x\x18\x05 \x01(\x01\x12\x11\n\tspacing_y\x18\x06 \x01(\x01\"\x91\x01\n\x1a\x41\x63quireMultiChannelRequest\x12\x14\n\x0cndimage_name\x18\x01 \x01(\t\x12\x1e\n\x08\x63hannels\x18\x02 \x03(\x0b\x32\x0c.api.Channel\x12\x0b\n\x03i_z\x18\x03 \x01(\x05\x12\x0b\n\x03i_t\x18\x04 \x01(\x05\x12\x10\n\x08metadata\x18\x06 \x01(\t\x12\x11\n\tsite_uuid\x18\x07 \x01(\t\"\xac\x01\n\x07NDImage\x12\x0c\n\x04name\x18\x01 \x01(\t\x12\x0f\n\x07\x63h_name\x18\x02 \x03(\t\x12\r\n\x05width\x18\x03 \x01(\r\x12\x0e\n\x06height\x18\x04 \x01(\r\x12\x0c\n\x04n_ch\x18\x05 \x01(\x05\x12\x0b\n\x03n_z\x18\x06 \x01(\x05\x12\x0b\n\x03n_t\x18\x07 \x01(\x05\x12\x1c\n\x05\x64type\x18\x08 \x01(\x0e\x32\r.api.DataType\x12\x1d\n\x05\x63type\x18\t \x01(\x0e\x32\x0e.api.ColorType\"4\n\x13ListNDImageResponse\x12\x1d\n\x07ndimage\x18\x01 \x03(\x0b\x32\x0c.api.NDImage\")\n\x11GetNDImageRequest\x12\x14\n\x0cndimage_name\x18\x01 \x01(\t\"3\n\x12GetNDImageResponse\x12\x1d\n\x07ndimage\x18\x01 \x01(\x0b\x32\x0c.api.NDImage\"[\n\x13GetImageDataRequest\x12\x14\n\x0cndimage_name\x18\x01 \x01(\t\x12\x14\n\x0c\x63hannel_name\x18\x02 \x01(\t\x12\x0b\n\x03i_z\x18\x03 \x01(\x05\x12\x0b\n\x03i_t\x18\x04 \x01(\x05\"t\n\tImageData\x12\r\n\x05width\x18\x01 \x01(\r\x12\x0e\n\x06height\x18\x02 \x01(\r\x12\x1c\n\x05\x64type\x18\x03 \x01(\x0e\x32\r.api.DataType\x12\x1d\n\x05\x63type\x18\x04 \x01(\x0e\x32\x0e.api.ColorType\x12\x0b\n\x03\x62uf\x18\x05 \x01(\x0c\"4\n\x14GetImageDataResponse\x12\x1c\n\x04\x64\x61ta\x18\x01 \x01(\x0b\x32\x0e.api.ImageData\"^\n\x1bGetSegmentationScoreRequest\x12\x14\n\x0cndimage_name\x18\x01 \x01(\t\x12\x0f\n\x07\x63h_name\x18\x02 \x01(\t\x12\x0b\n\x03i_z\x18\x03 \x01(\x05\x12\x0b\n\x03i_t\x18\x04 \x01(\x05\"<\n\x1cGetSegmentationScoreResponse\x12\x1c\n\x04\x64\x61ta\x18\x01 \x01(\x0b\x32\x0e.api.ImageData\"T\n\x16QuantifyRegionsRequest\x12\x14\n\x0cndimage_name\x18\x01 \x01(\t\x12\x0b\n\x03i_t\x18\x02 \x01(\x05\x12\x17\n\x0fsegmentation_ch\x18\x03 \x01(\t\"\x80\x01\n\x17QuantifyRegionsResponse\x12\x11\n\tn_regions\x18\x01 \x01(\x05\x12$\n\x0bregion_prop\x18\x02 \x03(\x0b\x32\x0f.api.RegionProp\x12,\n\rraw_intensity\x18\x03 \x03(\x0b\x32\x15.api.ChannelIntensity\"\xb0\x01\n\nRegionProp\x12\r\n\x05label\x18\x01 \x01(\r\x12\x0f\n\x07\x62\x62ox_x0\x18\x02 \x01(\r\x12\x0f\n\x07\x62\x62ox_y0\x18\x03 \x01(\r\x12\x12\n\nbbox_width\x18\x04 \x01(\r\x12\x13\n\x0b\x62\x62ox_height\x18\x05 \x01(\r\x12\x0c\n\x04\x61rea\x18\x06 \x01(\x01\x12\x12\n\ncentroid_x\x18\x07 \x01(\x01\x12\x12\n\ncentroid_y\x18\x08 \x01(\x01\x12\x12\n\nscore_mean\x18\t \x01(\x01\"3\n\x10\x43hannelIntensity\x12\x0f\n\x07\x63h_name\x18\x01 \x01(\t\x12\x0e\n\x06values\x18\x02 \x03(\x01\"=\n\x18GetQuantificationRequest\x12\x14\n\x0cndimage_name\x18\x01 \x01(\t\x12\x0b\n\x03i_t\x18\x02 \x01(\x05\"o\n\x19GetQuantificationResponse\x12$\n\x0bregion_prop\x18\x01 \x03(\x0b\x32\x0f.api.RegionProp\x12,\n\rraw_intensity\x18\x02 \x03(\x0b\x32\x15.api.ChannelIntensity*F\n\tPlateType\x12\x0b\n\x07UNKNOWN\x10\x00\x12\t\n\x05SLIDE\x10\x01\x12\x0f\n\x0bWELLPLATE96\x10\x02\x12\x10\n\x0cWELLPLATE384\x10\x03*o\n\x08\x44\x61taType\x12\x11\n\rUNKNOWN_DTYPE\x10\x00\x12\t\n\x05\x42OOL8\x10\x01\x12\t\n\x05UINT8\x10\x02\x12\n\n\x06UINT16\x10\x03\x12\t\n\x05INT16\x10\x04\x12\t\n\x05INT32\x10\x05\x12\x0b\n\x07\x46LOAT32\x10\x06\x12\x0b\n\x07\x46LOAT64\x10\x07*v\n\tColorType\x12\x11\n\rUNKNOWN_CTYPE\x10\x00\x12\t\n\x05MONO8\x10\x01\x12\n\n\x06MONO10\x10\x02\x12\n\n\x06MONO12\x10\x03\x12\n\n\x06MONO14\x10\x04\x12\n\n\x06MONO16\x10\x05\x12\x0c\n\x08\x42\x41YERRG8\x10\x06\x12\r\n\tBAYERRG16\x10\x07\x32\x88\x0c\n\x0bNikonTiCtrl\x12\x45\n\x0cListProperty\x12\x18.api.ListPropertyRequest\x1a\x19.api.ListPropertyResponse\"\x00\x12\x42\n\x0bGetProperty\x12\x17.api.GetPropertyRequest\x1a\x18.api.GetPropertyResponse\"\x00\x12@\n\x0bSetProperty\x12\x17.api.SetPropertyRequest\x1a\x16.google.protobuf.Empty\"\x00\x12\x42\n\x0cWaitProperty\x12\x18.api.WaitPropertyRequest\x1a\x16.google.protobuf.Empty\"\x00\x12\x41\n\x0bListChannel\x12\x16.google.protobuf.Empty\x1a\x18.api.ListChannelResponse\"\x00\x12\x44\n\rSwitchChannel\x12\x19.api.SwitchChannelRequest\x1a\x16.google.protobuf.Empty\"\x00\x12\x46\n\x0eOpenExperiment\x12\x1a.api.OpenExperimentRequest\x1a\x16.google.protobuf.Empty\"\x00\x12=\n\tListPlate\x12\x16.google.protobuf.Empty\x1a\x16.api.ListPlateResponse\"\x00\x12:\n\x08\x41\x64\x64Plate\x12\x14.api.AddPlateRequest\x1a\x16.google.protobuf.Empty\"\x00\x12V\n\x16SetPlatePositionOrigin\x12\".api.SetPlatePositionOriginRequest\x1a\x16.google.protobuf.Empty\"\x00\x12J\n\x10SetPlateMetadata\x12\x1c.api.SetPlateMetadataRequest\x1a\x16.google.protobuf.Empty\"\x00\x12H\n\x0fSetWellsEnabled\x12\x1b.api.SetWellsEnabledRequest\x1a\x16.google.protobuf.Empty\"\x00\x12J\n\x10SetWellsMetadata\x12\x1c.api.SetWellsMetadataRequest\x1a\x16.google.protobuf.Empty\"\x00\x12@\n\x0b\x43reateSites\x12\x17.api.CreateSitesRequest\x1a\x16.google.protobuf.Empty\"\x00\x12P\n\x13\x41\x63quireMultiChannel\x12\x1f.api.AcquireMultiChannelRequest\x1a\x16.google.protobuf.Empty\"\x00\x12\x41\n\x0bListNDImage\x12\x16.google.protobuf.Empty\x1a\x18.api.ListNDImageResponse\"\x00\x12?\n\nGetNDImage\x12\x16.api.GetNDImageRequest\x1a\x17.api.GetNDImageResponse\"\x00\x12\x45\n\x0cGetImageData\x12\x18.api.GetImageDataRequest\x1a\x19.api.GetImageDataResponse\"\x00\x12]\n\x14GetSegmentationScore\x12 .api.GetSegmentationScoreRequest\x1a!.api.GetSegmentationScoreResponse\"\x00\x12N\n\x0fQuantifyRegions\x12\x1b.api.QuantifyRegionsRequest\x1a\x1c.api.QuantifyRegionsResponse\"\x00\x12T\n\x11GetQuantification\x12\x1d.api.GetQuantificationRequest\x1a\x1e.api.GetQuantificationResponse\"\x00\x62\x06proto3'
-  ,
-  dependencies=[google_dot_protobuf_dot_empty__pb2.DESCRIPTOR,google_dot_protobuf_dot_duration__pb2.DESCRIPTOR,])
-
-_PLATETYPE = _descriptor.EnumDescriptor(
-  name='PlateType',
-  full_name='api.PlateType',
-  filename=None,
-  file=DESCRIPTOR,
-  create_key=_descriptor._internal_create_key,
-  values=[
-    _descriptor.EnumValueDescriptor(
-      name='UNKNOWN', index=0, number=0,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-    _descriptor.EnumValueDescriptor(
-      name='SLIDE', index=1, number=1,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-    _descriptor.EnumValueDescriptor(
-      name='WELLPLATE96', index=2, number=2,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-    _descriptor.EnumValueDescriptor(
-      name='WELLPLATE384', index=3, number=3,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-  ],
-  containing_type=None,
-  serialized_options=None,
-  serialized_start=3243,
-  serialized_end=3313,
-)
-_sym_db.RegisterEnumDescriptor(_PLATETYPE)
-
-PlateType = enum_type_wrapper.EnumTypeWrapper(_PLATETYPE)
-_DATATYPE = _descriptor.EnumDescriptor(
-  name='DataType',
-  full_name='api.DataType',
-  filename=None,
-  file=DESCRIPTOR,
-  create_key=_descriptor._internal_create_key,
-  values=[
-    _descriptor.EnumValueDescriptor(
-      name='UNKNOWN_DTYPE', index=0, number=0,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-    _descriptor.EnumValueDescriptor(
-      name='BOOL8', index=1, number=1,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-    _descriptor.EnumValueDescriptor(
-      name='UINT8', index=2, number=2,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-    _descriptor.EnumValueDescriptor(
-      name='UINT16', index=3, number=3,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-    _descriptor.EnumValueDescriptor(
-      name='INT16', index=4, number=4,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-    _descriptor.EnumValueDescriptor(
-      name='INT32', index=5, number=5,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-    _descriptor.EnumValueDescriptor(
-      name='FLOAT32', index=6, number=6,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-    _descriptor.EnumValueDescriptor(
-      name='FLOAT64', index=7, number=7,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-  ],
-  containing_type=None,
-  serialized_options=None,
-  serialized_start=3315,
-  serialized_end=3426,
-)
-_sym_db.RegisterEnumDescriptor(_DATATYPE)
-
-DataType = enum_type_wrapper.EnumTypeWrapper(_DATATYPE)
-_COLORTYPE = _descriptor.EnumDescriptor(
-  name='ColorType',
-  full_name='api.ColorType',
-  filename=None,
-  file=DESCRIPTOR,
-  create_key=_descriptor._internal_create_key,
-  values=[
-    _descriptor.EnumValueDescriptor(
-      name='UNKNOWN_CTYPE', index=0, number=0,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-    _descriptor.EnumValueDescriptor(
-      name='MONO8', index=1, number=1,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-    _descriptor.EnumValueDescriptor(
-      name='MONO10', index=2, number=2,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-    _descriptor.EnumValueDescriptor(
-      name='MONO12', index=3, number=3,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-    _descriptor.EnumValueDescriptor(
-      name='MONO14', index=4, number=4,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-    _descriptor.EnumValueDescriptor(
-      name='MONO16', index=5, number=5,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-    _descriptor.EnumValueDescriptor(
-      name='BAYERRG8', index=6, number=6,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-    _descriptor.EnumValueDescriptor(
-      name='BAYERRG16', index=7, number=7,
-      serialized_options=None,
-      type=None,
-      create_key=_descriptor._internal_create_key),
-  ],
-  containing_type=None,
-  serialized_options=None,
-  serialized_start=3428,
-  serialized_end=3546,
-)
-_sym_db.RegisterEnumDescriptor(_COLORTYPE)
-
-ColorType = enum_type_wrapper.EnumTypeWrapper(_COLORTYPE)
-UNKNOWN = 0
-SLIDE = 1
-WELLPLATE96 = 2
-WELLPLATE384 = 3
-UNKNOWN_DTYPE = 0
-BOOL8 = 1
-UINT8 = 2
-UINT16 = 3
-INT16 = 4
-INT32 = 5
-FLOAT32 = 6
-FLOAT64 = 7
-UNKNOWN_CTYPE = 0
-MONO8 = 1
-MONO10 = 2
-MONO12 = 3
-MONO14 = 4
-MONO16 = 5
-BAYERRG8 = 6
-BAYERRG16 = 7
-
-
-
-_PROPERTYVALUE = _descriptor.Descriptor(
-  name='PropertyValue',
-  full_name='api.PropertyValue',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='name', full_name='api.PropertyValue.name', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='value', full_name='api.PropertyValue.value', index=1,
-      number=2, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=79,
-  serialized_end=123,
-)
-
-
-_CHANNEL = _descriptor.Descriptor(
-  name='Channel',
-  full_name='api.Channel',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='preset_name', full_name='api.Channel.preset_name', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='exposure_ms', full_name='api.Channel.exposure_ms', index=1,
-      number=2, type=1, cpp_type=5, label=1,
-      has_default_value=False, default_value=float(0),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='illumination_intensity', full_name='api.Channel.illumination_intensity', index=2,
-      number=3, type=1, cpp_type=5, label=1,
-      has_default_value=False, default_value=float(0),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=125,
-  serialized_end=208,
-)
-
-
-_LISTPROPERTYREQUEST = _descriptor.Descriptor(
-  name='ListPropertyRequest',
-  full_name='api.ListPropertyRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='name', full_name='api.ListPropertyRequest.name', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=210,
-  serialized_end=245,
-)
-
-
-_LISTPROPERTYRESPONSE = _descriptor.Descriptor(
-  name='ListPropertyResponse',
-  full_name='api.ListPropertyResponse',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='name', full_name='api.ListPropertyResponse.name', index=0,
-      number=1, type=9, cpp_type=9, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=247,
-  serialized_end=283,
-)
-
-
-_GETPROPERTYREQUEST = _descriptor.Descriptor(
-  name='GetPropertyRequest',
-  full_name='api.GetPropertyRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='name', full_name='api.GetPropertyRequest.name', index=0,
-      number=1, type=9, cpp_type=9, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=285,
-  serialized_end=319,
-)
-
-
-_GETPROPERTYRESPONSE = _descriptor.Descriptor(
-  name='GetPropertyResponse',
-  full_name='api.GetPropertyResponse',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='property', full_name='api.GetPropertyResponse.property', index=0,
-      number=1, type=11, cpp_type=10, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=321,
-  serialized_end=380,
-)
-
-
-_SETPROPERTYREQUEST = _descriptor.Descriptor(
-  name='SetPropertyRequest',
-  full_name='api.SetPropertyRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='property', full_name='api.SetPropertyRequest.property', index=0,
-      number=1, type=11, cpp_type=10, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=382,
-  serialized_end=440,
-)
-
-
-_WAITPROPERTYREQUEST = _descriptor.Descriptor(
-  name='WaitPropertyRequest',
-  full_name='api.WaitPropertyRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='name', full_name='api.WaitPropertyRequest.name', index=0,
-      number=1, type=9, cpp_type=9, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='timeout', full_name='api.WaitPropertyRequest.timeout', index=1,
-      number=2, type=11, cpp_type=10, label=1,
-      has_default_value=False, default_value=None,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=442,
-  serialized_end=521,
-)
-
-
-_LISTCHANNELRESPONSE = _descriptor.Descriptor(
-  name='ListChannelResponse',
-  full_name='api.ListChannelResponse',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='channels', full_name='api.ListChannelResponse.channels', index=0,
-      number=1, type=11, cpp_type=10, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=523,
-  serialized_end=576,
-)
-
-
-_SWITCHCHANNELREQUEST = _descriptor.Descriptor(
-  name='SwitchChannelRequest',
-  full_name='api.SwitchChannelRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='channel', full_name='api.SwitchChannelRequest.channel', index=0,
-      number=1, type=11, cpp_type=10, label=1,
-      has_default_value=False, default_value=None,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=578,
-  serialized_end=631,
-)
-
-
-_OPENEXPERIMENTREQUEST = _descriptor.Descriptor(
-  name='OpenExperimentRequest',
-  full_name='api.OpenExperimentRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='name', full_name='api.OpenExperimentRequest.name', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='base_dir', full_name='api.OpenExperimentRequest.base_dir', index=1,
-      number=2, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-    _descriptor.OneofDescriptor(
-      name='_base_dir', full_name='api.OpenExperimentRequest._base_dir',
-      index=0, containing_type=None,
-      create_key=_descriptor._internal_create_key,
-    fields=[]),
-  ],
-  serialized_start=633,
-  serialized_end=706,
-)
-
-
-_POS2D = _descriptor.Descriptor(
-  name='Pos2D',
-  full_name='api.Pos2D',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='x', full_name='api.Pos2D.x', index=0,
-      number=1, type=1, cpp_type=5, label=1,
-      has_default_value=False, default_value=float(0),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='y', full_name='api.Pos2D.y', index=1,
-      number=2, type=1, cpp_type=5, label=1,
-      has_default_value=False, default_value=float(0),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=708,
-  serialized_end=737,
-)
-
-
-_PLATEINFO = _descriptor.Descriptor(
-  name='PlateInfo',
-  full_name='api.PlateInfo',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='uuid', full_name='api.PlateInfo.uuid', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='type', full_name='api.PlateInfo.type', index=1,
-      number=2, type=14, cpp_type=8, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='id', full_name='api.PlateInfo.id', index=2,
-      number=3, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='pos_origin', full_name='api.PlateInfo.pos_origin', index=3,
-      number=4, type=11, cpp_type=10, label=1,
-      has_default_value=False, default_value=None,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='metadata', full_name='api.PlateInfo.metadata', index=4,
-      number=5, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='well', full_name='api.PlateInfo.well', index=5,
-      number=6, type=11, cpp_type=10, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-    _descriptor.OneofDescriptor(
-      name='_pos_origin', full_name='api.PlateInfo._pos_origin',
-      index=0, containing_type=None,
-      create_key=_descriptor._internal_create_key,
-    fields=[]),
-  ],
-  serialized_start=740,
-  serialized_end=906,
-)
-
-
-_WELLINFO = _descriptor.Descriptor(
-  name='WellInfo',
-  full_name='api.WellInfo',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='uuid', full_name='api.WellInfo.uuid', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='id', full_name='api.WellInfo.id', index=1,
-      number=2, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='rel_pos', full_name='api.WellInfo.rel_pos', index=2,
-      number=3, type=11, cpp_type=10, label=1,
-      has_default_value=False, default_value=None,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='enabled', full_name='api.WellInfo.enabled', index=3,
-      number=4, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='metadata', full_name='api.WellInfo.metadata', index=4,
-      number=5, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='site', full_name='api.WellInfo.site', index=5,
-      number=6, type=11, cpp_type=10, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=909,
-  serialized_end=1038,
-)
-
-
-_SITEINFO = _descriptor.Descriptor(
-  name='SiteInfo',
-  full_name='api.SiteInfo',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='uuid', full_name='api.SiteInfo.uuid', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='id', full_name='api.SiteInfo.id', index=1,
-      number=2, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='rel_pos', full_name='api.SiteInfo.rel_pos', index=2,
-      number=3, type=11, cpp_type=10, label=1,
-      has_default_value=False, default_value=None,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='enabled', full_name='api.SiteInfo.enabled', index=3,
-      number=4, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='metadata', full_name='api.SiteInfo.metadata', index=4,
-      number=5, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=1040,
-  serialized_end=1140,
-)
-
-
-_LISTPLATERESPONSE = _descriptor.Descriptor(
-  name='ListPlateResponse',
-  full_name='api.ListPlateResponse',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='plate', full_name='api.ListPlateResponse.plate', index=0,
-      number=1, type=11, cpp_type=10, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=1142,
-  serialized_end=1192,
-)
-
-
-_ADDPLATEREQUEST = _descriptor.Descriptor(
-  name='AddPlateRequest',
-  full_name='api.AddPlateRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='plate_type', full_name='api.AddPlateRequest.plate_type', index=0,
-      number=1, type=14, cpp_type=8, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='plate_id', full_name='api.AddPlateRequest.plate_id', index=1,
-      number=2, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=1194,
-  serialized_end=1265,
-)
-
-
-_SETPLATEPOSITIONORIGINREQUEST = _descriptor.Descriptor(
-  name='SetPlatePositionOriginRequest',
-  full_name='api.SetPlatePositionOriginRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='plate_uuid', full_name='api.SetPlatePositionOriginRequest.plate_uuid', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='x', full_name='api.SetPlatePositionOriginRequest.x', index=1,
-      number=2, type=1, cpp_type=5, label=1,
-      has_default_value=False, default_value=float(0),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='y', full_name='api.SetPlatePositionOriginRequest.y', index=2,
-      number=3, type=1, cpp_type=5, label=1,
-      has_default_value=False, default_value=float(0),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=1267,
-  serialized_end=1340,
-)
-
-
-_SETPLATEMETADATAREQUEST = _descriptor.Descriptor(
-  name='SetPlateMetadataRequest',
-  full_name='api.SetPlateMetadataRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='plate_uuid', full_name='api.SetPlateMetadataRequest.plate_uuid', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='key', full_name='api.SetPlateMetadataRequest.key', index=1,
-      number=2, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='json_value', full_name='api.SetPlateMetadataRequest.json_value', index=2,
-      number=3, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=1342,
-  serialized_end=1420,
-)
-
-
-_SETWELLSENABLEDREQUEST = _descriptor.Descriptor(
-  name='SetWellsEnabledRequest',
-  full_name='api.SetWellsEnabledRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='plate_uuid', full_name='api.SetWellsEnabledRequest.plate_uuid', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='well_id', full_name='api.SetWellsEnabledRequest.well_id', index=1,
-      number=2, type=9, cpp_type=9, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='enabled', full_name='api.SetWellsEnabledRequest.enabled', index=2,
-      number=3, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=1422,
-  serialized_end=1500,
-)
-
-
-_SETWELLSMETADATAREQUEST = _descriptor.Descriptor(
-  name='SetWellsMetadataRequest',
-  full_name='api.SetWellsMetadataRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='plate_uuid', full_name='api.SetWellsMetadataRequest.plate_uuid', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='well_id', full_name='api.SetWellsMetadataRequest.well_id', index=1,
-      number=2, type=9, cpp_type=9, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='key', full_name='api.SetWellsMetadataRequest.key', index=2,
-      number=3, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='json_value', full_name='api.SetWellsMetadataRequest.json_value', index=3,
-      number=4, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=1502,
-  serialized_end=1597,
-)
-
-
-_CREATESITESREQUEST = _descriptor.Descriptor(
-  name='CreateSitesRequest',
-  full_name='api.CreateSitesRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='plate_uuid', full_name='api.CreateSitesRequest.plate_uuid', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='well_id', full_name='api.CreateSitesRequest.well_id', index=1,
-      number=2, type=9, cpp_type=9, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='n_x', full_name='api.CreateSitesRequest.n_x', index=2,
-      number=3, type=5, cpp_type=1, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='n_y', full_name='api.CreateSitesRequest.n_y', index=3,
-      number=4, type=5, cpp_type=1, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='spacing_x', full_name='api.CreateSitesRequest.spacing_x', index=4,
-      number=5, type=1, cpp_type=5, label=1,
-      has_default_value=False, default_value=float(0),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='spacing_y', full_name='api.CreateSitesRequest.spacing_y', index=5,
-      number=6, type=1, cpp_type=5, label=1,
-      has_default_value=False, default_value=float(0),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=1599,
-  serialized_end=1720,
-)
-
-
-_ACQUIREMULTICHANNELREQUEST = _descriptor.Descriptor(
-  name='AcquireMultiChannelRequest',
-  full_name='api.AcquireMultiChannelRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='ndimage_name', full_name='api.AcquireMultiChannelRequest.ndimage_name', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='channels', full_name='api.AcquireMultiChannelRequest.channels', index=1,
-      number=2, type=11, cpp_type=10, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='i_z', full_name='api.AcquireMultiChannelRequest.i_z', index=2,
-      number=3, type=5, cpp_type=1, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='i_t', full_name='api.AcquireMultiChannelRequest.i_t', index=3,
-      number=4, type=5, cpp_type=1, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='metadata', full_name='api.AcquireMultiChannelRequest.metadata', index=4,
-      number=6, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='site_uuid', full_name='api.AcquireMultiChannelRequest.site_uuid', index=5,
-      number=7, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=1723,
-  serialized_end=1868,
-)
-
-
-_NDIMAGE = _descriptor.Descriptor(
-  name='NDImage',
-  full_name='api.NDImage',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='name', full_name='api.NDImage.name', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='ch_name', full_name='api.NDImage.ch_name', index=1,
-      number=2, type=9, cpp_type=9, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='width', full_name='api.NDImage.width', index=2,
-      number=3, type=13, cpp_type=3, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='height', full_name='api.NDImage.height', index=3,
-      number=4, type=13, cpp_type=3, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='n_ch', full_name='api.NDImage.n_ch', index=4,
-      number=5, type=5, cpp_type=1, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='n_z', full_name='api.NDImage.n_z', index=5,
-      number=6, type=5, cpp_type=1, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='n_t', full_name='api.NDImage.n_t', index=6,
-      number=7, type=5, cpp_type=1, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='dtype', full_name='api.NDImage.dtype', index=7,
-      number=8, type=14, cpp_type=8, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='ctype', full_name='api.NDImage.ctype', index=8,
-      number=9, type=14, cpp_type=8, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=1871,
-  serialized_end=2043,
-)
-
-
-_LISTNDIMAGERESPONSE = _descriptor.Descriptor(
-  name='ListNDImageResponse',
-  full_name='api.ListNDImageResponse',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='ndimage', full_name='api.ListNDImageResponse.ndimage', index=0,
-      number=1, type=11, cpp_type=10, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=2045,
-  serialized_end=2097,
-)
-
-
-_GETNDIMAGEREQUEST = _descriptor.Descriptor(
-  name='GetNDImageRequest',
-  full_name='api.GetNDImageRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='ndimage_name', full_name='api.GetNDImageRequest.ndimage_name', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=2099,
-  serialized_end=2140,
-)
-
-
-_GETNDIMAGERESPONSE = _descriptor.Descriptor(
-  name='GetNDImageResponse',
-  full_name='api.GetNDImageResponse',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='ndimage', full_name='api.GetNDImageResponse.ndimage', index=0,
-      number=1, type=11, cpp_type=10, label=1,
-      has_default_value=False, default_value=None,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=2142,
-  serialized_end=2193,
-)
-
-
-_GETIMAGEDATAREQUEST = _descriptor.Descriptor(
-  name='GetImageDataRequest',
-  full_name='api.GetImageDataRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='ndimage_name', full_name='api.GetImageDataRequest.ndimage_name', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='channel_name', full_name='api.GetImageDataRequest.channel_name', index=1,
-      number=2, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='i_z', full_name='api.GetImageDataRequest.i_z', index=2,
-      number=3, type=5, cpp_type=1, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='i_t', full_name='api.GetImageDataRequest.i_t', index=3,
-      number=4, type=5, cpp_type=1, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=2195,
-  serialized_end=2286,
-)
-
-
-_IMAGEDATA = _descriptor.Descriptor(
-  name='ImageData',
-  full_name='api.ImageData',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='width', full_name='api.ImageData.width', index=0,
-      number=1, type=13, cpp_type=3, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='height', full_name='api.ImageData.height', index=1,
-      number=2, type=13, cpp_type=3, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='dtype', full_name='api.ImageData.dtype', index=2,
-      number=3, type=14, cpp_type=8, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='ctype', full_name='api.ImageData.ctype', index=3,
-      number=4, type=14, cpp_type=8, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='buf', full_name='api.ImageData.buf', index=4,
-      number=5, type=12, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"",
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=2288,
-  serialized_end=2404,
-)
-
-
-_GETIMAGEDATARESPONSE = _descriptor.Descriptor(
-  name='GetImageDataResponse',
-  full_name='api.GetImageDataResponse',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='data', full_name='api.GetImageDataResponse.data', index=0,
-      number=1, type=11, cpp_type=10, label=1,
-      has_default_value=False, default_value=None,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=2406,
-  serialized_end=2458,
-)
-
-
-_GETSEGMENTATIONSCOREREQUEST = _descriptor.Descriptor(
-  name='GetSegmentationScoreRequest',
-  full_name='api.GetSegmentationScoreRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='ndimage_name', full_name='api.GetSegmentationScoreRequest.ndimage_name', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='ch_name', full_name='api.GetSegmentationScoreRequest.ch_name', index=1,
-      number=2, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='i_z', full_name='api.GetSegmentationScoreRequest.i_z', index=2,
-      number=3, type=5, cpp_type=1, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='i_t', full_name='api.GetSegmentationScoreRequest.i_t', index=3,
-      number=4, type=5, cpp_type=1, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=2460,
-  serialized_end=2554,
-)
-
-
-_GETSEGMENTATIONSCORERESPONSE = _descriptor.Descriptor(
-  name='GetSegmentationScoreResponse',
-  full_name='api.GetSegmentationScoreResponse',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='data', full_name='api.GetSegmentationScoreResponse.data', index=0,
-      number=1, type=11, cpp_type=10, label=1,
-      has_default_value=False, default_value=None,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=2556,
-  serialized_end=2616,
-)
-
-
-_QUANTIFYREGIONSREQUEST = _descriptor.Descriptor(
-  name='QuantifyRegionsRequest',
-  full_name='api.QuantifyRegionsRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='ndimage_name', full_name='api.QuantifyRegionsRequest.ndimage_name', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='i_t', full_name='api.QuantifyRegionsRequest.i_t', index=1,
-      number=2, type=5, cpp_type=1, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='segmentation_ch', full_name='api.QuantifyRegionsRequest.segmentation_ch', index=2,
-      number=3, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=2618,
-  serialized_end=2702,
-)
-
-
-_QUANTIFYREGIONSRESPONSE = _descriptor.Descriptor(
-  name='QuantifyRegionsResponse',
-  full_name='api.QuantifyRegionsResponse',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='n_regions', full_name='api.QuantifyRegionsResponse.n_regions', index=0,
-      number=1, type=5, cpp_type=1, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='region_prop', full_name='api.QuantifyRegionsResponse.region_prop', index=1,
-      number=2, type=11, cpp_type=10, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='raw_intensity', full_name='api.QuantifyRegionsResponse.raw_intensity', index=2,
-      number=3, type=11, cpp_type=10, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=2705,
-  serialized_end=2833,
-)
-
-
-_REGIONPROP = _descriptor.Descriptor(
-  name='RegionProp',
-  full_name='api.RegionProp',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='label', full_name='api.RegionProp.label', index=0,
-      number=1, type=13, cpp_type=3, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='bbox_x0', full_name='api.RegionProp.bbox_x0', index=1,
-      number=2, type=13, cpp_type=3, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='bbox_y0', full_name='api.RegionProp.bbox_y0', index=2,
-      number=3, type=13, cpp_type=3, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='bbox_width', full_name='api.RegionProp.bbox_width', index=3,
-      number=4, type=13, cpp_type=3, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='bbox_height', full_name='api.RegionProp.bbox_height', index=4,
-      number=5, type=13, cpp_type=3, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='area', full_name='api.RegionProp.area', index=5,
-      number=6, type=1, cpp_type=5, label=1,
-      has_default_value=False, default_value=float(0),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='centroid_x', full_name='api.RegionProp.centroid_x', index=6,
-      number=7, type=1, cpp_type=5, label=1,
-      has_default_value=False, default_value=float(0),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='centroid_y', full_name='api.RegionProp.centroid_y', index=7,
-      number=8, type=1, cpp_type=5, label=1,
-      has_default_value=False, default_value=float(0),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='score_mean', full_name='api.RegionProp.score_mean', index=8,
-      number=9, type=1, cpp_type=5, label=1,
-      has_default_value=False, default_value=float(0),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=2836,
-  serialized_end=3012,
-)
-
-
-_CHANNELINTENSITY = _descriptor.Descriptor(
-  name='ChannelIntensity',
-  full_name='api.ChannelIntensity',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='ch_name', full_name='api.ChannelIntensity.ch_name', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='values', full_name='api.ChannelIntensity.values', index=1,
-      number=2, type=1, cpp_type=5, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=3014,
-  serialized_end=3065,
-)
-
-
-_GETQUANTIFICATIONREQUEST = _descriptor.Descriptor(
-  name='GetQuantificationRequest',
-  full_name='api.GetQuantificationRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='ndimage_name', full_name='api.GetQuantificationRequest.ndimage_name', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=b"".decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='i_t', full_name='api.GetQuantificationRequest.i_t', index=1,
-      number=2, type=5, cpp_type=1, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=3067,
-  serialized_end=3128,
-)
-
-
-_GETQUANTIFICATIONRESPONSE = _descriptor.Descriptor(
-  name='GetQuantificationResponse',
-  full_name='api.GetQuantificationResponse',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  create_key=_descriptor._internal_create_key,
-  fields=[
-    _descriptor.FieldDescriptor(
-      name='region_prop', full_name='api.GetQuantificationResponse.region_prop', index=0,
-      number=1, type=11, cpp_type=10, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-    _descriptor.FieldDescriptor(
-      name='raw_intensity', full_name='api.GetQuantificationResponse.raw_intensity', index=1,
-      number=2, type=11, cpp_type=10, label=3,
-      has_default_value=False, default_value=[],
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR,  create_key=_descriptor._internal_create_key),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=3130,
-  serialized_end=3241,
-)
-
-_GETPROPERTYRESPONSE.fields_by_name['property'].message_type = _PROPERTYVALUE
-_SETPROPERTYREQUEST.fields_by_name['property'].message_type = _PROPERTYVALUE
-_WAITPROPERTYREQUEST.fields_by_name['timeout'].message_type = google_dot_protobuf_dot_duration__pb2._DURATION
-_LISTCHANNELRESPONSE.fields_by_name['channels'].message_type = _CHANNEL
-_SWITCHCHANNELREQUEST.fields_by_name['channel'].message_type = _CHANNEL
-_OPENEXPERIMENTREQUEST.oneofs_by_name['_base_dir'].fields.append(
-  _OPENEXPERIMENTREQUEST.fields_by_name['base_dir'])
-_OPENEXPERIMENTREQUEST.fields_by_name['base_dir'].containing_oneof = _OPENEXPERIMENTREQUEST.oneofs_by_name['_base_dir']
-_PLATEINFO.fields_by_name['type'].enum_type = _PLATETYPE
-_PLATEINFO.fields_by_name['pos_origin'].message_type = _POS2D
-_PLATEINFO.fields_by_name['well'].message_type = _WELLINFO
-_PLATEINFO.oneofs_by_name['_pos_origin'].fields.append(
-  _PLATEINFO.fields_by_name['pos_origin'])
-_PLATEINFO.fields_by_name['pos_origin'].containing_oneof = _PLATEINFO.oneofs_by_name['_pos_origin']
-_WELLINFO.fields_by_name['rel_pos'].message_type = _POS2D
-_WELLINFO.fields_by_name['site'].message_type = _SITEINFO
-_SITEINFO.fields_by_name['rel_pos'].message_type = _POS2D
-_LISTPLATERESPONSE.fields_by_name['plate'].message_type = _PLATEINFO
-_ADDPLATEREQUEST.fields_by_name['plate_type'].enum_type = _PLATETYPE
-_ACQUIREMULTICHANNELREQUEST.fields_by_name['channels'].message_type = _CHANNEL
-_NDIMAGE.fields_by_name['dtype'].enum_type = _DATATYPE
-_NDIMAGE.fields_by_name['ctype'].enum_type = _COLORTYPE
-_LISTNDIMAGERESPONSE.fields_by_name['ndimage'].message_type = _NDIMAGE
-_GETNDIMAGERESPONSE.fields_by_name['ndimage'].message_type = _NDIMAGE
-_IMAGEDATA.fields_by_name['dtype'].enum_type = _DATATYPE
-_IMAGEDATA.fields_by_name['ctype'].enum_type = _COLORTYPE
-_GETIMAGEDATARESPONSE.fields_by_name['data'].message_type = _IMAGEDATA
-_GETSEGMENTATIONSCORERESPONSE.fields_by_name['data'].message_type = _IMAGEDATA
-_QUANTIFYREGIONSRESPONSE.fields_by_name['region_prop'].message_type = _REGIONPROP
-_QUANTIFYREGIONSRESPONSE.fields_by_name['raw_intensity'].message_type = _CHANNELINTENSITY
-_GETQUANTIFICATIONRESPONSE.fields_by_name['region_prop'].message_type = _REGIONPROP
-_GETQUANTIFICATIONRESPONSE.fields_by_name['raw_intensity'].message_type = _CHANNELINTENSITY
-DESCRIPTOR.message_types_by_name['PropertyValue'] = _PROPERTYVALUE
-DESCRIPTOR.message_types_by_name['Channel'] = _CHANNEL
-DESCRIPTOR.message_types_by_name['ListPropertyRequest'] = _LISTPROPERTYREQUEST
-DESCRIPTOR.message_types_by_name['ListPropertyResponse'] = _LISTPROPERTYRESPONSE
-DESCRIPTOR.message_types_by_name['GetPropertyRequest'] = _GETPROPERTYREQUEST
-DESCRIPTOR.message_types_by_name['GetPropertyResponse'] = _GETPROPERTYRESPONSE
-DESCRIPTOR.message_types_by_name['SetPropertyRequest'] = _SETPROPERTYREQUEST
-DESCRIPTOR.message_types_by_name['WaitPropertyRequest'] = _WAITPROPERTYREQUEST
-DESCRIPTOR.message_types_by_name['ListChannelResponse'] = _LISTCHANNELRESPONSE
-DESCRIPTOR.message_types_by_name['SwitchChannelRequest'] = _SWITCHCHANNELREQUEST
-DESCRIPTOR.message_types_by_name['OpenExperimentRequest'] = _OPENEXPERIMENTREQUEST
-DESCRIPTOR.message_types_by_name['Pos2D'] = _POS2D
-DESCRIPTOR.message_types_by_name['PlateInfo'] = _PLATEINFO
-DESCRIPTOR.message_types_by_name['WellInfo'] = _WELLINFO
-DESCRIPTOR.message_types_by_name['SiteInfo'] = _SITEINFO
-DESCRIPTOR.message_types_by_name['ListPlateResponse'] = _LISTPLATERESPONSE
-DESCRIPTOR.message_types_by_name['AddPlateRequest'] = _ADDPLATEREQUEST
-DESCRIPTOR.message_types_by_name['SetPlatePositionOriginRequest'] = _SETPLATEPOSITIONORIGINREQUEST
-DESCRIPTOR.message_types_by_name['SetPlateMetadataRequest'] = _SETPLATEMETADATAREQUEST
-DESCRIPTOR.message_types_by_name['SetWellsEnabledRequest'] = _SETWELLSENABLEDREQUEST
-DESCRIPTOR.message_types_by_name['SetWellsMetadataRequest'] = _SETWELLSMETADATAREQUEST
-DESCRIPTOR.message_types_by_name['CreateSitesRequest'] = _CREATESITESREQUEST
-DESCRIPTOR.message_types_by_name['AcquireMultiChannelRequest'] = _ACQUIREMULTICHANNELREQUEST
-DESCRIPTOR.message_types_by_name['NDImage'] = _NDIMAGE
-DESCRIPTOR.message_types_by_name['ListNDImageResponse'] = _LISTNDIMAGERESPONSE
-DESCRIPTOR.message_types_by_name['GetNDImageRequest'] = _GETNDIMAGEREQUEST
-DESCRIPTOR.message_types_by_name['GetNDImageResponse'] = _GETNDIMAGERESPONSE
-DESCRIPTOR.message_types_by_name['GetImageDataRequest'] = _GETIMAGEDATAREQUEST
-DESCRIPTOR.message_types_by_name['ImageData'] = _IMAGEDATA
-DESCRIPTOR.message_types_by_name['GetImageDataResponse'] = _GETIMAGEDATARESPONSE
-DESCRIPTOR.message_types_by_name['GetSegmentationScoreRequest'] = _GETSEGMENTATIONSCOREREQUEST
-DESCRIPTOR.message_types_by_name['GetSegmentationScoreResponse'] = _GETSEGMENTATIONSCORERESPONSE
-DESCRIPTOR.message_types_by_name['QuantifyRegionsRequest'] = _QUANTIFYREGIONSREQUEST
-DESCRIPTOR.message_types_by_name['QuantifyRegionsResponse'] = _QUANTIFYREGIONSRESPONSE
-DESCRIPTOR.message_types_by_name['RegionProp'] = _REGIONPROP
-DESCRIPTOR.message_types_by_name['ChannelIntensity'] = _CHANNELINTENSITY
-DESCRIPTOR.message_types_by_name['GetQuantificationRequest'] = _GETQUANTIFICATIONREQUEST
-DESCRIPTOR.message_types_by_name['GetQuantificationResponse'] = _GETQUANTIFICATIONRESPONSE
-DESCRIPTOR.enum_types_by_name['PlateType'] = _PLATETYPE
-DESCRIPTOR.enum_types_by_name['DataType'] = _DATATYPE
-DESCRIPTOR.enum_types_by_name['ColorType'] = _COLORTYPE
-_sym_db.RegisterFileDescriptor(DESCRIPTOR)
-
-PropertyValue = _reflection.GeneratedProtocolMessageType('PropertyValue', (_message.Message,), {
-  'DESCRIPTOR' : _PROPERTYVALUE,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.PropertyValue)
-  })
-_sym_db.RegisterMessage(PropertyValue)
-
-Channel = _reflection.GeneratedProtocolMessageType('Channel', (_message.Message,), {
-  'DESCRIPTOR' : _CHANNEL,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.Channel)
-  })
-_sym_db.RegisterMessage(Channel)
-
-ListPropertyRequest = _reflection.GeneratedProtocolMessageType('ListPropertyRequest', (_message.Message,), {
-  'DESCRIPTOR' : _LISTPROPERTYREQUEST,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.ListPropertyRequest)
-  })
-_sym_db.RegisterMessage(ListPropertyRequest)
-
-ListPropertyResponse = _reflection.GeneratedProtocolMessageType('ListPropertyResponse', (_message.Message,), {
-  'DESCRIPTOR' : _LISTPROPERTYRESPONSE,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.ListPropertyResponse)
-  })
-_sym_db.RegisterMessage(ListPropertyResponse)
-
-GetPropertyRequest = _reflection.GeneratedProtocolMessageType('GetPropertyRequest', (_message.Message,), {
-  'DESCRIPTOR' : _GETPROPERTYREQUEST,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.GetPropertyRequest)
-  })
-_sym_db.RegisterMessage(GetPropertyRequest)
-
-GetPropertyResponse = _reflection.GeneratedProtocolMessageType('GetPropertyResponse', (_message.Message,), {
-  'DESCRIPTOR' : _GETPROPERTYRESPONSE,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.GetPropertyResponse)
-  })
-_sym_db.RegisterMessage(GetPropertyResponse)
-
-SetPropertyRequest = _reflection.GeneratedProtocolMessageType('SetPropertyRequest', (_message.Message,), {
-  'DESCRIPTOR' : _SETPROPERTYREQUEST,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.SetPropertyRequest)
-  })
-_sym_db.RegisterMessage(SetPropertyRequest)
-
-WaitPropertyRequest = _reflection.GeneratedProtocolMessageType('WaitPropertyRequest', (_message.Message,), {
-  'DESCRIPTOR' : _WAITPROPERTYREQUEST,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.WaitPropertyRequest)
-  })
-_sym_db.RegisterMessage(WaitPropertyRequest)
-
-ListChannelResponse = _reflection.GeneratedProtocolMessageType('ListChannelResponse', (_message.Message,), {
-  'DESCRIPTOR' : _LISTCHANNELRESPONSE,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.ListChannelResponse)
-  })
-_sym_db.RegisterMessage(ListChannelResponse)
-
-SwitchChannelRequest = _reflection.GeneratedProtocolMessageType('SwitchChannelRequest', (_message.Message,), {
-  'DESCRIPTOR' : _SWITCHCHANNELREQUEST,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.SwitchChannelRequest)
-  })
-_sym_db.RegisterMessage(SwitchChannelRequest)
-
-OpenExperimentRequest = _reflection.GeneratedProtocolMessageType('OpenExperimentRequest', (_message.Message,), {
-  'DESCRIPTOR' : _OPENEXPERIMENTREQUEST,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.OpenExperimentRequest)
-  })
-_sym_db.RegisterMessage(OpenExperimentRequest)
-
-Pos2D = _reflection.GeneratedProtocolMessageType('Pos2D', (_message.Message,), {
-  'DESCRIPTOR' : _POS2D,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.Pos2D)
-  })
-_sym_db.RegisterMessage(Pos2D)
-
-PlateInfo = _reflection.GeneratedProtocolMessageType('PlateInfo', (_message.Message,), {
-  'DESCRIPTOR' : _PLATEINFO,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.PlateInfo)
-  })
-_sym_db.RegisterMessage(PlateInfo)
-
-WellInfo = _reflection.GeneratedProtocolMessageType('WellInfo', (_message.Message,), {
-  'DESCRIPTOR' : _WELLINFO,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.WellInfo)
-  })
-_sym_db.RegisterMessage(WellInfo)
-
-SiteInfo = _reflection.GeneratedProtocolMessageType('SiteInfo', (_message.Message,), {
-  'DESCRIPTOR' : _SITEINFO,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.SiteInfo)
-  })
-_sym_db.RegisterMessage(SiteInfo)
-
-ListPlateResponse = _reflection.GeneratedProtocolMessageType('ListPlateResponse', (_message.Message,), {
-  'DESCRIPTOR' : _LISTPLATERESPONSE,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.ListPlateResponse)
-  })
-_sym_db.RegisterMessage(ListPlateResponse)
-
-AddPlateRequest = _reflection.GeneratedProtocolMessageType('AddPlateRequest', (_message.Message,), {
-  'DESCRIPTOR' : _ADDPLATEREQUEST,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.AddPlateRequest)
-  })
-_sym_db.RegisterMessage(AddPlateRequest)
-
-SetPlatePositionOriginRequest = _reflection.GeneratedProtocolMessageType('SetPlatePositionOriginRequest', (_message.Message,), {
-  'DESCRIPTOR' : _SETPLATEPOSITIONORIGINREQUEST,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.SetPlatePositionOriginRequest)
-  })
-_sym_db.RegisterMessage(SetPlatePositionOriginRequest)
-
-SetPlateMetadataRequest = _reflection.GeneratedProtocolMessageType('SetPlateMetadataRequest', (_message.Message,), {
-  'DESCRIPTOR' : _SETPLATEMETADATAREQUEST,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.SetPlateMetadataRequest)
-  })
-_sym_db.RegisterMessage(SetPlateMetadataRequest)
-
-SetWellsEnabledRequest = _reflection.GeneratedProtocolMessageType('SetWellsEnabledRequest', (_message.Message,), {
-  'DESCRIPTOR' : _SETWELLSENABLEDREQUEST,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.SetWellsEnabledRequest)
-  })
-_sym_db.RegisterMessage(SetWellsEnabledRequest)
-
-SetWellsMetadataRequest = _reflection.GeneratedProtocolMessageType('SetWellsMetadataRequest', (_message.Message,), {
-  'DESCRIPTOR' : _SETWELLSMETADATAREQUEST,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.SetWellsMetadataRequest)
-  })
-_sym_db.RegisterMessage(SetWellsMetadataRequest)
-
-CreateSitesRequest = _reflection.GeneratedProtocolMessageType('CreateSitesRequest', (_message.Message,), {
-  'DESCRIPTOR' : _CREATESITESREQUEST,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.CreateSitesRequest)
-  })
-_sym_db.RegisterMessage(CreateSitesRequest)
-
-AcquireMultiChannelRequest = _reflection.GeneratedProtocolMessageType('AcquireMultiChannelRequest', (_message.Message,), {
-  'DESCRIPTOR' : _ACQUIREMULTICHANNELREQUEST,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.AcquireMultiChannelRequest)
-  })
-_sym_db.RegisterMessage(AcquireMultiChannelRequest)
-
-NDImage = _reflection.GeneratedProtocolMessageType('NDImage', (_message.Message,), {
-  'DESCRIPTOR' : _NDIMAGE,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.NDImage)
-  })
-_sym_db.RegisterMessage(NDImage)
-
-ListNDImageResponse = _reflection.GeneratedProtocolMessageType('ListNDImageResponse', (_message.Message,), {
-  'DESCRIPTOR' : _LISTNDIMAGERESPONSE,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.ListNDImageResponse)
-  })
-_sym_db.RegisterMessage(ListNDImageResponse)
-
-GetNDImageRequest = _reflection.GeneratedProtocolMessageType('GetNDImageRequest', (_message.Message,), {
-  'DESCRIPTOR' : _GETNDIMAGEREQUEST,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.GetNDImageRequest)
-  })
-_sym_db.RegisterMessage(GetNDImageRequest)
-
-GetNDImageResponse = _reflection.GeneratedProtocolMessageType('GetNDImageResponse', (_message.Message,), {
-  'DESCRIPTOR' : _GETNDIMAGERESPONSE,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.GetNDImageResponse)
-  })
-_sym_db.RegisterMessage(GetNDImageResponse)
-
-GetImageDataRequest = _reflection.GeneratedProtocolMessageType('GetImageDataRequest', (_message.Message,), {
-  'DESCRIPTOR' : _GETIMAGEDATAREQUEST,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.GetImageDataRequest)
-  })
-_sym_db.RegisterMessage(GetImageDataRequest)
-
-ImageData = _reflection.GeneratedProtocolMessageType('ImageData', (_message.Message,), {
-  'DESCRIPTOR' : _IMAGEDATA,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.ImageData)
-  })
-_sym_db.RegisterMessage(ImageData)
-
-GetImageDataResponse = _reflection.GeneratedProtocolMessageType('GetImageDataResponse', (_message.Message,), {
-  'DESCRIPTOR' : _GETIMAGEDATARESPONSE,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.GetImageDataResponse)
-  })
-_sym_db.RegisterMessage(GetImageDataResponse)
-
-GetSegmentationScoreRequest = _reflection.GeneratedProtocolMessageType('GetSegmentationScoreRequest', (_message.Message,), {
-  'DESCRIPTOR' : _GETSEGMENTATIONSCOREREQUEST,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.GetSegmentationScoreRequest)
-  })
-_sym_db.RegisterMessage(GetSegmentationScoreRequest)
-
-GetSegmentationScoreResponse = _reflection.GeneratedProtocolMessageType('GetSegmentationScoreResponse', (_message.Message,), {
-  'DESCRIPTOR' : _GETSEGMENTATIONSCORERESPONSE,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.GetSegmentationScoreResponse)
-  })
-_sym_db.RegisterMessage(GetSegmentationScoreResponse)
-
-QuantifyRegionsRequest = _reflection.GeneratedProtocolMessageType('QuantifyRegionsRequest', (_message.Message,), {
-  'DESCRIPTOR' : _QUANTIFYREGIONSREQUEST,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.QuantifyRegionsRequest)
-  })
-_sym_db.RegisterMessage(QuantifyRegionsRequest)
-
-QuantifyRegionsResponse = _reflection.GeneratedProtocolMessageType('QuantifyRegionsResponse', (_message.Message,), {
-  'DESCRIPTOR' : _QUANTIFYREGIONSRESPONSE,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.QuantifyRegionsResponse)
-  })
-_sym_db.RegisterMessage(QuantifyRegionsResponse)
-
-RegionProp = _reflection.GeneratedProtocolMessageType('RegionProp', (_message.Message,), {
-  'DESCRIPTOR' : _REGIONPROP,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.RegionProp)
-  })
-_sym_db.RegisterMessage(RegionProp)
-
-ChannelIntensity = _reflection.GeneratedProtocolMessageType('ChannelIntensity', (_message.Message,), {
-  'DESCRIPTOR' : _CHANNELINTENSITY,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.ChannelIntensity)
-  })
-_sym_db.RegisterMessage(ChannelIntensity)
-
-GetQuantificationRequest = _reflection.GeneratedProtocolMessageType('GetQuantificationRequest', (_message.Message,), {
-  'DESCRIPTOR' : _GETQUANTIFICATIONREQUEST,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.GetQuantificationRequest)
-  })
-_sym_db.RegisterMessage(GetQuantificationRequest)
-
-GetQuantificationResponse = _reflection.GeneratedProtocolMessageType('GetQuantificationResponse', (_message.Message,), {
-  'DESCRIPTOR' : _GETQUANTIFICATIONRESPONSE,
-  '__module__' : 'api_pb2'
-  # @@protoc_insertion_point(class_scope:api.GetQuantificationResponse)
-  })
-_sym_db.RegisterMessage(GetQuantificationResponse)
-
-
-
-_NIKONTICTRL = _descriptor.ServiceDescriptor(
-  name='NikonTiCtrl',
-  full_name='api.NikonTiCtrl',
-  file=DESCRIPTOR,
-  index=0,
-  serialized_options=None,
-  create_key=_descriptor._internal_create_key,
-  serialized_start=3549,
-  serialized_end=5093,
-  methods=[
-  _descriptor.MethodDescriptor(
-    name='ListProperty',
-    full_name='api.NikonTiCtrl.ListProperty',
-    index=0,
-    containing_service=None,
-    input_type=_LISTPROPERTYREQUEST,
-    output_type=_LISTPROPERTYRESPONSE,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='GetProperty',
-    full_name='api.NikonTiCtrl.GetProperty',
-    index=1,
-    containing_service=None,
-    input_type=_GETPROPERTYREQUEST,
-    output_type=_GETPROPERTYRESPONSE,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='SetProperty',
-    full_name='api.NikonTiCtrl.SetProperty',
-    index=2,
-    containing_service=None,
-    input_type=_SETPROPERTYREQUEST,
-    output_type=google_dot_protobuf_dot_empty__pb2._EMPTY,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='WaitProperty',
-    full_name='api.NikonTiCtrl.WaitProperty',
-    index=3,
-    containing_service=None,
-    input_type=_WAITPROPERTYREQUEST,
-    output_type=google_dot_protobuf_dot_empty__pb2._EMPTY,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='ListChannel',
-    full_name='api.NikonTiCtrl.ListChannel',
-    index=4,
-    containing_service=None,
-    input_type=google_dot_protobuf_dot_empty__pb2._EMPTY,
-    output_type=_LISTCHANNELRESPONSE,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='SwitchChannel',
-    full_name='api.NikonTiCtrl.SwitchChannel',
-    index=5,
-    containing_service=None,
-    input_type=_SWITCHCHANNELREQUEST,
-    output_type=google_dot_protobuf_dot_empty__pb2._EMPTY,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='OpenExperiment',
-    full_name='api.NikonTiCtrl.OpenExperiment',
-    index=6,
-    containing_service=None,
-    input_type=_OPENEXPERIMENTREQUEST,
-    output_type=google_dot_protobuf_dot_empty__pb2._EMPTY,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='ListPlate',
-    full_name='api.NikonTiCtrl.ListPlate',
-    index=7,
-    containing_service=None,
-    input_type=google_dot_protobuf_dot_empty__pb2._EMPTY,
-    output_type=_LISTPLATERESPONSE,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='AddPlate',
-    full_name='api.NikonTiCtrl.AddPlate',
-    index=8,
-    containing_service=None,
-    input_type=_ADDPLATEREQUEST,
-    output_type=google_dot_protobuf_dot_empty__pb2._EMPTY,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='SetPlatePositionOrigin',
-    full_name='api.NikonTiCtrl.SetPlatePositionOrigin',
-    index=9,
-    containing_service=None,
-    input_type=_SETPLATEPOSITIONORIGINREQUEST,
-    output_type=google_dot_protobuf_dot_empty__pb2._EMPTY,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='SetPlateMetadata',
-    full_name='api.NikonTiCtrl.SetPlateMetadata',
-    index=10,
-    containing_service=None,
-    input_type=_SETPLATEMETADATAREQUEST,
-    output_type=google_dot_protobuf_dot_empty__pb2._EMPTY,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='SetWellsEnabled',
-    full_name='api.NikonTiCtrl.SetWellsEnabled',
-    index=11,
-    containing_service=None,
-    input_type=_SETWELLSENABLEDREQUEST,
-    output_type=google_dot_protobuf_dot_empty__pb2._EMPTY,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='SetWellsMetadata',
-    full_name='api.NikonTiCtrl.SetWellsMetadata',
-    index=12,
-    containing_service=None,
-    input_type=_SETWELLSMETADATAREQUEST,
-    output_type=google_dot_protobuf_dot_empty__pb2._EMPTY,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='CreateSites',
-    full_name='api.NikonTiCtrl.CreateSites',
-    index=13,
-    containing_service=None,
-    input_type=_CREATESITESREQUEST,
-    output_type=google_dot_protobuf_dot_empty__pb2._EMPTY,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='AcquireMultiChannel',
-    full_name='api.NikonTiCtrl.AcquireMultiChannel',
-    index=14,
-    containing_service=None,
-    input_type=_ACQUIREMULTICHANNELREQUEST,
-    output_type=google_dot_protobuf_dot_empty__pb2._EMPTY,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='ListNDImage',
-    full_name='api.NikonTiCtrl.ListNDImage',
-    index=15,
-    containing_service=None,
-    input_type=google_dot_protobuf_dot_empty__pb2._EMPTY,
-    output_type=_LISTNDIMAGERESPONSE,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='GetNDImage',
-    full_name='api.NikonTiCtrl.GetNDImage',
-    index=16,
-    containing_service=None,
-    input_type=_GETNDIMAGEREQUEST,
-    output_type=_GETNDIMAGERESPONSE,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='GetImageData',
-    full_name='api.NikonTiCtrl.GetImageData',
-    index=17,
-    containing_service=None,
-    input_type=_GETIMAGEDATAREQUEST,
-    output_type=_GETIMAGEDATARESPONSE,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='GetSegmentationScore',
-    full_name='api.NikonTiCtrl.GetSegmentationScore',
-    index=18,
-    containing_service=None,
-    input_type=_GETSEGMENTATIONSCOREREQUEST,
-    output_type=_GETSEGMENTATIONSCORERESPONSE,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='QuantifyRegions',
-    full_name='api.NikonTiCtrl.QuantifyRegions',
-    index=19,
-    containing_service=None,
-    input_type=_QUANTIFYREGIONSREQUEST,
-    output_type=_QUANTIFYREGIONSRESPONSE,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-  _descriptor.MethodDescriptor(
-    name='GetQuantification',
-    full_name='api.NikonTiCtrl.GetQuantification',
-    index=20,
-    containing_service=None,
-    input_type=_GETQUANTIFICATIONREQUEST,
-    output_type=_GETQUANTIFICATIONRESPONSE,
-    serialized_options=None,
-    create_key=_descriptor._internal_create_key,
-  ),
-])
-_sym_db.RegisterServiceDescriptor(_NIKONTICTRL)
-
-DESCRIPTOR.services_by_name['NikonTiCtrl'] = _NIKONTICTRL
-
+DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\tapi.proto\x12\x03\x61pi\x1a\x1bgoogle/protobuf/empty.proto\x1a\x1egoogle/protobuf/duration.proto\",\n\rPropertyValue\x12\x0c\n\x04name\x18\x01 \x01(\t\x12\r\n\x05value\x18\x02 \x01(\t\"S\n\x07\x43hannel\x12\x13\n\x0bpreset_name\x18\x01 \x01(\t\x12\x13\n\x0b\x65xposure_ms\x18\x02 \x01(\x01\x12\x1e\n\x16illumination_intensity\x18\x03 \x01(\x01\"#\n\x13ListPropertyRequest\x12\x0c\n\x04name\x18\x01 \x01(\t\"$\n\x14ListPropertyResponse\x12\x0c\n\x04name\x18\x01 \x03(\t\"\"\n\x12GetPropertyRequest\x12\x0c\n\x04name\x18\x01 \x03(\t\";\n\x13GetPropertyResponse\x12$\n\x08property\x18\x01 \x03(\x0b\x32\x12.api.PropertyValue\":\n\x12SetPropertyRequest\x12$\n\x08property\x18\x01 \x03(\x0b\x32\x12.api.PropertyValue\"O\n\x13WaitPropertyRequest\x12\x0c\n\x04name\x18\x01 \x03(\t\x12*\n\x07timeout\x18\x02 \x01(\x0b\x32\x19.google.protobuf.Duration\"5\n\x13ListChannelResponse\x12\x1e\n\x08\x63hannels\x18\x01 \x03(\x0b\x32\x0c.api.Channel\"5\n\x14SwitchChannelRequest\x12\x1d\n\x07\x63hannel\x18\x01 \x01(\x0b\x32\x0c.api.Channel\"I\n\x15OpenExperimentRequest\x12\x0c\n\x04name\x18\x01 \x01(\t\x12\x15\n\x08\x62\x61se_dir\x18\x02 \x01(\tH\x00\x88\x01\x01\x42\x0b\n\t_base_dir\"\x1d\n\x05Pos2D\x12\t\n\x01x\x18\x01 \x01(\x01\x12\t\n\x01y\x18\x02 \x01(\x01\"\xa6\x01\n\tPlateInfo\x12\x0c\n\x04uuid\x18\x01 \x01(\t\x12\x1c\n\x04type\x18\x02 \x01(\x0e\x32\x0e.api.PlateType\x12\n\n\x02id\x18\x03 \x01(\t\x12#\n\npos_origin\x18\x04 \x01(\x0b\x32\n.api.Pos2DH\x00\x88\x01\x01\x12\x10\n\x08metadata\x18\x05 \x01(\t\x12\x1b\n\x04well\x18\x06 \x03(\x0b\x32\r.api.WellInfoB\r\n\x0b_pos_origin\"\x81\x01\n\x08WellInfo\x12\x0c\n\x04uuid\x18\x01 \x01(\t\x12\n\n\x02id\x18\x02 \x01(\t\x12\x1b\n\x07rel_pos\x18\x03 \x01(\x0b\x32\n.api.Pos2D\x12\x0f\n\x07\x65nabled\x18\x04 \x01(\x08\x12\x10\n\x08metadata\x18\x05 \x01(\t\x12\x1b\n\x04site\x18\x06 \x03(\x0b\x32\r.api.SiteInfo\"d\n\x08SiteInfo\x12\x0c\n\x04uuid\x18\x01 \x01(\t\x12\n\n\x02id\x18\x02 \x01(\t\x12\x1b\n\x07rel_pos\x18\x03 \x01(\x0b\x32\n.api.Pos2D\x12\x0f\n\x07\x65nabled\x18\x04 \x01(\x08\x12\x10\n\x08metadata\x18\x05 \x01(\t\"2\n\x11ListPlateResponse\x12\x1d\n\x05plate\x18\x01 \x03(\x0b\x32\x0e.api.PlateInfo\"G\n\x0f\x41\x64\x64PlateRequest\x12\"\n\nplate_type\x18\x01 \x01(\x0e\x32\x0e.api.PlateType\x12\x10\n\x08plate_id\x18\x02 \x01(\t\"I\n\x1dSetPlatePositionOriginRequest\x12\x12\n\nplate_uuid\x18\x01 \x01(\t\x12\t\n\x01x\x18\x02 \x01(\x01\x12\t\n\x01y\x18\x03 \x01(\x01\"N\n\x17SetPlateMetadataRequest\x12\x12\n\nplate_uuid\x18\x01 \x01(\t\x12\x0b\n\x03key\x18\x02 \x01(\t\x12\x12\n\njson_value\x18\x03 \x01(\t\"N\n\x16SetWellsEnabledRequest\x12\x12\n\nplate_uuid\x18\x01 \x01(\t\x12\x0f\n\x07well_id\x18\x02 \x03(\t\x12\x0f\n\x07\x65nabled\x18\x03 \x01(\x08\"_\n\x17SetWellsMetadataRequest\x12\x12\n\nplate_uuid\x18\x01 \x01(\t\x12\x0f\n\x07well_id\x18\x02 \x03(\t\x12\x0b\n\x03key\x18\x03 \x01(\t\x12\x12\n\njson_value\x18\x04 \x01(\t\"y\n\x12\x43reateSitesRequest\x12\x12\n\nplate_uuid\x18\x01 \x01(\t\x12\x0f\n\x07well_id\x18\x02 \x03(\t\x12\x0b\n\x03n_x\x18\x03 \x01(\x05\x12\x0b\n\x03n_y\x18\x04 \x01(\x05\x12\x11\n\tspacing_x\x18\x05 \x01(\x01\x12\x11\n\tspacing_y\x18\x06 \x01(\x01\"\\\n\x14SetFocusPointRequest\x12\x12\n\nplate_uuid\x18\x01 \x01(\t\x12\x0f\n\x07well_id\x18\x02 \x01(\t\x12\t\n\x01x\x18\x03 \x01(\x01\x12\t\n\x01y\x18\x04 \x01(\x01\x12\t\n\x01z\x18\x05 \x01(\x01\"*\n\x14\x43learFocusMapRequest\x12\x12\n\nplate_uuid\x18\x01 \x01(\t\"@\n\x1bSetFocusSurfaceModelRequest\x12\x12\n\nplate_uuid\x18\x01 \x01(\t\x12\r\n\x05model\x18\x02 \x01(\t\"(\n\x12GetFocusMapRequest\x12\x12\n\nplate_uuid\x18\x01 \x01(\t\">\n\nFocusPoint\x12\x0f\n\x07well_id\x18\x01 \x01(\t\x12\t\n\x01x\x18\x02 \x01(\x01\x12\t\n\x01y\x18\x03 \x01(\x01\x12\t\n\x01z\x18\x04 \x01(\x01\")\n\tSiteFocus\x12\x11\n\tsite_uuid\x18\x01 \x01(\t\x12\t\n\x01z\x18\x02 \x01(\x01\"h\n\x13GetFocusMapResponse\x12\r\n\x05model\x18\x01 \x01(\t\x12\x1e\n\x05point\x18\x02 \x03(\x0b\x32\x0f.api.FocusPoint\x12\"\n\nsite_focus\x18\x03 \x03(\x0b\x32\x0e.api.SiteFocus\"\x91\x01\n\x1a\x41\x63quireMultiChannelRequest\x12\x14\n\x0cndimage_name\x18\x01 \x01(\t\x12\x1e\n\x08\x63hannels\x18\x02 \x03(\x0b\x32\x0c.api.Channel\x12\x0b\n\x03i_z\x18\x03 \x01(\x05\x12\x0b\n\x03i_t\x18\x04 \x01(\x05\x12\x10\n\x08metadata\x18\x06 \x01(\t\x12\x11\n\tsite_uuid\x18\x07 \x01(\t\"\x92\x02\n\x14\x41\x63quireZStackRequest\x12\x14\n\x0cndimage_name\x18\x01 \x01(\t\x12\x1e\n\x08\x63hannels\x18\x02 \x03(\x0b\x32\x0c.api.Channel\x12\x15\n\x08z_center\x18\x03 \x01(\x01H\x00\x88\x01\x01\x12\x0f\n\x07step_um\x18\x04 \x01(\x01\x12\x0b\n\x03n_z\x18\x05 \x01(\x05\x12\x1f\n\x05order\x18\x06 \x01(\x0e\x32\x10.api.ZStackOrder\x12\x16\n\x0emax_projection\x18\x07 \x01(\x08\x12\x17\n\x0fmean_projection\x18\x08 \x01(\x08\x12\x0b\n\x03i_t\x18\t \x01(\x05\x12\x10\n\x08metadata\x18\n \x01(\t\x12\x11\n\tsite_uuid\x18\x0b \x01(\tB\x0b\n\t_z_center\"\xa3\x01\n\x10\x41utofocusRequest\x12\x1d\n\x07\x63hannel\x18\x01 \x01(\x0b\x32\x0c.api.Channel\x12 \n\x06metric\x18\x02 \x01(\x0e\x32\x10.api.FocusMetric\x12\x10\n\x08range_um\x18\x03 \x01(\x01\x12\x16\n\x0e\x63oarse_step_um\x18\x04 \x01(\x01\x12\x14\n\x0c\x66ine_step_um\x18\x05 \x01(\x01\x12\x0e\n\x06stride\x18\x06 \x01(\x05\"?\n\x11\x41utofocusResponse\x12\t\n\x01z\x18\x01 \x01(\x01\x12\r\n\x05score\x18\x02 \x01(\x01\x12\x10\n\x08n_frames\x18\x03 \x01(\x05\"h\n\x0fStageSpeedModel\x12\x0f\n\x07speed_x\x18\x01 \x01(\x01\x12\x0f\n\x07speed_y\x18\x02 \x01(\x01\x12\x0f\n\x07\x61\x63\x63\x65l_x\x18\x03 \x01(\x01\x12\x0f\n\x07\x61\x63\x63\x65l_y\x18\x04 \x01(\x01\x12\x11\n\tsettle_ms\x18\x05 \x01(\x01\"\xd9\x02\n\x10StartScanRequest\x12\x12\n\nplate_uuid\x18\x01 \x01(\t\x12\x0f\n\x07well_id\x18\x02 \x03(\t\x12\x1e\n\x08\x63hannels\x18\x03 \x03(\x0b\x32\x0c.api.Channel\x12\x0b\n\x03i_t\x18\x04 \x01(\x05\x12&\n\nfocus_mode\x18\x05 \x01(\x0e\x32\x12.api.ScanFocusMode\x12(\n\tautofocus\x18\x06 \x01(\x0b\x32\x15.api.AutofocusRequest\x12\x16\n\x0endimage_prefix\x18\x07 \x01(\t\x12\x10\n\x08metadata\x18\x08 \x01(\t\x12\"\n\nsite_order\x18\t \x01(\x0e\x32\x0e.api.SiteOrder\x12)\n\x0bspeed_model\x18\n \x01(\x0b\x32\x14.api.StageSpeedModel\x12(\n\rchannel_order\x18\x0b \x01(\x0e\x32\x11.api.ChannelOrder\"J\n\x10PlanScanResponse\x12\x11\n\ttravel_um\x18\x01 \x01(\x01\x12\x10\n\x08travel_s\x18\x02 \x01(\x01\x12\x11\n\tsite_uuid\x18\x03 \x03(\t\"\x8b\x02\n\x0cScanProgress\x12\r\n\x05state\x18\x01 \x01(\t\x12\x15\n\rn_sites_total\x18\x02 \x01(\x05\x12\x14\n\x0cn_sites_done\x18\x03 \x01(\x05\x12\x15\n\rn_wells_total\x18\x04 \x01(\x05\x12\x14\n\x0cn_wells_done\x18\x05 \x01(\x05\x12\x0f\n\x07well_id\x18\x06 \x01(\t\x12\x0f\n\x07site_id\x18\x07 \x01(\t\x12\x11\n\telapsed_s\x18\x08 \x01(\x01\x12\x13\n\x0bremaining_s\x18\t \x01(\x01\x12\x0f\n\x07message\x18\n \x01(\t\x12\x1b\n\x13predicted_travel_um\x18\x0b \x01(\x01\x12\x1a\n\x12predicted_travel_s\x18\x0c \x01(\x01\"\x81\x01\n\x0eTimelapseGroup\x12\x0c\n\x04name\x18\x01 \x01(\t\x12#\n\x04scan\x18\x02 \x01(\x0b\x32\x15.api.StartScanRequest\x12\x12\n\ninterval_s\x18\x03 \x01(\x01\x12\x10\n\x08n_rounds\x18\x04 \x01(\x05\x12\x16\n\x0estart_offset_s\x18\x05 \x01(\x01\"h\n\x15StartTimelapseRequest\x12#\n\x06groups\x18\x01 \x03(\x0b\x32\x13.api.TimelapseGroup\x12*\n\x0eoverrun_policy\x18\x02 \x01(\x0e\x32\x12.api.OverrunPolicy\"\x88\x02\n\x14TimelapseGroupStatus\x12\x0c\n\x04name\x18\x01 \x01(\t\x12\x12\n\ninterval_s\x18\x02 \x01(\x01\x12\x15\n\rn_rounds_done\x18\x03 \x01(\x05\x12\x18\n\x10n_rounds_skipped\x18\x04 \x01(\x05\x12\x17\n\x0fn_rounds_failed\x18\x05 \x01(\x05\x12\x14\n\x0cmean_round_s\x18\x06 \x01(\x01\x12\x13\n\x0bmax_round_s\x18\x07 \x01(\x01\x12\x13\n\x0bmean_late_s\x18\x08 \x01(\x01\x12\x12\n\nmax_late_s\x18\t \x01(\x01\x12\x1c\n\x0fnext_round_in_s\x18\n \x01(\x01H\x00\x88\x01\x01\x42\x12\n\x10_next_round_in_s\"\x96\x01\n\x0fTimelapseStatus\x12\x0f\n\x07running\x18\x01 \x01(\x08\x12\x11\n\telapsed_s\x18\x02 \x01(\x01\x12\x0e\n\x06\x62usy_s\x18\x03 \x01(\x01\x12\x13\n\x0butilization\x18\x04 \x01(\x01\x12)\n\x06groups\x18\x05 \x03(\x0b\x32\x19.api.TimelapseGroupStatus\x12\x0f\n\x07message\x18\x06 \x01(\t\"N\n\x19StartLiveRecordingRequest\x12\x0c\n\x04name\x18\x01 \x01(\t\x12\x12\n\nduration_s\x18\x02 \x01(\x01\x12\x0f\n\x07\x63h_name\x18\x03 \x01(\t\"\xb1\x01\n\x12LiveRecordingStats\x12\x0c\n\x04name\x18\x01 \x01(\t\x12\x0f\n\x07running\x18\x02 \x01(\x08\x12\x10\n\x08n_frames\x18\x03 \x01(\x04\x12\x18\n\x10n_dropped_camera\x18\x04 \x01(\x04\x12\x18\n\x10n_dropped_writer\x18\x05 \x01(\x04\x12\x11\n\telapsed_s\x18\x06 \x01(\x01\x12\x0b\n\x03\x66ps\x18\x07 \x01(\x01\x12\x16\n\x0ewrite_mb_per_s\x18\x08 \x01(\x01\"@\n\x1aImportLiveRecordingRequest\x12\x0c\n\x04name\x18\x01 \x01(\t\x12\x14\n\x0cndimage_name\x18\x02 \x01(\t\"-\n\x16WatchLiveFramesRequest\x12\x13\n\x0b\x65very_frame\x18\x01 \x01(\x08\"<\n\tLiveFrame\x12\x1c\n\x04\x64\x61ta\x18\x01 \x01(\x0b\x32\x0e.api.ImageData\x12\x11\n\tn_dropped\x18\x02 \x01(\x04\"R\n\x11LiveConsumerStats\x12\x0c\n\x04name\x18\x01 \x01(\t\x12\x0c\n\x04mode\x18\x02 \x01(\t\x12\x0e\n\x06n_read\x18\x03 \x01(\x04\x12\x11\n\tn_dropped\x18\x04 \x01(\x04\"O\n\x0eLiveFrameStats\x12\x13\n\x0bn_published\x18\x01 \x01(\x04\x12(\n\x08\x63onsumer\x18\x02 \x03(\x0b\x32\x16.api.LiveConsumerStats\"\xac\x01\n\x07NDImage\x12\x0c\n\x04name\x18\x01 \x01(\t\x12\x0f\n\x07\x63h_name\x18\x02 \x03(\t\x12\r\n\x05width\x18\x03 \x01(\r\x12\x0e\n\x06height\x18\x04 \x01(\r\x12\x0c\n\x04n_ch\x18\x05 \x01(\x05\x12\x0b\n\x03n_z\x18\x06 \x01(\x05\x12\x0b\n\x03n_t\x18\x07 \x01(\x05\x12\x1c\n\x05\x64type\x18\x08 \x01(\x0e\x32\r.api.DataType\x12\x1d\n\x05\x63type\x18\t \x01(\x0e\x32\x0e.api.ColorType\"4\n\x13ListNDImageResponse\x12\x1d\n\x07ndimage\x18\x01 \x03(\x0b\x32\x0c.api.NDImage\")\n\x11GetNDImageRequest\x12\x14\n\x0cndimage_name\x18\x01 \x01(\t\"3\n\x12GetNDImageResponse\x12\x1d\n\x07ndimage\x18\x01 \x01(\x0b\x32\x0c.api.NDImage\"[\n\x13GetImageDataRequest\x12\x14\n\x0cndimage_name\x18\x01 \x01(\t\x12\x14\n\x0c\x63hannel_name\x18\x02 \x01(\t\x12\x0b\n\x03i_z\x18\x03 \x01(\x05\x12\x0b\n\x03i_t\x18\x04 \x01(\x05\"t\n\tImageData\x12\r\n\x05width\x18\x01 \x01(\r\x12\x0e\n\x06height\x18\x02 \x01(\r\x12\x1c\n\x05\x64type\x18\x03 \x01(\x0e\x32\r.api.DataType\x12\x1d\n\x05\x63type\x18\x04 \x01(\x0e\x32\x0e.api.ColorType\x12\x0b\n\x03\x62uf\x18\x05 \x01(\x0c\"4\n\x14GetImageDataResponse\x12\x1c\n\x04\x64\x61ta\x18\x01 \x01(\x0b\x32\x0e.api.ImageData\"^\n\x1bGetSegmentationScoreRequest\x12\x14\n\x0cndimage_name\x18\x01 \x01(\t\x12\x0f\n\x07\x63h_name\x18\x02 \x01(\t\x12\x0b\n\x03i_z\x18\x03 \x01(\x05\x12\x0b\n\x03i_t\x18\x04 \x01(\x05\"<\n\x1cGetSegmentationScoreResponse\x12\x1c\n\x04\x64\x61ta\x18\x01 \x01(\x0b\x32\x0e.api.ImageData\"T\n\x16QuantifyRegionsRequest\x12\x14\n\x0cndimage_name\x18\x01 \x01(\t\x12\x0b\n\x03i_t\x18\x02 \x01(\x05\x12\x17\n\x0fsegmentation_ch\x18\x03 \x01(\t\"\xb4\x01\n\x17QuantifyRegionsResponse\x12\x11\n\tn_regions\x18\x01 \x01(\x05\x12$\n\x0bregion_prop\x18\x02 \x03(\x0b\x32\x0f.api.RegionProp\x12,\n\rraw_intensity\x18\x03 \x03(\x0b\x32\x15.api.ChannelIntensity\x12\x32\n\x13\x63orrected_intensity\x18\x04 \x03(\x0b\x32\x15.api.ChannelIntensity\"\xb0\x01\n\nRegionProp\x12\r\n\x05label\x18\x01 \x01(\r\x12\x0f\n\x07\x62\x62ox_x0\x18\x02 \x01(\r\x12\x0f\n\x07\x62\x62ox_y0\x18\x03 \x01(\r\x12\x12\n\nbbox_width\x18\x04 \x01(\r\x12\x13\n\x0b\x62\x62ox_height\x18\x05 \x01(\r\x12\x0c\n\x04\x61rea\x18\x06 \x01(\x01\x12\x12\n\ncentroid_x\x18\x07 \x01(\x01\x12\x12\n\ncentroid_y\x18\x08 \x01(\x01\x12\x12\n\nscore_mean\x18\t \x01(\x01\"3\n\x10\x43hannelIntensity\x12\x0f\n\x07\x63h_name\x18\x01 \x01(\t\x12\x0e\n\x06values\x18\x02 \x03(\x01\"=\n\x18GetQuantificationRequest\x12\x14\n\x0cndimage_name\x18\x01 \x01(\t\x12\x0b\n\x03i_t\x18\x02 \x01(\x05\"\xa3\x01\n\x19GetQuantificationResponse\x12$\n\x0bregion_prop\x18\x01 \x03(\x0b\x32\x0f.api.RegionProp\x12,\n\rraw_intensity\x18\x02 \x03(\x0b\x32\x15.api.ChannelIntensity\x12\x32\n\x13\x63orrected_intensity\x18\x03 \x03(\x0b\x32\x15.api.ChannelIntensity\"J\n\x13GetCellTableRequest\x12\x10\n\x08plate_id\x18\x01 \x01(\t\x12\x14\n\x0cndimage_name\x18\x02 \x01(\t\x12\x0b\n\x03i_t\x18\x03 \x01(\x05\"=\n\x0e\x43\x65llTableField\x12\x0c\n\x04name\x18\x01 \x01(\t\x12\r\n\x05\x64type\x18\x02 \x01(\t\x12\x0e\n\x06offset\x18\x03 \x01(\r\"i\n\x14GetCellTableResponse\x12\"\n\x05\x66ield\x18\x01 \x03(\x0b\x32\x13.api.CellTableField\x12\x10\n\x08itemsize\x18\x02 \x01(\r\x12\x0e\n\x06n_rows\x18\x03 \x01(\x04\x12\x0b\n\x03\x62uf\x18\x04 \x01(\x0c\"\xa7\x01\n\x19\x42uildCorrectionMapRequest\x12$\n\x04type\x18\x01 \x01(\x0e\x32\x16.api.CorrectionMapType\x12\x0f\n\x07\x63h_name\x18\x02 \x01(\t\x12\x14\n\x0cndimage_name\x18\x03 \x01(\t\x12\x10\n\x08\x63\x61lib_ch\x18\x04 \x01(\t\x12+\n\tstatistic\x18\x05 \x01(\x0e\x32\x18.api.CorrectionStatistic\"{\n\tSpanStats\x12\x0c\n\x04name\x18\x01 \x01(\t\x12\r\n\x05\x63ount\x18\x02 \x01(\x04\x12\x0e\n\x06p50_ms\x18\x03 \x01(\x01\x12\x0e\n\x06p90_ms\x18\x04 \x01(\x01\x12\x0e\n\x06p99_ms\x18\x05 \x01(\x01\x12\x0e\n\x06max_ms\x18\x06 \x01(\x01\x12\x11\n\thistogram\x18\x07 \x03(\x04\"4\n\x14GetSpanStatsResponse\x12\x1c\n\x04span\x18\x01 \x03(\x0b\x32\x0e.api.SpanStats*F\n\tPlateType\x12\x0b\n\x07UNKNOWN\x10\x00\x12\t\n\x05SLIDE\x10\x01\x12\x0f\n\x0bWELLPLATE96\x10\x02\x12\x10\n\x0cWELLPLATE384\x10\x03*=\n\x0bZStackOrder\x12\x16\n\x12\x43HANNELS_PER_PLANE\x10\x00\x12\x16\n\x12PLANES_PER_CHANNEL\x10\x01*A\n\x0b\x46ocusMetric\x12\x0b\n\x07\x42RENNER\x10\x00\x12\r\n\tTENENGRAD\x10\x01\x12\x16\n\x12LAPLACIAN_VARIANCE\x10\x02*@\n\rScanFocusMode\x12\r\n\tFOCUS_MAP\x10\x00\x12\x16\n\x12\x41UTOFOCUS_PER_WELL\x10\x01\x12\x08\n\x04NONE\x10\x02*\\\n\tSiteOrder\x12\x0e\n\nAS_CREATED\x10\x00\x12\x0e\n\nSERPENTINE\x10\x01\x12\x14\n\x10NEAREST_NEIGHBOR\x10\x02\x12\x19\n\x15NEAREST_NEIGHBOR_2OPT\x10\x03*:\n\x0c\x43hannelOrder\x12\x0c\n\x08\x41S_GIVEN\x10\x00\x12\r\n\tMIN_MOVES\x10\x01\x12\r\n\tPING_PONG\x10\x02*\'\n\rOverrunPolicy\x12\x08\n\x04SKIP\x10\x00\x12\x0c\n\x08\x43OMPRESS\x10\x01*o\n\x08\x44\x61taType\x12\x11\n\rUNKNOWN_DTYPE\x10\x00\x12\t\n\x05\x42OOL8\x10\x01\x12\t\n\x05UINT8\x10\x02\x12\n\n\x06UINT16\x10\x03\x12\t\n\x05INT16\x10\x04\x12\t\n\x05INT32\x10\x05\x12\x0b\n\x07\x46LOAT32\x10\x06\x12\x0b\n\x07\x46LOAT64\x10\x07*v\n\tColorType\x12\x11\n\rUNKNOWN_CTYPE\x10\x00\x12\t\n\x05MONO8\x10\x01\x12\n\n\x06MONO10\x10\x02\x12\n\n\x06MONO12\x10\x03\x12\n\n\x06MONO14\x10\x04\x12\n\n\x06MONO16\x10\x05\x12\x0c\n\x08\x42\x41YERRG8\x10\x06\x12\r\n\tBAYERRG16\x10\x07*\'\n\x11\x43orrectionMapType\x12\x08\n\x04\x44\x41RK\x10\x00\x12\x08\n\x04\x46LAT\x10\x01*+\n\x13\x43orrectionStatistic\x12\n\n\x06MEDIAN\x10\x00\x12\x08\n\x04MEAN\x10\x01\x32\x8e\x19\n\x0bNikonTiCtrl\x12\x45\n\x0cListProperty\x12\x18.api.ListPropertyRequest\x1a\x19.api.ListPropertyResponse\"\x00\x12\x42\n\x0bGetProperty\x12\x17.api.GetPropertyRequest\x1a\x18.api.GetPropertyResponse\"\x00\x12@\n\x0bSetProperty\x12\x17.api.SetPropertyRequest\x1a\x16.google.protobuf.Empty\"\x00\x12\x42\n\x0cWaitProperty\x12\x18.api.WaitPropertyRequest\x1a\x16.google.protobuf.Empty\"\x00\x12\x41\n\x0bListChannel\x12\x16.google.protobuf.Empty\x1a\x18.api.ListChannelResponse\"\x00\x12\x44\n\rSwitchChannel\x12\x19.api.SwitchChannelRequest\x1a\x16.google.protobuf.Empty\"\x00\x12\x46\n\x0eOpenExperiment\x12\x1a.api.OpenExperimentRequest\x1a\x16.google.protobuf.Empty\"\x00\x12=\n\tListPlate\x12\x16.google.protobuf.Empty\x1a\x16.api.ListPlateResponse\"\x00\x12:\n\x08\x41\x64\x64Plate\x12\x14.api.AddPlateRequest\x1a\x16.google.protobuf.Empty\"\x00\x12V\n\x16SetPlatePositionOrigin\x12\".api.SetPlatePositionOriginRequest\x1a\x16.google.protobuf.Empty\"\x00\x12J\n\x10SetPlateMetadata\x12\x1c.api.SetPlateMetadataRequest\x1a\x16.google.protobuf.Empty\"\x00\x12H\n\x0fSetWellsEnabled\x12\x1b.api.SetWellsEnabledRequest\x1a\x16.google.protobuf.Empty\"\x00\x12J\n\x10SetWellsMetadata\x12\x1c.api.SetWellsMetadataRequest\x1a\x16.google.protobuf.Empty\"\x00\x12@\n\x0b\x43reateSites\x12\x17.api.CreateSitesRequest\x1a\x16.google.protobuf.Empty\"\x00\x12\x44\n\rSetFocusPoint\x12\x19.api.SetFocusPointRequest\x1a\x16.google.protobuf.Empty\"\x00\x12\x44\n\rClearFocusMap\x12\x19.api.ClearFocusMapRequest\x1a\x16.google.protobuf.Empty\"\x00\x12R\n\x14SetFocusSurfaceModel\x12 .api.SetFocusSurfaceModelRequest\x1a\x16.google.protobuf.Empty\"\x00\x12\x42\n\x0bGetFocusMap\x12\x17.api.GetFocusMapRequest\x1a\x18.api.GetFocusMapResponse\"\x00\x12P\n\x13\x41\x63quireMultiChannel\x12\x1f.api.AcquireMultiChannelRequest\x1a\x16.google.protobuf.Empty\"\x00\x12\x44\n\rAcquireZStack\x12\x19.api.AcquireZStackRequest\x1a\x16.google.protobuf.Empty\"\x00\x12<\n\tAutofocus\x12\x15.api.AutofocusRequest\x1a\x16.api.AutofocusResponse\"\x00\x12:\n\x08PlanScan\x12\x15.api.StartScanRequest\x1a\x15.api.PlanScanResponse\"\x00\x12<\n\tStartScan\x12\x15.api.StartScanRequest\x1a\x16.google.protobuf.Empty\"\x00\x12=\n\tPauseScan\x12\x16.google.protobuf.Empty\x1a\x16.google.protobuf.Empty\"\x00\x12>\n\nResumeScan\x12\x16.google.protobuf.Empty\x1a\x16.google.protobuf.Empty\"\x00\x12<\n\x08StopScan\x12\x16.google.protobuf.Empty\x1a\x16.google.protobuf.Empty\"\x00\x12:\n\tWatchScan\x12\x16.google.protobuf.Empty\x1a\x11.api.ScanProgress\"\x00\x30\x01\x12\x46\n\x0eStartTimelapse\x12\x1a.api.StartTimelapseRequest\x1a\x16.google.protobuf.Empty\"\x00\x12\x41\n\rStopTimelapse\x12\x16.google.protobuf.Empty\x1a\x16.google.protobuf.Empty\"\x00\x12\x44\n\x12GetTimelapseStatus\x12\x16.google.protobuf.Empty\x1a\x14.api.TimelapseStatus\"\x00\x12N\n\x12StartLiveRecording\x12\x1e.api.StartLiveRecordingRequest\x1a\x16.google.protobuf.Empty\"\x00\x12\x46\n\x11StopLiveRecording\x12\x16.google.protobuf.Empty\x1a\x17.api.LiveRecordingStats\"\x00\x12J\n\x15GetLiveRecordingStats\x12\x16.google.protobuf.Empty\x1a\x17.api.LiveRecordingStats\"\x00\x12P\n\x13ImportLiveRecording\x12\x1f.api.ImportLiveRecordingRequest\x1a\x16.google.protobuf.Empty\"\x00\x12\x42\n\x0fWatchLiveFrames\x12\x1b.api.WatchLiveFramesRequest\x1a\x0e.api.LiveFrame\"\x00\x30\x01\x12\x42\n\x11GetLiveFrameStats\x12\x16.google.protobuf.Empty\x1a\x13.api.LiveFrameStats\"\x00\x12\x41\n\x0bListNDImage\x12\x16.google.protobuf.Empty\x1a\x18.api.ListNDImageResponse\"\x00\x12?\n\nGetNDImage\x12\x16.api.GetNDImageRequest\x1a\x17.api.GetNDImageResponse\"\x00\x12\x45\n\x0cGetImageData\x12\x18.api.GetImageDataRequest\x1a\x19.api.GetImageDataResponse\"\x00\x12]\n\x14GetSegmentationScore\x12 .api.GetSegmentationScoreRequest\x1a!.api.GetSegmentationScoreResponse\"\x00\x12N\n\x0fQuantifyRegions\x12\x1b.api.QuantifyRegionsRequest\x1a\x1c.api.QuantifyRegionsResponse\"\x00\x12T\n\x11GetQuantification\x12\x1d.api.GetQuantificationRequest\x1a\x1e.api.GetQuantificationResponse\"\x00\x12\x45\n\x0cGetCellTable\x12\x18.api.GetCellTableRequest\x1a\x19.api.GetCellTableResponse\"\x00\x12N\n\x12\x42uildCorrectionMap\x12\x1e.api.BuildCorrectionMapRequest\x1a\x16.google.protobuf.Empty\"\x00\x12\x43\n\x0cGetSpanStats\x12\x16.google.protobuf.Empty\x1a\x19.api.GetSpanStatsResponse\"\x00\x62\x06proto3')
+
+_builder.BuildMessageAndEnumDescriptors(DESCRIPTOR, globals())
+_builder.BuildTopDescriptorsAndMessages(DESCRIPTOR, 'api_pb2', globals())
+if _descriptor._USE_C_DESCRIPTORS == False:
+
+  DESCRIPTOR._options = None
+  _PLATETYPE._serialized_start=6968
+  _PLATETYPE._serialized_end=7038
+  _ZSTACKORDER._serialized_start=7040
+  _ZSTACKORDER._serialized_end=7101
+  _FOCUSMETRIC._serialized_start=7103
+  _FOCUSMETRIC._serialized_end=7168
+  _SCANFOCUSMODE._serialized_start=7170
+  _SCANFOCUSMODE._serialized_end=7234
+  _SITEORDER._serialized_start=7236
+  _SITEORDER._serialized_end=7328
+  _CHANNELORDER._serialized_start=7330
+  _CHANNELORDER._serialized_end=7388
+  _OVERRUNPOLICY._serialized_start=7390
+  _OVERRUNPOLICY._serialized_end=7429
+  _DATATYPE._serialized_start=7431
+  _DATATYPE._serialized_end=7542
+  _COLORTYPE._serialized_start=7544
+  _COLORTYPE._serialized_end=7662
+  _CORRECTIONMAPTYPE._serialized_start=7664
+  _CORRECTIONMAPTYPE._serialized_end=7703
+  _CORRECTIONSTATISTIC._serialized_start=7705
+  _CORRECTIONSTATISTIC._serialized_end=7748
+  _PROPERTYVALUE._serialized_start=79
+  _PROPERTYVALUE._serialized_end=123
+  _CHANNEL._serialized_start=125
+  _CHANNEL._serialized_end=208
+  _LISTPROPERTYREQUEST._serialized_start=210
+  _LISTPROPERTYREQUEST._serialized_end=245
+  _LISTPROPERTYRESPONSE._serialized_start=247
+  _LISTPROPERTYRESPONSE._serialized_end=283
+  _GETPROPERTYREQUEST._serialized_start=285
+  _GETPROPERTYREQUEST._serialized_end=319
+  _GETPROPERTYRESPONSE._serialized_start=321
+  _GETPROPERTYRESPONSE._serialized_end=380
+  _SETPROPERTYREQUEST._serialized_start=382
+  _SETPROPERTYREQUEST._serialized_end=440
+  _WAITPROPERTYREQUEST._serialized_start=442
+  _WAITPROPERTYREQUEST._serialized_end=521
+  _LISTCHANNELRESPONSE._serialized_start=523
+  _LISTCHANNELRESPONSE._serialized_end=576
+  _SWITCHCHANNELREQUEST._serialized_start=578
+  _SWITCHCHANNELREQUEST._serialized_end=631
+  _OPENEXPERIMENTREQUEST._serialized_start=633
+  _OPENEXPERIMENTREQUEST._serialized_end=706
+  _POS2D._serialized_start=708
+  _POS2D._serialized_end=737
+  _PLATEINFO._serialized_start=740
+  _PLATEINFO._serialized_end=906
+  _WELLINFO._serialized_start=909
+  _WELLINFO._serialized_end=1038
+  _SITEINFO._serialized_start=1040
+  _SITEINFO._serialized_end=1140
+  _LISTPLATERESPONSE._serialized_start=1142
+  _LISTPLATERESPONSE._serialized_end=1192
+  _ADDPLATEREQUEST._serialized_start=1194
+  _ADDPLATEREQUEST._serialized_end=1265
+  _SETPLATEPOSITIONORIGINREQUEST._serialized_start=1267
+  _SETPLATEPOSITIONORIGINREQUEST._serialized_end=1340
+  _SETPLATEMETADATAREQUEST._serialized_start=1342
+  _SETPLATEMETADATAREQUEST._serialized_end=1420
+  _SETWELLSENABLEDREQUEST._serialized_start=1422
+  _SETWELLSENABLEDREQUEST._serialized_end=1500
+  _SETWELLSMETADATAREQUEST._serialized_start=1502
+  _SETWELLSMETADATAREQUEST._serialized_end=1597
+  _CREATESITESREQUEST._serialized_start=1599
+  _CREATESITESREQUEST._serialized_end=1720
+  _SETFOCUSPOINTREQUEST._serialized_start=1722
+  _SETFOCUSPOINTREQUEST._serialized_end=1814
+  _CLEARFOCUSMAPREQUEST._serialized_start=1816
+  _CLEARFOCUSMAPREQUEST._serialized_end=1858
+  _SETFOCUSSURFACEMODELREQUEST._serialized_start=1860
+  _SETFOCUSSURFACEMODELREQUEST._serialized_end=1924
+  _GETFOCUSMAPREQUEST._serialized_start=1926
+  _GETFOCUSMAPREQUEST._serialized_end=1966
+  _FOCUSPOINT._serialized_start=1968
+  _FOCUSPOINT._serialized_end=2030
+  _SITEFOCUS._serialized_start=2032
+  _SITEFOCUS._serialized_end=2073
+  _GETFOCUSMAPRESPONSE._serialized_start=2075
+  _GETFOCUSMAPRESPONSE._serialized_end=2179
+  _ACQUIREMULTICHANNELREQUEST._serialized_start=2182
+  _ACQUIREMULTICHANNELREQUEST._serialized_end=2327
+  _ACQUIREZSTACKREQUEST._serialized_start=2330
+  _ACQUIREZSTACKREQUEST._serialized_end=2604
+  _AUTOFOCUSREQUEST._serialized_start=2607
+  _AUTOFOCUSREQUEST._serialized_end=2770
+  _AUTOFOCUSRESPONSE._serialized_start=2772
+  _AUTOFOCUSRESPONSE._serialized_end=2835
+  _STAGESPEEDMODEL._serialized_start=2837
+  _STAGESPEEDMODEL._serialized_end=2941
+  _STARTSCANREQUEST._serialized_start=2944
+  _STARTSCANREQUEST._serialized_end=3289
+  _PLANSCANRESPONSE._serialized_start=3291
+  _PLANSCANRESPONSE._serialized_end=3365
+  _SCANPROGRESS._serialized_start=3368
+  _SCANPROGRESS._serialized_end=3635
+  _TIMELAPSEGROUP._serialized_start=3638
+  _TIMELAPSEGROUP._serialized_end=3767
+  _STARTTIMELAPSEREQUEST._serialized_start=3769
+  _STARTTIMELAPSEREQUEST._serialized_end=3873
+  _TIMELAPSEGROUPSTATUS._serialized_start=3876
+  _TIMELAPSEGROUPSTATUS._serialized_end=4140
+  _TIMELAPSESTATUS._serialized_start=4143
+  _TIMELAPSESTATUS._serialized_end=4293
+  _STARTLIVERECORDINGREQUEST._serialized_start=4295
+  _STARTLIVERECORDINGREQUEST._serialized_end=4373
+  _LIVERECORDINGSTATS._serialized_start=4376
+  _LIVERECORDINGSTATS._serialized_end=4553
+  _IMPORTLIVERECORDINGREQUEST._serialized_start=4555
+  _IMPORTLIVERECORDINGREQUEST._serialized_end=4619
+  _WATCHLIVEFRAMESREQUEST._serialized_start=4621
+  _WATCHLIVEFRAMESREQUEST._serialized_end=4666
+  _LIVEFRAME._serialized_start=4668
+  _LIVEFRAME._serialized_end=4728
+  _LIVECONSUMERSTATS._serialized_start=4730
+  _LIVECONSUMERSTATS._serialized_end=4812
+  _LIVEFRAMESTATS._serialized_start=4814
+  _LIVEFRAMESTATS._serialized_end=4893
+  _NDIMAGE._serialized_start=4896
+  _NDIMAGE._serialized_end=5068
+  _LISTNDIMAGERESPONSE._serialized_start=5070
+  _LISTNDIMAGERESPONSE._serialized_end=5122
+  _GETNDIMAGEREQUEST._serialized_start=5124
+  _GETNDIMAGEREQUEST._serialized_end=5165
+  _GETNDIMAGERESPONSE._serialized_start=5167
+  _GETNDIMAGERESPONSE._serialized_end=5218
+  _GETIMAGEDATAREQUEST._serialized_start=5220
+  _GETIMAGEDATAREQUEST._serialized_end=5311
+  _IMAGEDATA._serialized_start=5313
+  _IMAGEDATA._serialized_end=5429
+  _GETIMAGEDATARESPONSE._serialized_start=5431
+  _GETIMAGEDATARESPONSE._serialized_end=5483
+  _GETSEGMENTATIONSCOREREQUEST._serialized_start=5485
+  _GETSEGMENTATIONSCOREREQUEST._serialized_end=5579
+  _GETSEGMENTATIONSCORERESPONSE._serialized_start=5581
+  _GETSEGMENTATIONSCORERESPONSE._serialized_end=5641
+  _QUANTIFYREGIONSREQUEST._serialized_start=5643
+  _QUANTIFYREGIONSREQUEST._serialized_end=5727
+  _QUANTIFYREGIONSRESPONSE._serialized_start=5730
+  _QUANTIFYREGIONSRESPONSE._serialized_end=5910
+  _REGIONPROP._serialized_start=5913
+  _REGIONPROP._serialized_end=6089
+  _CHANNELINTENSITY._serialized_start=6091
+  _CHANNELINTENSITY._serialized_end=6142
+  _GETQUANTIFICATIONREQUEST._serialized_start=6144
+  _GETQUANTIFICATIONREQUEST._serialized_end=6205
+  _GETQUANTIFICATIONRESPONSE._serialized_start=6208
+  _GETQUANTIFICATIONRESPONSE._serialized_end=6371
+  _GETCELLTABLEREQUEST._serialized_start=6373
+  _GETCELLTABLEREQUEST._serialized_end=6447
+  _CELLTABLEFIELD._serialized_start=6449
+  _CELLTABLEFIELD._serialized_end=6510
+  _GETCELLTABLERESPONSE._serialized_start=6512
+  _GETCELLTABLERESPONSE._serialized_end=6617
+  _BUILDCORRECTIONMAPREQUEST._serialized_start=6620
+  _BUILDCORRECTIONMAPREQUEST._serialized_end=6787
+  _SPANSTATS._serialized_start=6789
+  _SPANSTATS._serialized_end=6912
+  _GETSPANSTATSRESPONSE._serialized_start=6914
+  _GETSPANSTATSRESPONSE._serialized_end=6966
+  _NIKONTICTRL._serialized_start=7751
+  _NIKONTICTRL._serialized_end=10965
 # @@protoc_insertion_point(module_scope)
@@ -85,11 +85,116 @@ class NikonTiCtrlStub(object):
                 request_serializer=api__pb2.CreateSitesRequest.SerializeToString,
                 response_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
                 )
+        self.SetFocusPoint = channel.unary_unary(
+                '/api.NikonTiCtrl/SetFocusPoint',
+                request_serializer=api__pb2.SetFocusPointRequest.SerializeToString,
+                response_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                )
+        self.ClearFocusMap = channel.unary_unary(
+                '/api.NikonTiCtrl/ClearFocusMap',
+                request_serializer=api__pb2.ClearFocusMapRequest.SerializeToString,
+                response_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                )
+        self.SetFocusSurfaceModel = channel.unary_unary(
+                '/api.NikonTiCtrl/SetFocusSurfaceModel',
+                request_serializer=api__pb2.SetFocusSurfaceModelRequest.SerializeToString,
+                response_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                )
+        self.GetFocusMap = channel.unary_unary(
+                '/api.NikonTiCtrl/GetFocusMap',
+                request_serializer=api__pb2.GetFocusMapRequest.SerializeToString,
+                response_deserializer=api__pb2.GetFocusMapResponse.FromString,
+                )
         self.AcquireMultiChannel = channel.unary_unary(
                 '/api.NikonTiCtrl/AcquireMultiChannel',
                 request_serializer=api__pb2.AcquireMultiChannelRequest.SerializeToString,
                 response_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
                 )
+        self.AcquireZStack = channel.unary_unary(
+                '/api.NikonTiCtrl/AcquireZStack',
+                request_serializer=api__pb2.AcquireZStackRequest.SerializeToString,
+                response_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                )
+        self.Autofocus = channel.unary_unary(
+                '/api.NikonTiCtrl/Autofocus',
+                request_serializer=api__pb2.AutofocusRequest.SerializeToString,
+                response_deserializer=api__pb2.AutofocusResponse.FromString,
+                )
+        self.PlanScan = channel.unary_unary(
+                '/api.NikonTiCtrl/PlanScan',
+                request_serializer=api__pb2.StartScanRequest.SerializeToString,
+                response_deserializer=api__pb2.PlanScanResponse.FromString,
+                )
+        self.StartScan = channel.unary_unary(
+                '/api.NikonTiCtrl/StartScan',
+                request_serializer=api__pb2.StartScanRequest.SerializeToString,
+                response_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                )
+        self.PauseScan = channel.unary_unary(
+                '/api.NikonTiCtrl/PauseScan',
+                request_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+                response_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                )
+        self.ResumeScan = channel.unary_unary(
+                '/api.NikonTiCtrl/ResumeScan',
+                request_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+                response_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                )
+        self.StopScan = channel.unary_unary(
+                '/api.NikonTiCtrl/StopScan',
+                request_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+                response_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                )
+        self.WatchScan = channel.unary_stream(
+                '/api.NikonTiCtrl/WatchScan',
+                request_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+                response_deserializer=api__pb2.ScanProgress.FromString,
+                )
+        self.StartTimelapse = channel.unary_unary(
+                '/api.NikonTiCtrl/StartTimelapse',
+                request_serializer=api__pb2.StartTimelapseRequest.SerializeToString,
+                response_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                )
+        self.StopTimelapse = channel.unary_unary(
+                '/api.NikonTiCtrl/StopTimelapse',
+                request_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+                response_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                )
+        self.GetTimelapseStatus = channel.unary_unary(
+                '/api.NikonTiCtrl/GetTimelapseStatus',
+                request_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+                response_deserializer=api__pb2.TimelapseStatus.FromString,
+                )
+        self.StartLiveRecording = channel.unary_unary(
+                '/api.NikonTiCtrl/StartLiveRecording',
+                request_serializer=api__pb2.StartLiveRecordingRequest.SerializeToString,
+                response_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                )
+        self.StopLiveRecording = channel.unary_unary(
+                '/api.NikonTiCtrl/StopLiveRecording',
+                request_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+                response_deserializer=api__pb2.LiveRecordingStats.FromString,
+                )
+        self.GetLiveRecordingStats = channel.unary_unary(
+                '/api.NikonTiCtrl/GetLiveRecordingStats',
+                request_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+                response_deserializer=api__pb2.LiveRecordingStats.FromString,
+                )
+        self.ImportLiveRecording = channel.unary_unary(
+                '/api.NikonTiCtrl/ImportLiveRecording',
+                request_serializer=api__pb2.ImportLiveRecordingRequest.SerializeToString,
+                response_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                )
+        self.WatchLiveFrames = channel.unary_stream(
+                '/api.NikonTiCtrl/WatchLiveFrames',
+                request_serializer=api__pb2.WatchLiveFramesRequest.SerializeToString,
+                response_deserializer=api__pb2.LiveFrame.FromString,
+                )
+        self.GetLiveFrameStats = channel.unary_unary(
+                '/api.NikonTiCtrl/GetLiveFrameStats',
+                request_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+                response_deserializer=api__pb2.LiveFrameStats.FromString,
+                )
         self.ListNDImage = channel.unary_unary(
                 '/api.NikonTiCtrl/ListNDImage',
                 request_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
@@ -120,6 +225,21 @@ class NikonTiCtrlStub(object):
                 request_serializer=api__pb2.GetQuantificationRequest.SerializeToString,
                 response_deserializer=api__pb2.GetQuantificationResponse.FromString,
                 )
+        self.GetCellTable = channel.unary_unary(
+                '/api.NikonTiCtrl/GetCellTable',
+                request_serializer=api__pb2.GetCellTableRequest.SerializeToString,
+                response_deserializer=api__pb2.GetCellTableResponse.FromString,
+                )
+        self.BuildCorrectionMap = channel.unary_unary(
+                '/api.NikonTiCtrl/BuildCorrectionMap',
+                request_serializer=api__pb2.BuildCorrectionMapRequest.SerializeToString,
+                response_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                )
+        self.GetSpanStats = channel.unary_unary(
+                '/api.NikonTiCtrl/GetSpanStats',
+                request_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+                response_deserializer=api__pb2.GetSpanStatsResponse.FromString,
+                )
 
 
 class NikonTiCtrlServicer(object):
@@ -213,6 +333,30 @@ class NikonTiCtrlServicer(object):
         context.set_details('Method not implemented!')
         raise NotImplementedError('Method not implemented!')
 
+    def SetFocusPoint(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def ClearFocusMap(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def SetFocusSurfaceModel(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def GetFocusMap(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
     def AcquireMultiChannel(self, request, context):
         """Task
         """
@@ -220,6 +364,108 @@ class NikonTiCtrlServicer(object):
         context.set_details('Method not implemented!')
         raise NotImplementedError('Method not implemented!')
 
+    def AcquireZStack(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def Autofocus(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def PlanScan(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def StartScan(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def PauseScan(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def ResumeScan(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def StopScan(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def WatchScan(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def StartTimelapse(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def StopTimelapse(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def GetTimelapseStatus(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def StartLiveRecording(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def StopLiveRecording(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def GetLiveRecordingStats(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def ImportLiveRecording(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def WatchLiveFrames(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def GetLiveFrameStats(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
     def ListNDImage(self, request, context):
         """Data
         """
@@ -258,6 +504,25 @@ class NikonTiCtrlServicer(object):
         context.set_details('Method not implemented!')
         raise NotImplementedError('Method not implemented!')
 
+    def GetCellTable(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def BuildCorrectionMap(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def GetSpanStats(self, request, context):
+        """Diagnostics
+        """
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
 
 def add_NikonTiCtrlServicer_to_server(servicer, server):
     rpc_method_handlers = {
@@ -331,11 +596,116 @@ def add_NikonTiCtrlServicer_to_server(servicer, server):
                     request_deserializer=api__pb2.CreateSitesRequest.FromString,
                     response_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
             ),
+            'SetFocusPoint': grpc.unary_unary_rpc_method_handler(
+                    servicer.SetFocusPoint,
+                    request_deserializer=api__pb2.SetFocusPointRequest.FromString,
+                    response_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            ),
+            'ClearFocusMap': grpc.unary_unary_rpc_method_handler(
+                    servicer.ClearFocusMap,
+                    request_deserializer=api__pb2.ClearFocusMapRequest.FromString,
+                    response_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            ),
+            'SetFocusSurfaceModel': grpc.unary_unary_rpc_method_handler(
+                    servicer.SetFocusSurfaceModel,
+                    request_deserializer=api__pb2.SetFocusSurfaceModelRequest.FromString,
+                    response_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            ),
+            'GetFocusMap': grpc.unary_unary_rpc_method_handler(
+                    servicer.GetFocusMap,
+                    request_deserializer=api__pb2.GetFocusMapRequest.FromString,
+                    response_serializer=api__pb2.GetFocusMapResponse.SerializeToString,
+            ),
             'AcquireMultiChannel': grpc.unary_unary_rpc_method_handler(
                     servicer.AcquireMultiChannel,
                     request_deserializer=api__pb2.AcquireMultiChannelRequest.FromString,
                     response_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
             ),
+            'AcquireZStack': grpc.unary_unary_rpc_method_handler(
+                    servicer.AcquireZStack,
+                    request_deserializer=api__pb2.AcquireZStackRequest.FromString,
+                    response_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            ),
+            'Autofocus': grpc.unary_unary_rpc_method_handler(
+                    servicer.Autofocus,
+                    request_deserializer=api__pb2.AutofocusRequest.FromString,
+                    response_serializer=api__pb2.AutofocusResponse.SerializeToString,
+            ),
+            'PlanScan': grpc.unary_unary_rpc_method_handler(
+                    servicer.PlanScan,
+                    request_deserializer=api__pb2.StartScanRequest.FromString,
+                    response_serializer=api__pb2.PlanScanResponse.SerializeToString,
+            ),
+            'StartScan': grpc.unary_unary_rpc_method_handler(
+                    servicer.StartScan,
+                    request_deserializer=api__pb2.StartScanRequest.FromString,
+                    response_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            ),
+            'PauseScan': grpc.unary_unary_rpc_method_handler(
+                    servicer.PauseScan,
+                    request_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                    response_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            ),
+            'ResumeScan': grpc.unary_unary_rpc_method_handler(
+                    servicer.ResumeScan,
+                    request_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                    response_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            ),
+            'StopScan': grpc.unary_unary_rpc_method_handler(
+                    servicer.StopScan,
+                    request_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                    response_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            ),
+            'WatchScan': grpc.unary_stream_rpc_method_handler(
+                    servicer.WatchScan,
+                    request_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                    response_serializer=api__pb2.ScanProgress.SerializeToString,
+            ),
+            'StartTimelapse': grpc.unary_unary_rpc_method_handler(
+                    servicer.StartTimelapse,
+                    request_deserializer=api__pb2.StartTimelapseRequest.FromString,
+                    response_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            ),
+            'StopTimelapse': grpc.unary_unary_rpc_method_handler(
+                    servicer.StopTimelapse,
+                    request_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                    response_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            ),
+            'GetTimelapseStatus': grpc.unary_unary_rpc_method_handler(
+                    servicer.GetTimelapseStatus,
+                    request_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                    response_serializer=api__pb2.TimelapseStatus.SerializeToString,
+            ),
+            'StartLiveRecording': grpc.unary_unary_rpc_method_handler(
+                    servicer.StartLiveRecording,
+                    request_deserializer=api__pb2.StartLiveRecordingRequest.FromString,
+                    response_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            ),
+            'StopLiveRecording': grpc.unary_unary_rpc_method_handler(
+                    servicer.StopLiveRecording,
+                    request_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                    response_serializer=api__pb2.LiveRecordingStats.SerializeToString,
+            ),
+            'GetLiveRecordingStats': grpc.unary_unary_rpc_method_handler(
+                    servicer.GetLiveRecordingStats,
+                    request_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                    response_serializer=api__pb2.LiveRecordingStats.SerializeToString,
+            ),
+            'ImportLiveRecording': grpc.unary_unary_rpc_method_handler(
+                    servicer.ImportLiveRecording,
+                    request_deserializer=api__pb2.ImportLiveRecordingRequest.FromString,
+                    response_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            ),
+            'WatchLiveFrames': grpc.unary_stream_rpc_method_handler(
+                    servicer.WatchLiveFrames,
+                    request_deserializer=api__pb2.WatchLiveFramesRequest.FromString,
+                    response_serializer=api__pb2.LiveFrame.SerializeToString,
+            ),
+            'GetLiveFrameStats': grpc.unary_unary_rpc_method_handler(
+                    servicer.GetLiveFrameStats,
+                    request_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                    response_serializer=api__pb2.LiveFrameStats.SerializeToString,
+            ),
             'ListNDImage': grpc.unary_unary_rpc_method_handler(
                     servicer.ListNDImage,
                     request_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
@@ -366,6 +736,21 @@ def add_NikonTiCtrlServicer_to_server(servicer, server):
                     request_deserializer=api__pb2.GetQuantificationRequest.FromString,
                     response_serializer=api__pb2.GetQuantificationResponse.SerializeToString,
             ),
+            'GetCellTable': grpc.unary_unary_rpc_method_handler(
+                    servicer.GetCellTable,
+                    request_deserializer=api__pb2.GetCellTableRequest.FromString,
+                    response_serializer=api__pb2.GetCellTableResponse.SerializeToString,
+            ),
+            'BuildCorrectionMap': grpc.unary_unary_rpc_method_handler(
+                    servicer.BuildCorrectionMap,
+                    request_deserializer=api__pb2.BuildCorrectionMapRequest.FromString,
+                    response_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            ),
+            'GetSpanStats': grpc.unary_unary_rpc_method_handler(
+                    servicer.GetSpanStats,
+                    request_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                    response_serializer=api__pb2.GetSpanStatsResponse.SerializeToString,
+            ),
     }
     generic_handler = grpc.method_handlers_generic_handler(
             'api.NikonTiCtrl', rpc_method_handlers)
@@ -615,7 +1000,7 @@ class NikonTiCtrl(object):
             insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
 
     @staticmethod
-    def AcquireMultiChannel(request,
+    def SetFocusPoint(request,
             target,
             options=(),
             channel_credentials=None,
@@ -625,14 +1010,14 @@ class NikonTiCtrl(object):
             wait_for_ready=None,
             timeout=None,
             metadata=None):
-        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/AcquireMultiChannel',
-            api__pb2.AcquireMultiChannelRequest.SerializeToString,
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/SetFocusPoint',
+            api__pb2.SetFocusPointRequest.SerializeToString,
             google_dot_protobuf_dot_empty__pb2.Empty.FromString,
             options, channel_credentials,
             insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
 
     @staticmethod
-    def ListNDImage(request,
+    def ClearFocusMap(request,
             target,
             options=(),
             channel_credentials=None,
@@ -642,14 +1027,14 @@ class NikonTiCtrl(object):
             wait_for_ready=None,
             timeout=None,
             metadata=None):
-        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/ListNDImage',
-            google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
-            api__pb2.ListNDImageResponse.FromString,
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/ClearFocusMap',
+            api__pb2.ClearFocusMapRequest.SerializeToString,
+            google_dot_protobuf_dot_empty__pb2.Empty.FromString,
             options, channel_credentials,
             insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
 
     @staticmethod
-    def GetNDImage(request,
+    def SetFocusSurfaceModel(request,
             target,
             options=(),
             channel_credentials=None,
@@ -659,14 +1044,14 @@ class NikonTiCtrl(object):
             wait_for_ready=None,
             timeout=None,
             metadata=None):
-        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/GetNDImage',
-            api__pb2.GetNDImageRequest.SerializeToString,
-            api__pb2.GetNDImageResponse.FromString,
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/SetFocusSurfaceModel',
+            api__pb2.SetFocusSurfaceModelRequest.SerializeToString,
+            google_dot_protobuf_dot_empty__pb2.Empty.FromString,
             options, channel_credentials,
             insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
 
     @staticmethod
-    def GetImageData(request,
+    def GetFocusMap(request,
             target,
             options=(),
             channel_credentials=None,
@@ -676,14 +1061,14 @@ class NikonTiCtrl(object):
             wait_for_ready=None,
             timeout=None,
             metadata=None):
-        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/GetImageData',
-            api__pb2.GetImageDataRequest.SerializeToString,
-            api__pb2.GetImageDataResponse.FromString,
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/GetFocusMap',
+            api__pb2.GetFocusMapRequest.SerializeToString,
+            api__pb2.GetFocusMapResponse.FromString,
             options, channel_credentials,
             insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
 
     @staticmethod
-    def GetSegmentationScore(request,
+    def AcquireMultiChannel(request,
             target,
             options=(),
             channel_credentials=None,
@@ -693,14 +1078,14 @@ class NikonTiCtrl(object):
             wait_for_ready=None,
             timeout=None,
             metadata=None):
-        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/GetSegmentationScore',
-            api__pb2.GetSegmentationScoreRequest.SerializeToString,
-            api__pb2.GetSegmentationScoreResponse.FromString,
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/AcquireMultiChannel',
+            api__pb2.AcquireMultiChannelRequest.SerializeToString,
+            google_dot_protobuf_dot_empty__pb2.Empty.FromString,
             options, channel_credentials,
             insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
 
     @staticmethod
-    def QuantifyRegions(request,
+    def AcquireZStack(request,
             target,
             options=(),
             channel_credentials=None,
@@ -710,14 +1095,14 @@ class NikonTiCtrl(object):
             wait_for_ready=None,
             timeout=None,
             metadata=None):
-        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/QuantifyRegions',
-            api__pb2.QuantifyRegionsRequest.SerializeToString,
-            api__pb2.QuantifyRegionsResponse.FromString,
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/AcquireZStack',
+            api__pb2.AcquireZStackRequest.SerializeToString,
+            google_dot_protobuf_dot_empty__pb2.Empty.FromString,
             options, channel_credentials,
             insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
 
     @staticmethod
-    def GetQuantification(request,
+    def Autofocus(request,
             target,
             options=(),
             channel_credentials=None,
@@ -727,8 +1112,416 @@ class NikonTiCtrl(object):
             wait_for_ready=None,
             timeout=None,
             metadata=None):
-        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/GetQuantification',
-            api__pb2.GetQuantificationRequest.SerializeToString,
-            api__pb2.GetQuantificationResponse.FromString,
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/Autofocus',
+            api__pb2.AutofocusRequest.SerializeToString,
+            api__pb2.AutofocusResponse.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def PlanScan(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/PlanScan',
+            api__pb2.StartScanRequest.SerializeToString,
+            api__pb2.PlanScanResponse.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def StartScan(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/StartScan',
+            api__pb2.StartScanRequest.SerializeToString,
+            google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def PauseScan(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/PauseScan',
+            google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def ResumeScan(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/ResumeScan',
+            google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def StopScan(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/StopScan',
+            google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def WatchScan(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_stream(request, target, '/api.NikonTiCtrl/WatchScan',
+            google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            api__pb2.ScanProgress.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def StartTimelapse(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/StartTimelapse',
+            api__pb2.StartTimelapseRequest.SerializeToString,
+            google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def StopTimelapse(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/StopTimelapse',
+            google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def GetTimelapseStatus(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/GetTimelapseStatus',
+            google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            api__pb2.TimelapseStatus.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def StartLiveRecording(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/StartLiveRecording',
+            api__pb2.StartLiveRecordingRequest.SerializeToString,
+            google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def StopLiveRecording(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/StopLiveRecording',
+            google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            api__pb2.LiveRecordingStats.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def GetLiveRecordingStats(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/GetLiveRecordingStats',
+            google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            api__pb2.LiveRecordingStats.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def ImportLiveRecording(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/ImportLiveRecording',
+            api__pb2.ImportLiveRecordingRequest.SerializeToString,
+            google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def WatchLiveFrames(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_stream(request, target, '/api.NikonTiCtrl/WatchLiveFrames',
+            api__pb2.WatchLiveFramesRequest.SerializeToString,
+            api__pb2.LiveFrame.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def GetLiveFrameStats(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/GetLiveFrameStats',
+            google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            api__pb2.LiveFrameStats.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def ListNDImage(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/ListNDImage',
+            google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            api__pb2.ListNDImageResponse.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def GetNDImage(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/GetNDImage',
+            api__pb2.GetNDImageRequest.SerializeToString,
+            api__pb2.GetNDImageResponse.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def GetImageData(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/GetImageData',
+            api__pb2.GetImageDataRequest.SerializeToString,
+            api__pb2.GetImageDataResponse.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def GetSegmentationScore(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/GetSegmentationScore',
+            api__pb2.GetSegmentationScoreRequest.SerializeToString,
+            api__pb2.GetSegmentationScoreResponse.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def QuantifyRegions(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/QuantifyRegions',
+            api__pb2.QuantifyRegionsRequest.SerializeToString,
+            api__pb2.QuantifyRegionsResponse.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def GetQuantification(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/GetQuantification',
+            api__pb2.GetQuantificationRequest.SerializeToString,
+            api__pb2.GetQuantificationResponse.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def GetCellTable(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/GetCellTable',
+            api__pb2.GetCellTableRequest.SerializeToString,
+            api__pb2.GetCellTableResponse.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def BuildCorrectionMap(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/BuildCorrectionMap',
+            api__pb2.BuildCorrectionMapRequest.SerializeToString,
+            google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def GetSpanStats(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/api.NikonTiCtrl/GetSpanStats',
+            google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            api__pb2.GetSpanStatsResponse.FromString,
             options, channel_credentials,
             insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
@@ -258,6 +258,42 @@ class Plate():
         pos_origin_y = pos[1] - rel_pos[1]
         self.pos_origin = (pos_origin_x, pos_origin_y)
 
+    def set_focus_point(self, well_id: str, pos: Optional[Tuple[float, float, float]]=None):
+        if pos is None:
+            x, y = self._api.get_xy_stage_position()
+            z = self._api.get_z_stage_position()
+        else:
+            x, y, z = pos
+        req = api_pb2.SetFocusPointRequest(
+                plate_uuid = self.uuid,
+                well_id = self.normalize_id(well_id),
+                x = x,
+                y = y,
+                z = z)
+        self._api.stub.SetFocusPoint(req)
+
+    def clear_focus_map(self):
+        req = api_pb2.ClearFocusMapRequest(plate_uuid = self.uuid)
+        self._api.stub.ClearFocusMap(req)
+
+    def set_focus_surface_model(self, model: str):
+        # "auto", "plane" or "thin_plate_spline"
+        req = api_pb2.SetFocusSurfaceModelRequest(
+                plate_uuid = self.uuid,
+                model = model)
+        self._api.stub.SetFocusSurfaceModel(req)
+
+    def focus_map(self) -> Tuple[pd.DataFrame, pd.DataFrame]:
+        req = api_pb2.GetFocusMapRequest(plate_uuid = self.uuid)
+        resp = self._api.stub.GetFocusMap(req)
+        df_points = pd.DataFrame(
+            [[p.well_id, p.x, p.y, p.z] for p in resp.point],
+            columns=["well_id", "x", "y", "z"])
+        df_sites = pd.DataFrame(
+            [[s.site_uuid, s.z] for s in resp.site_focus],
+            columns=["site_uuid", "z"])
+        return df_points, df_sites
+
     def move_to_position(self, well_id: str, i_x: int, i_y: int, grid_spacing=-250, wait=True):
         # TODO validate i_x, i_y
         well = self._wells[well_id]
@@ -1,12 +1,16 @@
 #include "analysismanager.h"
 
+#include <cstring>
 #include <fmt/os.h>
+#include <limits>
 #include <xtensor/xadapt.hpp>
 #include <xtensor/xview.hpp>
 
 #include "config.h"
 #include "experimentcontrol.h"
 #include "logging.h"
+#include "utils/time_utils.h"
+#include "utils/trace.h"
 
 AnalysisManager::AnalysisManager(ExperimentControl *exp)
     : unet(config.system.unet_model.server_addr,
@@ -23,78 +27,211 @@ AnalysisManager::AnalysisManager(ExperimentControl *exp)
 AnalysisManager::~AnalysisManager()
 {
     if (h5file) {
+        try {
+            FlushCellTables();
+        } catch (std::exception &e) {
+            LOG_ERROR("failed to flush cell tables: {}", e.what());
+        }
         delete h5file;
     }
 }
 
 void AnalysisManager::LoadFile()
 {
+    utils::StopWatch sw;
+    {
+        // trackRegions takes mutex_quant while holding mutex_tracking
+        std::unique_lock<std::mutex> lk_tracking(mutex_tracking);
+        next_track_id.clear();
+    }
     std::unique_lock<std::shared_mutex> lk(mutex_quant);
 
     if (h5file) {
+        FlushCellTables();
         delete h5file;
         h5file = nullptr;
     }
+    ndimage_names.clear();
+    quantification_index.clear();
+    cacheClear();
+    {
+        std::unique_lock<std::mutex> lk_table(mutex_cell_table);
+        cell_table_batches.clear();
+        cell_table_index.clear();
+        cell_table_dtype.clear();
+    }
+
     if (!exp->ExperimentDir().empty()) {
         h5file = new HDF5File(exp->ExperimentDir() / "analysis.h5");
     }
 
+    if (h5file == nullptr) {
+        return;
+    }
+    loadCellTableIndex();
+
     if (!h5file->exists("/segmentation")) {
         return;
     }
 
-    std::vector<std::string> ndimage_names = h5file->list("/segmentation");
-    for (const auto &ndimage_name : ndimage_names) {
+    // Only index the groups here. Datasets are read when first requested.
+    for (const auto &ndimage_name : h5file->list("/segmentation")) {
         std::string ndimage_path = "/segmentation/" + ndimage_name;
-        std::vector<std::string> t_names = h5file->list(ndimage_path);
-        for (const auto &t_name : t_names) {
+        for (const auto &t_name : h5file->list(ndimage_path)) {
             int i_t = std::stoi(t_name);
             std::string path = ndimage_path + "/" + t_name;
 
-            std::string region_props_path = path + "/region_props";
-            std::string raw_intensity_mean_path = path + "/raw_intensity_mean";
-
-            if ((h5file->exists(region_props_path)) &&
-                (h5file->exists(raw_intensity_mean_path)))
+            std::vector<std::string> dataset_names = h5file->list(path);
+            auto has_dataset = [&dataset_names](std::string name) {
+                return std::find(dataset_names.begin(), dataset_names.end(),
+                                 name) != dataset_names.end();
+            };
+            if (has_dataset("region_props") &&
+                has_dataset("raw_intensity_mean"))
             {
-                StructArray rparr = h5file->read(region_props_path);
-                StructArray raw_intensity =
-                    h5file->read(raw_intensity_mean_path);
-
-                QuantificationResults results;
-                results.region_props.reserve(rparr.Size());
-                results.unet_score.reserve(rparr.Size());
-
-                for (int i = 0; i < rparr.Size(); i++) {
-                    ImageRegionProp rp;
-                    rp.label = rparr.Field<uint16_t>("label")[i];
-                    rp.bbox_x0 = rparr.Field<uint32_t>("bbox_x0")[i];
-                    rp.bbox_y0 = rparr.Field<uint32_t>("bbox_y0")[i];
-                    rp.bbox_width = rparr.Field<uint32_t>("bbox_width")[i];
-                    rp.bbox_height = rparr.Field<uint32_t>("bbox_height")[i];
-                    rp.area = rparr.Field<double>("area")[i];
-                    rp.centroid_x = rparr.Field<double>("centroid_x")[i];
-                    rp.centroid_y = rparr.Field<double>("centroid_y")[i];
-
-                    results.region_props.push_back(rp);
-                    results.unet_score.push_back(
-                        rparr.Field<double>("score_mean")[i]);
+                quantification_index.insert({ndimage_name, i_t});
+                if (std::find(ndimage_names.begin(), ndimage_names.end(),
+                              ndimage_name) == ndimage_names.end())
+                {
+                    ndimage_names.push_back(ndimage_name);
                 }
+            }
+        }
+    }
 
-                results.raw_intensity_mean.reserve(raw_intensity.Size());
-                for (const auto &ch_name : raw_intensity.Names()) {
-                    results.ch_names.push_back(ch_name);
-                    results.raw_intensity_mean.push_back(
-                        raw_intensity.Field<float>(ch_name));
-                }
+    LOG_INFO("{} quantification results indexed from file [{:.1f} ms]",
+             quantification_index.size(), sw.Milliseconds());
+}
 
-                quantifications[{ndimage_name, i_t}] = results;
-            }
+// Per-channel values of regions, stored as a struct array with one field per
+// channel
+static StructArray
+channelValuesToStructArray(const std::vector<std::string> &ch_names,
+                           const std::vector<xt::xarray<float>> &values,
+                           size_t n_regions)
+{
+    StructArray sarr(ch_names, Dtype::float32, n_regions,
+                     StructArrayLayout::Records);
+    for (int i_ch = 0; i_ch < ch_names.size(); i_ch++) {
+        auto field = sarr.FieldRef<float>(ch_names[i_ch]);
+        for (int i = 0; i < n_regions; i++) {
+            field[i] = values[i_ch][i];
         }
     }
+    return sarr;
+}
+
+static void channelValuesFromStructArray(StructArray &sarr,
+                                         std::vector<std::string> &ch_names,
+                                         std::vector<xt::xarray<float>> &values)
+{
+    for (const auto &ch_name : sarr.Names()) {
+        auto field = sarr.FieldRef<float>(ch_name);
+        xt::xarray<float> arr = xt::xarray<float>::from_shape({sarr.Size()});
+        for (int i = 0; i < sarr.Size(); i++) {
+            arr[i] = field[i];
+        }
+        ch_names.push_back(ch_name);
+        values.push_back(arr);
+    }
+}
 
-    LOG_INFO("{} quantification results loaded from file",
-             quantifications.size());
+std::shared_ptr<const QuantificationResults>
+AnalysisManager::loadQuantification(std::string ndimage_name, int i_t)
+{
+    std::string path = fmt::format("/segmentation/{}/{}", ndimage_name, i_t);
+
+    StructArray rparr = h5file->read(path + "/region_props");
+    StructArray raw_intensity = h5file->read(path + "/raw_intensity_mean");
+
+    auto results = std::make_shared<QuantificationResults>();
+    results->region_props.reserve(rparr.Size());
+    results->unet_score.reserve(rparr.Size());
+
+    auto label = rparr.FieldRef<uint16_t>("label");
+    auto bbox_x0 = rparr.FieldRef<uint32_t>("bbox_x0");
+    auto bbox_y0 = rparr.FieldRef<uint32_t>("bbox_y0");
+    auto bbox_width = rparr.FieldRef<uint32_t>("bbox_width");
+    auto bbox_height = rparr.FieldRef<uint32_t>("bbox_height");
+    auto area = rparr.FieldRef<double>("area");
+    auto centroid_x = rparr.FieldRef<double>("centroid_x");
+    auto centroid_y = rparr.FieldRef<double>("centroid_y");
+    auto score_mean = rparr.FieldRef<double>("score_mean");
+    for (int i = 0; i < rparr.Size(); i++) {
+        ImageRegionProp rp;
+        rp.label = label[i];
+        rp.bbox_x0 = bbox_x0[i];
+        rp.bbox_y0 = bbox_y0[i];
+        rp.bbox_width = bbox_width[i];
+        rp.bbox_height = bbox_height[i];
+        rp.area = area[i];
+        rp.centroid_x = centroid_x[i];
+        rp.centroid_y = centroid_y[i];
+
+        results->region_props.push_back(rp);
+        results->unet_score.push_back(score_mean[i]);
+    }
+
+    if (h5file->exists(path + "/track_id")) {
+        xt::xarray<uint32_t> track_id =
+            h5file->read<uint32_t>(path + "/track_id");
+        results->track_id.assign(track_id.begin(), track_id.end());
+    }
+
+    channelValuesFromStructArray(raw_intensity, results->ch_names,
+                                 results->raw_intensity_mean);
+
+    if (h5file->exists(path + "/corrected_intensity_mean")) {
+        StructArray corrected_intensity =
+            h5file->read(path + "/corrected_intensity_mean");
+        channelValuesFromStructArray(corrected_intensity,
+                                     results->corrected_ch_names,
+                                     results->corrected_intensity_mean);
+    }
+
+    return results;
+}
+
+std::shared_ptr<const QuantificationResults>
+AnalysisManager::cacheGet(const QuantificationKey &key)
+{
+    std::unique_lock<std::mutex> lk(mutex_cache);
+
+    auto it = cache.find(key);
+    if (it == cache.end()) {
+        return nullptr;
+    }
+    cache_lru.splice(cache_lru.begin(), cache_lru, it->second.second);
+    return it->second.first;
+}
+
+void AnalysisManager::cachePut(
+    const QuantificationKey &key,
+    std::shared_ptr<const QuantificationResults> results)
+{
+    std::unique_lock<std::mutex> lk(mutex_cache);
+
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        it->second.first = results;
+        cache_lru.splice(cache_lru.begin(), cache_lru, it->second.second);
+        return;
+    }
+
+    cache_lru.push_front(key);
+    cache[key] = {results, cache_lru.begin()};
+
+    while (cache.size() > cache_capacity) {
+        cache.erase(cache_lru.back());
+        cache_lru.pop_back();
+    }
+}
+
+void AnalysisManager::cacheClear()
+{
+    std::unique_lock<std::mutex> lk(mutex_cache);
+    cache.clear();
+    cache_lru.clear();
 }
 
 xt::xarray<double>
@@ -120,6 +257,8 @@ AnalysisManager::GetSegmentationScore(std::string ndimage_name, int i_t,
 int AnalysisManager::QuantifyRegions(std::string ndimage_name, int i_t,
                                      std::string segmentation_ch)
 {
+    utils::TraceSpan span("analysis", "quantify regions");
+
     // Find image
     NDImage *ndimage = exp->Images()->GetNDImage(ndimage_name);
     int i_ch = ndimage->ChannelIndex(segmentation_ch);
@@ -138,7 +277,9 @@ int AnalysisManager::QuantifyRegions(std::string ndimage_name, int i_t,
     xt::xarray<float> imnorm = Normalize(im_raw_arr);
 
     // U-Net
+    utils::TraceSpan span_unet("analysis", "unet");
     xt::xarray<float> im_score = unet.GetScore(imnorm);
+    span_unet.End();
 
     // Segment score image and calculate mean score of regions
     std::vector<ImageRegionProp> region_prop;
@@ -187,18 +328,21 @@ int AnalysisManager::QuantifyRegions(std::string ndimage_name, int i_t,
     //
     // Save U-Net score and label image
     //
+    utils::StopWatch sw_save;
+    utils::TraceSpan span_save("analysis", "save segmentation");
     xt::xarray<uint16_t> im_score_u16 = im_score * 65535;
     std::string group_name =
         fmt::format("/segmentation/{}/{}", ndimage_name, i_t);
     h5file->write(fmt::format("{}/unet_score", group_name), im_score_u16, true);
     h5file->write(fmt::format("{}/label_image", group_name), im_labels, true);
-    h5file->flush();
 
-    LOG_DEBUG("Label image saved");
+    span_save.End();
+    LOG_DEBUG("Label image saved [{:.1f} ms]", sw_save.Milliseconds());
 
     // Workaround to deal with 0 cell condition
     // Full implementation should save the results as well
     if (region_prop_filtered.size() == 0) {
+        h5file->flush();
         SendEvent({
             .type = EventType::QuantificationCompleted,
             .value = ndimage_name,
@@ -235,12 +379,34 @@ int AnalysisManager::QuantifyRegions(std::string ndimage_name, int i_t,
 
         results.ch_names.push_back(ndimage->ChannelName(i_ch));
         results.raw_intensity_mean.push_back(ch_mean);
+
+        // Same regions on the corrected image, if the channel has maps
+        std::string ch_name = ndimage->ChannelName(i_ch);
+        ImageCorrection *correction = exp->Images()->Correction();
+        if (correction->HasCorrection(ch_name)) {
+            ImageData im_corr = correction->Apply(ch_name, im_ch);
+            xt::xarray<float> im_corr_arr =
+                xt::adapt((float *)im_corr.Buf().get(), im_corr.size(),
+                          xt::no_ownership(), shape);
+            xt::xarray<double> corr_sum = RegionSum(
+                im_corr_arr, im_labels, region_prop_filtered.back().label);
+            xt::xarray<float> corr_mean =
+                xt::view(corr_sum, xt::range(1, corr_sum.size())) /
+                area_filtered;
+
+            results.corrected_ch_names.push_back(ch_name);
+            results.corrected_intensity_mean.push_back(corr_mean);
+        }
     }
 
+    trackRegions(ndimage_name, i_t, results);
+
     {
         std::unique_lock<std::shared_mutex> lk(mutex_quant);
 
-        quantifications[{ndimage_name, i_t}] = results;
+        quantification_index.insert({ndimage_name, i_t});
+        cachePut({ndimage_name, i_t},
+                 std::make_shared<const QuantificationResults>(results));
 
         if (std::find(ndimage_names.begin(), ndimage_names.end(),
                       ndimage_name) == ndimage_names.end())
@@ -265,38 +431,55 @@ int AnalysisManager::QuantifyRegions(std::string ndimage_name, int i_t,
             {"centroid_y", Dtype::float64},
             {"score_mean", Dtype::float64},
         },
-        results.region_props.size());
-
+        results.region_props.size(), StructArrayLayout::Records);
+
+    auto rp_label = rp_sarr.FieldRef<uint16_t>("label");
+    auto rp_bbox_x0 = rp_sarr.FieldRef<uint32_t>("bbox_x0");
+    auto rp_bbox_y0 = rp_sarr.FieldRef<uint32_t>("bbox_y0");
+    auto rp_bbox_width = rp_sarr.FieldRef<uint32_t>("bbox_width");
+    auto rp_bbox_height = rp_sarr.FieldRef<uint32_t>("bbox_height");
+    auto rp_area = rp_sarr.FieldRef<double>("area");
+    auto rp_centroid_x = rp_sarr.FieldRef<double>("centroid_x");
+    auto rp_centroid_y = rp_sarr.FieldRef<double>("centroid_y");
+    auto rp_score_mean = rp_sarr.FieldRef<double>("score_mean");
     for (int i = 0; i < results.region_props.size(); i++) {
-        rp_sarr.Field<uint16_t>("label")[i] = results.region_props[i].label;
-        rp_sarr.Field<uint32_t>("bbox_x0")[i] = results.region_props[i].bbox_x0;
-        rp_sarr.Field<uint32_t>("bbox_y0")[i] = results.region_props[i].bbox_y0;
-        rp_sarr.Field<uint32_t>("bbox_width")[i] =
-            results.region_props[i].bbox_width;
-        rp_sarr.Field<uint32_t>("bbox_height")[i] =
-            results.region_props[i].bbox_height;
-        rp_sarr.Field<double>("area")[i] = results.region_props[i].area;
-        rp_sarr.Field<double>("centroid_x")[i] =
-            results.region_props[i].centroid_x;
-        rp_sarr.Field<double>("centroid_y")[i] =
-            results.region_props[i].centroid_y;
-    }
-    rp_sarr.Field<double>("score_mean") = xt::adapt(score_mean_filtered);
+        const ImageRegionProp &rp = results.region_props[i];
+        rp_label[i] = rp.label;
+        rp_bbox_x0[i] = rp.bbox_x0;
+        rp_bbox_y0[i] = rp.bbox_y0;
+        rp_bbox_width[i] = rp.bbox_width;
+        rp_bbox_height[i] = rp.bbox_height;
+        rp_area[i] = rp.area;
+        rp_centroid_x[i] = rp.centroid_x;
+        rp_centroid_y[i] = rp.centroid_y;
+        rp_score_mean[i] = results.unet_score[i];
+    }
 
     h5file->write(fmt::format("{}/region_props", group_name), rp_sarr);
+    h5file->write(fmt::format("{}/track_id", group_name),
+                  xt::xarray<uint32_t>(xt::adapt(results.track_id)));
 
-    StructArray raw_intensity_mean_sarr(results.ch_names, Dtype::float32,
-                                        results.region_props.size());
-    for (int i = 0; i < results.ch_names.size(); i++) {
-        std::string ch_name = results.ch_names[i];
-        raw_intensity_mean_sarr.Field<float>(ch_name) =
-            results.raw_intensity_mean[i];
-    }
+    StructArray raw_intensity_mean_sarr = channelValuesToStructArray(
+        results.ch_names, results.raw_intensity_mean,
+        results.region_props.size());
     h5file->write(fmt::format("{}/raw_intensity_mean", group_name),
                   raw_intensity_mean_sarr);
+
+    std::string corrected_path =
+        fmt::format("{}/corrected_intensity_mean", group_name);
+    if (!results.corrected_ch_names.empty()) {
+        StructArray corrected_intensity_mean_sarr = channelValuesToStructArray(
+            results.corrected_ch_names, results.corrected_intensity_mean,
+            results.region_props.size());
+        h5file->write(corrected_path, corrected_intensity_mean_sarr);
+    } else if (h5file->exists(corrected_path)) {
+        h5file->remove(corrected_path);
+    }
+    appendCellTable(ndimage, i_t, results);
     h5file->flush();
 
-    LOG_DEBUG("Quantification completed");
+    LOG_DEBUG("Quantification completed, {} saved [{:.1f} ms]", group_name,
+              sw_save.Milliseconds());
 
     SendEvent({
         .type = EventType::QuantificationCompleted,
@@ -315,12 +498,7 @@ std::vector<std::string> AnalysisManager::GetNDImageNames()
 bool AnalysisManager::HasQuantification(std::string ndimage_name, int i_t)
 {
     std::shared_lock<std::shared_mutex> lk(mutex_quant);
-
-    auto it = quantifications.find({ndimage_name, i_t});
-    if (it == quantifications.end()) {
-        return false;
-    }
-    return true;
+    return quantification_index.contains({ndimage_name, i_t});
 }
 
 QuantificationResults
@@ -328,10 +506,462 @@ AnalysisManager::GetQuantification(std::string ndimage_name, int i_t)
 {
     std::shared_lock<std::shared_mutex> lk(mutex_quant);
 
-    auto it = quantifications.find({ndimage_name, i_t});
-    if (it == quantifications.end()) {
+    QuantificationKey key = {ndimage_name, i_t};
+    if (!quantification_index.contains(key)) {
         throw std::invalid_argument("quantification not found");
     }
 
-    return it->second;
+    std::shared_ptr<const QuantificationResults> results = cacheGet(key);
+    if (results == nullptr) {
+        results = loadQuantification(ndimage_name, i_t);
+        cachePut(key, results);
+    }
+
+    return *results;
+}
+
+//
+// Tracking
+//
+
+void AnalysisManager::trackRegions(std::string ndimage_name, int i_t,
+                                   QuantificationResults &results)
+{
+    utils::StopWatch sw;
+    utils::TraceSpan span("analysis", "track regions");
+    std::unique_lock<std::mutex> lk(mutex_tracking);
+
+    std::string next_id_path =
+        fmt::format("/tracking/{}/next_track_id", ndimage_name);
+    auto it = next_track_id.find(ndimage_name);
+    if (it == next_track_id.end()) {
+        uint32_t next_id = 1;
+        if (h5file->exists(next_id_path)) {
+            next_id = h5file->read<uint32_t>(next_id_path)[0];
+        }
+        it = next_track_id.insert({ndimage_name, next_id}).first;
+    }
+    uint32_t &next_id = it->second;
+
+    // Link to the previous time point if it has been tracked
+    std::vector<int> links(results.region_props.size(), -1);
+    QuantificationResults prev;
+    if ((i_t > 0) && HasQuantification(ndimage_name, i_t - 1)) {
+        prev = GetQuantification(ndimage_name, i_t - 1);
+        if (prev.track_id.size() == prev.region_props.size()) {
+            links = LinkRegions(prev.region_props, results.region_props,
+                                tracking_params);
+        }
+    }
+
+    int n_linked = 0;
+    results.track_id.resize(results.region_props.size());
+    for (int i = 0; i < results.region_props.size(); i++) {
+        if (links[i] >= 0) {
+            results.track_id[i] = prev.track_id[links[i]];
+            n_linked++;
+        } else {
+            results.track_id[i] = next_id++;
+        }
+    }
+
+    h5file->write(next_id_path, xt::xarray<uint32_t>({next_id}));
+
+    LOG_DEBUG("Tracking {} t={}: {}/{} regions linked [{:.1f} ms]",
+              ndimage_name, i_t, n_linked, results.region_props.size(),
+              sw.Milliseconds());
+}
+
+//
+// Cell tables
+//
+
+// Fields of a are kept in order, fields only in b are added at the end.
+static std::vector<StructArrayFieldDef>
+mergeCellTableDtype(const std::vector<StructArrayFieldDef> &a,
+                    const std::vector<StructArrayFieldDef> &b)
+{
+    std::vector<StructArrayFieldDef> merged = a;
+    for (const auto &field : b) {
+        auto it = std::find_if(merged.begin(), merged.end(),
+                               [&field](const StructArrayFieldDef &f) {
+                                   return f.name == field.name;
+                               });
+        if (it == merged.end()) {
+            merged.push_back(field);
+        } else if (it->dtype != field.dtype) {
+            throw std::invalid_argument(fmt::format(
+                "cell table field {} has a different type", field.name));
+        }
+    }
+    return merged;
+}
+
+// Copy rows field by field by name, both in records layout. Fields missing
+// from src are NaN for floating point fields and zero otherwise.
+static void copyCellTableRows(StructArray &src, size_t src_begin,
+                              StructArray &dst, size_t dst_begin, size_t count)
+{
+    std::map<std::string, size_t> src_offset;
+    for (const auto &field : src.Fields()) {
+        src_offset[field.name] = field.offset;
+    }
+    for (const auto &field : dst.Fields()) {
+        size_t field_size = DtypeSize(field.dtype);
+        uint8_t *dst_ptr =
+            dst.Data() + dst_begin * dst.ItemSize() + field.offset;
+        auto it = src_offset.find(field.name);
+        if (it != src_offset.end()) {
+            const uint8_t *src_ptr =
+                src.Data() + src_begin * src.ItemSize() + it->second;
+            for (size_t i = 0; i < count; i++) {
+                std::memcpy(dst_ptr + i * dst.ItemSize(),
+                            src_ptr + i * src.ItemSize(), field_size);
+            }
+        } else if (field.dtype == Dtype::float32) {
+            float nan = std::numeric_limits<float>::quiet_NaN();
+            for (size_t i = 0; i < count; i++) {
+                std::memcpy(dst_ptr + i * dst.ItemSize(), &nan, field_size);
+            }
+        } else if (field.dtype == Dtype::float64) {
+            double nan = std::numeric_limits<double>::quiet_NaN();
+            for (size_t i = 0; i < count; i++) {
+                std::memcpy(dst_ptr + i * dst.ItemSize(), &nan, field_size);
+            }
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                std::memset(dst_ptr + i * dst.ItemSize(), 0, field_size);
+            }
+        }
+    }
+}
+
+void AnalysisManager::appendCellTable(NDImage *ndimage, int i_t,
+                                      const QuantificationResults &results)
+{
+    ::Site *site = ndimage->Site();
+    if (site == nullptr) {
+        return;
+    }
+    ::Well *well = site->Well();
+    std::string plate_id = well->Plate()->ID();
+
+    std::vector<StructArrayFieldDef> dtype = {
+        {"ndimage_index", Dtype::int32},
+        {"t", Dtype::int32},
+        {"well_index", Dtype::int32},
+        {"site_index", Dtype::int32},
+        {"label", Dtype::uint16},
+        {"bbox_x0", Dtype::uint32},
+        {"bbox_y0", Dtype::uint32},
+        {"bbox_width", Dtype::uint32},
+        {"bbox_height", Dtype::uint32},
+        {"area", Dtype::float64},
+        {"centroid_x", Dtype::float64},
+        {"centroid_y", Dtype::float64},
+        {"score_mean", Dtype::float64},
+        {"track_id", Dtype::uint32},
+    };
+    for (const auto &ch_name : results.ch_names) {
+        dtype.push_back({"raw_intensity_mean_" + ch_name, Dtype::float32});
+    }
+    for (const auto &ch_name : results.corrected_ch_names) {
+        dtype.push_back(
+            {"corrected_intensity_mean_" + ch_name, Dtype::float32});
+    }
+
+    size_t n_rows = results.region_props.size();
+    StructArray rows(dtype, n_rows, StructArrayLayout::Records);
+
+    auto ndimage_index = rows.FieldRef<int32_t>("ndimage_index");
+    auto t = rows.FieldRef<int32_t>("t");
+    auto well_index = rows.FieldRef<int32_t>("well_index");
+    auto site_index = rows.FieldRef<int32_t>("site_index");
+    auto label = rows.FieldRef<uint16_t>("label");
+    auto bbox_x0 = rows.FieldRef<uint32_t>("bbox_x0");
+    auto bbox_y0 = rows.FieldRef<uint32_t>("bbox_y0");
+    auto bbox_width = rows.FieldRef<uint32_t>("bbox_width");
+    auto bbox_height = rows.FieldRef<uint32_t>("bbox_height");
+    auto area = rows.FieldRef<double>("area");
+    auto centroid_x = rows.FieldRef<double>("centroid_x");
+    auto centroid_y = rows.FieldRef<double>("centroid_y");
+    auto score_mean = rows.FieldRef<double>("score_mean");
+    auto track_id = rows.FieldRef<uint32_t>("track_id");
+    for (int i = 0; i < n_rows; i++) {
+        const ImageRegionProp &rp = results.region_props[i];
+        ndimage_index[i] = ndimage->Index();
+        t[i] = i_t;
+        well_index[i] = well->Index();
+        site_index[i] = site->Index();
+        label[i] = rp.label;
+        bbox_x0[i] = rp.bbox_x0;
+        bbox_y0[i] = rp.bbox_y0;
+        bbox_width[i] = rp.bbox_width;
+        bbox_height[i] = rp.bbox_height;
+        area[i] = rp.area;
+        centroid_x[i] = rp.centroid_x;
+        centroid_y[i] = rp.centroid_y;
+        score_mean[i] = results.unet_score[i];
+        track_id[i] = results.track_id[i];
+    }
+    for (int i_ch = 0; i_ch < results.ch_names.size(); i_ch++) {
+        auto ch_mean = rows.FieldRef<float>("raw_intensity_mean_" +
+                                            results.ch_names[i_ch]);
+        for (int i = 0; i < n_rows; i++) {
+            ch_mean[i] = results.raw_intensity_mean[i_ch][i];
+        }
+    }
+    for (int i_ch = 0; i_ch < results.corrected_ch_names.size(); i_ch++) {
+        auto ch_mean = rows.FieldRef<float>("corrected_intensity_mean_" +
+                                            results.corrected_ch_names[i_ch]);
+        for (int i = 0; i < n_rows; i++) {
+            ch_mean[i] = results.corrected_intensity_mean[i_ch][i];
+        }
+    }
+
+    std::unique_lock<std::mutex> lk(mutex_cell_table);
+
+    // A plate has a single table layout, widened when a site brings new
+    // channels. Rows of a site that is quantified again replace the
+    // previous ones. Both rewrite the table, which is rare.
+    std::tuple<int, int> key = {ndimage->Index(), i_t};
+    CellTableBatch &batch = cell_table_batches[plate_id];
+    std::vector<StructArrayFieldDef> &table_dtype = cell_table_dtype[plate_id];
+    std::vector<StructArrayFieldDef> merged_dtype =
+        mergeCellTableDtype(table_dtype, dtype);
+
+    bool requantified = cell_table_index.contains(key);
+    for (const auto &[index_ndimage, index_t, offset, count] :
+         batch.index_rows)
+    {
+        if ((index_ndimage == std::get<0>(key)) && (index_t == i_t)) {
+            requantified = true;
+        }
+    }
+    if (requantified || (merged_dtype != table_dtype)) {
+        flushCellTable(plate_id);
+        if (h5file->exists(
+                fmt::format("/quantification/{}/cells", plate_id))) {
+            rewriteCellTable(plate_id, merged_dtype, key);
+        }
+    }
+    table_dtype = merged_dtype;
+
+    if (dtype != table_dtype) {
+        StructArray widened(table_dtype, n_rows, StructArrayLayout::Records);
+        copyCellTableRows(rows, 0, widened, 0, n_rows);
+        rows = std::move(widened);
+    }
+    batch.dtype = table_dtype;
+    batch.index_rows.push_back({ndimage->Index(), i_t, batch.n_rows, n_rows});
+    batch.buf.append((char *)rows.Data(), rows.ItemSize() * n_rows);
+    batch.n_rows += n_rows;
+
+    // Appended with the site, which QuantifyRegions flushes to the file, so
+    // the table keeps up with the per-site datasets
+    flushCellTable(plate_id);
+}
+
+void AnalysisManager::flushCellTable(std::string plate_id)
+{
+    utils::TraceSpan span("analysis", "flush cell table");
+    auto it = cell_table_batches.find(plate_id);
+    if ((it == cell_table_batches.end()) || (it->second.index_rows.empty())) {
+        return;
+    }
+    CellTableBatch &batch = it->second;
+
+    std::string group_name = fmt::format("/quantification/{}", plate_id);
+
+    StructArray rows(batch.dtype, batch.n_rows, StructArrayLayout::Records);
+    rows.FromBuf(batch.buf);
+    uint64_t offset =
+        h5file->append(group_name + "/cells", rows, cell_table_chunk_rows);
+
+    StructArray index_rows(
+        {
+            {"ndimage_index", Dtype::int32},
+            {"t", Dtype::int32},
+            {"offset", Dtype::uint64},
+            {"count", Dtype::uint64},
+        },
+        batch.index_rows.size(), StructArrayLayout::Records);
+    auto index_ndimage = index_rows.FieldRef<int32_t>("ndimage_index");
+    auto index_t = index_rows.FieldRef<int32_t>("t");
+    auto index_offset = index_rows.FieldRef<uint64_t>("offset");
+    auto index_count = index_rows.FieldRef<uint64_t>("count");
+    for (int i = 0; i < batch.index_rows.size(); i++) {
+        auto [ndimage_index, i_t, batch_offset, count] = batch.index_rows[i];
+        index_ndimage[i] = ndimage_index;
+        index_t[i] = i_t;
+        index_offset[i] = offset + batch_offset;
+        index_count[i] = count;
+
+        cell_table_index[{ndimage_index, i_t}] = {
+            .plate_id = plate_id,
+            .offset = offset + batch_offset,
+            .count = count,
+        };
+    }
+    h5file->append(group_name + "/cell_index", index_rows,
+                   cell_table_chunk_rows);
+
+    LOG_DEBUG("{} rows of {} sites appended to {}/cells", batch.n_rows,
+              batch.index_rows.size(), group_name);
+
+    batch = CellTableBatch();
+}
+
+void AnalysisManager::rewriteCellTable(std::string plate_id,
+                                       std::vector<StructArrayFieldDef> dtype,
+                                       std::tuple<int, int> exclude)
+{
+    utils::StopWatch sw;
+    utils::TraceSpan span("analysis", "rewrite cell table");
+    std::string group_name = fmt::format("/quantification/{}", plate_id);
+
+    StructArray cells = h5file->read(group_name + "/cells");
+    StructArray index_rows = h5file->read(group_name + "/cell_index");
+
+    // Later entries replace earlier ones of the same site, as on load
+    std::map<std::tuple<int, int>, std::tuple<uint64_t, uint64_t>> sites;
+    auto index_ndimage = index_rows.FieldRef<int32_t>("ndimage_index");
+    auto index_t = index_rows.FieldRef<int32_t>("t");
+    auto index_offset = index_rows.FieldRef<uint64_t>("offset");
+    auto index_count = index_rows.FieldRef<uint64_t>("count");
+    for (int i = 0; i < index_rows.Size(); i++) {
+        sites[{index_ndimage[i], index_t[i]}] = {index_offset[i],
+                                                  index_count[i]};
+    }
+    sites.erase(exclude);
+
+    uint64_t n_rows = 0;
+    for (const auto &[site_key, loc] : sites) {
+        n_rows += std::get<1>(loc);
+    }
+    StructArray new_cells(dtype, n_rows, StructArrayLayout::Records);
+    StructArray new_index_rows(index_rows.DataType(), sites.size(),
+                               StructArrayLayout::Records);
+    auto new_index_ndimage = new_index_rows.FieldRef<int32_t>("ndimage_index");
+    auto new_index_t = new_index_rows.FieldRef<int32_t>("t");
+    auto new_index_offset = new_index_rows.FieldRef<uint64_t>("offset");
+    auto new_index_count = new_index_rows.FieldRef<uint64_t>("count");
+
+    std::erase_if(cell_table_index, [&plate_id](const auto &item) {
+        return item.second.plate_id == plate_id;
+    });
+    uint64_t offset = 0;
+    int i_site = 0;
+    for (const auto &[site_key, loc] : sites) {
+        auto [old_offset, count] = loc;
+        copyCellTableRows(cells, old_offset, new_cells, offset, count);
+        new_index_ndimage[i_site] = std::get<0>(site_key);
+        new_index_t[i_site] = std::get<1>(site_key);
+        new_index_offset[i_site] = offset;
+        new_index_count[i_site] = count;
+        cell_table_index[site_key] = {
+            .plate_id = plate_id,
+            .offset = offset,
+            .count = count,
+        };
+        offset += count;
+        i_site++;
+    }
+
+    h5file->remove(group_name + "/cells");
+    h5file->remove(group_name + "/cell_index");
+    h5file->append(group_name + "/cells", new_cells, cell_table_chunk_rows);
+    h5file->append(group_name + "/cell_index", new_index_rows,
+                   cell_table_chunk_rows);
+
+    LOG_INFO("{}/cells rewritten with {} rows of {} sites [{:.1f} ms]",
+             group_name, n_rows, sites.size(), sw.Milliseconds());
+}
+
+void AnalysisManager::FlushCellTables()
+{
+    std::unique_lock<std::mutex> lk(mutex_cell_table);
+
+    if (h5file == nullptr) {
+        return;
+    }
+    for (const auto &[plate_id, batch] : cell_table_batches) {
+        flushCellTable(plate_id);
+    }
+    h5file->flush();
+}
+
+void AnalysisManager::loadCellTableIndex()
+{
+    std::unique_lock<std::mutex> lk(mutex_cell_table);
+
+    if (!h5file->exists("/quantification")) {
+        return;
+    }
+    for (const auto &plate_id : h5file->list("/quantification")) {
+        std::string path =
+            fmt::format("/quantification/{}/cell_index", plate_id);
+        if (!h5file->exists(path)) {
+            continue;
+        }
+
+        std::string cells_path =
+            fmt::format("/quantification/{}/cells", plate_id);
+        cell_table_dtype[plate_id] = h5file->read(cells_path, 0, 1).DataType();
+
+        // Later entries replace earlier ones of the same site
+        StructArray index_rows = h5file->read(path);
+        auto index_ndimage = index_rows.FieldRef<int32_t>("ndimage_index");
+        auto index_t = index_rows.FieldRef<int32_t>("t");
+        auto index_offset = index_rows.FieldRef<uint64_t>("offset");
+        auto index_count = index_rows.FieldRef<uint64_t>("count");
+        for (int i = 0; i < index_rows.Size(); i++) {
+            cell_table_index[{index_ndimage[i], index_t[i]}] = {
+                .plate_id = plate_id,
+                .offset = index_offset[i],
+                .count = index_count[i],
+            };
+        }
+    }
+}
+
+StructArray AnalysisManager::ReadCellTable(std::string plate_id)
+{
+    std::unique_lock<std::mutex> lk(mutex_cell_table);
+
+    if (h5file == nullptr) {
+        throw std::runtime_error("experiment not open");
+    }
+    flushCellTable(plate_id);
+
+    std::string path = fmt::format("/quantification/{}/cells", plate_id);
+    if (!h5file->exists(path)) {
+        throw std::invalid_argument("cell table not found");
+    }
+    return h5file->read(path);
+}
+
+StructArray AnalysisManager::ReadCellTable(std::string ndimage_name, int i_t)
+{
+    NDImage *ndimage = exp->Images()->GetNDImage(ndimage_name);
+    if (ndimage == nullptr) {
+        throw std::invalid_argument("ndimage not found");
+    }
+
+    std::unique_lock<std::mutex> lk(mutex_cell_table);
+
+    if (h5file == nullptr) {
+        throw std::runtime_error("experiment not open");
+    }
+    if (ndimage->Site() != nullptr) {
+        flushCellTable(ndimage->Site()->Well()->Plate()->ID());
+    }
+
+    auto it = cell_table_index.find({ndimage->Index(), i_t});
+    if (it == cell_table_index.end()) {
+        throw std::invalid_argument("quantification not found");
+    }
+    const CellTableLocation &loc = it->second;
+    return h5file->read(fmt::format("/quantification/{}/cells", loc.plate_id),
+                        loc.offset, loc.count);
 }
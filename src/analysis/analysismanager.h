@@ -2,12 +2,17 @@
 #define ANALYSISMANAGER_H
 
 #include <filesystem>
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <shared_mutex>
 #include <string>
 #include <tuple>
 #include <vector>
 
+#include "analysis/tracking.h"
 #include "analysis/utils.h"
 #include "eventstream.h"
 #include "utils/hdf5file.h"
@@ -15,6 +20,7 @@
 struct QuantificationResults;
 
 class ExperimentControl;
+class NDImage;
 
 class AnalysisManager : public EventSender {
 public:
@@ -31,24 +37,92 @@ public:
     bool HasQuantification(std::string ndimage_name, int i_t);
     QuantificationResults GetQuantification(std::string ndimage_name, int i_t);
 
+    // Plate-level cell tables under /quantification/<plate_id>
+    void FlushCellTables();
+    StructArray ReadCellTable(std::string plate_id);
+    StructArray ReadCellTable(std::string ndimage_name, int i_t);
+
 private:
+    typedef std::tuple<std::string, int> QuantificationKey;
+
     ExperimentControl *exp;
     HDF5File *h5file = nullptr;
 
     UNet unet;
 
+    // Index of (ndimage, t) with quantification results in the file.
+    // Results are read on demand.
     std::shared_mutex mutex_quant;
     std::vector<std::string> ndimage_names;
-    std::map<std::tuple<std::string, int>, QuantificationResults>
-        quantifications;
+    std::set<QuantificationKey> quantification_index;
+
+    // Bounded LRU cache of loaded results, most recently used at front
+    std::mutex mutex_cache;
+    size_t cache_capacity = 256;
+    std::list<QuantificationKey> cache_lru;
+    std::map<QuantificationKey,
+             std::pair<std::shared_ptr<const QuantificationResults>,
+                       std::list<QuantificationKey>::iterator>>
+        cache;
+
+    // Rows of the cell tables are collected per plate and appended with
+    // each quantified site.
+    // cell_table_index locates the rows of each (ndimage index, t).
+    // cell_table_dtype is the layout of the table and its pending batch.
+    struct CellTableBatch {
+        std::vector<StructArrayFieldDef> dtype;
+        std::string buf;
+        size_t n_rows = 0;
+        std::vector<std::tuple<int, int, uint64_t, uint64_t>> index_rows;
+    };
+    struct CellTableLocation {
+        std::string plate_id;
+        uint64_t offset;
+        uint64_t count;
+    };
+    std::mutex mutex_cell_table;
+    size_t cell_table_chunk_rows = 4096;
+    std::map<std::string, CellTableBatch> cell_table_batches;
+    std::map<std::tuple<int, int>, CellTableLocation> cell_table_index;
+    std::map<std::string, std::vector<StructArrayFieldDef>> cell_table_dtype;
+
+    void appendCellTable(NDImage *ndimage, int i_t,
+                         const QuantificationResults &results);
+    void flushCellTable(std::string plate_id);
+    void rewriteCellTable(std::string plate_id,
+                          std::vector<StructArrayFieldDef> dtype,
+                          std::tuple<int, int> exclude);
+    void loadCellTableIndex();
+
+    // Regions are linked to the previous time point when a time point is
+    // quantified. Track IDs are unique within an NDImage.
+    std::mutex mutex_tracking;
+    TrackingParams tracking_params;
+    std::map<std::string, uint32_t> next_track_id;
+
+    void trackRegions(std::string ndimage_name, int i_t,
+                      QuantificationResults &results);
+
+    std::shared_ptr<const QuantificationResults>
+    loadQuantification(std::string ndimage_name, int i_t);
+    std::shared_ptr<const QuantificationResults>
+    cacheGet(const QuantificationKey &key);
+    void cachePut(const QuantificationKey &key,
+                  std::shared_ptr<const QuantificationResults> results);
+    void cacheClear();
 };
 
 struct QuantificationResults {
     std::vector<ImageRegionProp> region_props;
     std::vector<double> unet_score;
+    std::vector<uint32_t> track_id;
 
     std::vector<std::string> ch_names;
     std::vector<xt::xarray<float>> raw_intensity_mean;
+
+    // Channels with dark-frame or flat-field correction only
+    std::vector<std::string> corrected_ch_names;
+    std::vector<xt::xarray<float>> corrected_intensity_mean;
 };
 
 #endif
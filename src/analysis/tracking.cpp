@@ -0,0 +1,147 @@
+#include "tracking.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+
+CentroidGrid::CentroidGrid(const std::vector<ImageRegionProp> &region_props,
+                           double cell_size)
+    : region_props(region_props), cell_size(cell_size)
+{
+    if (cell_size <= 0) {
+        throw std::invalid_argument("cell_size must be positive");
+    }
+    if (region_props.empty()) {
+        return;
+    }
+
+    double x_min = region_props[0].centroid_x;
+    double x_max = x_min;
+    double y_min = region_props[0].centroid_y;
+    double y_max = y_min;
+    for (const auto &rp : region_props) {
+        x_min = std::min(x_min, rp.centroid_x);
+        x_max = std::max(x_max, rp.centroid_x);
+        y_min = std::min(y_min, rp.centroid_y);
+        y_max = std::max(y_max, rp.centroid_y);
+    }
+    x0 = x_min;
+    y0 = y_min;
+    nx = (int)((x_max - x_min) / cell_size) + 1;
+    ny = (int)((y_max - y_min) / cell_size) + 1;
+
+    // Counting sort of regions into buckets
+    std::vector<int> bucket_of(region_props.size());
+    bucket_start.assign((size_t)nx * ny + 1, 0);
+    for (int i = 0; i < region_props.size(); i++) {
+        int bucket = bucketY(region_props[i].centroid_y) * nx +
+                     bucketX(region_props[i].centroid_x);
+        bucket_of[i] = bucket;
+        bucket_start[bucket + 1]++;
+    }
+    for (int i = 0; i < nx * ny; i++) {
+        bucket_start[i + 1] += bucket_start[i];
+    }
+    std::vector<int> fill = bucket_start;
+    bucket_items.resize(region_props.size());
+    for (int i = 0; i < region_props.size(); i++) {
+        bucket_items[fill[bucket_of[i]]++] = i;
+    }
+}
+
+int CentroidGrid::bucketX(double x) const
+{
+    return std::clamp((int)std::floor((x - x0) / cell_size), 0, nx - 1);
+}
+
+int CentroidGrid::bucketY(double y) const
+{
+    return std::clamp((int)std::floor((y - y0) / cell_size), 0, ny - 1);
+}
+
+void CentroidGrid::Query(double x, double y, double radius,
+                         std::vector<int> &indices) const
+{
+    if (region_props.empty()) {
+        return;
+    }
+
+    int bx0 = bucketX(x - radius);
+    int bx1 = bucketX(x + radius);
+    int by0 = bucketY(y - radius);
+    int by1 = bucketY(y + radius);
+    double r2 = radius * radius;
+    for (int by = by0; by <= by1; by++) {
+        for (int bx = bx0; bx <= bx1; bx++) {
+            int bucket = by * nx + bx;
+            for (int k = bucket_start[bucket]; k < bucket_start[bucket + 1];
+                 k++)
+            {
+                int i = bucket_items[k];
+                double dx = region_props[i].centroid_x - x;
+                double dy = region_props[i].centroid_y - y;
+                if (dx * dx + dy * dy <= r2) {
+                    indices.push_back(i);
+                }
+            }
+        }
+    }
+}
+
+static double bboxIoU(const ImageRegionProp &a, const ImageRegionProp &b)
+{
+    double ix0 = std::max(a.bbox_x0, b.bbox_x0);
+    double iy0 = std::max(a.bbox_y0, b.bbox_y0);
+    double ix1 = std::min(a.bbox_x0 + a.bbox_width, b.bbox_x0 + b.bbox_width);
+    double iy1 = std::min(a.bbox_y0 + a.bbox_height, b.bbox_y0 + b.bbox_height);
+    if ((ix1 <= ix0) || (iy1 <= iy0)) {
+        return 0;
+    }
+    double intersection = (ix1 - ix0) * (iy1 - iy0);
+    double area_a = (double)a.bbox_width * a.bbox_height;
+    double area_b = (double)b.bbox_width * b.bbox_height;
+    return intersection / (area_a + area_b - intersection);
+}
+
+std::vector<int> LinkRegions(const std::vector<ImageRegionProp> &prev,
+                             const std::vector<ImageRegionProp> &curr,
+                             const TrackingParams &params)
+{
+    std::vector<int> links(curr.size(), -1);
+    if (prev.empty() || curr.empty()) {
+        return links;
+    }
+
+    // Candidate pairs within max_distance
+    CentroidGrid grid(prev, params.max_distance);
+    std::vector<std::tuple<double, int, int>> candidates;
+    std::vector<int> neighbors;
+    for (int i_curr = 0; i_curr < curr.size(); i_curr++) {
+        const ImageRegionProp &rp = curr[i_curr];
+        neighbors.clear();
+        grid.Query(rp.centroid_x, rp.centroid_y, params.max_distance,
+                   neighbors);
+        for (int i_prev : neighbors) {
+            const ImageRegionProp &rp_prev = prev[i_prev];
+            double distance = std::hypot(rp_prev.centroid_x - rp.centroid_x,
+                                         rp_prev.centroid_y - rp.centroid_y);
+            double overlap = bboxIoU(rp_prev, rp);
+            double cost = distance / params.max_distance +
+                          params.overlap_weight * (1 - overlap);
+            candidates.push_back({cost, i_prev, i_curr});
+        }
+    }
+
+    // Greedy one-to-one assignment in order of increasing cost
+    std::sort(candidates.begin(), candidates.end());
+    std::vector<bool> prev_linked(prev.size(), false);
+    for (const auto &[cost, i_prev, i_curr] : candidates) {
+        if (prev_linked[i_prev] || (links[i_curr] >= 0)) {
+            continue;
+        }
+        prev_linked[i_prev] = true;
+        links[i_curr] = i_prev;
+    }
+    return links;
+}
@@ -0,0 +1,49 @@
+#ifndef TRACKING_H
+#define TRACKING_H
+
+#include <vector>
+
+#include "analysis/utils.h"
+
+struct TrackingParams {
+    // Maximum centroid displacement between frames, in pixels
+    double max_distance = 25;
+    // Weight of (1 - bounding box IoU) relative to the normalized distance
+    double overlap_weight = 1;
+};
+
+// Uniform grid over region centroids. Each bucket is cell_size wide, so a
+// radius query with radius <= cell_size only visits the 3x3 neighbourhood.
+class CentroidGrid {
+public:
+    CentroidGrid(const std::vector<ImageRegionProp> &region_props,
+                 double cell_size);
+
+    // Append indices of regions with centroid within radius of (x, y)
+    void Query(double x, double y, double radius,
+               std::vector<int> &indices) const;
+
+private:
+    const std::vector<ImageRegionProp> &region_props;
+    double cell_size;
+    double x0 = 0;
+    double y0 = 0;
+    int nx = 0;
+    int ny = 0;
+
+    // Region indices sorted by bucket, bucket i is [start[i], start[i+1])
+    std::vector<int> bucket_start;
+    std::vector<int> bucket_items;
+
+    int bucketX(double x) const;
+    int bucketY(double y) const;
+};
+
+// Link regions of the current frame to regions of the previous frame.
+// Returns, for each region in curr, the index of the linked region in prev,
+// or -1 if it starts a new track.
+std::vector<int> LinkRegions(const std::vector<ImageRegionProp> &prev,
+                             const std::vector<ImageRegionProp> &curr,
+                             const TrackingParams &params);
+
+#endif
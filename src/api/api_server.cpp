@@ -4,6 +4,7 @@
 
 #include "image/imageutils.h"
 #include "logging.h"
+#include "utils/trace.h"
 
 api::DataType DataTypeToPB(DataType dtype)
 {
@@ -89,6 +90,34 @@ ColorType ColorTypeFromPB(api::ColorType pb_ctype)
     }
 }
 
+std::string DtypeName(Dtype dtype)
+{
+    switch (dtype) {
+    case Dtype::float32:
+        return "float32";
+    case Dtype::float64:
+        return "float64";
+    case Dtype::uint8:
+        return "uint8";
+    case Dtype::uint16:
+        return "uint16";
+    case Dtype::uint32:
+        return "uint32";
+    case Dtype::uint64:
+        return "uint64";
+    case Dtype::int8:
+        return "int8";
+    case Dtype::int16:
+        return "int16";
+    case Dtype::int32:
+        return "int32";
+    case Dtype::int64:
+        return "int64";
+    default:
+        throw std::invalid_argument("unimplemented dtype");
+    }
+}
+
 api::PlateType PlateTypeToPB(PlateType pb_platetype)
 {
     switch (pb_platetype) {
@@ -117,6 +146,136 @@ PlateType PlateTypeFromPB(api::PlateType pb_platetype)
     }
 }
 
+Channel ChannelFromPB(const api::Channel &pb_channel)
+{
+    return Channel{
+        .preset_name = pb_channel.preset_name(),
+        .exposure_ms = pb_channel.exposure_ms(),
+        .illumination_intensity = pb_channel.illumination_intensity(),
+    };
+}
+
+// Zero values are replaced by the defaults
+AutofocusParams AutofocusParamsFromPB(const api::AutofocusRequest &req)
+{
+    AutofocusParams params;
+    switch (req.metric()) {
+    case api::FocusMetric::BRENNER:
+        params.metric = im::FocusMetric::Brenner;
+        break;
+    case api::FocusMetric::TENENGRAD:
+        params.metric = im::FocusMetric::Tenengrad;
+        break;
+    case api::FocusMetric::LAPLACIAN_VARIANCE:
+        params.metric = im::FocusMetric::LaplacianVariance;
+        break;
+    default:
+        throw std::invalid_argument("invalid focus metric");
+    }
+    if (req.range_um() > 0) {
+        params.range_um = req.range_um();
+    }
+    if (req.coarse_step_um() > 0) {
+        params.coarse_step_um = req.coarse_step_um();
+    }
+    if (req.fine_step_um() > 0) {
+        params.fine_step_um = req.fine_step_um();
+    }
+    if (req.stride() > 0) {
+        params.stride = req.stride();
+    }
+    return params;
+}
+
+ScanPlan ScanPlanFromPB(const api::StartScanRequest &req, const Plate *plate)
+{
+    ScanPlan plan;
+    plan.plate_id = plate->ID();
+    for (const auto &well_id : req.well_id()) {
+        plan.well_ids.push_back(well_id);
+    }
+    for (const auto &ch : req.channels()) {
+        plan.channels.push_back(ChannelFromPB(ch));
+    }
+    plan.i_t = req.i_t();
+    switch (req.focus_mode()) {
+    case api::ScanFocusMode::FOCUS_MAP:
+        plan.focus_mode = ScanFocusMode::FocusMap;
+        break;
+    case api::ScanFocusMode::AUTOFOCUS_PER_WELL:
+        plan.focus_mode = ScanFocusMode::AutofocusPerWell;
+        plan.autofocus_channel = ChannelFromPB(req.autofocus().channel());
+        plan.autofocus_params = AutofocusParamsFromPB(req.autofocus());
+        break;
+    case api::ScanFocusMode::NONE:
+        plan.focus_mode = ScanFocusMode::None;
+        break;
+    default:
+        throw std::invalid_argument("invalid focus mode");
+    }
+    switch (req.site_order()) {
+    case api::SiteOrder::AS_CREATED:
+        plan.site_order = SiteOrder::AsCreated;
+        break;
+    case api::SiteOrder::SERPENTINE:
+        plan.site_order = SiteOrder::Serpentine;
+        break;
+    case api::SiteOrder::NEAREST_NEIGHBOR:
+        plan.site_order = SiteOrder::NearestNeighbor;
+        break;
+    case api::SiteOrder::NEAREST_NEIGHBOR_2OPT:
+        plan.site_order = SiteOrder::NearestNeighbor2Opt;
+        break;
+    default:
+        throw std::invalid_argument("invalid site order");
+    }
+    switch (req.channel_order()) {
+    case api::ChannelOrder::AS_GIVEN:
+        plan.channel_order = ChannelOrder::AsGiven;
+        break;
+    case api::ChannelOrder::MIN_MOVES:
+        plan.channel_order = ChannelOrder::MinMoves;
+        break;
+    case api::ChannelOrder::PING_PONG:
+        plan.channel_order = ChannelOrder::PingPong;
+        break;
+    default:
+        throw std::invalid_argument("invalid channel order");
+    }
+    const api::StageSpeedModel &speed = req.speed_model();
+    if (speed.speed_x() > 0) {
+        plan.speed_model.speed_x = speed.speed_x();
+    }
+    if (speed.speed_y() > 0) {
+        plan.speed_model.speed_y = speed.speed_y();
+    }
+    if (speed.accel_x() > 0) {
+        plan.speed_model.accel_x = speed.accel_x();
+    }
+    if (speed.accel_y() > 0) {
+        plan.speed_model.accel_y = speed.accel_y();
+    }
+    if (speed.settle_ms() > 0) {
+        plan.speed_model.settle_ms = speed.settle_ms();
+    }
+    plan.ndimage_prefix = req.ndimage_prefix();
+    plan.metadata = nlohmann::ordered_json(req.metadata());
+    return plan;
+}
+
+void LiveRecordingStatsToPB(const LiveRecordingStats &stats,
+                            api::LiveRecordingStats *pb_stats)
+{
+    pb_stats->set_name(stats.name);
+    pb_stats->set_running(stats.running);
+    pb_stats->set_n_frames(stats.n_frames);
+    pb_stats->set_n_dropped_camera(stats.n_dropped_camera);
+    pb_stats->set_n_dropped_writer(stats.n_dropped_writer);
+    pb_stats->set_elapsed_s(stats.elapsed_s);
+    pb_stats->set_fps(stats.fps);
+    pb_stats->set_write_mb_per_s(stats.write_mb_per_s);
+}
+
 APIServer::APIServer(std::string listen_addr, ExperimentControl *exp)
 {
     this->exp = exp;
@@ -141,6 +300,7 @@ grpc::Status APIServer::GetProperty(ServerContext *context,
                                     const api::GetPropertyRequest *req,
                                     api::GetPropertyResponse *resp)
 {
+    utils::TraceSpan span("api", __func__);
     for (const auto &name : req->name()) {
         StatusOr<std::string> value;
         try {
@@ -165,15 +325,16 @@ grpc::Status APIServer::SetProperty(ServerContext *context,
                                     const api::SetPropertyRequest *req,
                                     google::protobuf::Empty *resp)
 {
-    PropertyValueMap property_value_map;
-    for (const auto &property : req->property()) {
-        std::string name = property.name();
-        std::string value = property.value();
-        property_value_map[name] = value;
-    }
-
+    utils::TraceSpan span("api", __func__);
     Status status;
     try {
+        // Paths are interned, which throws if there are too many
+        PropertyValueMap property_value_map;
+        for (const auto &property : req->property()) {
+            std::string name = property.name();
+            std::string value = property.value();
+            property_value_map[name] = value;
+        }
         status = exp->Devices()->SetProperty(property_value_map);
     } catch (std::exception &e) {
         return grpc::Status(grpc::StatusCode::INTERNAL,
@@ -190,8 +351,7 @@ grpc::Status APIServer::WaitProperty(ServerContext *context,
                                      const api::WaitPropertyRequest *req,
                                      google::protobuf::Empty *resp)
 {
-    std::vector<PropertyPath> propertyList(req->name().begin(),
-                                           req->name().end());
+    utils::TraceSpan span("api", __func__);
     std::chrono::nanoseconds timeout;
     timeout = std::chrono::seconds(req->timeout().seconds()) +
               std::chrono::nanoseconds(req->timeout().nanos());
@@ -201,6 +361,8 @@ grpc::Status APIServer::WaitProperty(ServerContext *context,
 
     absl::Status status;
     try {
+        std::vector<PropertyPath> propertyList(req->name().begin(),
+                                               req->name().end());
         status = exp->Devices()->WaitPropertyFor(
             propertyList,
             std::chrono::duration_cast<std::chrono::milliseconds>(timeout));
@@ -219,6 +381,7 @@ grpc::Status APIServer::ListProperty(ServerContext *context,
                                      const api::ListPropertyRequest *req,
                                      api::ListPropertyResponse *resp)
 {
+    utils::TraceSpan span("api", __func__);
     std::string name = req->name();
     std::vector<PropertyPath> property_list;
 
@@ -239,6 +402,7 @@ grpc::Status APIServer::ListChannel(ServerContext *context,
                                     const protobuf::Empty *req,
                                     api::ListChannelResponse *resp)
 {
+    utils::TraceSpan span("api", __func__);
     std::vector<std::string> preset_names = exp->Channels()->ListPresetNames();
 
     for (const auto &preset_name : preset_names) {
@@ -258,6 +422,7 @@ grpc::Status APIServer::SwitchChannel(ServerContext *context,
                                       const ::api::SwitchChannelRequest *req,
                                       protobuf::Empty *resp)
 {
+    utils::TraceSpan span("api", __func__);
     try {
         exp->Channels()->SwitchChannel(req->channel().preset_name(),
                                        req->channel().exposure_ms(),
@@ -273,6 +438,7 @@ grpc::Status APIServer::OpenExperiment(ServerContext *context,
                                        const api::OpenExperimentRequest *req,
                                        google::protobuf::Empty *resp)
 {
+    utils::TraceSpan span("api", __func__);
     try {
         if (req->has_base_dir()) {
             exp->SetBaseDir(req->base_dir());
@@ -289,6 +455,7 @@ grpc::Status APIServer::ListPlate(ServerContext *context,
                                   const google::protobuf::Empty *req,
                                   api::ListPlateResponse *resp)
 {
+    utils::TraceSpan span("api", __func__);
     try {
         for (const auto &plate : exp->Samples()->Plates()) {
             auto plate_pb = resp->add_plate();
@@ -335,6 +502,7 @@ grpc::Status APIServer::AddPlate(ServerContext *context,
                                  const api::AddPlateRequest *req,
                                  protobuf::Empty *resp)
 {
+    utils::TraceSpan span("api", __func__);
     try {
         exp->Samples()->AddPlate(PlateTypeFromPB(req->plate_type()),
                                  req->plate_id());
@@ -350,6 +518,7 @@ APIServer::SetPlatePositionOrigin(ServerContext *context,
                                   const api::SetPlatePositionOriginRequest *req,
                                   google::protobuf::Empty *resp)
 {
+    utils::TraceSpan span("api", __func__);
     try {
         Plate *plate = exp->Samples()->PlateByUUID(req->plate_uuid());
         if (plate == nullptr) {
@@ -370,6 +539,7 @@ APIServer::SetPlateMetadata(ServerContext *context,
                             const api::SetPlateMetadataRequest *req,
                             google::protobuf::Empty *resp)
 {
+    utils::TraceSpan span("api", __func__);
     try {
         Plate *plate = exp->Samples()->PlateByUUID(req->plate_uuid());
         if (plate == nullptr) {
@@ -390,6 +560,7 @@ grpc::Status APIServer::SetWellsEnabled(ServerContext *context,
                                         const api::SetWellsEnabledRequest *req,
                                         google::protobuf::Empty *resp)
 {
+    utils::TraceSpan span("api", __func__);
     try {
         Plate *plate = exp->Samples()->PlateByUUID(req->plate_uuid());
         if (plate == nullptr) {
@@ -414,6 +585,7 @@ APIServer::SetWellsMetadata(ServerContext *context,
                             const api::SetWellsMetadataRequest *req,
                             google::protobuf::Empty *resp)
 {
+    utils::TraceSpan span("api", __func__);
     try {
         Plate *plate = exp->Samples()->PlateByUUID(req->plate_uuid());
         if (plate == nullptr) {
@@ -438,6 +610,7 @@ grpc::Status APIServer::CreateSites(ServerContext *context,
                                     const api::CreateSitesRequest *req,
                                     google::protobuf::Empty *resp)
 {
+    utils::TraceSpan span("api", __func__);
     try {
         Plate *plate = exp->Samples()->PlateByUUID(req->plate_uuid());
         if (plate == nullptr) {
@@ -459,11 +632,119 @@ grpc::Status APIServer::CreateSites(ServerContext *context,
     return grpc::Status::OK;
 }
 
+grpc::Status APIServer::SetFocusPoint(ServerContext *context,
+                                      const api::SetFocusPointRequest *req,
+                                      google::protobuf::Empty *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    try {
+        Plate *plate = exp->Samples()->PlateByUUID(req->plate_uuid());
+        if (plate == nullptr) {
+            return grpc::Status(
+                grpc::StatusCode::NOT_FOUND,
+                fmt::format("plate '{}' not found", req->plate_uuid()));
+        }
+        exp->Samples()->SetFocusPoint(plate->ID(), req->well_id(), req->x(),
+                                      req->y(), req->z());
+    } catch (std::exception &e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL,
+                            fmt::format("unexpected exception: {}", e.what()));
+    }
+    return grpc::Status::OK;
+}
+
+grpc::Status APIServer::ClearFocusMap(ServerContext *context,
+                                      const api::ClearFocusMapRequest *req,
+                                      google::protobuf::Empty *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    try {
+        Plate *plate = exp->Samples()->PlateByUUID(req->plate_uuid());
+        if (plate == nullptr) {
+            return grpc::Status(
+                grpc::StatusCode::NOT_FOUND,
+                fmt::format("plate '{}' not found", req->plate_uuid()));
+        }
+        exp->Samples()->ClearFocusMap(plate->ID());
+    } catch (std::exception &e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL,
+                            fmt::format("unexpected exception: {}", e.what()));
+    }
+    return grpc::Status::OK;
+}
+
+grpc::Status
+APIServer::SetFocusSurfaceModel(ServerContext *context,
+                                const api::SetFocusSurfaceModelRequest *req,
+                                google::protobuf::Empty *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    FocusSurfaceModel model;
+    try {
+        model = FocusSurfaceModelFromString(req->model());
+    } catch (std::exception &e) {
+        return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, e.what());
+    }
+    try {
+        Plate *plate = exp->Samples()->PlateByUUID(req->plate_uuid());
+        if (plate == nullptr) {
+            return grpc::Status(
+                grpc::StatusCode::NOT_FOUND,
+                fmt::format("plate '{}' not found", req->plate_uuid()));
+        }
+        exp->Samples()->SetFocusSurfaceModel(plate->ID(), model);
+    } catch (std::exception &e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL,
+                            fmt::format("unexpected exception: {}", e.what()));
+    }
+    return grpc::Status::OK;
+}
+
+grpc::Status APIServer::GetFocusMap(ServerContext *context,
+                                    const api::GetFocusMapRequest *req,
+                                    api::GetFocusMapResponse *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    try {
+        Plate *plate = exp->Samples()->PlateByUUID(req->plate_uuid());
+        if (plate == nullptr) {
+            return grpc::Status(
+                grpc::StatusCode::NOT_FOUND,
+                fmt::format("plate '{}' not found", req->plate_uuid()));
+        }
+        resp->set_model(FocusSurfaceModelToString(
+            exp->Samples()->FocusMapModel(plate->ID())));
+        for (const auto &point : exp->Samples()->FocusPoints(plate->ID())) {
+            auto pb_point = resp->add_point();
+            pb_point->set_well_id(point.well_id);
+            pb_point->set_x(point.x);
+            pb_point->set_y(point.y);
+            pb_point->set_z(point.z);
+        }
+        for (const auto &well : plate->EnabledWells()) {
+            for (const auto &site : well->Sites()) {
+                std::optional<double> z = exp->Samples()->PredictFocusZ(site);
+                if (!z.has_value()) {
+                    continue;
+                }
+                auto pb_site_focus = resp->add_site_focus();
+                pb_site_focus->set_site_uuid(site->UUID());
+                pb_site_focus->set_z(z.value());
+            }
+        }
+    } catch (std::exception &e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL,
+                            fmt::format("unexpected exception: {}", e.what()));
+    }
+    return grpc::Status::OK;
+}
+
 grpc::Status
 APIServer::AcquireMultiChannel(ServerContext *context,
                                const api::AcquireMultiChannelRequest *req,
                                protobuf::Empty *resp)
 {
+    utils::TraceSpan span("api", __func__);
     nlohmann::ordered_json metadata(req->metadata());
     std::vector<Channel> channels;
     for (const auto &ch : req->channels()) {
@@ -493,10 +774,418 @@ APIServer::AcquireMultiChannel(ServerContext *context,
     return grpc::Status::OK;
 }
 
+grpc::Status APIServer::AcquireZStack(ServerContext *context,
+                                      const api::AcquireZStackRequest *req,
+                                      protobuf::Empty *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    nlohmann::ordered_json metadata(req->metadata());
+    std::vector<Channel> channels;
+    for (const auto &ch : req->channels()) {
+        channels.push_back(ChannelFromPB(ch));
+    }
+    ZStackParams params;
+    if (req->has_z_center()) {
+        params.z_center = req->z_center();
+    }
+    if (req->step_um() != 0) {
+        params.step_um = req->step_um();
+    }
+    if (req->n_z() != 0) {
+        params.n_z = req->n_z();
+    }
+    switch (req->order()) {
+    case api::ZStackOrder::CHANNELS_PER_PLANE:
+        params.order = ZStackOrder::ChannelsPerPlane;
+        break;
+    case api::ZStackOrder::PLANES_PER_CHANNEL:
+        params.order = ZStackOrder::PlanesPerChannel;
+        break;
+    default:
+        return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                            "invalid z-stack order");
+    }
+    params.max_projection = req->max_projection();
+    params.mean_projection = req->mean_projection();
+    try {
+        Site *site = nullptr;
+        if (!req->site_uuid().empty()) {
+            site = exp->Samples()->SiteByUUID(req->site_uuid());
+            if (site == nullptr) {
+                return grpc::Status(
+                    grpc::StatusCode::NOT_FOUND,
+                    fmt::format("site '{}' not found", req->site_uuid()));
+            }
+        }
+        exp->AcquireZStack(req->ndimage_name(), channels, params, req->i_t(),
+                           site, metadata);
+        exp->WaitZStack();
+    } catch (std::exception &e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL,
+                            fmt::format("unexpected exception: {}", e.what()));
+    }
+    return grpc::Status::OK;
+}
+
+grpc::Status APIServer::Autofocus(ServerContext *context,
+                                  const api::AutofocusRequest *req,
+                                  api::AutofocusResponse *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    try {
+        AutofocusResult result = exp->Autofocus(ChannelFromPB(req->channel()),
+                                                AutofocusParamsFromPB(*req));
+        resp->set_z(result.z);
+        resp->set_score(result.score);
+        resp->set_n_frames(result.n_frames);
+    } catch (std::exception &e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL,
+                            fmt::format("unexpected exception: {}", e.what()));
+    }
+    return grpc::Status::OK;
+}
+
+grpc::Status APIServer::PlanScan(ServerContext *context,
+                                 const api::StartScanRequest *req,
+                                 api::PlanScanResponse *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    try {
+        Plate *plate = exp->Samples()->PlateByUUID(req->plate_uuid());
+        if (plate == nullptr) {
+            return grpc::Status(
+                grpc::StatusCode::NOT_FOUND,
+                fmt::format("plate '{}' not found", req->plate_uuid()));
+        }
+
+        SitePath path = exp->PlanScan(ScanPlanFromPB(*req, plate));
+        resp->set_travel_um(path.travel_um);
+        resp->set_travel_s(path.travel_s);
+        for (const auto &site : path.sites) {
+            resp->add_site_uuid(site->UUID());
+        }
+    } catch (std::invalid_argument &e) {
+        return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, e.what());
+    } catch (std::exception &e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL,
+                            fmt::format("unexpected exception: {}", e.what()));
+    }
+    return grpc::Status::OK;
+}
+
+grpc::Status APIServer::StartScan(ServerContext *context,
+                                  const api::StartScanRequest *req,
+                                  protobuf::Empty *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    try {
+        Plate *plate = exp->Samples()->PlateByUUID(req->plate_uuid());
+        if (plate == nullptr) {
+            return grpc::Status(
+                grpc::StatusCode::NOT_FOUND,
+                fmt::format("plate '{}' not found", req->plate_uuid()));
+        }
+
+        exp->StartScan(ScanPlanFromPB(*req, plate));
+    } catch (std::invalid_argument &e) {
+        return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, e.what());
+    } catch (std::exception &e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL,
+                            fmt::format("unexpected exception: {}", e.what()));
+    }
+    return grpc::Status::OK;
+}
+
+grpc::Status APIServer::PauseScan(ServerContext *context,
+                                  const protobuf::Empty *req,
+                                  protobuf::Empty *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    exp->PauseScan();
+    return grpc::Status::OK;
+}
+
+grpc::Status APIServer::ResumeScan(ServerContext *context,
+                                   const protobuf::Empty *req,
+                                   protobuf::Empty *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    exp->ResumeScan();
+    return grpc::Status::OK;
+}
+
+grpc::Status APIServer::StopScan(ServerContext *context,
+                                 const protobuf::Empty *req,
+                                 protobuf::Empty *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    exp->StopScan();
+    return grpc::Status::OK;
+}
+
+grpc::Status
+APIServer::WatchScan(ServerContext *context, const protobuf::Empty *req,
+                     grpc::ServerWriter<api::ScanProgress> *writer)
+{
+    utils::TraceSpan span("api", __func__);
+    ScanProgress progress = exp->GetScanProgress();
+    for (;;) {
+        api::ScanProgress pb_progress;
+        pb_progress.set_state(ScanStateToString(progress.state));
+        pb_progress.set_n_sites_total(progress.n_sites_total);
+        pb_progress.set_n_sites_done(progress.n_sites_done);
+        pb_progress.set_n_wells_total(progress.n_wells_total);
+        pb_progress.set_n_wells_done(progress.n_wells_done);
+        pb_progress.set_well_id(progress.well_id);
+        pb_progress.set_site_id(progress.site_id);
+        pb_progress.set_elapsed_s(progress.elapsed_s);
+        pb_progress.set_remaining_s(progress.remaining_s);
+        pb_progress.set_message(progress.message);
+        pb_progress.set_predicted_travel_um(progress.predicted_travel_um);
+        pb_progress.set_predicted_travel_s(progress.predicted_travel_s);
+        if (!writer->Write(pb_progress)) {
+            return grpc::Status::OK;
+        }
+
+        if ((progress.state != ScanState::Running) &&
+            (progress.state != ScanState::Paused))
+        {
+            return grpc::Status::OK;
+        }
+
+        // Wake up regularly to notice cancelled clients
+        uint64_t seq = progress.seq;
+        do {
+            if (context->IsCancelled()) {
+                return grpc::Status::CANCELLED;
+            }
+            progress =
+                exp->WaitScanProgress(seq, std::chrono::milliseconds(500));
+        } while (progress.seq == seq);
+    }
+}
+
+grpc::Status APIServer::StartTimelapse(ServerContext *context,
+                                       const api::StartTimelapseRequest *req,
+                                       protobuf::Empty *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    try {
+        std::vector<TimelapseGroup> groups;
+        for (const auto &pb_group : req->groups()) {
+            Plate *plate =
+                exp->Samples()->PlateByUUID(pb_group.scan().plate_uuid());
+            if (plate == nullptr) {
+                return grpc::Status(grpc::StatusCode::NOT_FOUND,
+                                    fmt::format("plate '{}' not found",
+                                                pb_group.scan().plate_uuid()));
+            }
+            groups.push_back(TimelapseGroup{
+                .name = pb_group.name(),
+                .plan = ScanPlanFromPB(pb_group.scan(), plate),
+                .interval_s = pb_group.interval_s(),
+                .n_rounds = pb_group.n_rounds(),
+                .start_offset_s = pb_group.start_offset_s(),
+            });
+        }
+
+        OverrunPolicy policy;
+        switch (req->overrun_policy()) {
+        case api::OverrunPolicy::SKIP:
+            policy = OverrunPolicy::Skip;
+            break;
+        case api::OverrunPolicy::COMPRESS:
+            policy = OverrunPolicy::Compress;
+            break;
+        default:
+            return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                                "invalid overrun policy");
+        }
+
+        exp->StartTimelapse(groups, policy);
+    } catch (std::invalid_argument &e) {
+        return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, e.what());
+    } catch (std::exception &e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL,
+                            fmt::format("unexpected exception: {}", e.what()));
+    }
+    return grpc::Status::OK;
+}
+
+grpc::Status APIServer::StopTimelapse(ServerContext *context,
+                                      const protobuf::Empty *req,
+                                      protobuf::Empty *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    exp->StopTimelapse();
+    return grpc::Status::OK;
+}
+
+grpc::Status APIServer::GetTimelapseStatus(ServerContext *context,
+                                           const protobuf::Empty *req,
+                                           api::TimelapseStatus *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    TimelapseStatus status = exp->GetTimelapseStatus();
+    resp->set_running(status.running);
+    resp->set_elapsed_s(status.elapsed_s);
+    resp->set_busy_s(status.busy_s);
+    resp->set_utilization(status.utilization);
+    resp->set_message(status.message);
+    for (const auto &group : status.groups) {
+        api::TimelapseGroupStatus *pb_group = resp->add_groups();
+        pb_group->set_name(group.name);
+        pb_group->set_interval_s(group.interval_s);
+        pb_group->set_n_rounds_done(group.n_rounds_done);
+        pb_group->set_n_rounds_skipped(group.n_rounds_skipped);
+        pb_group->set_n_rounds_failed(group.n_rounds_failed);
+        pb_group->set_mean_round_s(group.mean_round_s);
+        pb_group->set_max_round_s(group.max_round_s);
+        pb_group->set_mean_late_s(group.mean_late_s);
+        pb_group->set_max_late_s(group.max_late_s);
+        if (group.next_round_in_s.has_value()) {
+            pb_group->set_next_round_in_s(group.next_round_in_s.value());
+        }
+    }
+    return grpc::Status::OK;
+}
+
+grpc::Status
+APIServer::StartLiveRecording(ServerContext *context,
+                              const api::StartLiveRecordingRequest *req,
+                              protobuf::Empty *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    std::string ch_name = req->ch_name().empty() ? "Live" : req->ch_name();
+    try {
+        exp->StartLiveRecording(req->name(), req->duration_s(), ch_name);
+    } catch (std::invalid_argument &e) {
+        return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, e.what());
+    } catch (std::exception &e) {
+        return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION, e.what());
+    }
+    return grpc::Status::OK;
+}
+
+grpc::Status APIServer::StopLiveRecording(ServerContext *context,
+                                          const protobuf::Empty *req,
+                                          api::LiveRecordingStats *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    try {
+        LiveRecordingStatsToPB(exp->StopLiveRecording(), resp);
+    } catch (std::exception &e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL,
+                            fmt::format("unexpected exception: {}", e.what()));
+    }
+    return grpc::Status::OK;
+}
+
+grpc::Status APIServer::GetLiveRecordingStats(ServerContext *context,
+                                              const protobuf::Empty *req,
+                                              api::LiveRecordingStats *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    std::optional<LiveRecordingStats> stats = exp->GetLiveRecordingStats();
+    if (!stats.has_value()) {
+        return grpc::Status(grpc::StatusCode::NOT_FOUND, "no recording");
+    }
+    LiveRecordingStatsToPB(stats.value(), resp);
+    return grpc::Status::OK;
+}
+
+grpc::Status
+APIServer::ImportLiveRecording(ServerContext *context,
+                               const api::ImportLiveRecordingRequest *req,
+                               protobuf::Empty *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    try {
+        exp->ImportLiveRecording(req->name(), req->ndimage_name());
+    } catch (std::invalid_argument &e) {
+        return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, e.what());
+    } catch (std::exception &e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL,
+                            fmt::format("unexpected exception: {}", e.what()));
+    }
+    return grpc::Status::OK;
+}
+
+grpc::Status
+APIServer::WatchLiveFrames(ServerContext *context,
+                           const api::WatchLiveFramesRequest *req,
+                           grpc::ServerWriter<api::LiveFrame> *writer)
+{
+    utils::TraceSpan span("api", __func__);
+    LiveFrameBuffer *live_frames = exp->Images()->LiveFrames();
+    LiveReadMode mode =
+        req->every_frame() ? LiveReadMode::EveryFrame : LiveReadMode::Latest;
+    int consumer_id =
+        live_frames->Subscribe(fmt::format("api {}", context->peer()), mode);
+
+    grpc::Status status = grpc::Status::OK;
+    try {
+        for (;;) {
+            // Wake up regularly to notice cancelled clients
+            if (context->IsCancelled()) {
+                status = grpc::Status::CANCELLED;
+                break;
+            }
+            std::optional<ImageData> frame = live_frames->NextFor(
+                consumer_id, std::chrono::milliseconds(500));
+            if (!frame.has_value()) {
+                continue;
+            }
+            // End of the live stream
+            if (frame->empty()) {
+                break;
+            }
+
+            api::LiveFrame pb_frame;
+            pb_frame.mutable_data()->set_width(frame->Width());
+            pb_frame.mutable_data()->set_height(frame->Height());
+            pb_frame.mutable_data()->set_dtype(
+                DataTypeToPB(frame->DataType()));
+            pb_frame.mutable_data()->set_ctype(
+                ColorTypeToPB(frame->ColorType()));
+            pb_frame.mutable_data()->set_buf(frame->Buf().get(),
+                                             frame->BufSize());
+            pb_frame.set_n_dropped(live_frames->Stats(consumer_id).n_dropped);
+            if (!writer->Write(pb_frame)) {
+                break;
+            }
+        }
+    } catch (std::exception &e) {
+        status = grpc::Status(
+            grpc::StatusCode::INTERNAL,
+            fmt::format("unexpected exception: {}", e.what()));
+    }
+    live_frames->Unsubscribe(consumer_id);
+    return status;
+}
+
+grpc::Status APIServer::GetLiveFrameStats(ServerContext *context,
+                                          const protobuf::Empty *req,
+                                          api::LiveFrameStats *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    LiveFrameBuffer *live_frames = exp->Images()->LiveFrames();
+    resp->set_n_published(live_frames->NumPublished());
+    for (const auto &stats : live_frames->Stats()) {
+        auto pb_stats = resp->add_consumer();
+        pb_stats->set_name(stats.name);
+        pb_stats->set_mode(LiveReadModeToString(stats.mode));
+        pb_stats->set_n_read(stats.n_read);
+        pb_stats->set_n_dropped(stats.n_dropped);
+    }
+    return grpc::Status::OK;
+}
+
 grpc::Status APIServer::ListNDImage(ServerContext *context,
                                     const google::protobuf::Empty *req,
                                     api::ListNDImageResponse *resp)
 {
+    utils::TraceSpan span("api", __func__);
     try {
         auto ndimage_list = exp->Images()->ListNDImage();
         for (const auto &im : ndimage_list) {
@@ -524,6 +1213,7 @@ grpc::Status APIServer::GetNDImage(ServerContext *context,
                                    const api::GetNDImageRequest *req,
                                    api::GetNDImageResponse *resp)
 {
+    utils::TraceSpan span("api", __func__);
     try {
         NDImage *im = exp->Images()->GetNDImage(req->ndimage_name());
         if (im == nullptr) {
@@ -555,6 +1245,7 @@ grpc::Status APIServer::GetImageData(ServerContext *context,
                                      const api::GetImageDataRequest *req,
                                      api::GetImageDataResponse *resp)
 {
+    utils::TraceSpan span("api", __func__);
     try {
         NDImage *ndimage = exp->Images()->GetNDImage(req->ndimage_name());
         if (ndimage == nullptr) {
@@ -592,6 +1283,7 @@ APIServer::GetSegmentationScore(ServerContext *context,
                                 const api::GetSegmentationScoreRequest *req,
                                 api::GetSegmentationScoreResponse *resp)
 {
+    utils::TraceSpan span("api", __func__);
     xt::xarray<float> score;
     try {
         score = exp->Analysis()->GetSegmentationScore(
@@ -613,6 +1305,7 @@ grpc::Status APIServer::QuantifyRegions(ServerContext *context,
                                         const api::QuantifyRegionsRequest *req,
                                         api::QuantifyRegionsResponse *resp)
 {
+    utils::TraceSpan span("api", __func__);
     int n_regions;
     QuantificationResults results;
     try {
@@ -653,6 +1346,16 @@ grpc::Status APIServer::QuantifyRegions(ServerContext *context,
                 pb_ch->add_values(mean_intensity[i]);
             }
         }
+        for (int i_ch = 0; i_ch < results.corrected_ch_names.size(); i_ch++) {
+            xt::xarray<double> mean_intensity =
+                results.corrected_intensity_mean[i_ch];
+
+            auto pb_ch = resp->add_corrected_intensity();
+            pb_ch->set_ch_name(results.corrected_ch_names[i_ch]);
+            for (int i = 0; i < n_regions; i++) {
+                pb_ch->add_values(mean_intensity[i]);
+            }
+        }
     } catch (std::exception &e) {
         return grpc::Status(grpc::StatusCode::INTERNAL,
                             fmt::format("unexpected exception: {}", e.what()));
@@ -666,6 +1369,7 @@ APIServer::GetQuantification(ServerContext *context,
                              const api::GetQuantificationRequest *req,
                              api::GetQuantificationResponse *resp)
 {
+    utils::TraceSpan span("api", __func__);
     try {
         QuantificationResults results =
             exp->Analysis()->GetQuantification(req->ndimage_name(), req->i_t());
@@ -692,10 +1396,115 @@ APIServer::GetQuantification(ServerContext *context,
                 pb_ch->add_values(mean_intensity[i]);
             }
         }
+        for (int i_ch = 0; i_ch < results.corrected_ch_names.size(); i_ch++) {
+            xt::xarray<double> mean_intensity =
+                results.corrected_intensity_mean[i_ch];
+
+            auto pb_ch = resp->add_corrected_intensity();
+            pb_ch->set_ch_name(results.corrected_ch_names[i_ch]);
+            for (int i = 0; i < mean_intensity.shape(0); i++) {
+                pb_ch->add_values(mean_intensity[i]);
+            }
+        }
     } catch (std::exception &e) {
         return grpc::Status(grpc::StatusCode::INTERNAL,
                             fmt::format("unexpected exception: {}", e.what()));
     }
 
     return grpc::Status::OK;
-}
\ No newline at end of file
+}
+
+grpc::Status APIServer::GetCellTable(ServerContext *context,
+                                     const api::GetCellTableRequest *req,
+                                     api::GetCellTableResponse *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    try {
+        StructArray cells;
+        if (!req->ndimage_name().empty()) {
+            cells = exp->Analysis()->ReadCellTable(req->ndimage_name(),
+                                                   req->i_t());
+        } else {
+            cells = exp->Analysis()->ReadCellTable(req->plate_id());
+        }
+
+        for (const auto &field : cells.Fields()) {
+            auto pb_field = resp->add_field();
+            pb_field->set_name(field.name);
+            pb_field->set_dtype(DtypeName(field.dtype));
+            pb_field->set_offset(field.offset);
+        }
+        resp->set_itemsize(cells.ItemSize());
+        resp->set_n_rows(cells.Size());
+        resp->set_buf(cells.Data(), cells.ItemSize() * cells.Size());
+    } catch (std::invalid_argument &e) {
+        return grpc::Status(grpc::StatusCode::NOT_FOUND, e.what());
+    } catch (std::exception &e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL,
+                            fmt::format("unexpected exception: {}", e.what()));
+    }
+    return grpc::Status::OK;
+}
+
+grpc::Status
+APIServer::BuildCorrectionMap(ServerContext *context,
+                              const api::BuildCorrectionMapRequest *req,
+                              google::protobuf::Empty *resp)
+{
+    utils::TraceSpan span("api", __func__);
+    CorrectionMapType type;
+    switch (req->type()) {
+    case api::CorrectionMapType::DARK:
+        type = CorrectionMapType::Dark;
+        break;
+    case api::CorrectionMapType::FLAT:
+        type = CorrectionMapType::Flat;
+        break;
+    default:
+        return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                            "invalid correction map type");
+    }
+
+    CorrectionStatistic stat;
+    switch (req->statistic()) {
+    case api::CorrectionStatistic::MEDIAN:
+        stat = CorrectionStatistic::Median;
+        break;
+    case api::CorrectionStatistic::MEAN:
+        stat = CorrectionStatistic::Mean;
+        break;
+    default:
+        return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                            "invalid correction statistic");
+    }
+
+    try {
+        exp->Images()->BuildCorrectionMap(type, req->ch_name(),
+                                          req->ndimage_name(),
+                                          req->calib_ch(), stat);
+    } catch (std::exception &e) {
+        return grpc::Status(grpc::StatusCode::INTERNAL,
+                            fmt::format("unexpected exception: {}", e.what()));
+    }
+
+    return grpc::Status::OK;
+}
+
+grpc::Status APIServer::GetSpanStats(ServerContext *context,
+                                     const protobuf::Empty *req,
+                                     api::GetSpanStatsResponse *resp)
+{
+    for (const auto &stats : utils::GetSpanStats()) {
+        api::SpanStats *pb_stats = resp->add_span();
+        pb_stats->set_name(stats.name);
+        pb_stats->set_count(stats.count);
+        pb_stats->set_p50_ms(stats.p50_ms);
+        pb_stats->set_p90_ms(stats.p90_ms);
+        pb_stats->set_p99_ms(stats.p99_ms);
+        pb_stats->set_max_ms(stats.max_ms);
+        for (uint64_t n : stats.histogram) {
+            pb_stats->add_histogram(n);
+        }
+    }
+    return grpc::Status::OK;
+}
@@ -71,11 +71,74 @@ public:
     grpc::Status CreateSites(ServerContext *context,
                              const api::CreateSitesRequest *req,
                              google::protobuf::Empty *resp) override;
+    grpc::Status SetFocusPoint(ServerContext *context,
+                               const api::SetFocusPointRequest *req,
+                               google::protobuf::Empty *resp) override;
+    grpc::Status ClearFocusMap(ServerContext *context,
+                               const api::ClearFocusMapRequest *req,
+                               google::protobuf::Empty *resp) override;
+    grpc::Status
+    SetFocusSurfaceModel(ServerContext *context,
+                         const api::SetFocusSurfaceModelRequest *req,
+                         google::protobuf::Empty *resp) override;
+    grpc::Status GetFocusMap(ServerContext *context,
+                             const api::GetFocusMapRequest *req,
+                             api::GetFocusMapResponse *resp) override;
 
     // Task
     grpc::Status AcquireMultiChannel(ServerContext *context,
                                      const api::AcquireMultiChannelRequest *req,
                                      protobuf::Empty *resp) override;
+    grpc::Status AcquireZStack(ServerContext *context,
+                               const api::AcquireZStackRequest *req,
+                               protobuf::Empty *resp) override;
+    grpc::Status Autofocus(ServerContext *context,
+                           const api::AutofocusRequest *req,
+                           api::AutofocusResponse *resp) override;
+    grpc::Status PlanScan(ServerContext *context,
+                          const api::StartScanRequest *req,
+                          api::PlanScanResponse *resp) override;
+    grpc::Status StartScan(ServerContext *context,
+                           const api::StartScanRequest *req,
+                           protobuf::Empty *resp) override;
+    grpc::Status PauseScan(ServerContext *context, const protobuf::Empty *req,
+                           protobuf::Empty *resp) override;
+    grpc::Status ResumeScan(ServerContext *context, const protobuf::Empty *req,
+                            protobuf::Empty *resp) override;
+    grpc::Status StopScan(ServerContext *context, const protobuf::Empty *req,
+                          protobuf::Empty *resp) override;
+    grpc::Status
+    WatchScan(ServerContext *context, const protobuf::Empty *req,
+              grpc::ServerWriter<api::ScanProgress> *writer) override;
+    grpc::Status StartTimelapse(ServerContext *context,
+                                const api::StartTimelapseRequest *req,
+                                protobuf::Empty *resp) override;
+    grpc::Status StopTimelapse(ServerContext *context,
+                               const protobuf::Empty *req,
+                               protobuf::Empty *resp) override;
+    grpc::Status GetTimelapseStatus(ServerContext *context,
+                                    const protobuf::Empty *req,
+                                    api::TimelapseStatus *resp) override;
+    grpc::Status StartLiveRecording(ServerContext *context,
+                                    const api::StartLiveRecordingRequest *req,
+                                    protobuf::Empty *resp) override;
+    grpc::Status StopLiveRecording(ServerContext *context,
+                                   const protobuf::Empty *req,
+                                   api::LiveRecordingStats *resp) override;
+    grpc::Status GetLiveRecordingStats(ServerContext *context,
+                                       const protobuf::Empty *req,
+                                       api::LiveRecordingStats *resp) override;
+    grpc::Status
+    ImportLiveRecording(ServerContext *context,
+                        const api::ImportLiveRecordingRequest *req,
+                        protobuf::Empty *resp) override;
+    grpc::Status
+    WatchLiveFrames(ServerContext *context,
+                    const api::WatchLiveFramesRequest *req,
+                    grpc::ServerWriter<api::LiveFrame> *writer) override;
+    grpc::Status GetLiveFrameStats(ServerContext *context,
+                                   const protobuf::Empty *req,
+                                   api::LiveFrameStats *resp) override;
     // Data
     grpc::Status ListNDImage(ServerContext *context,
                              const google::protobuf::Empty *req,
@@ -102,6 +165,20 @@ public:
                       const api::GetQuantificationRequest *req,
                       api::GetQuantificationResponse *resp) override;
 
+    grpc::Status GetCellTable(ServerContext *context,
+                              const api::GetCellTableRequest *req,
+                              api::GetCellTableResponse *resp) override;
+
+    grpc::Status
+    BuildCorrectionMap(ServerContext *context,
+                       const api::BuildCorrectionMapRequest *req,
+                       google::protobuf::Empty *resp) override;
+
+    // Diagnostics
+    grpc::Status GetSpanStats(ServerContext *context,
+                              const protobuf::Empty *req,
+                              api::GetSpanStatsResponse *resp) override;
+
 private:
     std::shared_ptr<grpc::Server> server;
 
@@ -0,0 +1,152 @@
+#include "app.h"
+
+#include <cstdlib>
+#include <filesystem>
+
+#include <fmt/format.h>
+
+#include "config.h"
+#include "logging.h"
+#include "utils/time_utils.h"
+
+#ifdef NIKONTICTRL_VENDOR_DEVICES
+#include "device/flir/flir_spinnaker.h"
+#include "device/hamamatsu/hamamatsu_dcam.h"
+#include "device/nikon/nikon_ti.h"
+#include "device/prior/prior_proscan.h"
+#endif
+
+void initLogger()
+{
+    slog::InitConsole();
+
+    // Write logs to folder
+    // C:\Users\<username>\AppData\Local\NikonTiCtrl
+    char *local_app_data_env = std::getenv("LOCALAPPDATA");
+    if (local_app_data_env != NULL) {
+        std::filesystem::path log_folder =
+            std::filesystem::path(local_app_data_env) / "NikonTiCtrl";
+        if (!std::filesystem::exists(log_folder)) {
+            std::filesystem::create_directory(log_folder);
+        }
+        std::string filename = fmt::format("NikonTiCtrl-{:%Y%m%d-%H%M%S}.log",
+                                           utils::Now().Local());
+        std::filesystem::path log_path = log_folder / filename;
+        slog::DefaultLogger().SetFilename(log_path);
+        LOG_INFO("Writing log to {}", log_path.string());
+    } else {
+        LOG_ERROR("Failed to get LOCALAPPDATA path from environment variables. "
+                  "Log is not written to a file.");
+    }
+}
+
+bool loadConfig()
+{
+    try {
+        std::filesystem::path systemConfigPath = getSystemConfigPath();
+        if (!std::filesystem::exists(systemConfigPath)) {
+            LOG_FATAL("Cannot find config file at {}",
+                      systemConfigPath.string());
+            return false;
+        }
+        loadSystemConfig(systemConfigPath);
+        LOG_INFO("  System config loaded from {}", systemConfigPath.string());
+
+        std::filesystem::path userConfigPath = getUserConfigPath();
+        if (!std::filesystem::exists(userConfigPath)) {
+            createDefaultUserConfig(userConfigPath);
+            LOG_WARN("  User config not found. Default config is created.");
+        }
+        loadUserConfig(userConfigPath);
+        LOG_INFO("  User config loaded from {}", userConfigPath.string());
+
+    } catch (std::exception &e) {
+        LOG_FATAL("Failed to load config: {}", e.what());
+        return false;
+    }
+
+    LOG_INFO("Current user: {}<{}>", config.user.name, config.user.email);
+    return true;
+}
+
+void addDevices(DeviceHub &dev)
+{
+    try {
+        if (config.system.simulation.has_value()) {
+            LOG_WARN("Using simulated devices");
+            dev.AddSimulatedDevices(config.system.simulation.value());
+        } else {
+#ifdef NIKONTICTRL_VENDOR_DEVICES
+            dev.AddDevice("NikonTi", new NikonTi::Microscope);
+            dev.AddDevice("PriorProScan",
+                          new PriorProscan::Proscan("ASRL1::INSTR"));
+            dev.AddCamera("Hamamatsu", new Hamamatsu::DCam);
+            // dev.AddDevice("FLIR", new FLIR::Camera);
+#else
+            LOG_ERROR("Built without vendor device drivers. "
+                      "Set system.simulation in the config to use simulated "
+                      "devices.");
+#endif
+        }
+    } catch (std::exception &e) {
+        LOG_ERROR("Failed to add device: {}", e.what());
+    }
+}
+
+void connectDevices(DeviceHub &dev)
+{
+    absl::Status status = dev.ConnectAll();
+    if (!status.ok()) {
+        LOG_ERROR("Connect: {}", status.ToString());
+    } else {
+        LOG_INFO("All connected");
+    }
+
+    // Init properties
+    if (dev.GetCamera() == nullptr) {
+        return;
+    }
+    status = dev.SetProperty("/Hamamatsu/BIT PER CHANNEL", "16");
+    if (!status.ok()) {
+        LOG_ERROR("Init device properties: {}", status.ToString());
+    } else {
+        LOG_INFO("Device initialized");
+    }
+}
+
+void disconnectDevices(DeviceHub &dev)
+{
+    LOG_INFO("Disconnecting devices...");
+    absl::Status status = dev.DisconnectAll();
+    if (!status.ok()) {
+        LOG_ERROR("Disconnect: {}", status.ToString());
+    } else {
+        LOG_INFO("All disconnected");
+    }
+    LOG_INFO("Disconnected");
+}
+
+void printEvents(EventStream *stream)
+{
+    Event e;
+    while (stream->Receive(&e)) {
+        switch (e.type) {
+        case EventType::DeviceConnectionStateChanged:
+            LOG_DEBUG("[Event:{}] {}=\"{}\"", EventTypeToString(e.type),
+                      e.device, e.value);
+            break;
+        case EventType::DeviceOperationComplete:
+            LOG_DEBUG("[Event:{}] {}=\"{}\"", EventTypeToString(e.type), e.path,
+                      e.value);
+            break;
+        case EventType::DevicePropertyValueUpdate:
+            if ((e.path.PropertyName() != "XYPosition") &&
+                (e.path.PropertyName() != "RawXYPosition") &&
+                (e.path.PropertyName() != "ZDrivePosition"))
+            {
+                LOG_DEBUG("[Event:{}] {}=\"{}\"", EventTypeToString(e.type),
+                          e.path, e.value);
+            }
+        }
+    }
+}
@@ -0,0 +1,20 @@
+#ifndef APP_H
+#define APP_H
+
+#include "device/devicehub.h"
+#include "eventstream.h"
+
+// Startup and shutdown shared by the GUI and the headless server
+
+void initLogger();
+// Loads the system and user config. Errors are logged, and false is returned.
+bool loadConfig();
+
+// Simulated devices are added if the config has a simulation section
+void addDevices(DeviceHub &dev);
+void connectDevices(DeviceHub &dev);
+void disconnectDevices(DeviceHub &dev);
+
+void printEvents(EventStream *stream);
+
+#endif
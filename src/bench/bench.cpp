@@ -0,0 +1,166 @@
+#include "bench/bench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <latch>
+#include <new>
+#include <thread>
+
+#include <fmt/format.h>
+
+//
+// Allocation counting, for the benchmark executable only
+//
+
+static std::atomic<uint64_t> alloc_count = 0;
+static std::atomic<uint64_t> alloc_bytes = 0;
+
+void *operator new(std::size_t size)
+{
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    void *p = std::malloc(size ? size : 1);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete[](void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+uint64_t AllocCount() { return alloc_count; }
+
+uint64_t AllocBytes() { return alloc_bytes; }
+
+//
+// Runner
+//
+
+bool BenchSelected(const std::string &name, const BenchOptions &options)
+{
+    return options.filter.empty() ||
+           (name.find(options.filter) != std::string::npos);
+}
+
+static BenchResult runThreads(const Benchmark &bench, int n_threads,
+                              double min_seconds)
+{
+    using clock = std::chrono::steady_clock;
+
+    std::vector<BenchOp> ops;
+    for (int i = 0; i < n_threads; i++) {
+        ops.push_back(bench.make_op(i));
+    }
+    // Warm up caches and lazily created state
+    for (auto &op : ops) {
+        op();
+    }
+
+    std::atomic<bool> stop = false;
+    std::latch start(n_threads + 1);
+    std::vector<std::vector<double>> latency_ms(n_threads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < n_threads; i++) {
+        threads.emplace_back([&, i] {
+            start.arrive_and_wait();
+            while (!stop) {
+                clock::time_point tp = clock::now();
+                ops[i]();
+                latency_ms[i].push_back(
+                    std::chrono::duration<double, std::milli>(clock::now() -
+                                                              tp)
+                        .count());
+            }
+        });
+    }
+
+    uint64_t allocs_start = AllocCount();
+    uint64_t alloc_bytes_start = AllocBytes();
+    clock::time_point tp_start = clock::now();
+    start.arrive_and_wait();
+    std::this_thread::sleep_for(
+        std::chrono::microseconds((int64_t)(min_seconds * 1e6)));
+    stop = true;
+    for (auto &t : threads) {
+        t.join();
+    }
+    double seconds =
+        std::chrono::duration<double>(clock::now() - tp_start).count();
+    uint64_t allocs = AllocCount() - allocs_start;
+    uint64_t bytes = AllocBytes() - alloc_bytes_start;
+
+    std::vector<double> all_latency_ms;
+    for (const auto &l : latency_ms) {
+        all_latency_ms.insert(all_latency_ms.end(), l.begin(), l.end());
+    }
+    std::sort(all_latency_ms.begin(), all_latency_ms.end());
+
+    BenchResult result;
+    result.name = bench.name;
+    result.n_threads = n_threads;
+    result.n_ops = all_latency_ms.size();
+    result.seconds = seconds;
+    if (result.n_ops > 0) {
+        result.ops_per_s = result.n_ops / seconds;
+        result.mb_per_s = result.n_ops * bench.bytes_per_op / 1e6 / seconds;
+        result.p50_ms = all_latency_ms[(result.n_ops - 1) / 2];
+        result.p99_ms = all_latency_ms[(size_t)((result.n_ops - 1) * 0.99)];
+        result.allocs_per_op = (double)allocs / result.n_ops;
+        result.alloc_kb_per_op = bytes / 1e3 / result.n_ops;
+    }
+    return result;
+}
+
+std::vector<BenchResult> RunBenchmark(const Benchmark &bench,
+                                      const BenchOptions &options)
+{
+    std::vector<BenchResult> results;
+    if (!BenchSelected(bench.name, options)) {
+        return results;
+    }
+    for (int n_threads : options.threads) {
+        if (!bench.threaded && (n_threads > 1)) {
+            continue;
+        }
+        BenchResult result = runThreads(bench, n_threads, options.min_seconds);
+        PrintBenchResult(result);
+        results.push_back(result);
+    }
+    return results;
+}
+
+void PrintBenchResult(const BenchResult &result)
+{
+    fmt::print(stderr,
+               "{:<32} {:>2} threads {:>9.1f} ops/s {:>9.1f} MB/s  "
+               "p50 {:>8.3f} ms  p99 {:>8.3f} ms  {:>7.1f} allocs/op\n",
+               result.name, result.n_threads, result.ops_per_s,
+               result.mb_per_s, result.p50_ms, result.p99_ms,
+               result.allocs_per_op);
+}
+
+nlohmann::ordered_json BenchResultToJSON(const BenchResult &result)
+{
+    return {
+        {"name", result.name},
+        {"n_threads", result.n_threads},
+        {"n_ops", result.n_ops},
+        {"seconds", result.seconds},
+        {"ops_per_s", result.ops_per_s},
+        {"mb_per_s", result.mb_per_s},
+        {"p50_ms", result.p50_ms},
+        {"p99_ms", result.p99_ms},
+        {"allocs_per_op", result.allocs_per_op},
+        {"alloc_kb_per_op", result.alloc_kb_per_op},
+    };
+}
@@ -0,0 +1,73 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <xtensor/xarray.hpp>
+
+#include "image/imagedata.h"
+
+// An operation, e.g. encoding one frame. It is timed as a whole, so state
+// that is not measured is prepared when the operation is made.
+using BenchOp = std::function<void()>;
+
+struct Benchmark {
+    std::string name;
+    // Input processed by one operation, for MB/s
+    uint64_t bytes_per_op = 0;
+    // Runs only with one thread if false, e.g. for a single writer
+    bool threaded = true;
+    // Called once per thread before the timing starts
+    std::function<BenchOp(int i_thread)> make_op;
+};
+
+struct BenchOptions {
+    std::vector<int> threads = {1, 2, 4, 8};
+    double min_seconds = 1;
+    // Only benchmarks with names containing filter are run
+    std::string filter;
+};
+
+struct BenchResult {
+    std::string name;
+    int n_threads = 1;
+    uint64_t n_ops = 0;
+    double seconds = 0;
+    // Over all threads
+    double ops_per_s = 0;
+    double mb_per_s = 0;
+    // Latency of one operation
+    double p50_ms = 0;
+    double p99_ms = 0;
+    // Heap allocations through operator new, over all threads. Allocations
+    // with malloc inside libraries are not counted.
+    double allocs_per_op = 0;
+    double alloc_kb_per_op = 0;
+};
+
+// Runs the benchmark with each thread count of the options
+std::vector<BenchResult> RunBenchmark(const Benchmark &bench,
+                                      const BenchOptions &options);
+bool BenchSelected(const std::string &name, const BenchOptions &options);
+
+uint64_t AllocCount();
+uint64_t AllocBytes();
+
+void PrintBenchResult(const BenchResult &result);
+nlohmann::ordered_json BenchResultToJSON(const BenchResult &result);
+
+// Cells above the background, scaled to [0, 1] like the output of UNet, so
+// that the analysis can run without the model server
+xt::xarray<float> CellScore(ImageData data);
+
+// Storage, codec and analysis benchmarks over Uint16 frames. Files are
+// written to tmp_dir.
+std::vector<Benchmark> MicroBenchmarks(std::vector<ImageData> frames,
+                                       std::filesystem::path tmp_dir);
+
+#endif
@@ -0,0 +1,378 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include "bench/bench.h"
+#include "bench/scenario.h"
+#include "config.h"
+#include "device/sim/sim_camera.h"
+#include "image/liverecording.h"
+#include "logging.h"
+#include "utils/time_utils.h"
+#include "version.h"
+
+// Benchmarks of the storage, codec and analysis hot paths.
+//
+//   NikonTiBench [--out <results.json>] [--frames <recording.json>]
+//                [--width <px>] [--height <px>] [--threads 1,2,4,8]
+//                [--min-time <s>] [--filter <name>]
+//
+// Frames are synthetic cells at the sensor size, or the frames of a live
+// recording with --frames.
+//
+// Plate scans on the simulated devices, for each combination of the swept
+// tunables:
+//
+//   NikonTiBench scenario [--config <config.json>] [--out <results.json>]
+//                         [--report <report.md>] [--wells <n>]
+//                         [--sites <nx>x<ny>] [--channels BF,YFP]
+//                         [--sweep <tunable>=<value>,<value>...]...
+//
+// Channel presets and the timings of the simulated devices are read from the
+// system config.
+
+static const int n_frames = 8;
+
+void printUsage()
+{
+    fmt::print("Usage: NikonTiBench [--out <results.json>] "
+               "[--frames <recording.json>] [--width <px>] [--height <px>] "
+               "[--threads 1,2,4,8] [--min-time <s>] [--filter <name>]\n");
+    fmt::print("       NikonTiBench scenario [--config <config.json>] "
+               "[--out <results.json>] [--report <report.md>] [--wells <n>] "
+               "[--sites <nx>x<ny>] [--channels BF,YFP] "
+               "[--sweep <tunable>=<value>,<value>...]...\n");
+    fmt::print("Tunables:");
+    for (const auto &name : ScenarioTunableNames()) {
+        fmt::print(" {}", name);
+    }
+    fmt::print("\n");
+}
+
+std::vector<std::string> splitList(std::string s, char sep = ',')
+{
+    std::vector<std::string> items;
+    size_t start = 0;
+    while (start <= s.size()) {
+        size_t end = std::min(s.find(sep, start), s.size());
+        items.push_back(s.substr(start, end - start));
+        start = end + 1;
+    }
+    return items;
+}
+
+std::vector<int> parseThreads(std::string s)
+{
+    std::vector<int> threads;
+    for (const auto &item : splitList(s)) {
+        threads.push_back(std::stoi(item));
+    }
+    return threads;
+}
+
+bool writeFile(std::filesystem::path path, const std::string &content)
+{
+    std::ofstream ofs(path);
+    if (!ofs) {
+        fmt::print(stderr, "Failed to create {}\n", path.string());
+        return false;
+    }
+    ofs << content;
+    return true;
+}
+
+std::filesystem::path newTempDir()
+{
+    auto t_now = std::chrono::system_clock::now().time_since_epoch();
+    std::filesystem::path tmp_dir = std::filesystem::temp_directory_path() /
+                                    fmt::format("NikonTiBench-{}",
+                                                t_now.count());
+    std::filesystem::create_directories(tmp_dir);
+    return tmp_dir;
+}
+
+//
+// Scenario
+//
+
+// Params of every combination of the swept values
+std::vector<ScenarioParams> expandSweeps(
+    ScenarioParams base,
+    const std::vector<std::pair<std::string, std::vector<std::string>>>
+        &sweeps)
+{
+    std::vector<ScenarioParams> runs = {base};
+    for (const auto &[name, values] : sweeps) {
+        std::vector<ScenarioParams> expanded;
+        for (const auto &params : runs) {
+            for (const auto &value : values) {
+                ScenarioParams p = params;
+                SetScenarioTunable(p, name, value);
+                expanded.push_back(p);
+            }
+        }
+        runs = expanded;
+    }
+    for (int i = 0; i < runs.size(); i++) {
+        runs[i].name = fmt::format("run{}", i + 1);
+    }
+    return runs;
+}
+
+int scenarioMain(int argc, char *argv[])
+{
+    std::filesystem::path config_path;
+    std::filesystem::path out_path;
+    std::filesystem::path report_path;
+    std::vector<std::string> channel_names;
+    std::vector<std::pair<std::string, std::vector<std::string>>> sweeps;
+    ScenarioParams base;
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if ((arg == "--config") && (i + 1 < argc)) {
+                config_path = argv[++i];
+            } else if ((arg == "--out") && (i + 1 < argc)) {
+                out_path = argv[++i];
+            } else if ((arg == "--report") && (i + 1 < argc)) {
+                report_path = argv[++i];
+            } else if ((arg == "--wells") && (i + 1 < argc)) {
+                base.n_wells = std::stoi(argv[++i]);
+            } else if ((arg == "--sites") && (i + 1 < argc)) {
+                std::vector<std::string> n = splitList(argv[++i], 'x');
+                if (n.size() != 2) {
+                    throw std::invalid_argument("invalid --sites");
+                }
+                base.n_sites_x = std::stoi(n[0]);
+                base.n_sites_y = std::stoi(n[1]);
+            } else if ((arg == "--channels") && (i + 1 < argc)) {
+                channel_names = splitList(argv[++i]);
+            } else if ((arg == "--sweep") && (i + 1 < argc)) {
+                std::string sweep = argv[++i];
+                size_t eq = sweep.find('=');
+                if (eq == std::string::npos) {
+                    throw std::invalid_argument("invalid --sweep");
+                }
+                sweeps.push_back({sweep.substr(0, eq),
+                                  splitList(sweep.substr(eq + 1))});
+            } else {
+                throw std::invalid_argument(arg);
+            }
+        }
+        if ((base.n_wells < 1) || (base.n_wells > 96)) {
+            throw std::invalid_argument("--wells must be 1 to 96");
+        }
+    } catch (std::exception &e) {
+        printUsage();
+        return 2;
+    }
+
+    try {
+        if (config_path.empty()) {
+            config_path = getSystemConfigPath();
+        }
+        loadSystemConfig(config_path);
+    } catch (std::exception &e) {
+        fmt::print(stderr, "Failed to load config: {}\n", e.what());
+        return 1;
+    }
+    if (config.system.simulation.has_value()) {
+        base.sim = config.system.simulation.value();
+    }
+    if (channel_names.empty()) {
+        for (int i = 0; i < std::min<size_t>(2, config.system.presets.size());
+             i++)
+        {
+            channel_names.push_back(config.system.presets[i].name);
+        }
+    }
+    for (const auto &name : channel_names) {
+        auto it = std::find_if(
+            config.system.presets.begin(), config.system.presets.end(),
+            [&name](const ChannelPreset &p) { return p.name == name; });
+        if (it == config.system.presets.end()) {
+            fmt::print(stderr, "Channel preset {} not found\n", name);
+            return 1;
+        }
+        base.channels.push_back(Channel{
+            .preset_name = it->name,
+            .exposure_ms = it->default_exposure_ms,
+            .illumination_intensity = it->default_illumination_intensity,
+        });
+    }
+    if (base.channels.empty()) {
+        fmt::print(stderr, "No channel presets in config\n");
+        return 1;
+    }
+
+    std::vector<ScenarioParams> runs;
+    try {
+        runs = expandSweeps(base, sweeps);
+    } catch (std::exception &e) {
+        fmt::print(stderr, "Invalid sweep: {}\n", e.what());
+        return 2;
+    }
+
+    std::filesystem::path tmp_dir = newTempDir();
+    std::vector<ScenarioResult> results;
+    nlohmann::ordered_json results_json = nlohmann::ordered_json::array();
+    for (const auto &params : runs) {
+        fmt::print(stderr, "{}:", params.name);
+        for (const auto &[name, value] : params.tunables) {
+            fmt::print(stderr, " {}={}", name, value);
+        }
+        fmt::print(stderr, "\n");
+
+        ScenarioResult result = RunScenario(params, tmp_dir);
+        if (result.ok) {
+            fmt::print(stderr,
+                       "  {} sites in {:.1f} s, {:.0f} sites/h, "
+                       "max backlog {}\n",
+                       result.n_sites, result.elapsed_s,
+                       result.sites_per_hour, result.max_backlog);
+        } else {
+            fmt::print(stderr, "  Failed: {}\n", result.error);
+        }
+        results.push_back(result);
+        results_json.push_back(ScenarioResultToJSON(result));
+    }
+    std::filesystem::remove_all(tmp_dir);
+
+    std::string report = ScenarioReportMarkdown(results);
+    fmt::print("{}", report);
+    if (!report_path.empty() && !writeFile(report_path, report)) {
+        return 1;
+    }
+    if (!out_path.empty()) {
+        nlohmann::ordered_json j = {
+            {"version", gitTagVersion},
+            {"timestamp", utils::Now().FormatRFC3339_Local()},
+            {"hardware_concurrency", std::thread::hardware_concurrency()},
+            {"n_wells", base.n_wells},
+            {"n_sites_x", base.n_sites_x},
+            {"n_sites_y", base.n_sites_y},
+            {"channels", channel_names},
+            {"runs", results_json},
+        };
+        if (!writeFile(out_path, j.dump(2))) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+//
+// Micro-benchmarks
+//
+
+int microMain(int argc, char *argv[])
+{
+    std::filesystem::path out_path;
+    std::filesystem::path recording_path;
+    Sim::SimConfig sim_config;
+    BenchOptions options;
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if ((arg == "--out") && (i + 1 < argc)) {
+                out_path = argv[++i];
+            } else if ((arg == "--frames") && (i + 1 < argc)) {
+                recording_path = argv[++i];
+            } else if ((arg == "--width") && (i + 1 < argc)) {
+                sim_config.width = std::stoi(argv[++i]);
+            } else if ((arg == "--height") && (i + 1 < argc)) {
+                sim_config.height = std::stoi(argv[++i]);
+            } else if ((arg == "--threads") && (i + 1 < argc)) {
+                options.threads = parseThreads(argv[++i]);
+            } else if ((arg == "--min-time") && (i + 1 < argc)) {
+                options.min_seconds = std::stod(argv[++i]);
+            } else if ((arg == "--filter") && (i + 1 < argc)) {
+                options.filter = argv[++i];
+            } else {
+                printUsage();
+                return 2;
+            }
+        }
+    } catch (std::exception &e) {
+        printUsage();
+        return 2;
+    }
+
+    //
+    // Frames
+    //
+    std::vector<ImageData> frames;
+    nlohmann::ordered_json frames_info;
+    if (recording_path.empty()) {
+        frames = Sim::SyntheticCellImages(sim_config, n_frames);
+        frames_info = {{"source", "synthetic"}};
+    } else {
+        LiveRecordingReader reader(recording_path);
+        int n = std::min(reader.NumFrames(), n_frames);
+        if (n == 0) {
+            fmt::print(stderr, "Recording has no frames\n");
+            return 1;
+        }
+        for (int k = 0; k < n; k++) {
+            frames.push_back(reader.Frame(k));
+        }
+        frames_info = {{"source", recording_path.string()}};
+    }
+    frames_info["width"] = frames[0].Width();
+    frames_info["height"] = frames[0].Height();
+    frames_info["n_frames"] = frames.size();
+    fmt::print(stderr, "Frames: {} ({}x{})\n",
+               frames_info["source"].get<std::string>(), frames[0].Width(),
+               frames[0].Height());
+
+    std::filesystem::path tmp_dir = newTempDir();
+
+    //
+    // Run
+    //
+    nlohmann::ordered_json results = nlohmann::ordered_json::array();
+    try {
+        for (const auto &bench : MicroBenchmarks(frames, tmp_dir)) {
+            for (const auto &result : RunBenchmark(bench, options)) {
+                results.push_back(BenchResultToJSON(result));
+            }
+        }
+    } catch (std::exception &e) {
+        fmt::print(stderr, "Benchmark failed: {}\n", e.what());
+        std::filesystem::remove_all(tmp_dir);
+        return 1;
+    }
+    std::filesystem::remove_all(tmp_dir);
+
+    if (!out_path.empty()) {
+        nlohmann::ordered_json j = {
+            {"version", gitTagVersion},
+            {"timestamp", utils::Now().FormatRFC3339_Local()},
+            {"hardware_concurrency", std::thread::hardware_concurrency()},
+            {"frames", frames_info},
+            {"results", results},
+        };
+        if (!writeFile(out_path, j.dump(2))) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    slog::InitConsole();
+    slog::DefaultLogger().SetConsoleActiveLevel(slog::level::warn);
+
+    if ((argc > 1) && (std::string(argv[1]) == "scenario")) {
+        return scenarioMain(argc - 1, argv + 1);
+    }
+    return microMain(argc, argv);
+}
@@ -0,0 +1,251 @@
+#include "bench/bench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include <fmt/format.h>
+#include <xtensor/xadapt.hpp>
+#include <xtensor/xarray.hpp>
+#include <xtensor/xmath.hpp>
+
+#include "analysis/utils.h"
+#include "device/propertypath.h"
+#include "device/propertystore.h"
+#include "image/imageutils.h"
+#include "utils/hdf5file.h"
+#include "utils/tifffile.h"
+#include "utils/zipfile.h"
+
+static xt::xarray<uint16_t> frameArray(ImageData data)
+{
+    std::vector<size_t> im_shape = {data.Height(), data.Width()};
+    return xt::adapt((uint16_t *)data.Buf().get(), data.size(),
+                     xt::no_ownership(), im_shape);
+}
+
+xt::xarray<float> CellScore(ImageData data)
+{
+    xt::xarray<float> im = xt::cast<float>(frameArray(data));
+    float lo = xt::amin(im)();
+    float hi = xt::amax(im)();
+    return (im - lo) / std::max(hi - lo, 1.0f);
+}
+
+static std::string encodeTiff(xt::xarray<uint16_t> im, uint16_t compression)
+{
+    TiffEncoder tif;
+    tif.SetCompression(compression);
+    tif.SetDescription("{}");
+    return tif.EncodeMono16(im);
+}
+
+std::vector<Benchmark> MicroBenchmarks(std::vector<ImageData> frames,
+                                       std::filesystem::path tmp_dir)
+{
+    if (frames.empty()) {
+        throw std::invalid_argument("no frames");
+    }
+    uint64_t frame_bytes = frames[0].BufSize();
+    auto frame = [frames](int i) { return frames[i % frames.size()]; };
+
+    std::vector<Benchmark> benchmarks;
+
+    //
+    // Image
+    //
+    benchmarks.push_back({
+        .name = "image/hist",
+        .bytes_per_op = frame_bytes,
+        .make_op = [frame](int i_thread) -> BenchOp {
+            return [data = frame(i_thread)] { im::Hist(data); };
+        },
+    });
+    benchmarks.push_back({
+        .name = "image/as_float32",
+        .bytes_per_op = frame_bytes,
+        .make_op = [frame](int i_thread) -> BenchOp {
+            return [data = frame(i_thread)]() mutable { data.AsFloat32(); };
+        },
+    });
+
+    //
+    // TIFF
+    //
+    std::vector<std::pair<std::string, uint16_t>> compressions = {
+        {"none", COMPRESSION_NONE},
+        {"zstd", COMPRESSION_ZSTD},
+        {"deflate", COMPRESSION_ADOBE_DEFLATE},
+    };
+    for (const auto &[name, compression] : compressions) {
+        benchmarks.push_back({
+            .name = "tiff/encode_" + name,
+            .bytes_per_op = frame_bytes,
+            .make_op = [frame, compression](int i_thread) -> BenchOp {
+                return [im = frameArray(frame(i_thread)), compression] {
+                    encodeTiff(im, compression);
+                };
+            },
+        });
+    }
+
+    //
+    // Zip, shared by all threads as in ImageManager
+    //
+    std::string tiff_buf = encodeTiff(frameArray(frame(0)), COMPRESSION_ZSTD);
+    auto zip_write = std::make_shared<ZipFile>(tmp_dir / "bench_write.zip");
+    auto zip_write_mutex = std::make_shared<std::mutex>();
+    auto n_zip_files = std::make_shared<std::atomic<uint64_t>>(0);
+    for (bool flush : {false, true}) {
+        benchmarks.push_back({
+            .name = flush ? "zip/add_file_flush" : "zip/add_file",
+            .bytes_per_op = tiff_buf.size(),
+            .make_op = [=](int i_thread) -> BenchOp {
+                return [=] {
+                    std::string name = fmt::format("t{}-{}", i_thread,
+                                                   (*n_zip_files)++);
+                    std::lock_guard<std::mutex> lk(*zip_write_mutex);
+                    zip_write->AddFile(name, tiff_buf);
+                    if (flush) {
+                        zip_write->flush();
+                    }
+                };
+            },
+        });
+    }
+
+    auto zip_read = std::make_shared<ZipFile>(tmp_dir / "bench_read.zip");
+    int n_zip_read = 16;
+    for (int i = 0; i < n_zip_read; i++) {
+        zip_read->AddFile(fmt::format("{}", i), tiff_buf);
+    }
+    zip_read->flush();
+    benchmarks.push_back({
+        .name = "zip/get_data",
+        .bytes_per_op = tiff_buf.size(),
+        .make_op = [=](int i_thread) -> BenchOp {
+            auto k = std::make_shared<int>(i_thread);
+            return [=] {
+                zip_read->GetData(fmt::format("{}", (*k)++ % n_zip_read));
+            };
+        },
+    });
+
+    //
+    // Analysis
+    //
+    std::vector<ImageRegionProp> region_props;
+    xt::xarray<uint16_t> label = RegionLabel(CellScore(frame(0)), region_props);
+    int max_label = region_props.size();
+
+    benchmarks.push_back({
+        .name = "analysis/region_label",
+        .bytes_per_op = frame_bytes,
+        .make_op = [frame](int i_thread) -> BenchOp {
+            return [score = CellScore(frame(i_thread))] {
+                std::vector<ImageRegionProp> props;
+                RegionLabel(score, props);
+            };
+        },
+    });
+    benchmarks.push_back({
+        .name = "analysis/region_sum",
+        .bytes_per_op = frame_bytes,
+        .make_op = [frame, label, max_label](int i_thread) -> BenchOp {
+            return [im = frameArray(frame(0)), label, max_label] {
+                RegionSum(im, label, max_label);
+            };
+        },
+    });
+
+    //
+    // HDF5, single writer as in AnalysisManager
+    //
+    auto h5file = std::make_shared<HDF5File>(tmp_dir / "bench.h5");
+    auto n_datasets = std::make_shared<uint64_t>(0);
+    for (bool compress : {false, true}) {
+        benchmarks.push_back({
+            .name = compress ? "hdf5/write_label_compressed"
+                             : "hdf5/write_label",
+            .bytes_per_op = label.size() * sizeof(uint16_t),
+            .threaded = false,
+            .make_op = [=](int i_thread) -> BenchOp {
+                return [=] {
+                    h5file->write(fmt::format("/label_{}", (*n_datasets)++),
+                                  label, compress);
+                };
+            },
+        });
+    }
+
+    //
+    // Device properties, a snapshot of a few devices as in ExposeFrame and
+    // the check of a channel preset against it
+    //
+    std::vector<std::pair<PropertyPath, std::string>> property_values;
+    for (int i_dev = 0; i_dev < 4; i_dev++) {
+        for (int i = 0; i < 50; i++) {
+            property_values.push_back({
+                PropertyPath(fmt::format("Device{}", i_dev),
+                             fmt::format("Property{}", i)),
+                fmt::format("{}", i),
+            });
+        }
+    }
+    PropertyValueMap snapshot;
+    for (const auto &[path, value] : property_values) {
+        snapshot[path] = value;
+    }
+    PropertyValueMap preset_values;
+    for (int i = 0; i < property_values.size(); i += 10) {
+        preset_values[property_values[i].first] = "0";
+    }
+
+    benchmarks.push_back({
+        .name = "device/property_snapshot",
+        .make_op = [property_values](int i_thread) -> BenchOp {
+            return [property_values] {
+                PropertyValueMap snapshot;
+                snapshot.reserve(property_values.size());
+                for (const auto &[path, value] : property_values) {
+                    snapshot[path] = value;
+                }
+            };
+        },
+    });
+    benchmarks.push_back({
+        .name = "device/property_diff",
+        .make_op = [snapshot, preset_values](int i_thread) -> BenchOp {
+            return [snapshot, preset_values] {
+                PropertyValueMap diff;
+                for (const auto &[path, value] : preset_values) {
+                    auto it = snapshot.find(path);
+                    if ((it == snapshot.end()) || (it->second != value)) {
+                        diff[path] = value;
+                    }
+                }
+            };
+        },
+    });
+
+    auto store = std::make_shared<PropertySnapshotStore>();
+    store->Publish(snapshot);
+    benchmarks.push_back({
+        .name = "device/store_latest",
+        .make_op = [store](int i_thread) -> BenchOp {
+            return [store] { store->Latest(); };
+        },
+    });
+    benchmarks.push_back({
+        .name = "device/store_publish",
+        .make_op = [store, property_values](int i_thread) -> BenchOp {
+            PropertyPath path = property_values[0].first;
+            return [store, path, i = 0]() mutable {
+                store->Publish(path, fmt::format("{}", i++));
+            };
+        },
+    });
+
+    return benchmarks;
+}
@@ -0,0 +1,315 @@
+#include "bench/scenario.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include "analysis/utils.h"
+#include "app.h"
+#include "bench/bench.h"
+#include "experimentcontrol.h"
+#include "logging.h"
+#include "utils/time_utils.h"
+
+static const std::string plate_id = "bench";
+static const int plate_n_cols = 12;
+static const std::chrono::milliseconds backlog_interval(5);
+// Spans in the report of each run
+static const int n_report_spans = 8;
+
+static uint16_t compressionFromString(const std::string &value)
+{
+    if (value == "none") {
+        return COMPRESSION_NONE;
+    } else if (value == "zstd") {
+        return COMPRESSION_ZSTD;
+    } else if (value == "deflate") {
+        return COMPRESSION_ADOBE_DEFLATE;
+    } else if (value == "lzw") {
+        return COMPRESSION_LZW;
+    }
+    throw std::invalid_argument("invalid compression");
+}
+
+std::vector<std::string> ScenarioTunableNames()
+{
+    return {"compression", "pending_images", "analysis", "site_order",
+            "channel_order", "readout_ms"};
+}
+
+void SetScenarioTunable(ScenarioParams &params, const std::string &name,
+                        const std::string &value)
+{
+    if (name == "compression") {
+        params.storage.compression = compressionFromString(value);
+    } else if (name == "pending_images") {
+        params.storage.max_pending_images = std::stoi(value);
+        if (params.storage.max_pending_images < 1) {
+            throw std::invalid_argument("invalid pending_images");
+        }
+    } else if (name == "analysis") {
+        if ((value != "on") && (value != "off")) {
+            throw std::invalid_argument("analysis must be on or off");
+        }
+        params.analysis = (value == "on");
+    } else if (name == "site_order") {
+        params.site_order = SiteOrderFromString(value);
+    } else if (name == "channel_order") {
+        params.channel_order = ChannelOrderFromString(value);
+    } else if (name == "readout_ms") {
+        params.sim.readout_ms = std::stod(value);
+    } else {
+        throw std::invalid_argument(fmt::format("unknown tunable {}", name));
+    }
+    params.tunables[name] = value;
+}
+
+static std::vector<std::string> benchWellIDs(int n_wells)
+{
+    std::vector<std::string> well_ids;
+    for (int i = 0; i < n_wells; i++) {
+        well_ids.push_back(fmt::format("{:c}{:02d}", 'A' + i / plate_n_cols,
+                                       i % plate_n_cols + 1));
+    }
+    return well_ids;
+}
+
+// Labels the first channel of every site as soon as it is saved
+static void runAnalysis(ExperimentControl *exp, EventStream *stream,
+                        std::atomic<int> *n_analyzed)
+{
+    std::set<std::string> analyzed;
+    Event e;
+    while (stream->Receive(&e)) {
+        if ((e.type != EventType::NDImageChanged) ||
+            analyzed.contains(e.value))
+        {
+            continue;
+        }
+        NDImage *ndimage = exp->Images()->GetNDImage(e.value);
+        if ((ndimage == nullptr) || !ndimage->HasData(0, 0, 0)) {
+            continue;
+        }
+        analyzed.insert(e.value);
+
+        utils::TraceSpan span("analysis", "label site");
+        ImageData data = ndimage->GetData(0, 0, 0);
+        std::vector<ImageRegionProp> region_props;
+        xt::xarray<uint16_t> label = RegionLabel(CellScore(data), region_props);
+        std::vector<size_t> im_shape = {data.Height(), data.Width()};
+        xt::xarray<uint16_t> im =
+            xt::adapt((uint16_t *)data.Buf().get(), data.size(),
+                      xt::no_ownership(), im_shape);
+        RegionSum(im, label, region_props.size());
+        (*n_analyzed)++;
+    }
+}
+
+ScenarioResult RunScenario(const ScenarioParams &params,
+                           std::filesystem::path base_dir)
+{
+    ScenarioResult result;
+    result.name = params.name;
+    result.tunables = params.tunables;
+
+    DeviceHub dev;
+    dev.AddSimulatedDevices(params.sim);
+    connectDevices(dev);
+
+    // Declared before exp, which keeps sending to it until destroyed
+    EventStream analysis_stream;
+    std::atomic<int> n_analyzed = 0;
+    std::thread analysis_thread;
+
+    ExperimentControl exp(&dev);
+    try {
+        exp.SetBaseDir(base_dir);
+        exp.OpenExperiment(params.name);
+        exp.Images()->SetStorageOptions(params.storage);
+
+        std::vector<std::string> well_ids = benchWellIDs(params.n_wells);
+        SampleManager *samples = exp.Samples();
+        samples->AddPlate(PlateType::Wellplate96, plate_id);
+        samples->SetPlatePositionOrigin(plate_id, 0, 0);
+        samples->CreateSitesOnCenteredGrid(
+            plate_id, well_ids, params.n_sites_x, params.n_sites_y,
+            params.site_spacing_um, params.site_spacing_um);
+
+        ScanPlan plan;
+        plan.plate_id = plate_id;
+        plan.well_ids = well_ids;
+        plan.channels = params.channels;
+        plan.site_order = params.site_order;
+        plan.channel_order = params.channel_order;
+        plan.speed_model.speed_x = params.sim.xy_speed_um_per_s;
+        plan.speed_model.speed_y = params.sim.xy_speed_um_per_s;
+        plan.speed_model.settle_ms = params.sim.xy_settle_ms;
+
+        if (params.analysis) {
+            exp.Images()->SubscribeEvents(&analysis_stream);
+            analysis_thread = std::thread(runAnalysis, &exp, &analysis_stream,
+                                          &n_analyzed);
+        }
+
+        utils::ClearSpanStats();
+        utils::StopWatch sw;
+        exp.StartScan(plan);
+
+        uint64_t n_samples = 0;
+        uint64_t backlog_sum = 0;
+        for (;;) {
+            ScanProgress progress = exp.GetScanProgress();
+            if ((progress.state != ScanState::Running) &&
+                (progress.state != ScanState::Paused))
+            {
+                break;
+            }
+            int backlog = exp.Images()->NumPendingImages();
+            result.max_backlog = std::max(result.max_backlog, backlog);
+            backlog_sum += backlog;
+            n_samples++;
+            std::this_thread::sleep_for(backlog_interval);
+        }
+        exp.WaitScan();
+        result.elapsed_s = sw.Milliseconds() / 1000;
+
+        ScanProgress progress = exp.GetScanProgress();
+        if (progress.state != ScanState::Completed) {
+            throw std::runtime_error(progress.message);
+        }
+        result.ok = true;
+        result.n_sites = progress.n_sites_done;
+        result.n_frames = progress.n_sites_done * params.channels.size();
+        result.sites_per_hour = result.n_sites / (result.elapsed_s / 3600);
+        result.frames_per_s = result.n_frames / result.elapsed_s;
+        if (n_samples > 0) {
+            result.mean_backlog = (double)backlog_sum / n_samples;
+        }
+    } catch (std::exception &e) {
+        LOG_ERROR("[{}] Scenario failed: {}", params.name, e.what());
+        result.error = e.what();
+    }
+
+    utils::StopWatch sw_drain;
+    analysis_stream.Close();
+    if (analysis_thread.joinable()) {
+        analysis_thread.join();
+        result.analysis_drain_s = sw_drain.Milliseconds() / 1000;
+    }
+    result.n_analyzed = n_analyzed;
+    result.spans = utils::GetSpanStats();
+    exp.CloseExperiment();
+    disconnectDevices(dev);
+    return result;
+}
+
+nlohmann::ordered_json ScenarioResultToJSON(const ScenarioResult &result)
+{
+    nlohmann::ordered_json spans = nlohmann::ordered_json::array();
+    for (const auto &s : result.spans) {
+        spans.push_back({
+            {"name", s.name},
+            {"count", s.count},
+            {"total_ms", s.total_ms},
+            {"p50_ms", s.p50_ms},
+            {"p90_ms", s.p90_ms},
+            {"p99_ms", s.p99_ms},
+            {"max_ms", s.max_ms},
+        });
+    }
+    return {
+        {"name", result.name},
+        {"tunables", result.tunables},
+        {"ok", result.ok},
+        {"error", result.error},
+        {"n_sites", result.n_sites},
+        {"n_frames", result.n_frames},
+        {"elapsed_s", result.elapsed_s},
+        {"sites_per_hour", result.sites_per_hour},
+        {"frames_per_s", result.frames_per_s},
+        {"max_backlog", result.max_backlog},
+        {"mean_backlog", result.mean_backlog},
+        {"n_analyzed", result.n_analyzed},
+        {"analysis_drain_s", result.analysis_drain_s},
+        {"spans", spans},
+    };
+}
+
+std::string ScenarioReportMarkdown(const std::vector<ScenarioResult> &results)
+{
+    std::string report = "# Scan throughput\n\n";
+    if (results.empty()) {
+        return report;
+    }
+
+    //
+    // Comparison of the runs, relative to the first
+    //
+    std::vector<std::string> names;
+    for (const auto &[name, value] : results[0].tunables) {
+        names.push_back(name);
+    }
+    std::string header = "| run |";
+    std::string sep = "|---|";
+    for (const auto &name : names) {
+        header += fmt::format(" {} |", name);
+        sep += "---|";
+    }
+    report += header +
+              " sites/h | vs first | frames/s | max backlog | "
+              "mean backlog | analyzed | analysis drain s |\n";
+    report += sep + "---|---|---|---|---|---|---|\n";
+    double base_sites_per_hour = results[0].sites_per_hour;
+    for (const auto &r : results) {
+        std::string row = fmt::format("| {} |", r.name);
+        for (const auto &name : names) {
+            auto it = r.tunables.find(name);
+            row += fmt::format(" {} |",
+                               (it != r.tunables.end()) ? it->second : "");
+        }
+        if (!r.ok) {
+            report += row + fmt::format(" failed: {} | | | | | | |\n", r.error);
+            continue;
+        }
+        double relative = (base_sites_per_hour > 0)
+                              ? r.sites_per_hour / base_sites_per_hour
+                              : 0;
+        report += row + fmt::format(" {:.0f} | {:.2f}x | {:.2f} | {} | "
+                                    "{:.1f} | {} | {:.1f} |\n",
+                                    r.sites_per_hour, relative,
+                                    r.frames_per_s, r.max_backlog,
+                                    r.mean_backlog, r.n_analyzed,
+                                    r.analysis_drain_s);
+    }
+
+    //
+    // Where the time goes in each run
+    //
+    for (const auto &r : results) {
+        if (!r.ok) {
+            continue;
+        }
+        std::vector<utils::SpanStats> spans = r.spans;
+        std::sort(spans.begin(), spans.end(), [](const auto &a, const auto &b) {
+            return a.total_ms > b.total_ms;
+        });
+        if (spans.size() > n_report_spans) {
+            spans.resize(n_report_spans);
+        }
+        report += fmt::format("\n## {}\n\n", r.name);
+        report += "| span | count | ms/site | p50 ms | p99 ms | max ms |\n";
+        report += "|---|---|---|---|---|---|\n";
+        for (const auto &s : spans) {
+            report += fmt::format(
+                "| {} | {} | {:.1f} | {:.2f} | {:.2f} | {:.2f} |\n", s.name,
+                s.count, s.total_ms / std::max(r.n_sites, 1), s.p50_ms,
+                s.p99_ms, s.max_ms);
+        }
+    }
+    return report;
+}
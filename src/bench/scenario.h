@@ -0,0 +1,75 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "channel.h"
+#include "device/sim/sim_config.h"
+#include "image/imagemanager.h"
+#include "sample/pathplanner.h"
+#include "task/channelplanner.h"
+#include "utils/trace.h"
+
+// A plate scan through ExperimentControl on the simulated devices, with the
+// tunables of one run
+struct ScenarioParams {
+    std::string name;
+    // Set by SetScenarioTunable, for the report
+    std::map<std::string, std::string> tunables;
+    Sim::SimConfig sim;
+    ImageStorageOptions storage;
+    // Labels the cells of every site while scanning, like an analysis server
+    // sharing the computer. UNet is replaced by CellScore.
+    bool analysis = false;
+    SiteOrder site_order = SiteOrder::AsCreated;
+    ChannelOrder channel_order = ChannelOrder::AsGiven;
+
+    // First wells of a 96-well plate, row by row
+    int n_wells = 4;
+    int n_sites_x = 3;
+    int n_sites_y = 3;
+    double site_spacing_um = 700;
+    std::vector<Channel> channels;
+};
+
+struct ScenarioResult {
+    std::string name;
+    std::map<std::string, std::string> tunables;
+    bool ok = false;
+    std::string error;
+
+    int n_sites = 0;
+    int n_frames = 0;
+    double elapsed_s = 0;
+    double sites_per_hour = 0;
+    double frames_per_s = 0;
+    // Images waiting to be saved, sampled during the scan
+    int max_backlog = 0;
+    double mean_backlog = 0;
+    int n_analyzed = 0;
+    // Analysis still running after the scan completed
+    double analysis_drain_s = 0;
+    // Spans of the scan, e.g. task/scan site and image/encode tiff
+    std::vector<utils::SpanStats> spans;
+};
+
+// Applies a tunable to the params, e.g. ("compression", "zstd").
+// Throws std::invalid_argument for unknown names or values.
+void SetScenarioTunable(ScenarioParams &params, const std::string &name,
+                        const std::string &value);
+std::vector<std::string> ScenarioTunableNames();
+
+// Runs the scenario in a new experiment under base_dir
+ScenarioResult RunScenario(const ScenarioParams &params,
+                           std::filesystem::path base_dir);
+
+nlohmann::ordered_json ScenarioResultToJSON(const ScenarioResult &result);
+// Comparison of the runs, and the slowest spans of each run
+std::string ScenarioReportMarkdown(const std::vector<ScenarioResult> &results);
+
+#endif
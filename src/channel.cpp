@@ -1,5 +1,10 @@
 #include "channel.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <stdexcept>
+
 void from_json(const nlohmann::json &j, ChannelPreset &p)
 {
     j.at("name").get_to(p.name);
@@ -22,4 +27,65 @@ void from_json(const nlohmann::json &j, ChannelPreset &p)
         j.at("default_illumination_intensity")
             .get_to(p.default_illumination_intensity);
     }
-}
\ No newline at end of file
+
+    if (j.contains("set_after")) {
+        for (const auto &[property, after] : j.at("set_after").items()) {
+            std::vector<PropertyPath> &deps = p.set_after[property];
+            for (const auto &dep : after) {
+                deps.push_back(dep.get<std::string>());
+            }
+        }
+    }
+
+    // Check that set_after has no cycle
+    std::map<PropertyPath, int> state; // 1: visiting, 2: done
+    std::function<void(const PropertyPath &)> visit =
+        [&](const PropertyPath &property) {
+            if (state[property] == 2) {
+                return;
+            }
+            if (state[property] == 1) {
+                throw std::invalid_argument(
+                    fmt::format("preset {}: set_after has a cycle at {}",
+                                p.name, property));
+            }
+            state[property] = 1;
+            auto it = p.set_after.find(property);
+            if (it != p.set_after.end()) {
+                for (const auto &dep : it->second) {
+                    visit(dep);
+                }
+            }
+            state[property] = 2;
+        };
+    for (const auto &[property, deps] : p.set_after) {
+        visit(property);
+    }
+}
+
+void from_json(const nlohmann::json &j, MoveCost &c)
+{
+    c.base_ms = j.value("base_ms", c.base_ms);
+    c.step_ms = j.value("step_ms", c.step_ms);
+    c.n_positions = j.value("n_positions", c.n_positions);
+}
+
+double MoveCost::Cost(const std::string &from, const std::string &to) const
+{
+    if (from == to) {
+        return 0;
+    }
+    int pos_from;
+    int pos_to;
+    try {
+        pos_from = std::stoi(from);
+        pos_to = std::stoi(to);
+    } catch (std::exception &e) {
+        return base_ms;
+    }
+    int steps = std::abs(pos_to - pos_from);
+    if (n_positions > 0) {
+        steps = std::min(steps, n_positions - steps);
+    }
+    return base_ms + step_ms * steps;
+}
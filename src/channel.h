@@ -3,6 +3,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "device/propertypath.h"
 
@@ -13,6 +14,21 @@ struct ChannelPreset {
     PropertyPath illumination_property;
     double default_exposure_ms;
     double default_illumination_intensity;
+    // A property is set only after these properties have settled, if they
+    // change in the same switch, e.g. a filter after the shutter is closed.
+    // Other properties are set concurrently.
+    std::map<PropertyPath, std::vector<PropertyPath>> set_after;
+};
+
+// Time to move a property between two values, e.g. a filter turret. Numeric
+// values are positions, and a move takes base_ms plus step_ms per position
+// passed. A turret with n_positions may move the shorter way around.
+struct MoveCost {
+    double base_ms = 0;
+    double step_ms = 0;
+    int n_positions = 0;
+
+    double Cost(const std::string &from, const std::string &to) const;
 };
 
 struct Channel {
@@ -22,5 +38,6 @@ struct Channel {
 };
 
 void from_json(const nlohmann::json &j, ChannelPreset &p);
+void from_json(const nlohmann::json &j, MoveCost &c);
 
 #endif
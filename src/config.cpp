@@ -43,6 +43,27 @@ std::filesystem::path getUserConfigPath()
     return user_app_dir / "user.json";
 }
 
+static Sim::SimConfig simConfigFromJSON(const nlohmann::json &j)
+{
+    Sim::SimConfig c;
+    c.width = j.value("width", c.width);
+    c.height = j.value("height", c.height);
+    c.readout_ms = j.value("readout_ms", c.readout_ms);
+    c.lost_frame_rate = j.value("lost_frame_rate", c.lost_frame_rate);
+    c.n_cells = j.value("n_cells", c.n_cells);
+    c.cell_radius_px = j.value("cell_radius_px", c.cell_radius_px);
+    c.seed = j.value("seed", c.seed);
+    c.xy_speed_um_per_s = j.value("xy_speed_um_per_s", c.xy_speed_um_per_s);
+    c.xy_settle_ms = j.value("xy_settle_ms", c.xy_settle_ms);
+    c.z_speed_um_per_s = j.value("z_speed_um_per_s", c.z_speed_um_per_s);
+    c.z_settle_ms = j.value("z_settle_ms", c.z_settle_ms);
+    c.shutter_latency_ms = j.value("shutter_latency_ms", c.shutter_latency_ms);
+    c.filter_wheel_latency_ms =
+        j.value("filter_wheel_latency_ms", c.filter_wheel_latency_ms);
+    c.turret_latency_ms = j.value("turret_latency_ms", c.turret_latency_ms);
+    return c;
+}
+
 void loadSystemConfig(std::filesystem::path filename)
 {
     std::ifstream ifs(filename.string());
@@ -67,6 +88,24 @@ void loadSystemConfig(std::filesystem::path filename)
         throw std::runtime_error(fmt::format("presets: {}", e.what()));
     }
 
+    if (j.contains("move_cost")) {
+        try {
+            for (const auto &[property, cost] : j.at("move_cost").items()) {
+                config.system.move_cost[property] = cost.get<MoveCost>();
+            }
+        } catch (std::exception &e) {
+            throw std::runtime_error(fmt::format("move_cost: {}", e.what()));
+        }
+    }
+
+    if (j.contains("simulation")) {
+        try {
+            config.system.simulation = simConfigFromJSON(j.at("simulation"));
+        } catch (std::exception &e) {
+            throw std::runtime_error(fmt::format("simulation: {}", e.what()));
+        }
+    }
+
     return;
 }
 
@@ -3,12 +3,14 @@
 
 #include <filesystem>
 #include <map>
+#include <optional>
 #include <nlohmann/json.hpp>
 #include <string>
 #include <vector>
 
 #include "channel.h"
 #include "device/propertypath.h"
+#include "device/sim/sim_config.h"
 
 struct Label {
     std::string name;
@@ -30,6 +32,10 @@ struct ConfigSystem {
     std::map<std::string, double> pixel_size;
     std::map<PropertyPath, std::map<std::string, Label>> labels;
     std::vector<ChannelPreset> presets;
+    // Of the properties that are slow to move, for ordering channels
+    std::map<PropertyPath, MoveCost> move_cost;
+    // Simulated devices are used instead of the instrument if set
+    std::optional<Sim::SimConfig> simulation;
 };
 
 struct ConfigUser {
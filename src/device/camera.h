@@ -0,0 +1,40 @@
+#ifndef DEVICE_CAMERA_H
+#define DEVICE_CAMERA_H
+
+#include <chrono>
+#include <cstdint>
+
+#include "device/device.h"
+#include "image/imagedata.h"
+
+// Frame API used by the acquisition tasks, following the buffer and event
+// model of DCAM.
+class Camera : public Device {
+public:
+    virtual Status AllocBuffer(uint8_t n_frames) = 0;
+    virtual Status ReleaseBuffer() = 0;
+    virtual uint8_t BufferAllocated() = 0;
+
+    virtual DataType GetDataType() = 0;
+    virtual ColorType GetColorType() = 0;
+    virtual uint32_t GetWidth() = 0;
+    virtual uint32_t GetHeight() = 0;
+
+    virtual Status StartAcquisition() = 0;
+    virtual Status StartContinousAcquisition() = 0;
+    virtual Status StopAcquisition() = 0;
+    virtual Status WaitExposureEnd(uint32_t timeout_ms) = 0;
+    virtual Status WaitFrameReady(uint32_t timeout_ms) = 0;
+    // i_frame is the buffer index, or -1 for the latest frame
+    virtual StatusOr<ImageData> GetFrame(
+        int32_t i_frame,
+        std::chrono::system_clock::time_point *tp_exposure_end = nullptr) = 0;
+    // Number of frames captured since the acquisition started. Frame k is in
+    // buffer k % BufferAllocated() until it is overwritten. Frames reported
+    // lost by WaitFrameReady() are not counted.
+    virtual StatusOr<int32_t> GetFrameCount() = 0;
+
+    virtual Status FireTrigger() = 0;
+};
+
+#endif
@@ -1,7 +1,11 @@
 #include "device/devicehub.h"
 
+#include <algorithm>
+
 #include <fmt/format.h>
 
+#include "device/sim/sim_camera.h"
+#include "device/sim/sim_device.h"
 #include "logging.h"
 
 DeviceHub::~DeviceHub()
@@ -26,6 +30,17 @@ void DeviceHub::AddDevice(std::string dev_name, Device *dev)
 
     dev_map[dev_name] = dev;
 
+    dev->SubscribeEvents(nullptr, [this, dev_name](Event &e) {
+        if (e.type == EventType::DevicePropertyValueUpdate) {
+            property_store.Publish(
+                PropertyPath(dev_name, e.path.PropertyName()), e.value);
+        } else if ((e.type == EventType::DeviceConnectionStateChanged) &&
+                   (e.value == DeviceConnectionState::ConnectionLost))
+        {
+            property_store.RemoveDevice(dev_name);
+        }
+    });
+
     if (!event_subscriber_list.empty()) {
         for (const auto &channel : event_subscriber_list) {
             dev->SubscribeEvents(channel, [dev_name](Event &e) {
@@ -55,13 +70,21 @@ std::string DeviceHub::GetDeviceName(Device *dev)
     return "";
 }
 
-void DeviceHub::AddCamera(std::string dev_name, Hamamatsu::DCam *dcam)
+void DeviceHub::AddCamera(std::string dev_name, Camera *camera)
 {
-    AddDevice(dev_name, dcam);
-    hamamatsu_dcam = dcam;
+    AddDevice(dev_name, camera);
+    this->camera = camera;
 }
 
-Hamamatsu::DCam *DeviceHub::GetHamamatsuDCam() { return hamamatsu_dcam; }
+Camera *DeviceHub::GetCamera() { return camera; }
+
+void DeviceHub::AddSimulatedDevices(Sim::SimConfig config)
+{
+    AddDevice("NikonTi", new Sim::SimDevice(Sim::NikonTiPropInfo(config)));
+    AddDevice("PriorProScan",
+              new Sim::SimDevice(Sim::ProscanPropInfo(config)));
+    AddCamera("Hamamatsu", new Sim::SimCamera(config));
+}
 
 Status DeviceHub::ConnectAll()
 {
@@ -97,8 +120,13 @@ Status DeviceHub::runDeviceConnect(std::string dev_name, Device *dev)
 {
     LOG_INFO("Connecting device {}...", dev_name);
     utils::StopWatch sw;
+    clearSnapshotNodes(dev_name);
     Status status = dev->Connect();
     if (status.ok()) {
+        // For properties without an update since connecting
+        PropertyValueMap path_value_map;
+        appendSnapshot(dev_name, dev, path_value_map);
+        property_store.Publish(path_value_map, true);
         LOG_INFO("Device {} connected [{:.0f} ms]", dev_name,
                  sw.Milliseconds());
     } else {
@@ -112,7 +140,9 @@ Status DeviceHub::runDeviceDisconnect(std::string dev_name, Device *dev)
 {
     LOG_INFO("Disconnecting device {}...", dev_name);
     utils::StopWatch sw;
+    clearSnapshotNodes(dev_name);
     Status status = dev->Disconnect();
+    property_store.RemoveDevice(dev_name);
     if (status.ok()) {
         LOG_INFO("Device {} disconnected [{:.0f} ms]", dev_name,
                  sw.Milliseconds());
@@ -285,9 +315,7 @@ PropertyValueMap DeviceHub::GetPropertySnapshot()
         if (!dev->IsConnected()) {
             continue;
         }
-        for (const auto &[prop_name, value] : dev->GetPropertySnapshot()) {
-            path_value_map[PropertyPath(dev_name, prop_name)] = value;
-        }
+        appendSnapshot(dev_name, dev, path_value_map);
     }
     return path_value_map;
 }
@@ -304,13 +332,69 @@ DeviceHub::GetPropertySnapshot(std::set<std::string> dev_name_set)
         if (!dev->IsConnected()) {
             continue;
         }
-        for (const auto &[prop_name, value] : dev->GetPropertySnapshot()) {
-            path_value_map[PropertyPath(dev_name, prop_name)] = value;
+        appendSnapshot(dev_name, dev, path_value_map);
+    }
+    return path_value_map;
+}
+
+PropertyValueMap
+DeviceHub::GetPropertySnapshot(const std::vector<PropertyPath> &paths)
+{
+    PropertyValueMap path_value_map;
+
+    for (const auto &path : paths) {
+        Device *dev = GetDevice(path.DeviceName());
+        if ((dev == nullptr) || !dev->IsConnected()) {
+            continue;
+        }
+        PropertyNode *node = dev->Node(path.PropertyName());
+        if (node == nullptr) {
+            continue;
+        }
+        auto snapshot = node->GetSnapshot();
+        if (snapshot.has_value()) {
+            path_value_map[path] = snapshot.value();
         }
     }
     return path_value_map;
 }
 
+PropertySnapshotPtr DeviceHub::LatestPropertySnapshot()
+{
+    return property_store.Latest();
+}
+
+void DeviceHub::clearSnapshotNodes(const std::string &dev_name)
+{
+    std::lock_guard<std::mutex> lk(snapshot_mutex);
+    snapshot_nodes.erase(dev_name);
+}
+
+void DeviceHub::appendSnapshot(const std::string &dev_name, Device *dev,
+                               PropertyValueMap &path_value_map)
+{
+    std::lock_guard<std::mutex> lk(snapshot_mutex);
+    auto it = snapshot_nodes.find(dev_name);
+    if (it == snapshot_nodes.end()) {
+        SnapshotNodes nodes;
+        for (const auto &[prop_name, node] : dev->NodeMap()) {
+            nodes.push_back({PropertyPath(dev_name, prop_name), node});
+        }
+        // In the order of the map, so values are mostly appended
+        std::sort(nodes.begin(), nodes.end(), [](const auto &a, const auto &b) {
+            return a.first < b.first;
+        });
+        it = snapshot_nodes.emplace(dev_name, std::move(nodes)).first;
+    }
+    path_value_map.reserve(path_value_map.size() + it->second.size());
+    for (const auto &[path, node] : it->second) {
+        auto snapshot = node->GetSnapshot();
+        if (snapshot.has_value()) {
+            path_value_map[path] = std::move(snapshot.value());
+        }
+    }
+}
+
 void DeviceHub::SubscribeEvents(EventStream *channel)
 {
     for (const auto &[dev_name, dev] : dev_map) {
@@ -3,15 +3,18 @@
 
 #include <future>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
 
 #include "device/device.h"
 #include "device/propertypath.h"
+#include "device/propertystore.h"
 #include "eventstream.h"
 
-#include "device/hamamatsu/hamamatsu_dcam.h"
+#include "device/camera.h"
+#include "device/sim/sim_config.h"
 
 class DeviceHub {
 public:
@@ -21,8 +24,10 @@ public:
     Device *GetDevice(std::string dev_name);
     std::string GetDeviceName(Device *dev);
 
-    void AddCamera(std::string dev_name, Hamamatsu::DCam *dcam);
-    Hamamatsu::DCam *GetHamamatsuDCam();
+    void AddCamera(std::string dev_name, Camera *camera);
+    Camera *GetCamera();
+    // Adds simulated devices with the names of the real devices
+    void AddSimulatedDevices(Sim::SimConfig config);
 
     Status ConnectAll();
     Status DisconnectAll();
@@ -41,14 +46,29 @@ public:
 
     PropertyValueMap GetPropertySnapshot();
     PropertyValueMap GetPropertySnapshot(std::set<std::string> dev_name_set);
+    // Last known values of only these properties, without querying devices
+    PropertyValueMap GetPropertySnapshot(const std::vector<PropertyPath> &paths);
+    // Values published by the connected devices, without reading any device
+    PropertySnapshotPtr LatestPropertySnapshot();
 
     void SubscribeEvents(EventStream *channel);
 
 private:
     std::map<std::string, Device *> dev_map;
-    Hamamatsu::DCam *hamamatsu_dcam = nullptr;
+    Camera *camera = nullptr;
 
     std::vector<EventStream *> event_subscriber_list;
+    PropertySnapshotStore property_store;
+
+    // Paths and nodes of each connected device, so that a snapshot does not
+    // build paths. Cleared when the device connects or disconnects, as nodes
+    // may be recreated.
+    typedef std::vector<std::pair<PropertyPath, PropertyNode *>> SnapshotNodes;
+    std::mutex snapshot_mutex;
+    std::map<std::string, SnapshotNodes> snapshot_nodes;
+    void clearSnapshotNodes(const std::string &dev_name);
+    void appendSnapshot(const std::string &dev_name, Device *dev,
+                        PropertyValueMap &path_value_map);
 
     Status runDeviceConnect(std::string dev_name, Device *dev);
     Status runDeviceDisconnect(std::string dev_name, Device *dev);
@@ -477,6 +477,21 @@ DCam::GetFrame(int32_t i_frame,
     return frame;
 }
 
+StatusOr<int32_t> DCam::GetFrameCount()
+{
+    DCAMCAP_TRANSFERINFO transfer_info;
+    memset(&transfer_info, 0, sizeof(transfer_info));
+    transfer_info.size = sizeof(transfer_info);
+    transfer_info.iKind = DCAMCAP_TRANSFERKIND_FRAME;
+
+    DCAMERR err = dcamcap_transferinfo(hdcam, &transfer_info);
+    if ((int32_t)err < 0) {
+        return absl::InternalError(fmt::format("dcamcap_transferinfo: {}",
+                                               DCAMERR_ToString(err)));
+    }
+    return transfer_info.nFrameCount;
+}
+
 Status DCam::updateWidthHeight()
 {
     StatusOr<std::string> width_str = Node("IMAGE WIDTH")->GetValue();
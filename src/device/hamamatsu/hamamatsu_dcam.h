@@ -14,7 +14,7 @@
 #include <absl/status/status.h>
 #include <absl/status/statusor.h>
 
-#include "device/device.h"
+#include "device/camera.h"
 #include "image/imagedata.h"
 
 // dcamapi4.h
@@ -29,7 +29,7 @@ using absl::StatusOr;
 class DCam;
 class PropertyNode;
 
-class DCam : public Device {
+class DCam : public Camera {
     friend class PropertyNode;
 
 public:
@@ -43,25 +43,26 @@ public:
     ::PropertyNode *Node(std::string name) override;
     std::map<std::string, ::PropertyNode *> NodeMap() override;
 
-    Status AllocBuffer(uint8_t n_frames);
-    Status ReleaseBuffer();
-    uint8_t BufferAllocated();
-
-    DataType GetDataType() { return dtype; }
-    ColorType GetColorType() { return ctype; }
-    uint32_t GetWidth() { return width; }
-    uint32_t GetHeight() { return height; }
-
-    Status StartAcquisition();
-    Status StartContinousAcquisition();
-    Status StopAcquisition();
-    Status WaitExposureEnd(uint32_t timeout_ms);
-    Status WaitFrameReady(uint32_t timeout_ms);
-    StatusOr<ImageData>
-    GetFrame(int32_t i_frame,
-             std::chrono::system_clock::time_point *tp_exposure_end = nullptr);
-
-    Status FireTrigger();
+    Status AllocBuffer(uint8_t n_frames) override;
+    Status ReleaseBuffer() override;
+    uint8_t BufferAllocated() override;
+
+    DataType GetDataType() override { return dtype; }
+    ColorType GetColorType() override { return ctype; }
+    uint32_t GetWidth() override { return width; }
+    uint32_t GetHeight() override { return height; }
+
+    Status StartAcquisition() override;
+    Status StartContinousAcquisition() override;
+    Status StopAcquisition() override;
+    Status WaitExposureEnd(uint32_t timeout_ms) override;
+    Status WaitFrameReady(uint32_t timeout_ms) override;
+    StatusOr<ImageData> GetFrame(int32_t i_frame,
+                                 std::chrono::system_clock::time_point
+                                     *tp_exposure_end = nullptr) override;
+    StatusOr<int32_t> GetFrameCount() override;
+
+    Status FireTrigger() override;
 
 private:
     std::mutex hdcam_mutex;
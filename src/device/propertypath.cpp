@@ -1,20 +1,47 @@
 #include "device/propertypath.h"
 
-PropertyPath::PropertyPath(std::string path)
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+struct PropertyRegistry {
+    std::shared_mutex mutex;
+    // By the path as given, and by the path as formatted
+    std::unordered_map<std::string, const PropertyPath::Entry *> by_path;
+    std::vector<std::unique_ptr<PropertyPath::Entry>> entries;
+};
+
+// Paths given by API clients are interned too, so the table is bounded
+static const size_t max_entries = 1 << 16;
+// Other spellings of interned paths are only remembered up to this
+static const size_t max_by_path = 2 * max_entries;
+
+static PropertyRegistry &registry()
 {
+    static PropertyRegistry registry;
+    return registry;
+}
+
+static PropertyPath::Entry parsePath(const std::string &path)
+{
+    PropertyPath::Entry entry{};
     // size = 0
     if (path.empty()) {
-        return;
+        return entry;
     }
 
     if (path.size() == 1) {
         // size = 1
         if (path == "/") {
-            root = true;
-            return;
+            entry.root = true;
+            return entry;
         } else {
-            property_name_ = path;
-            return;
+            entry.property_name = path;
+            return entry;
         }
     } else {
         // size > 1
@@ -22,48 +49,202 @@ PropertyPath::PropertyPath(std::string path)
             std::size_t pos = path.find_first_of('/', 1);
             if (pos == std::string::npos) {
                 // "/dev_name"
-                dev_name_ = path.substr(1, pos - 1);
-                return;
+                entry.dev_name = path.substr(1, pos - 1);
+                return entry;
             } else {
                 // "/dev_name/property_name"
                 // "/dev_name/property_name/sub_property_name"
-                dev_name_ = path.substr(1, pos - 1);
-                property_name_ = path.substr(pos + 1, std::string::npos);
-                return;
+                entry.dev_name = path.substr(1, pos - 1);
+                entry.property_name = path.substr(pos + 1, std::string::npos);
+                return entry;
             }
         } else {
             // "property_name"
             // "property_name/sub_property_name"
-            property_name_ = path;
-            return;
+            entry.property_name = path;
+            return entry;
         }
     }
 }
 
-std::string PropertyPath::ToString() const
+static std::string entryPath(const PropertyPath::Entry &entry)
 {
-    if (root) {
+    if (entry.root) {
         return "/";
     } else {
-        if (dev_name_.empty() && property_name_.empty()) {
+        if (entry.dev_name.empty() && entry.property_name.empty()) {
             return "";
         }
-        if (dev_name_.empty()) {
-            return property_name_;
+        if (entry.dev_name.empty()) {
+            return entry.property_name;
+        }
+        if (entry.property_name.empty()) {
+            return "/" + entry.dev_name;
+        }
+        return "/" + entry.dev_name + "/" + entry.property_name;
+    }
+}
+
+
+static const PropertyPath::Entry *findEntry(const std::string &path)
+{
+    PropertyRegistry &r = registry();
+    std::shared_lock<std::shared_mutex> lk(r.mutex);
+    auto it = r.by_path.find(path);
+    if (it == r.by_path.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+static const PropertyPath::Entry *internEntry(const std::string &path,
+                                              PropertyPath::Entry entry)
+{
+    entry.path = entryPath(entry);
+    PropertyRegistry &r = registry();
+    std::unique_lock<std::shared_mutex> lk(r.mutex);
+    const PropertyPath::Entry *interned;
+    auto it = r.by_path.find(entry.path);
+    if (it != r.by_path.end()) {
+        interned = it->second;
+    } else {
+        if (r.entries.size() >= max_entries) {
+            throw std::length_error(
+                fmt::format("too many property paths, not adding {}", path));
         }
-        if (property_name_.empty()) {
-            return "/" + dev_name_;
+        entry.id = r.entries.size();
+        r.entries.push_back(
+            std::make_unique<PropertyPath::Entry>(std::move(entry)));
+        interned = r.entries.back().get();
+        r.by_path[interned->path] = interned;
+    }
+    if (r.by_path.size() < max_by_path) {
+        r.by_path.emplace(path, interned);
+    }
+    return interned;
+}
+
+PropertyPath::PropertyPath()
+{
+    static const Entry *empty_entry = internEntry("", Entry{});
+    entry_ = empty_entry;
+}
+
+PropertyPath::PropertyPath(std::string path)
+{
+    entry_ = findEntry(path);
+    if (entry_ == nullptr) {
+        entry_ = internEntry(path, parsePath(path));
+    }
+}
+
+PropertyPath::PropertyPath(std::string dev_name, std::string property_name)
+{
+    Entry entry{};
+    entry.dev_name = dev_name;
+    entry.property_name = property_name;
+    std::string path = entryPath(entry);
+    entry_ = findEntry(path);
+    if (entry_ == nullptr) {
+        entry_ = internEntry(path, std::move(entry));
+    }
+}
+
+PropertyValueMap::iterator
+PropertyValueMap::lowerBound(const PropertyPath &path)
+{
+    return std::lower_bound(
+        values.begin(), values.end(), path,
+        [](const value_type &v, const PropertyPath &p) { return v.first < p; });
+}
+
+PropertyValueMap::const_iterator
+PropertyValueMap::lowerBound(const PropertyPath &path) const
+{
+    return std::lower_bound(
+        values.begin(), values.end(), path,
+        [](const value_type &v, const PropertyPath &p) { return v.first < p; });
+}
+
+PropertyValueMap::iterator PropertyValueMap::find(const PropertyPath &path)
+{
+    auto it = lowerBound(path);
+    if ((it == values.end()) || !(it->first == path)) {
+        return values.end();
+    }
+    return it;
+}
+
+PropertyValueMap::const_iterator
+PropertyValueMap::find(const PropertyPath &path) const
+{
+    auto it = lowerBound(path);
+    if ((it == values.end()) || !(it->first == path)) {
+        return values.end();
+    }
+    return it;
+}
+
+std::string &PropertyValueMap::operator[](const PropertyPath &path)
+{
+    auto it = lowerBound(path);
+    if ((it == values.end()) || !(it->first == path)) {
+        it = values.insert(it, value_type(path, std::string()));
+    }
+    return it->second;
+}
+
+const std::string &PropertyValueMap::at(const PropertyPath &path) const
+{
+    auto it = find(path);
+    if (it == values.end()) {
+        throw std::out_of_range(
+            fmt::format("property {} not in map", path.ToString()));
+    }
+    return it->second;
+}
+
+size_t PropertyValueMap::erase(const PropertyPath &path)
+{
+    auto it = find(path);
+    if (it == values.end()) {
+        return 0;
+    }
+    values.erase(it);
+    return 1;
+}
+
+void PropertyValueMap::merge(const PropertyValueMap &other)
+{
+    std::vector<value_type> merged;
+    merged.reserve(values.size() + other.values.size());
+    auto it = values.begin();
+    auto it_other = other.values.begin();
+    while ((it != values.end()) || (it_other != other.values.end())) {
+        if ((it_other == other.values.end()) ||
+            ((it != values.end()) && (it->first < it_other->first)))
+        {
+            merged.push_back(std::move(*it++));
+        } else if ((it == values.end()) || (it_other->first < it->first)) {
+            merged.push_back(*it_other++);
+        } else {
+            // Kept from this map
+            merged.push_back(std::move(*it++));
+            it_other++;
         }
-        return "/" + dev_name_ + "/" + property_name_;
     }
+    values = std::move(merged);
 }
 
-std::vector<PropertyPath> PropertyPathList(PropertyValueMap path_value_map)
+std::vector<PropertyPath>
+PropertyPathList(const PropertyValueMap &path_value_map)
 {
     std::vector<PropertyPath> path_list;
+    path_list.reserve(path_value_map.size());
     for (const auto &[path, value] : path_value_map) {
         path_list.push_back(path);
     }
+    std::sort(path_list.begin(), path_list.end(), PathNameLess());
     return path_list;
 }
 
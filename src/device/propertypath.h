@@ -1,47 +1,75 @@
 #ifndef DEVICE_PROPERTYPATH_H
 #define DEVICE_PROPERTYPATH_H
 
-#include <map>
+#include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
 #include <nlohmann/json.hpp>
 using json = nlohmann::ordered_json;
 
+// Dense ID of an interned path, in the order paths were first seen
+typedef uint32_t PropertyId;
+
+// A path is interned on construction, so copying and comparing paths does not
+// touch strings. Paths are never released. Besides the properties of the
+// devices, paths given by API clients are interned, so the number of paths is
+// capped, and constructing a new path beyond it throws std::length_error.
 class PropertyPath {
 public:
-    PropertyPath() {}
-    PropertyPath(std::string dev_name, std::string property_name)
-        : dev_name_(dev_name), property_name_(property_name)
-    {
-    }
+    PropertyPath();
+    PropertyPath(std::string dev_name, std::string property_name);
     PropertyPath(std::string path);
     PropertyPath(const char *path) : PropertyPath(std::string(path)) {}
 
     bool empty() const
     {
-        return (!root) && (dev_name_.empty()) && (property_name_.empty());
+        return (!entry_->root) && (entry_->dev_name.empty()) &&
+               (entry_->property_name.empty());
     }
 
-    bool IsRoot() const { return root; }
+    bool IsRoot() const { return entry_->root; }
     bool IsDevice() const
     {
-        return (!dev_name_.empty()) && (property_name_.empty());
+        return (!entry_->dev_name.empty()) && (entry_->property_name.empty());
     }
-    std::string DeviceName() const { return dev_name_; }
-    std::string PropertyName() const { return property_name_; }
-    std::string ToString() const;
+    const std::string &DeviceName() const { return entry_->dev_name; }
+    const std::string &PropertyName() const { return entry_->property_name; }
+    const std::string &ToString() const { return entry_->path; }
+    PropertyId Id() const { return entry_->id; }
+
+    struct Entry {
+        PropertyId id;
+        bool root;
+        std::string dev_name;
+        std::string property_name;
+        std::string path;
+    };
 
 private:
-    bool root = false;
-    std::string dev_name_;
-    std::string property_name_;
+    const Entry *entry_;
 };
 
+// By ID rather than by name, so a map of paths iterates in the order the
+// paths were first seen. That order differs from run to run, so anything
+// leaving the process is sorted with PathNameLess instead.
 inline bool operator<(const PropertyPath &lhs, const PropertyPath &rhs)
 {
-    return lhs.ToString() < rhs.ToString();
+    return lhs.Id() < rhs.Id();
+}
+
+struct PathNameLess {
+    bool operator()(const PropertyPath &lhs, const PropertyPath &rhs) const
+    {
+        return lhs.ToString() < rhs.ToString();
+    }
+};
+
+inline bool operator==(const PropertyPath &lhs, const PropertyPath &rhs)
+{
+    return lhs.Id() == rhs.Id();
 }
 
 template <> struct fmt::formatter<PropertyPath> : formatter<string_view> {
@@ -52,11 +80,46 @@ template <> struct fmt::formatter<PropertyPath> : formatter<string_view> {
     }
 };
 
-typedef std::map<PropertyPath, std::string> PropertyValueMap;
+// Values of properties in a vector sorted by ID. The subset of std::map used
+// by the callers, without a node per value.
+class PropertyValueMap {
+public:
+    typedef std::pair<PropertyPath, std::string> value_type;
+    typedef std::vector<value_type>::iterator iterator;
+    typedef std::vector<value_type>::const_iterator const_iterator;
+
+    iterator begin() { return values.begin(); }
+    iterator end() { return values.end(); }
+    const_iterator begin() const { return values.begin(); }
+    const_iterator end() const { return values.end(); }
+    size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+    void clear() { values.clear(); }
+    void reserve(size_t n) { values.reserve(n); }
+
+    iterator find(const PropertyPath &path);
+    const_iterator find(const PropertyPath &path) const;
+    bool contains(const PropertyPath &path) const
+    {
+        return find(path) != end();
+    }
+    std::string &operator[](const PropertyPath &path);
+    const std::string &at(const PropertyPath &path) const;
+    size_t erase(const PropertyPath &path);
+    // Adds the values of paths not in this map, like std::map::merge
+    void merge(const PropertyValueMap &other);
+
+private:
+    std::vector<value_type> values;
+    iterator lowerBound(const PropertyPath &path);
+    const_iterator lowerBound(const PropertyPath &path) const;
+};
 
 void from_json(const nlohmann::json &j, PropertyValueMap &pv);
 
 // Helper functions
-std::vector<PropertyPath> PropertyPathList(PropertyValueMap path_value_map);
+// Sorted by name
+std::vector<PropertyPath>
+PropertyPathList(const PropertyValueMap &path_value_map);
 
 #endif
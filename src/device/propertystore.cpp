@@ -0,0 +1,69 @@
+#include "device/propertystore.h"
+
+PropertySnapshotStore::PropertySnapshotStore()
+{
+    current.store(std::make_shared<const PropertySnapshot>());
+}
+
+PropertySnapshotPtr PropertySnapshotStore::Latest() const
+{
+    return current.load(std::memory_order_acquire);
+}
+
+void PropertySnapshotStore::Publish(const PropertyPath &path,
+                                    const std::string &value)
+{
+    std::lock_guard<std::mutex> lk(publish_mutex);
+    PropertySnapshotPtr latest = Latest();
+    auto it = latest->values.find(path);
+    if ((it != latest->values.end()) && (it->second == value)) {
+        return;
+    }
+    auto snapshot = std::make_shared<PropertySnapshot>(*latest);
+    snapshot->values[path] = value;
+    replace(snapshot);
+}
+
+void PropertySnapshotStore::Publish(const PropertyValueMap &values,
+                                    bool only_missing)
+{
+    std::lock_guard<std::mutex> lk(publish_mutex);
+    PropertySnapshotPtr latest = Latest();
+    auto snapshot = std::make_shared<PropertySnapshot>(*latest);
+    bool changed = false;
+    for (const auto &[path, value] : values) {
+        auto it = snapshot->values.find(path);
+        if (it == snapshot->values.end()) {
+            snapshot->values[path] = value;
+            changed = true;
+        } else if (!only_missing && (it->second != value)) {
+            it->second = value;
+            changed = true;
+        }
+    }
+    if (changed) {
+        replace(snapshot);
+    }
+}
+
+void PropertySnapshotStore::RemoveDevice(const std::string &dev_name)
+{
+    std::lock_guard<std::mutex> lk(publish_mutex);
+    PropertySnapshotPtr latest = Latest();
+    auto snapshot = std::make_shared<PropertySnapshot>();
+    for (const auto &[path, value] : latest->values) {
+        if (path.DeviceName() != dev_name) {
+            snapshot->values[path] = value;
+        }
+    }
+    if (snapshot->values.size() != latest->values.size()) {
+        snapshot->version = latest->version;
+        replace(snapshot);
+    }
+}
+
+void PropertySnapshotStore::replace(std::shared_ptr<PropertySnapshot> snapshot)
+{
+    snapshot->version++;
+    current.store(std::move(snapshot), std::memory_order_release);
+}
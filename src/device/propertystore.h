@@ -0,0 +1,46 @@
+#ifndef DEVICE_PROPERTYSTORE_H
+#define DEVICE_PROPERTYSTORE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "device/propertypath.h"
+
+// Values of all published properties at one version. Never modified once
+// published.
+struct PropertySnapshot {
+    uint64_t version = 0;
+    PropertyValueMap values;
+};
+
+typedef std::shared_ptr<const PropertySnapshot> PropertySnapshotPtr;
+
+// Latest values of device properties. Devices publish updates from their
+// callback threads, each into a new snapshot that replaces the current one.
+// Readers take the current snapshot without copying values or waiting for
+// publishers, and may keep it as long as needed.
+class PropertySnapshotStore {
+public:
+    PropertySnapshotStore();
+
+    PropertySnapshotPtr Latest() const;
+
+    void Publish(const PropertyPath &path, const std::string &value);
+    // Values of properties already in the store are kept if only_missing,
+    // e.g. when seeding from the nodes while updates arrive
+    void Publish(const PropertyValueMap &values, bool only_missing = false);
+    // Removes the properties of a device that is disconnected
+    void RemoveDevice(const std::string &dev_name);
+
+private:
+    // Serializes publishers, readers never take it
+    std::mutex publish_mutex;
+    std::atomic<PropertySnapshotPtr> current;
+
+    void replace(std::shared_ptr<PropertySnapshot> snapshot);
+};
+
+#endif
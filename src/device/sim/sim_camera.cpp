@@ -0,0 +1,378 @@
+#include "device/sim/sim_camera.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <optional>
+
+#include <fmt/format.h>
+
+#include "logging.h"
+#include "utils/time_utils.h"
+
+namespace Sim {
+
+static const int n_scenes = 4;
+static const float background = 100;
+
+SimCamera::SimCamera(SimConfig config) : props(CameraPropInfo(config))
+{
+    this->config = config;
+    rng.seed(config.seed);
+}
+
+SimCamera::~SimCamera()
+{
+    Status status = Disconnect();
+    (void)(status);
+}
+
+Status SimCamera::Connect()
+{
+    if (scenes.empty()) {
+        utils::StopWatch sw;
+        scenes = SyntheticCellImages(config, n_scenes);
+        LOG_DEBUG("Simulated camera: {} scenes generated [{:.0f} ms]",
+                  scenes.size(), sw.Milliseconds());
+    }
+    return props.Connect();
+}
+
+Status SimCamera::Disconnect()
+{
+    bool was_capturing;
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        was_capturing = capturing;
+    }
+    if (was_capturing) {
+        Status status = StopAcquisition();
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    return props.Disconnect();
+}
+
+::PropertyNode *SimCamera::Node(std::string name) { return props.Node(name); }
+
+std::map<std::string, ::PropertyNode *> SimCamera::NodeMap()
+{
+    return props.NodeMap();
+}
+
+void SimCamera::SubscribeEvents(EventStream *stream)
+{
+    props.SubscribeEvents(stream);
+}
+
+void SimCamera::SubscribeEvents(EventStream *stream,
+                                std::function<void(Event &)> middleware)
+{
+    props.SubscribeEvents(stream, middleware);
+}
+
+Status SimCamera::AllocBuffer(uint8_t n_frames)
+{
+    std::lock_guard<std::mutex> lk(mutex);
+    if (capturing) {
+        return absl::FailedPreconditionError("acquisition is running");
+    }
+    buffer.clear();
+    for (int i = 0; i < n_frames; i++) {
+        buffer.push_back(ImageData(config.height, config.width,
+                                   DataType::Uint16, ColorType::Mono16));
+    }
+    buffer_timestamp.assign(n_frames, {});
+    return absl::OkStatus();
+}
+
+Status SimCamera::ReleaseBuffer()
+{
+    std::lock_guard<std::mutex> lk(mutex);
+    if (capturing) {
+        return absl::FailedPreconditionError("acquisition is running");
+    }
+    buffer.clear();
+    buffer_timestamp.clear();
+    return absl::OkStatus();
+}
+
+uint8_t SimCamera::BufferAllocated()
+{
+    std::lock_guard<std::mutex> lk(mutex);
+    return buffer.size();
+}
+
+Status SimCamera::StartAcquisition() { return startCapture(false); }
+
+Status SimCamera::StartContinousAcquisition() { return startCapture(true); }
+
+Status SimCamera::startCapture(bool sequence)
+{
+    StatusOr<std::string> trigger_source = props.GetProperty("TRIGGER SOURCE");
+    if (!trigger_source.ok()) {
+        return trigger_source.status();
+    }
+
+    std::lock_guard<std::mutex> lk(mutex);
+    if (buffer.empty()) {
+        return absl::FailedPreconditionError("buffer not allocated");
+    }
+    if (capturing) {
+        return absl::FailedPreconditionError("acquisition is running");
+    }
+    internal_trigger = (trigger_source.value() == "INTERNAL");
+    n_remaining = sequence ? -1 : buffer.size();
+    n_trigger = 0;
+    n_exposure_end = 0;
+    frame_events.clear();
+    frame_count = 0;
+    capturing = true;
+    capture_thread = std::thread(&SimCamera::runCapture, this);
+    return absl::OkStatus();
+}
+
+Status SimCamera::StopAcquisition()
+{
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        capturing = false;
+    }
+    cv.notify_all();
+    if (capture_thread.joinable()) {
+        capture_thread.join();
+    }
+    return absl::OkStatus();
+}
+
+Status SimCamera::FireTrigger()
+{
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        if (!capturing || internal_trigger) {
+            return absl::FailedPreconditionError(
+                "not capturing with software trigger");
+        }
+        n_trigger++;
+    }
+    cv.notify_all();
+    return absl::OkStatus();
+}
+
+Status SimCamera::WaitExposureEnd(uint32_t timeout_ms)
+{
+    std::unique_lock<std::mutex> lk(mutex);
+    bool ok = cv.wait_for(lk, std::chrono::milliseconds(timeout_ms), [this] {
+        return (n_exposure_end > 0) || !capturing;
+    });
+    if (!ok) {
+        return absl::DeadlineExceededError("");
+    }
+    if (n_exposure_end == 0) {
+        return absl::CancelledError("wait is aborted");
+    }
+    n_exposure_end--;
+    return absl::OkStatus();
+}
+
+Status SimCamera::WaitFrameReady(uint32_t timeout_ms)
+{
+    std::unique_lock<std::mutex> lk(mutex);
+    bool ok = cv.wait_for(lk, std::chrono::milliseconds(timeout_ms), [this] {
+        return !frame_events.empty() || !capturing;
+    });
+    if (!ok) {
+        return absl::DeadlineExceededError("");
+    }
+    if (frame_events.empty()) {
+        return absl::CancelledError("wait is aborted");
+    }
+    bool frame_ok = frame_events.front();
+    frame_events.pop_front();
+    if (!frame_ok) {
+        return absl::DataLossError("frame data is lost (simulated)");
+    }
+    return absl::OkStatus();
+}
+
+StatusOr<ImageData>
+SimCamera::GetFrame(int32_t i_frame,
+                    std::chrono::system_clock::time_point *tp_exposure_end)
+{
+    std::lock_guard<std::mutex> lk(mutex);
+    if (frame_count == 0) {
+        return absl::FailedPreconditionError("no frame captured");
+    }
+    if (i_frame < 0) {
+        i_frame = (frame_count - 1) % buffer.size();
+    }
+    if (i_frame >= buffer.size()) {
+        return absl::InvalidArgumentError(
+            fmt::format("frame {} is not in the buffer", i_frame));
+    }
+
+    // Copied out of the buffer like the real camera
+    ImageData frame(config.height, config.width, DataType::Uint16,
+                    ColorType::Mono16);
+    std::memcpy(frame.Buf().get(), buffer[i_frame].Buf().get(),
+                frame.BufSize());
+    if (tp_exposure_end != nullptr) {
+        *tp_exposure_end = buffer_timestamp[i_frame];
+    }
+    return frame;
+}
+
+StatusOr<int32_t> SimCamera::GetFrameCount()
+{
+    std::lock_guard<std::mutex> lk(mutex);
+    return frame_count;
+}
+
+std::chrono::microseconds SimCamera::exposureTime()
+{
+    StatusOr<std::string> value = props.GetProperty("EXPOSURE TIME");
+    double exposure_s = 0.01;
+    if (value.ok()) {
+        try {
+            exposure_s = std::stod(value.value());
+        } catch (std::exception &e) {
+            LOG_WARN("Simulated camera: invalid EXPOSURE TIME {}",
+                     value.value());
+        }
+    }
+    return std::chrono::microseconds((int64_t)(exposure_s * 1e6));
+}
+
+void SimCamera::runCapture()
+{
+    using clock = std::chrono::steady_clock;
+    struct Readout {
+        clock::time_point tp_ready;
+        std::chrono::system_clock::time_point tp_exposure_end;
+    };
+
+    std::chrono::microseconds readout((int64_t)(config.readout_ms * 1000));
+    std::bernoulli_distribution lost(config.lost_frame_rate);
+    std::optional<clock::time_point> tp_exposure_end;
+    clock::time_point tp_readout_end = clock::now();
+    std::deque<Readout> readouts;
+    int i_scene = 0;
+
+    std::unique_lock<std::mutex> lk(mutex);
+    while (capturing) {
+        clock::time_point now = clock::now();
+
+        // An exposure can start during the readout of the previous frame, but
+        // does not end before that readout ends
+        if (!tp_exposure_end.has_value() && (n_remaining != 0) &&
+            (internal_trigger || (n_trigger > 0)))
+        {
+            if (!internal_trigger) {
+                n_trigger--;
+            }
+            if (n_remaining > 0) {
+                n_remaining--;
+            }
+            tp_exposure_end = std::max(now + exposureTime(), tp_readout_end);
+        }
+
+        if (tp_exposure_end.has_value() && (now >= tp_exposure_end.value())) {
+            tp_readout_end = tp_exposure_end.value() + readout;
+            readouts.push_back(Readout{
+                .tp_ready = tp_readout_end,
+                .tp_exposure_end =
+                    std::chrono::system_clock::now() -
+                    std::chrono::duration_cast<
+                        std::chrono::system_clock::duration>(
+                        now - tp_exposure_end.value()),
+            });
+            tp_exposure_end.reset();
+            // The camera keeps as many events as buffer frames
+            n_exposure_end = std::min<int>(n_exposure_end + 1, buffer.size());
+            cv.notify_all();
+            continue;
+        }
+
+        if (!readouts.empty() && (now >= readouts.front().tp_ready)) {
+            Readout frame = readouts.front();
+            readouts.pop_front();
+            bool frame_ok = !lost(rng);
+            if (frame_ok) {
+                int i_frame = frame_count % buffer.size();
+                std::memcpy(buffer[i_frame].Buf().get(),
+                            scenes[i_scene].Buf().get(),
+                            buffer[i_frame].BufSize());
+                buffer_timestamp[i_frame] = frame.tp_exposure_end;
+                frame_count++;
+                i_scene = (i_scene + 1) % scenes.size();
+            }
+            frame_events.push_back(frame_ok);
+            if (frame_events.size() > buffer.size()) {
+                frame_events.pop_front();
+            }
+            cv.notify_all();
+            continue;
+        }
+
+        // Sleep until the next event, or until woken by a trigger or stop
+        std::optional<clock::time_point> tp_next = tp_exposure_end;
+        if (!readouts.empty()) {
+            clock::time_point tp_ready = readouts.front().tp_ready;
+            tp_next = tp_next.has_value() ? std::min(tp_next.value(), tp_ready)
+                                          : tp_ready;
+        }
+        if (tp_next.has_value()) {
+            cv.wait_until(lk, tp_next.value());
+        } else {
+            cv.wait(lk);
+        }
+    }
+}
+
+std::vector<ImageData> SyntheticCellImages(const SimConfig &config, int n)
+{
+    uint32_t width = config.width;
+    uint32_t height = config.height;
+    std::mt19937 scene_rng(config.seed);
+
+    // Cells are soft discs of different size and brightness
+    std::vector<float> signal((size_t)width * height, background);
+    std::uniform_real_distribution<float> pos_x(0, width);
+    std::uniform_real_distribution<float> pos_y(0, height);
+    std::uniform_real_distribution<float> size(0.7, 1.3);
+    std::uniform_real_distribution<float> brightness(500, 3000);
+    for (int i = 0; i < config.n_cells; i++) {
+        float cx = pos_x(scene_rng);
+        float cy = pos_y(scene_rng);
+        float r = config.cell_radius_px * size(scene_rng);
+        float amp = brightness(scene_rng);
+        int x0 = std::max<int>(0, cx - 2 * r);
+        int x1 = std::min<int>(width, cx + 2 * r + 1);
+        int y0 = std::max<int>(0, cy - 2 * r);
+        int y1 = std::min<int>(height, cy + 2 * r + 1);
+        for (int y = y0; y < y1; y++) {
+            for (int x = x0; x < x1; x++) {
+                float d = std::hypot(x - cx, y - cy);
+                signal[(size_t)y * width + x] +=
+                    amp / (1 + std::exp((d - r) / 1.5f));
+            }
+        }
+    }
+
+    // Shot noise, approximated as normal
+    std::normal_distribution<float> noise(0, 1);
+    std::vector<ImageData> images;
+    for (int i = 0; i < n; i++) {
+        ImageData scene(height, width, DataType::Uint16, ColorType::Mono16);
+        uint16_t *buf = (uint16_t *)scene.Buf().get();
+        for (size_t k = 0; k < signal.size(); k++) {
+            float v = signal[k] + std::sqrt(signal[k]) * noise(scene_rng);
+            buf[k] = (uint16_t)std::clamp(v, 0.0f, 65535.0f);
+        }
+        images.push_back(scene);
+    }
+    return images;
+}
+
+} // namespace Sim
@@ -0,0 +1,95 @@
+#ifndef DEVICE_SIM_CAMERA_H
+#define DEVICE_SIM_CAMERA_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "device/camera.h"
+#include "device/sim/sim_config.h"
+#include "device/sim/sim_device.h"
+
+namespace Sim {
+
+// Frames of the same cells with different shot noise
+std::vector<ImageData> SyntheticCellImages(const SimConfig &config, int n);
+
+// Camera without hardware. Exposures follow EXPOSURE TIME and TRIGGER SOURCE,
+// and frames are ready after the readout time. Frames are synthetic cells
+// with shot noise.
+class SimCamera : public Camera {
+public:
+    SimCamera(SimConfig config);
+    ~SimCamera();
+
+    Status Connect() override;
+    Status Disconnect() override;
+    bool IsConnected() override { return props.IsConnected(); }
+
+    ::PropertyNode *Node(std::string name) override;
+    std::map<std::string, ::PropertyNode *> NodeMap() override;
+
+    // Property events are sent by the property device
+    void SubscribeEvents(EventStream *stream) override;
+    void SubscribeEvents(EventStream *stream,
+                         std::function<void(Event &)> middleware) override;
+
+    Status AllocBuffer(uint8_t n_frames) override;
+    Status ReleaseBuffer() override;
+    uint8_t BufferAllocated() override;
+
+    DataType GetDataType() override { return DataType::Uint16; }
+    ColorType GetColorType() override { return ColorType::Mono16; }
+    uint32_t GetWidth() override { return config.width; }
+    uint32_t GetHeight() override { return config.height; }
+
+    Status StartAcquisition() override;
+    Status StartContinousAcquisition() override;
+    Status StopAcquisition() override;
+    Status WaitExposureEnd(uint32_t timeout_ms) override;
+    Status WaitFrameReady(uint32_t timeout_ms) override;
+    StatusOr<ImageData> GetFrame(int32_t i_frame,
+                                 std::chrono::system_clock::time_point
+                                     *tp_exposure_end = nullptr) override;
+    StatusOr<int32_t> GetFrameCount() override;
+
+    Status FireTrigger() override;
+
+private:
+    SimConfig config;
+    SimDevice props;
+
+    // Synthetic frames, used in turn
+    std::vector<ImageData> scenes;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<ImageData> buffer;
+    std::vector<std::chrono::system_clock::time_point> buffer_timestamp;
+    int32_t frame_count = 0;
+
+    bool capturing = false;
+    bool internal_trigger = false;
+    int n_trigger = 0;
+    // Exposures left in a snap, or -1 in a sequence
+    int n_remaining = 0;
+    // Events not yet taken by a wait. Frame events are false if the frame
+    // was lost.
+    int n_exposure_end = 0;
+    std::deque<bool> frame_events;
+
+    std::mt19937 rng;
+    std::thread capture_thread;
+    Status startCapture(bool sequence);
+    void runCapture();
+    std::chrono::microseconds exposureTime();
+};
+
+} // namespace Sim
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef DEVICE_SIM_CONFIG_H
+#define DEVICE_SIM_CONFIG_H
+
+#include <cstdint>
+
+namespace Sim {
+
+// Timing and image parameters of the simulated devices. Defaults are close to
+// the instrument.
+struct SimConfig {
+    // Camera
+    uint32_t width = 2048;
+    uint32_t height = 2048;
+    // A frame is read out after its exposure. The next exposure overlaps with
+    // the readout.
+    double readout_ms = 10;
+    // Probability that a frame is lost after its exposure
+    double lost_frame_rate = 0;
+    int n_cells = 300;
+    double cell_radius_px = 12;
+    uint32_t seed = 1;
+
+    // Stage moves take the distance at this speed plus the settle time
+    double xy_speed_um_per_s = 10000;
+    double xy_settle_ms = 30;
+    double z_speed_um_per_s = 1000;
+    double z_settle_ms = 5;
+
+    double shutter_latency_ms = 10;
+    double filter_wheel_latency_ms = 60;
+    // Filter block, nosepiece and light path
+    double turret_latency_ms = 300;
+};
+
+} // namespace Sim
+
+#endif
@@ -0,0 +1,310 @@
+#include "device/sim/sim_device.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include <fmt/format.h>
+
+#include "logging.h"
+
+namespace Sim {
+
+SimDevice::SimDevice(std::map<std::string, PropInfo> prop_info)
+{
+    for (const auto &[name, info] : prop_info) {
+        PropertyNode *node = new PropertyNode;
+        node->dev = this;
+        node->name = name;
+        node->info = info;
+        node->snapshot_value = info.default_value;
+        node_map[name] = node;
+    }
+}
+
+SimDevice::~SimDevice()
+{
+    Status status = Disconnect();
+    (void)(status);
+    for (auto &[name, node] : node_map) {
+        delete node;
+    }
+}
+
+Status SimDevice::Connect()
+{
+    if (connected) {
+        return absl::OkStatus();
+    }
+    SendEvent({
+        .type = EventType::DeviceConnectionStateChanged,
+        .value = DeviceConnectionState::Connecting,
+    });
+
+    {
+        std::lock_guard<std::mutex> lk(pending_mutex);
+        stopping = false;
+    }
+    completion_thread = std::thread(&SimDevice::runCompletion, this);
+
+    connected = true;
+    SendEvent({
+        .type = EventType::DeviceConnectionStateChanged,
+        .value = DeviceConnectionState::Connected,
+    });
+    for (const auto &[name, node] : node_map) {
+        SendEvent({
+            .type = EventType::DevicePropertyValueUpdate,
+            .path = name,
+            .value = node->GetSnapshot().value_or(""),
+        });
+    }
+    return absl::OkStatus();
+}
+
+Status SimDevice::Disconnect()
+{
+    if (!completion_thread.joinable()) {
+        return absl::OkStatus();
+    }
+    SendEvent({
+        .type = EventType::DeviceConnectionStateChanged,
+        .value = DeviceConnectionState::Disconnecting,
+    });
+
+    {
+        std::lock_guard<std::mutex> lk(pending_mutex);
+        stopping = true;
+    }
+    pending_cv.notify_all();
+    completion_thread.join();
+
+    // Operations still pending are completed at once
+    for (const auto &[name, node] : node_map) {
+        node->completeSet(std::chrono::steady_clock::time_point::max());
+    }
+
+    connected = false;
+    SendEvent({
+        .type = EventType::DeviceConnectionStateChanged,
+        .value = DeviceConnectionState::NotConnected,
+    });
+    return absl::OkStatus();
+}
+
+::PropertyNode *SimDevice::Node(std::string name)
+{
+    auto it = node_map.find(name);
+    if (it == node_map.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+std::map<std::string, ::PropertyNode *> SimDevice::NodeMap()
+{
+    std::map<std::string, ::PropertyNode *> base_node_map;
+    for (auto &[name, node] : node_map) {
+        base_node_map[name] = node;
+    }
+    return base_node_map;
+}
+
+void SimDevice::schedule(PropertyNode *node,
+                         std::chrono::steady_clock::time_point tp_complete)
+{
+    {
+        std::lock_guard<std::mutex> lk(pending_mutex);
+        pending_ops.insert({tp_complete, node});
+    }
+    pending_cv.notify_all();
+}
+
+void SimDevice::runCompletion()
+{
+    std::unique_lock<std::mutex> lk(pending_mutex);
+    while (!stopping) {
+        if (pending_ops.empty()) {
+            pending_cv.wait(lk);
+            continue;
+        }
+        auto it = pending_ops.begin();
+        if (std::chrono::steady_clock::now() < it->first) {
+            pending_cv.wait_until(lk, it->first);
+            continue;
+        }
+        PropertyNode *node = it->second;
+        pending_ops.erase(it);
+
+        lk.unlock();
+        node->completeSet(std::chrono::steady_clock::now());
+        lk.lock();
+    }
+    pending_ops.clear();
+}
+
+StatusOr<std::string> PropertyNode::GetValue()
+{
+    if (!dev->IsConnected()) {
+        return absl::UnavailableError("device not connected");
+    }
+    std::shared_lock<std::shared_mutex> lk(mutex_snapshot);
+    return snapshot_value.value();
+}
+
+Status PropertyNode::SetValue(std::string value)
+{
+    if (!dev->IsConnected()) {
+        return absl::UnavailableError("device not connected");
+    }
+    if (!Writeable()) {
+        return absl::PermissionDeniedError("not writeable");
+    }
+    if (!info.options.empty() &&
+        (std::find(info.options.begin(), info.options.end(), value) ==
+         info.options.end()))
+    {
+        return absl::InvalidArgumentError(
+            fmt::format("invalid value '{}'", value));
+    }
+
+    double duration_ms = info.latency_ms;
+    if (info.speed_um_per_s > 0) {
+        std::string current_value = GetSnapshot().value_or(value);
+        try {
+            duration_ms += travelMilliseconds(current_value, value);
+        } catch (std::exception &e) {
+            return absl::InvalidArgumentError(
+                fmt::format("invalid position '{}': {}", value, e.what()));
+        }
+    }
+
+    if (duration_ms <= 0) {
+        handleValueUpdate(value);
+        dev->SendEvent({
+            .type = EventType::DeviceOperationComplete,
+            .path = name,
+            .value = value,
+        });
+        return absl::OkStatus();
+    }
+
+    auto tp = std::chrono::steady_clock::now() +
+              std::chrono::microseconds((int64_t)(duration_ms * 1000));
+    {
+        std::unique_lock<std::shared_mutex> lk(mutex_set);
+        pending_set_value = value;
+        tp_complete = tp;
+    }
+    dev->schedule(this, tp);
+    return absl::OkStatus();
+}
+
+Status PropertyNode::WaitFor(std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::shared_mutex> lk(mutex_set);
+    bool ok = cv_set.wait_for(
+        lk, timeout, [this] { return !pending_set_value.has_value(); });
+    if (ok) {
+        return absl::OkStatus();
+    } else {
+        return absl::DeadlineExceededError("");
+    }
+}
+
+Status PropertyNode::WaitUntil(std::chrono::steady_clock::time_point timepoint)
+{
+    std::unique_lock<std::shared_mutex> lk(mutex_set);
+    bool ok = cv_set.wait_until(
+        lk, timepoint, [this] { return !pending_set_value.has_value(); });
+    if (ok) {
+        return absl::OkStatus();
+    } else {
+        return absl::DeadlineExceededError("");
+    }
+}
+
+std::optional<std::string> PropertyNode::GetSnapshot()
+{
+    std::shared_lock<std::shared_mutex> lk(mutex_snapshot);
+    return snapshot_value;
+}
+
+double PropertyNode::travelMilliseconds(const std::string &from,
+                                        const std::string &to)
+{
+    auto parse = [](const std::string &value) {
+        std::vector<double> pos;
+        std::stringstream ss(value);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            pos.push_back(std::stod(item));
+        }
+        return pos;
+    };
+    std::vector<double> pos_from = parse(from);
+    std::vector<double> pos_to = parse(to);
+    if (pos_from.size() != pos_to.size()) {
+        throw std::invalid_argument(
+            fmt::format("expecting {} coordinates", pos_from.size()));
+    }
+
+    double dist_sq = 0;
+    for (int i = 0; i < pos_to.size(); i++) {
+        dist_sq += (pos_to[i] - pos_from[i]) * (pos_to[i] - pos_from[i]);
+    }
+    return std::sqrt(dist_sq) / info.speed_um_per_s * 1000;
+}
+
+void PropertyNode::completeSet(std::chrono::steady_clock::time_point now)
+{
+    std::string value;
+    std::optional<std::string> previous_value;
+    {
+        std::unique_lock<std::shared_mutex> lk(mutex_set);
+        // Entries of an operation replaced by a later set are stale
+        if (!pending_set_value.has_value() || (now < tp_complete)) {
+            return;
+        }
+        value = pending_set_value.value();
+        pending_set_value.reset();
+
+        // Update the value before waiters are released
+        std::unique_lock<std::shared_mutex> lk_snapshot(mutex_snapshot);
+        previous_value = snapshot_value;
+        snapshot_value = value;
+    }
+    cv_set.notify_all();
+
+    if (previous_value != value) {
+        dev->SendEvent({
+            .type = EventType::DevicePropertyValueUpdate,
+            .path = name,
+            .value = value,
+        });
+    }
+    dev->SendEvent({
+        .type = EventType::DeviceOperationComplete,
+        .path = name,
+        .value = value,
+    });
+}
+
+void PropertyNode::handleValueUpdate(std::string value)
+{
+    std::optional<std::string> previous_value;
+    {
+        std::unique_lock<std::shared_mutex> lk(mutex_snapshot);
+        previous_value = snapshot_value;
+        snapshot_value = value;
+    }
+    if (previous_value != value) {
+        dev->SendEvent({
+            .type = EventType::DevicePropertyValueUpdate,
+            .path = name,
+            .value = value,
+        });
+    }
+}
+
+} // namespace Sim
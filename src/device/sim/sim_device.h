@@ -0,0 +1,97 @@
+#ifndef DEVICE_SIM_DEVICE_H
+#define DEVICE_SIM_DEVICE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+
+#include <absl/status/status.h>
+#include <absl/status/statusor.h>
+
+#include "device/device.h"
+#include "device/sim/sim_prop_info.h"
+
+namespace Sim {
+
+using absl::Status;
+using absl::StatusOr;
+
+class PropertyNode;
+
+// Device without hardware. Set operations complete after the latency of the
+// property, with the same events as the real devices.
+class SimDevice : public Device {
+    friend class PropertyNode;
+
+public:
+    SimDevice(std::map<std::string, PropInfo> prop_info);
+    ~SimDevice();
+
+    Status Connect() override;
+    Status Disconnect() override;
+    bool IsConnected() override { return connected; }
+
+    ::PropertyNode *Node(std::string name) override;
+    std::map<std::string, ::PropertyNode *> NodeMap() override;
+
+private:
+    std::map<std::string, PropertyNode *> node_map;
+    std::atomic<bool> connected = false;
+
+    // Pending set operations by the time they complete
+    std::mutex pending_mutex;
+    std::condition_variable pending_cv;
+    std::multimap<std::chrono::steady_clock::time_point, PropertyNode *>
+        pending_ops;
+    bool stopping = false;
+    std::thread completion_thread;
+    void schedule(PropertyNode *node,
+                  std::chrono::steady_clock::time_point tp_complete);
+    void runCompletion();
+};
+
+class PropertyNode : public ::PropertyNode {
+    friend class SimDevice;
+
+public:
+    std::string Name() override { return name; }
+    std::string Description() override { return info.description; }
+    bool Valid() override { return dev->IsConnected(); }
+    bool Readable() override { return true; }
+    bool Writeable() override { return !info.readonly; }
+    std::vector<std::string> Options() override { return info.options; }
+
+    StatusOr<std::string> GetValue() override;
+    Status SetValue(std::string value) override;
+    Status WaitFor(std::chrono::milliseconds timeout) override;
+    Status WaitUntil(std::chrono::steady_clock::time_point timepoint) override;
+
+    std::optional<std::string> GetSnapshot() override;
+
+private:
+    SimDevice *dev;
+    std::string name;
+    PropInfo info;
+
+    double travelMilliseconds(const std::string &from, const std::string &to);
+    void completeSet(std::chrono::steady_clock::time_point now);
+    void handleValueUpdate(std::string value);
+
+    std::shared_mutex mutex_snapshot;
+    std::optional<std::string> snapshot_value;
+
+    std::shared_mutex mutex_set;
+    std::condition_variable_any cv_set;
+    std::optional<std::string> pending_set_value;
+    std::chrono::steady_clock::time_point tp_complete;
+};
+
+} // namespace Sim
+
+#endif
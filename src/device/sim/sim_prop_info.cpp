@@ -0,0 +1,139 @@
+#include "device/sim/sim_prop_info.h"
+
+#include <fmt/format.h>
+
+namespace Sim {
+
+std::map<std::string, PropInfo> NikonTiPropInfo(const SimConfig &config)
+{
+    return {
+        {"FilterBlock1",
+         {
+             .description = "Filter Block",
+             .default_value = "1",
+             .options = {"1", "2", "3", "4", "5", "6"},
+             .latency_ms = config.turret_latency_ms,
+         }},
+        {"LightPath",
+         {
+             .description = "Light Path",
+             .default_value = "1",
+             .options = {"1", "2", "3", "4"},
+             .latency_ms = config.turret_latency_ms,
+         }},
+        {"NosePiece",
+         {
+             .description = "Nose Piece",
+             .default_value = "1",
+             .options = {"1", "2", "3", "4", "5", "6"},
+             .latency_ms = config.turret_latency_ms,
+         }},
+        {"DiaShutter",
+         {
+             .description = "Dia Shutter",
+             .default_value = "Off",
+             .options = {"On", "Off"},
+             .latency_ms = config.shutter_latency_ms,
+         }},
+        {"DiaLampIntensity",
+         {
+             .description = "Dia Lamp Intensity",
+             .default_value = "12.0",
+         }},
+        {"ZDrivePosition",
+         {
+             .description = "Z Drive Position",
+             .default_value = "3000.000",
+             .latency_ms = config.z_settle_ms,
+             .speed_um_per_s = config.z_speed_um_per_s,
+         }},
+        {"PFSOffset",
+         {
+             .description = "PFS Offset",
+             .default_value = "0",
+         }},
+        {"PFSStatus",
+         {
+             .description = "PFS Status",
+             .default_value = "Out of focus search range",
+             .options = {"Out of focus search range", "Focusing", "Locked"},
+             .readonly = true,
+         }},
+        {"PFSState",
+         {
+             .description = "PFS State",
+             .default_value = "Off",
+             .options = {"On", "Off"},
+         }},
+    };
+}
+
+std::map<std::string, PropInfo> ProscanPropInfo(const SimConfig &config)
+{
+    return {
+        {"XYPosition",
+         {
+             .description = "Position of stage (x, y) in um",
+             .default_value = "0.0,0.0",
+             .latency_ms = config.xy_settle_ms,
+             .speed_um_per_s = config.xy_speed_um_per_s,
+         }},
+        {"FilterWheel1",
+         {
+             .description = "Filter Wheel 1",
+             .default_value = "1",
+             .options = {"1", "2", "3", "4", "5", "6"},
+             .latency_ms = config.filter_wheel_latency_ms,
+         }},
+        {"FilterWheel3",
+         {
+             .description = "Filter Wheel 3",
+             .default_value = "1",
+             .options = {"1", "2", "3", "4", "5", "6", "7", "8", "9", "10"},
+             .latency_ms = config.filter_wheel_latency_ms,
+         }},
+        {"LumenShutter",
+         {
+             .description = "Lumen Shutter",
+             .default_value = "Off",
+             .options = {"On", "Off"},
+             .latency_ms = config.shutter_latency_ms,
+         }},
+        {"LumenOutputIntensity",
+         {
+             .description = "Lumen Output Intensity",
+             .default_value = "100",
+         }},
+    };
+}
+
+std::map<std::string, PropInfo> CameraPropInfo(const SimConfig &config)
+{
+    return {
+        {"EXPOSURE TIME",
+         {
+             .description = "Exposure time in seconds",
+             .default_value = "0.01",
+         }},
+        {"TRIGGER SOURCE",
+         {
+             .description = "Trigger source",
+             .default_value = "INTERNAL",
+             .options = {"INTERNAL", "SOFTWARE"},
+         }},
+        {"BIT PER CHANNEL",
+         {
+             .description = "Bit per channel",
+             .default_value = "16",
+             .options = {"16"},
+         }},
+        {"INTERNAL FRAME RATE",
+         {
+             .description = "Maximum frame rate of the readout",
+             .default_value = fmt::format("{:g}", 1000 / config.readout_ms),
+             .readonly = true,
+         }},
+    };
+}
+
+} // namespace Sim
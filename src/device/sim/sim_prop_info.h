@@ -0,0 +1,32 @@
+#ifndef DEVICE_SIM_PROP_INFO_H
+#define DEVICE_SIM_PROP_INFO_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "device/sim/sim_config.h"
+
+namespace Sim {
+
+struct PropInfo {
+    std::string description;
+    std::string default_value;
+    std::vector<std::string> options;
+    bool readonly = false;
+
+    // A set operation completes after the latency, plus the travel time if
+    // the value is a position "x" or "x,y" in um and speed is set
+    double latency_ms = 0;
+    double speed_um_per_s = 0;
+};
+
+// Properties with the names of the real devices, so that channel presets and
+// tasks work unchanged
+std::map<std::string, PropInfo> NikonTiPropInfo(const SimConfig &config);
+std::map<std::string, PropInfo> ProscanPropInfo(const SimConfig &config);
+std::map<std::string, PropInfo> CameraPropInfo(const SimConfig &config);
+
+} // namespace Sim
+
+#endif
@@ -71,6 +71,8 @@ void EventSender::SendEvent(Event e)
         if (middleware.has_value()) {
             (*middleware)(e);
         }
-        stream->Send(e);
+        if (stream != nullptr) {
+            stream->Send(e);
+        }
     }
 }
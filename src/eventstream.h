@@ -68,6 +68,8 @@ private:
 class EventSender {
 public:
     virtual void SubscribeEvents(EventStream *stream);
+    // The middleware is called in the thread of the sender. Stream may be
+    // null to only call the middleware.
     virtual void SubscribeEvents(EventStream *stream,
                                  std::function<void(Event &)> middleware);
 
@@ -1,8 +1,11 @@
 #include "experimentcontrol.h"
 
+#include <ctime>
 #include <set>
 
 #include "logging.h"
+#include "utils/time_utils.h"
+#include "utils/trace.h"
 
 ExperimentControl::ExperimentControl(DeviceHub *dev)
 {
@@ -14,6 +17,11 @@ ExperimentControl::ExperimentControl(DeviceHub *dev)
     this->channel_control = new ChannelControl(dev);
     this->live_view_task = new LiveViewTask(this);
     this->multichannel_task = new MultiChannelTask(this);
+    this->autofocus_task = new AutofocusTask(this);
+    this->zstack_task = new ZStackTask(this);
+    this->scan_task =
+        new ScanTask(this, this->multichannel_task, this->autofocus_task);
+    this->timelapse_task = new TimelapseTask(this, this->scan_task);
 
     dev->SubscribeEvents(&dev_event_stream);
     handle_dev_event_future = std::async(
@@ -25,6 +33,7 @@ ExperimentControl::~ExperimentControl()
     dev_event_stream.Close();
     handle_dev_event_future.get();
 
+    waitPendingImages();
     if (db) {
         delete db;
     }
@@ -36,6 +45,10 @@ ExperimentControl::~ExperimentControl()
     delete channel_control;
     delete live_view_task;
     delete multichannel_task;
+    delete autofocus_task;
+    delete zstack_task;
+    delete scan_task;
+    delete timelapse_task;
 }
 
 void ExperimentControl::SubscribeEvents(EventStream *channel)
@@ -49,6 +62,10 @@ void ExperimentControl::SubscribeEvents(EventStream *channel)
     channel_control->SubscribeEvents(channel);
     live_view_task->SubscribeEvents(channel);
     multichannel_task->SubscribeEvents(channel);
+    autofocus_task->SubscribeEvents(channel);
+    zstack_task->SubscribeEvents(channel);
+    scan_task->SubscribeEvents(channel);
+    timelapse_task->SubscribeEvents(channel);
 }
 
 std::filesystem::path ExperimentControl::BaseDir()
@@ -131,6 +148,7 @@ void ExperimentControl::OpenExperimentDir(std::filesystem::path exp_dir)
 
 void ExperimentControl::CloseExperiment()
 {
+    waitPendingImages();
     if (this->db) {
         delete this->db;
         this->db = nullptr;
@@ -141,6 +159,16 @@ void ExperimentControl::CloseExperiment()
     });
 }
 
+void ExperimentControl::waitPendingImages()
+{
+    // Queued frames belong to the DB and the zip of the open experiment
+    try {
+        image_manager->WaitPendingImages();
+    } catch (std::exception &e) {
+        LOG_ERROR("Failed to save pending images: {}", e.what());
+    }
+}
+
 bool ExperimentControl::is_open()
 {
     return (!exp_dir.empty()) && (db != nullptr);
@@ -158,6 +186,23 @@ ImageManager *ExperimentControl::Images() { return image_manager; }
 
 AnalysisManager *ExperimentControl::Analysis() { return analysis_manager; }
 
+void ExperimentControl::saveTrace(utils::TraceSession &trace)
+{
+    if (!is_open()) {
+        return;
+    }
+    try {
+        std::filesystem::path dir = exp_dir / "traces";
+        std::filesystem::create_directories(dir);
+        std::string filename =
+            fmt::format("{:%Y%m%d-%H%M%S}-{}.json",
+                        fmt::localtime(std::time(nullptr)), trace.Name());
+        trace.Save(dir / filename);
+    } catch (std::exception &e) {
+        LOG_WARN("Failed to save trace {}: {}", trace.Name(), e.what());
+    }
+}
+
 void ExperimentControl::runLiveView()
 {
     if (is_busy) {
@@ -227,6 +272,9 @@ void ExperimentControl::StartLiveView()
         throw std::runtime_error(
             "Cannot start live view: task control is in busy state");
     }
+    if (dev->GetCamera() == nullptr) {
+        throw std::runtime_error("Cannot start live view: no camera");
+    }
 
     //
     // Clear the future and log errors we missed
@@ -269,6 +317,43 @@ void ExperimentControl::StopLiveView()
 
 bool ExperimentControl::IsLiveRunning() { return live_view_task->IsRunning(); }
 
+void ExperimentControl::StartLiveRecording(std::string name, double duration_s,
+                                           std::string ch_name)
+{
+    if (!is_open()) {
+        throw std::runtime_error("experiment not open");
+    }
+    if (name.empty()) {
+        throw std::invalid_argument("empty recording name");
+    }
+    std::filesystem::path dir = exp_dir / "recordings";
+    std::filesystem::create_directories(dir);
+    if (std::filesystem::exists(dir / (name + ".raw"))) {
+        throw std::invalid_argument("recording already exists");
+    }
+    live_view_task->StartRecording(dir, name, ch_name, duration_s);
+}
+
+LiveRecordingStats ExperimentControl::StopLiveRecording()
+{
+    return live_view_task->StopRecording();
+}
+
+std::optional<LiveRecordingStats> ExperimentControl::GetLiveRecordingStats()
+{
+    return live_view_task->RecordingStats();
+}
+
+void ExperimentControl::ImportLiveRecording(std::string name,
+                                            std::string ndimage_name)
+{
+    if (!is_open()) {
+        throw std::runtime_error("experiment not open");
+    }
+    image_manager->ImportRecording(exp_dir / "recordings" / (name + ".json"),
+                                   ndimage_name);
+}
+
 void ExperimentControl::runMultiChannelTask(std::string ndimage_name,
                                             std::vector<Channel> channels,
                                             int i_z, int i_t, Site *site,
@@ -287,9 +372,11 @@ void ExperimentControl::runMultiChannelTask(std::string ndimage_name,
     }
 
     is_busy = true;
+    utils::TraceSession trace(fmt::format("multichannel-{}", ndimage_name));
     try {
         Status status = multichannel_task->Acquire(ndimage_name, channels, i_z,
                                                    i_t, site, metadata);
+        image_manager->WaitPendingImages();
         if (!status.ok()) {
             throw std::runtime_error(status.ToString());
         }
@@ -309,10 +396,12 @@ void ExperimentControl::runMultiChannelTask(std::string ndimage_name,
             .type = EventType::TaskMessage,
             .value = message,
         });
+        saveTrace(trace);
         throw std::runtime_error(message);
     }
 
     is_busy = false;
+    saveTrace(trace);
     SendEvent({
         .type = EventType::TaskStateChanged,
         .value = "Ready",
@@ -332,6 +421,9 @@ void ExperimentControl::AcquireMultiChannel(std::string ndimage_name,
         throw std::runtime_error(
             "Cannot start task: task control is in busy state");
     }
+    if (dev->GetCamera() == nullptr) {
+        throw std::runtime_error("Cannot start task: no camera");
+    }
 
     //
     // Clear the future and log errors we missed
@@ -358,6 +450,339 @@ void ExperimentControl::WaitMultiChannelTask()
     current_task_future.get();
 }
 
+void ExperimentControl::runZStack(std::string ndimage_name,
+                                  std::vector<Channel> channels,
+                                  ZStackParams params, int i_t, Site *site,
+                                  nlohmann::ordered_json metadata)
+{
+    if (is_busy) {
+        throw std::runtime_error(
+            "Cannot start Z-stack: task control is in busy state");
+    }
+
+    std::lock_guard<std::mutex> lk(task_mutex);
+
+    if (is_busy) {
+        throw std::runtime_error(
+            "Cannot start Z-stack: task control is in busy state");
+    }
+
+    is_busy = true;
+    utils::TraceSession trace(fmt::format("zstack-{}", ndimage_name));
+    try {
+        Status status = zstack_task->Acquire(ndimage_name, channels, params,
+                                             i_t, site, metadata);
+        image_manager->WaitPendingImages();
+        if (!status.ok()) {
+            throw std::runtime_error(status.ToString());
+        }
+    } catch (std::exception &e) {
+        is_busy = false;
+        std::string message = fmt::format("Error in Z-stack: {}", e.what());
+        LOG_ERROR(message);
+        SendEvent({
+            .type = EventType::TaskStateChanged,
+            .value = "Ready",
+        });
+        SendEvent({
+            .type = EventType::TaskMessage,
+            .value = message,
+        });
+        saveTrace(trace);
+        throw std::runtime_error(message);
+    }
+
+    is_busy = false;
+    saveTrace(trace);
+    SendEvent({
+        .type = EventType::TaskStateChanged,
+        .value = "Ready",
+    });
+}
+
+void ExperimentControl::AcquireZStack(std::string ndimage_name,
+                                      std::vector<Channel> channels,
+                                      ZStackParams params, int i_t, Site *site,
+                                      nlohmann::ordered_json metadata)
+{
+    if (is_busy) {
+        throw std::runtime_error(
+            "Cannot start Z-stack: task control is in busy state");
+    }
+    if (dev->GetCamera() == nullptr) {
+        throw std::runtime_error("Cannot start Z-stack: no camera");
+    }
+
+    if (current_task_future.valid()) {
+        try {
+            current_task_future.get();
+        } catch (std::exception &e) {
+            LOG_WARN("Ignore error in previous task: {}", e.what());
+        }
+    }
+
+    current_task_future =
+        std::async(std::launch::async, &ExperimentControl::runZStack, this,
+                   ndimage_name, channels, params, i_t, site, metadata);
+}
+
+void ExperimentControl::WaitZStack()
+{
+    // Wait and get exception
+    current_task_future.get();
+}
+
+AutofocusResult ExperimentControl::Autofocus(Channel channel,
+                                             AutofocusParams params)
+{
+    if (is_busy) {
+        throw std::runtime_error(
+            "Cannot start autofocus: task control is in busy state");
+    }
+    if (dev->GetCamera() == nullptr) {
+        throw std::runtime_error("Cannot start autofocus: no camera");
+    }
+
+    std::lock_guard<std::mutex> lk(task_mutex);
+
+    if (is_busy) {
+        throw std::runtime_error(
+            "Cannot start autofocus: task control is in busy state");
+    }
+
+    is_busy = true;
+    utils::TraceSession trace("autofocus");
+    SendEvent({
+        .type = EventType::TaskStateChanged,
+        .value = "Running",
+    });
+    AutofocusResult result;
+    try {
+        StatusOr<AutofocusResult> status_or =
+            autofocus_task->Run(channel, params);
+        if (!status_or.ok()) {
+            throw std::runtime_error(status_or.status().ToString());
+        }
+        result = status_or.value();
+    } catch (std::exception &e) {
+        is_busy = false;
+        std::string message = fmt::format("Error in autofocus: {}", e.what());
+        LOG_ERROR(message);
+        SendEvent({
+            .type = EventType::TaskStateChanged,
+            .value = "Ready",
+        });
+        SendEvent({
+            .type = EventType::TaskMessage,
+            .value = message,
+        });
+        saveTrace(trace);
+        throw std::runtime_error(message);
+    }
+
+    is_busy = false;
+    saveTrace(trace);
+    SendEvent({
+        .type = EventType::TaskStateChanged,
+        .value = "Ready",
+    });
+    return result;
+}
+
+void ExperimentControl::runScan(ScanPlan plan)
+{
+    if (is_busy) {
+        throw std::runtime_error(
+            "Cannot start scan: task control is in busy state");
+    }
+
+    std::lock_guard<std::mutex> lk(task_mutex);
+
+    if (is_busy) {
+        throw std::runtime_error(
+            "Cannot start scan: task control is in busy state");
+    }
+
+    is_busy = true;
+    utils::TraceSession trace("scan");
+    try {
+        Status status = scan_task->Run(plan);
+        if (!status.ok()) {
+            throw std::runtime_error(status.ToString());
+        }
+    } catch (std::exception &e) {
+        is_busy = false;
+        std::string message = fmt::format("Error in scan: {}", e.what());
+        LOG_ERROR(message);
+        SendEvent({
+            .type = EventType::TaskStateChanged,
+            .value = "Ready",
+        });
+        SendEvent({
+            .type = EventType::TaskMessage,
+            .value = message,
+        });
+        saveTrace(trace);
+        throw std::runtime_error(message);
+    }
+
+    is_busy = false;
+    saveTrace(trace);
+    SendEvent({
+        .type = EventType::TaskStateChanged,
+        .value = "Ready",
+    });
+}
+
+SitePath ExperimentControl::PlanScan(ScanPlan plan)
+{
+    StatusOr<SitePath> path = scan_task->PlanPath(plan);
+    if (!path.ok()) {
+        throw std::runtime_error(
+            fmt::format("Cannot plan scan: {}", path.status().ToString()));
+    }
+    return path.value();
+}
+
+void ExperimentControl::StartScan(ScanPlan plan)
+{
+    //
+    // Check for obvious errors and throw exception immediately
+    //
+    if (is_busy) {
+        throw std::runtime_error(
+            "Cannot start scan: task control is in busy state");
+    }
+    if (dev->GetCamera() == nullptr) {
+        throw std::runtime_error("Cannot start scan: no camera");
+    }
+
+    //
+    // Clear the future and log errors we missed
+    //
+    if (current_task_future.valid()) {
+        try {
+            current_task_future.get();
+        } catch (std::exception &e) {
+            LOG_WARN("Ignore error in previous task: {}", e.what());
+        }
+    }
+
+    //
+    // Start async task, and wait for its first progress update so that
+    // progress read right after this call belongs to the new scan
+    //
+    uint64_t seq = scan_task->Progress().seq;
+    scan_task->Arm();
+    current_task_future = std::async(std::launch::async,
+                                     &ExperimentControl::runScan, this, plan);
+    scan_task->WaitProgress(seq, std::chrono::seconds(1));
+}
+
+void ExperimentControl::PauseScan() { scan_task->Pause(); }
+
+void ExperimentControl::ResumeScan() { scan_task->Resume(); }
+
+void ExperimentControl::StopScan() { scan_task->Stop(); }
+
+void ExperimentControl::WaitScan()
+{
+    // Wait and get exception
+    current_task_future.get();
+}
+
+ScanProgress ExperimentControl::GetScanProgress()
+{
+    return scan_task->Progress();
+}
+
+ScanProgress
+ExperimentControl::WaitScanProgress(uint64_t seq,
+                                    std::chrono::milliseconds timeout)
+{
+    return scan_task->WaitProgress(seq, timeout);
+}
+
+void ExperimentControl::runTimelapse(std::vector<TimelapseGroup> groups,
+                                     OverrunPolicy policy)
+{
+    if (is_busy) {
+        throw std::runtime_error(
+            "Cannot start time-lapse: task control is in busy state");
+    }
+
+    std::lock_guard<std::mutex> lk(task_mutex);
+
+    if (is_busy) {
+        throw std::runtime_error(
+            "Cannot start time-lapse: task control is in busy state");
+    }
+
+    is_busy = true;
+    try {
+        Status status = timelapse_task->Run(groups, policy);
+        if (!status.ok()) {
+            throw std::runtime_error(status.ToString());
+        }
+    } catch (std::exception &e) {
+        is_busy = false;
+        std::string message = fmt::format("Error in time-lapse: {}", e.what());
+        LOG_ERROR(message);
+        SendEvent({
+            .type = EventType::TaskStateChanged,
+            .value = "Ready",
+        });
+        SendEvent({
+            .type = EventType::TaskMessage,
+            .value = message,
+        });
+        throw std::runtime_error(message);
+    }
+
+    is_busy = false;
+    SendEvent({
+        .type = EventType::TaskStateChanged,
+        .value = "Ready",
+    });
+}
+
+void ExperimentControl::StartTimelapse(std::vector<TimelapseGroup> groups,
+                                       OverrunPolicy policy)
+{
+    if (is_busy) {
+        throw std::runtime_error(
+            "Cannot start time-lapse: task control is in busy state");
+    }
+    if (dev->GetCamera() == nullptr) {
+        throw std::runtime_error("Cannot start time-lapse: no camera");
+    }
+
+    if (current_task_future.valid()) {
+        try {
+            current_task_future.get();
+        } catch (std::exception &e) {
+            LOG_WARN("Ignore error in previous task: {}", e.what());
+        }
+    }
+
+    timelapse_task->Arm();
+    current_task_future =
+        std::async(std::launch::async, &ExperimentControl::runTimelapse, this,
+                   groups, policy);
+}
+
+void ExperimentControl::StopTimelapse() { timelapse_task->Stop(); }
+
+void ExperimentControl::WaitTimelapse()
+{
+    // Wait and get exception
+    current_task_future.get();
+}
+
+TimelapseStatus ExperimentControl::GetTimelapseStatus()
+{
+    return timelapse_task->GetStatus();
+}
 
 void ExperimentControl::handleDeviceEvents()
 {
@@ -10,9 +10,14 @@
 #include "experimentdb.h"
 #include "image/imagemanager.h"
 #include "sample/samplemanager.h"
+#include "task/autofocus_task.h"
 #include "task/channelcontrol.h"
 #include "task/live_view_task.h"
 #include "task/multi_channel_task.h"
+#include "task/scan_task.h"
+#include "task/timelapse_task.h"
+#include "task/zstack_task.h"
+#include "utils/trace.h"
 
 class ExperimentControl : public EventSender {
 public:
@@ -40,12 +45,47 @@ public:
     void StopLiveView();
     bool IsLiveRunning();
 
+    // Records every live frame to the recordings directory of the experiment,
+    // for duration_s or until stopped if 0
+    void StartLiveRecording(std::string name, double duration_s = 0,
+                            std::string ch_name = "Live");
+    LiveRecordingStats StopLiveRecording();
+    std::optional<LiveRecordingStats> GetLiveRecordingStats();
+    void ImportLiveRecording(std::string name, std::string ndimage_name);
+
     void AcquireMultiChannel(std::string ndimage_name,
                              std::vector<Channel> channels, int i_z, int i_t,
                              Site *site = nullptr,
                              nlohmann::ordered_json metadata = nullptr);
     void WaitMultiChannelTask();
 
+    void AcquireZStack(std::string ndimage_name, std::vector<Channel> channels,
+                       ZStackParams params, int i_t = 0, Site *site = nullptr,
+                       nlohmann::ordered_json metadata = nullptr);
+    void WaitZStack();
+
+    AutofocusResult Autofocus(Channel channel, AutofocusParams params = {});
+
+    // Order of sites and predicted stage travel of a scan
+    SitePath PlanScan(ScanPlan plan);
+    // Scan runs in the background, and can be paused or stopped between sites
+    void StartScan(ScanPlan plan);
+    void PauseScan();
+    void ResumeScan();
+    void StopScan();
+    void WaitScan();
+    ScanProgress GetScanProgress();
+    ScanProgress WaitScanProgress(uint64_t seq,
+                                  std::chrono::milliseconds timeout);
+
+    // Time-lapse runs the scan of each group at its interval in the
+    // background, until all rounds are done or stopped
+    void StartTimelapse(std::vector<TimelapseGroup> groups,
+                        OverrunPolicy policy);
+    void StopTimelapse();
+    void WaitTimelapse();
+    TimelapseStatus GetTimelapseStatus();
+
 private:
     DeviceHub *dev;
     SampleManager *sample_manager;
@@ -63,14 +103,27 @@ private:
 
     LiveViewTask *live_view_task;
     MultiChannelTask *multichannel_task;
+    AutofocusTask *autofocus_task;
+    ZStackTask *zstack_task;
+    ScanTask *scan_task;
+    TimelapseTask *timelapse_task;
 
     std::mutex task_mutex;
     std::atomic<bool> is_busy = false;
     std::future<void> current_task_future;
+    // Spans of a task are saved to the traces directory of the experiment
+    void saveTrace(utils::TraceSession &trace);
+    void waitPendingImages();
     void runLiveView();
     void runMultiChannelTask(std::string ndimage_name,
                              std::vector<Channel> channels, int i_z, int i_t,
                              Site *site, nlohmann::ordered_json metadata);
+    void runZStack(std::string ndimage_name, std::vector<Channel> channels,
+                   ZStackParams params, int i_t, Site *site,
+                   nlohmann::ordered_json metadata);
+    void runScan(ScanPlan plan);
+    void runTimelapse(std::vector<TimelapseGroup> groups,
+                      OverrunPolicy policy);
 };
 
 #endif
@@ -40,6 +40,15 @@ CREATE TABLE "Site" (
   FOREIGN KEY ("plate_id", "well_id") REFERENCES "Well" ("plate_id", "well_id") ON DELETE CASCADE
 );
 
+CREATE TABLE "FocusPoint" (
+  "plate_id" TEXT NOT NULL REFERENCES "Plate" ("plate_id") ON DELETE CASCADE,
+  "well_id" TEXT NOT NULL,
+  "rel_pos_x" REAL NOT NULL,
+  "rel_pos_y" REAL NOT NULL,
+  "z" REAL NOT NULL,
+  PRIMARY KEY ("plate_id", "well_id")
+);
+
 CREATE TABLE "NDImage" (
   "index" INTEGER NOT NULL,
   "name" TEXT NOT NULL PRIMARY KEY,
@@ -67,12 +76,14 @@ CREATE TABLE "Image" (
   "pos_x" REAL,
   "pos_y" REAL,
   "pos_z" REAL,
+  "planned_time" TEXT,
+  "acquired_time" TEXT,
   PRIMARY KEY ("ndimage_name", "ch_name", "i_z", "i_t")
 );
 )";
 
 std::string sql_check_schema = R"(
-SELECT "Image"."ndimage_name", "Image"."ch_name", "Image"."i_z", "Image"."i_t", "Image"."path", "Image"."exposure_ms", "Image"."pos_x", "Image"."pos_y", "Image"."pos_z"
+SELECT "Image"."ndimage_name", "Image"."ch_name", "Image"."i_z", "Image"."i_t", "Image"."path", "Image"."exposure_ms", "Image"."pos_x", "Image"."pos_y", "Image"."pos_z", "Image"."planned_time", "Image"."acquired_time"
 FROM "Image" "Image"
 WHERE 0 = 1;
 
@@ -91,8 +102,30 @@ WHERE 0 = 1;
 SELECT "Well"."plate_id", "Well"."well_id", "Well"."rel_pos_x", "Well"."rel_pos_y", "Well"."enabled", "Well"."metadata"
 FROM "Well" "Well"
 WHERE 0 = 1;
+
+SELECT "FocusPoint"."plate_id", "FocusPoint"."well_id", "FocusPoint"."rel_pos_x", "FocusPoint"."rel_pos_y", "FocusPoint"."z"
+FROM "FocusPoint" "FocusPoint"
+WHERE 0 = 1;
+)";
+
+// Tables added after the initial schema, created when opening older files
+std::string sql_upgrade_tables = R"(
+CREATE TABLE IF NOT EXISTS "FocusPoint" (
+  "plate_id" TEXT NOT NULL REFERENCES "Plate" ("plate_id") ON DELETE CASCADE,
+  "well_id" TEXT NOT NULL,
+  "rel_pos_x" REAL NOT NULL,
+  "rel_pos_y" REAL NOT NULL,
+  "z" REAL NOT NULL,
+  PRIMARY KEY ("plate_id", "well_id")
+);
 )";
 
+// Columns added after the initial schema, added when opening older files
+static const std::vector<std::vector<std::string>> upgrade_columns = {
+    {"Image", "planned_time", "TEXT"},
+    {"Image", "acquired_time", "TEXT"},
+};
+
 ExperimentDB::ExperimentDB(std::filesystem::path filename)
 {
     bool is_new_file = !std::filesystem::exists(filename);
@@ -109,6 +142,8 @@ ExperimentDB::ExperimentDB(std::filesystem::path filename)
     if (is_new_file) {
         createTables();
     } else {
+        exec(sql_upgrade_tables);
+        upgradeColumns();
         checkSchema();
     }
 }
@@ -189,6 +224,26 @@ std::vector<SiteRow> ExperimentDB::GetAllSites()
     return results;
 }
 
+std::vector<FocusPointRow> ExperimentDB::GetAllFocusPoints()
+{
+    std::vector<FocusPointRow> results;
+
+    sqlite3_stmt *stmt = prepare(
+        R"(SELECT plate_id, well_id, rel_pos_x, rel_pos_y, z FROM FocusPoint ORDER BY plate_id, well_id)");
+    while (step(stmt)) {
+        results.emplace_back(FocusPointRow{
+            .plate_id = (const char *)(sqlite3_column_text(stmt, 0)),
+            .well_id = (const char *)(sqlite3_column_text(stmt, 1)),
+            .rel_pos_x = sqlite3_column_double(stmt, 2),
+            .rel_pos_y = sqlite3_column_double(stmt, 3),
+            .z = sqlite3_column_double(stmt, 4),
+        });
+    }
+    finalize(stmt);
+
+    return results;
+}
+
 std::vector<NDImageRow> ExperimentDB::GetAllNDImages()
 {
     std::vector<NDImageRow> results;
@@ -221,7 +276,7 @@ std::vector<ImageRow> ExperimentDB::GetAllImages()
 
     sqlite3_stmt *stmt =
         prepare("SELECT ndimage_name, ch_name, i_z, i_t, path, exposure_ms, "
-                "pos_x, pos_y, pos_z FROM Image");
+                "pos_x, pos_y, pos_z, planned_time, acquired_time FROM Image");
     while (step(stmt)) {
         auto row = ImageRow{
             .ndimage_name = (const char *)(sqlite3_column_text(stmt, 0)),
@@ -240,6 +295,12 @@ std::vector<ImageRow> ExperimentDB::GetAllImages()
         if (sqlite3_column_type(stmt, 8) != SQLITE_NULL) {
             row.pos_z = sqlite3_column_double(stmt, 8);
         }
+        if (sqlite3_column_type(stmt, 9) != SQLITE_NULL) {
+            row.planned_time = (const char *)(sqlite3_column_text(stmt, 9));
+        }
+        if (sqlite3_column_type(stmt, 10) != SQLITE_NULL) {
+            row.acquired_time = (const char *)(sqlite3_column_text(stmt, 10));
+        }
         results.push_back(row);
     }
     finalize(stmt);
@@ -270,6 +331,36 @@ void ExperimentDB::checkSchema()
     }
 }
 
+void ExperimentDB::upgradeColumns()
+{
+    for (const auto &column : upgrade_columns) {
+        if (hasColumn(column[0], column[1])) {
+            continue;
+        }
+        try {
+            exec(fmt::format(R"(ALTER TABLE "{}" ADD COLUMN "{}" {})",
+                             column[0], column[1], column[2]));
+        } catch (std::exception &e) {
+            throw std::runtime_error(
+                fmt::format("upgrade db schema: {}", e.what()));
+        }
+    }
+}
+
+bool ExperimentDB::hasColumn(std::string table, std::string column)
+{
+    sqlite3_stmt *stmt =
+        prepare(fmt::format(R"(PRAGMA table_info("{}"))", table));
+    bool found = false;
+    while (step(stmt)) {
+        if (column == (const char *)(sqlite3_column_text(stmt, 1))) {
+            found = true;
+        }
+    }
+    finalize(stmt);
+    return found;
+}
+
 void ExperimentDB::InsertOrReplaceRow(PlateRow row)
 {
     sqlite3_stmt *stmt = prepare(R"(
@@ -309,6 +400,26 @@ void ExperimentDB::InsertOrReplaceRow(SiteRow row)
     finalize(stmt);
 }
 
+void ExperimentDB::InsertOrReplaceRow(FocusPointRow row)
+{
+    sqlite3_stmt *stmt = prepare(R"(
+        INSERT OR REPLACE INTO "FocusPoint" (plate_id, well_id, rel_pos_x, rel_pos_y, z)
+        VALUES (?,?,?,?,?)
+        )");
+    bind(stmt, row.plate_id, row.well_id, row.rel_pos_x, row.rel_pos_y, row.z);
+    step(stmt);
+    finalize(stmt);
+}
+
+void ExperimentDB::DeleteFocusPoints(std::string plate_id)
+{
+    sqlite3_stmt *stmt =
+        prepare(R"(DELETE FROM "FocusPoint" WHERE plate_id = ?)");
+    bind(stmt, plate_id);
+    step(stmt);
+    finalize(stmt);
+}
+
 void ExperimentDB::InsertOrReplaceRow(NDImageRow row)
 {
     sqlite3_stmt *stmt = prepare(R"(
@@ -325,11 +436,12 @@ void ExperimentDB::InsertOrReplaceRow(NDImageRow row)
 void ExperimentDB::InsertOrReplaceRow(ImageRow row)
 {
     sqlite3_stmt *stmt = prepare(R"(
-        INSERT OR REPLACE INTO "Image" (ndimage_name, ch_name, i_z, i_t, path, exposure_ms, pos_x, pos_y, pos_z)
-        VALUES (?,?,?,?,?,?,?,?,?)
+        INSERT OR REPLACE INTO "Image" (ndimage_name, ch_name, i_z, i_t, path, exposure_ms, pos_x, pos_y, pos_z, planned_time, acquired_time)
+        VALUES (?,?,?,?,?,?,?,?,?,?,?)
         )");
     bind(stmt, row.ndimage_name, row.ch_name, row.i_z, row.i_t, row.path,
-         row.exposure_ms, row.pos_x, row.pos_y, row.pos_z);
+         row.exposure_ms, row.pos_x, row.pos_y, row.pos_z, row.planned_time,
+         row.acquired_time);
     step(stmt);
     finalize(stmt);
 }
@@ -449,6 +561,21 @@ void ExperimentDB::bind(sqlite3_stmt *stmt, int index,
     }
 }
 
+void ExperimentDB::bind(sqlite3_stmt *stmt, int index,
+                        const std::optional<std::string> &value)
+{
+    int rc;
+    if (value.has_value()) {
+        rc = sqlite3_bind_text(stmt, index, value->c_str(), value->size(),
+                               NULL);
+    } else {
+        rc = sqlite3_bind_null(stmt, index);
+    }
+    if (rc != SQLITE_OK) {
+        throw std::runtime_error(fmt::format("bind: {}\n", sqlite3_errmsg(db)));
+    }
+}
+
 void ExperimentDB::bind(sqlite3_stmt *stmt, int index, const bool value)
 {
     int rc = sqlite3_bind_int(stmt, index, value ? 1 : 0);
@@ -42,6 +42,14 @@ struct SiteRow {
     nlohmann::ordered_json metadata;
 };
 
+struct FocusPointRow {
+    std::string plate_id;
+    std::string well_id;
+    double rel_pos_x;
+    double rel_pos_y;
+    double z;
+};
+
 struct NDImageRow {
     int index;
     std::string name;
@@ -66,6 +74,9 @@ struct ImageRow {
     std::optional<double> pos_x;
     std::optional<double> pos_y;
     std::optional<double> pos_z;
+    // RFC3339, set for images of scheduled acquisitions
+    std::optional<std::string> planned_time;
+    std::optional<std::string> acquired_time;
 };
 
 class ExperimentDB {
@@ -76,15 +87,19 @@ public:
     std::vector<PlateRow> GetAllPlates();
     std::vector<WellRow> GetAllWells();
     std::vector<SiteRow> GetAllSites();
+    std::vector<FocusPointRow> GetAllFocusPoints();
     std::vector<NDImageRow> GetAllNDImages();
     std::vector<ImageRow> GetAllImages();
 
     void InsertOrReplaceRow(PlateRow row);
     void InsertOrReplaceRow(WellRow row);
     void InsertOrReplaceRow(SiteRow row);
+    void InsertOrReplaceRow(FocusPointRow row);
     void InsertOrReplaceRow(NDImageRow row);
     void InsertOrReplaceRow(ImageRow row);
 
+    void DeleteFocusPoints(std::string plate_id);
+
     void BeginTransaction();
     void Commit();
     void Rollback();
@@ -97,6 +112,8 @@ private:
 
     void createTables();
     void checkSchema();
+    void upgradeColumns();
+    bool hasColumn(std::string table, std::string column);
 
     void exec(std::string sql);
     sqlite3_stmt *prepare(std::string sql);
@@ -108,6 +125,8 @@ private:
     void bind(sqlite3_stmt *stmt, int index, const int value);
     void bind(sqlite3_stmt *stmt, int index, const bool value);
     void bind(sqlite3_stmt *stmt, int index, std::optional<double> value);
+    void bind(sqlite3_stmt *stmt, int index,
+              const std::optional<std::string> &value);
 
     template <class... Args> void bind(sqlite3_stmt *stmt, const Args &...args);
 };
@@ -0,0 +1,293 @@
+#include "image/correction.h"
+
+#include <algorithm>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include "logging.h"
+#include "utils/time_utils.h"
+
+ImageCorrection::~ImageCorrection() { Close(); }
+
+void ImageCorrection::Open(std::filesystem::path path)
+{
+    Close();
+
+    std::unique_lock<std::shared_mutex> lk(mutex);
+    this->path = path;
+
+    // The file is created when the first map is built
+    if (!std::filesystem::exists(path)) {
+        return;
+    }
+    openFile(false);
+
+    for (const auto &ch_name : h5file->list("/")) {
+        auto ch_maps = std::make_shared<CorrectionMaps>();
+        std::string dark_path = fmt::format("/{}/dark", ch_name);
+        std::string flat_path = fmt::format("/{}/flat", ch_name);
+        if (h5file->exists(dark_path)) {
+            ch_maps->dark = h5file->read<float>(dark_path);
+        }
+        if (h5file->exists(flat_path)) {
+            ch_maps->flat = h5file->read<float>(flat_path);
+            ch_maps->gain =
+                xt::xarray<float>::from_shape(ch_maps->flat.shape());
+            for (size_t i = 0; i < ch_maps->flat.size(); i++) {
+                ch_maps->gain.data()[i] = 1.0f / ch_maps->flat.data()[i];
+            }
+        }
+        maps[ch_name] = ch_maps;
+    }
+
+    LOG_INFO("Correction maps loaded for {} channels", maps.size());
+}
+
+void ImageCorrection::Close()
+{
+    std::unique_lock<std::shared_mutex> lk(mutex);
+
+    if (h5file) {
+        delete h5file;
+        h5file = nullptr;
+    }
+    maps.clear();
+    path.clear();
+}
+
+void ImageCorrection::openFile(bool create)
+{
+    if (h5file) {
+        return;
+    }
+    if (path.empty()) {
+        throw std::runtime_error("experiment not open");
+    }
+    if (!create && !std::filesystem::exists(path)) {
+        throw std::runtime_error("correction file not found");
+    }
+    h5file = new HDF5File(path);
+}
+
+void ImageCorrection::BuildMap(CorrectionMapType type, std::string ch_name,
+                               std::vector<ImageData> frames,
+                               CorrectionStatistic stat)
+{
+    utils::StopWatch sw;
+    if (frames.empty()) {
+        throw std::invalid_argument("no calibration frames");
+    }
+    xt::xarray<float> map = FrameStatistic(frames, stat);
+
+    std::unique_lock<std::shared_mutex> lk(mutex);
+    openFile(true);
+
+    // Maps are replaced, not modified, so Apply() can use them without a lock
+    auto ch_maps = std::make_shared<CorrectionMaps>();
+    auto it = maps.find(ch_name);
+    if (it != maps.end()) {
+        *ch_maps = *it->second;
+    }
+
+    if (type == CorrectionMapType::Dark) {
+        ch_maps->dark = map;
+        h5file->write(fmt::format("/{}/dark", ch_name), map, true);
+    } else {
+        // Flat is built with the current dark map of the channel, if any
+        bool has_dark = (ch_maps->dark.size() == map.size());
+        double sum = 0;
+        for (size_t i = 0; i < map.size(); i++) {
+            if (has_dark) {
+                map.data()[i] -= ch_maps->dark.data()[i];
+            }
+            sum += map.data()[i];
+        }
+        double mean = sum / map.size();
+        if (mean <= 0) {
+            throw std::runtime_error(
+                "mean of flat-field frames is not positive");
+        }
+
+        // Normalize to mean of 1, and keep the gain finite
+        ch_maps->gain = xt::xarray<float>::from_shape(map.shape());
+        for (size_t i = 0; i < map.size(); i++) {
+            float v = std::max(float(map.data()[i] / mean), 1e-3f);
+            map.data()[i] = v;
+            ch_maps->gain.data()[i] = 1.0f / v;
+        }
+        ch_maps->flat = map;
+        h5file->write(fmt::format("/{}/flat", ch_name), map, true);
+    }
+    h5file->flush();
+
+    maps[ch_name] = ch_maps;
+
+    LOG_INFO("Correction {} map of {} built from {} frames [{:.1f} ms]",
+             (type == CorrectionMapType::Dark) ? "dark" : "flat", ch_name,
+             frames.size(), sw.Milliseconds());
+}
+
+void ImageCorrection::RemoveMaps(std::string ch_name)
+{
+    std::unique_lock<std::shared_mutex> lk(mutex);
+
+    maps.erase(ch_name);
+    if (h5file && h5file->exists("/" + ch_name)) {
+        h5file->remove("/" + ch_name);
+        h5file->flush();
+    }
+}
+
+bool ImageCorrection::HasCorrection(std::string ch_name)
+{
+    std::shared_lock<std::shared_mutex> lk(mutex);
+    return maps.contains(ch_name);
+}
+
+std::vector<std::string> ImageCorrection::ListChannels()
+{
+    std::shared_lock<std::shared_mutex> lk(mutex);
+
+    std::vector<std::string> ch_names;
+    for (const auto &[ch_name, ch_maps] : maps) {
+        ch_names.push_back(ch_name);
+    }
+    return ch_names;
+}
+
+std::shared_ptr<const ImageCorrection::CorrectionMaps>
+ImageCorrection::getMaps(std::string ch_name)
+{
+    std::shared_lock<std::shared_mutex> lk(mutex);
+
+    auto it = maps.find(ch_name);
+    if (it == maps.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+ImageData ImageCorrection::Apply(std::string ch_name, ImageData im)
+{
+    if (im.DataType() != DataType::Uint16) {
+        throw std::invalid_argument("unsupported data type");
+    }
+    std::shared_ptr<const CorrectionMaps> ch_maps = getMaps(ch_name);
+
+    size_t n = im.size();
+    const float *dark = nullptr;
+    const float *gain = nullptr;
+    if (ch_maps) {
+        if (ch_maps->dark.size() > 0) {
+            if (ch_maps->dark.size() != n) {
+                throw std::invalid_argument(
+                    "image size does not match dark map");
+            }
+            dark = ch_maps->dark.data();
+        }
+        if (ch_maps->gain.size() > 0) {
+            if (ch_maps->gain.size() != n) {
+                throw std::invalid_argument(
+                    "image size does not match flat map");
+            }
+            gain = ch_maps->gain.data();
+        }
+    }
+
+    ImageData im_out(im.Height(), im.Width(), DataType::Float32,
+                     im.ColorType());
+    const uint16_t *in = (const uint16_t *)im.Buf().get();
+    float *out = (float *)im_out.Buf().get();
+
+    // One pass over the frame, with loops simple enough to be vectorized
+    if (dark && gain) {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = (float(in[i]) - dark[i]) * gain[i];
+        }
+    } else if (dark) {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = float(in[i]) - dark[i];
+        }
+    } else if (gain) {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = float(in[i]) * gain[i];
+        }
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = float(in[i]);
+        }
+    }
+    return im_out;
+}
+
+xt::xarray<float> FrameStatistic(std::vector<ImageData> frames,
+                                 CorrectionStatistic stat)
+{
+    if (frames.empty()) {
+        throw std::invalid_argument("no frames");
+    }
+    uint32_t height = frames[0].Height();
+    uint32_t width = frames[0].Width();
+
+    std::vector<const uint16_t *> bufs;
+    for (auto &frame : frames) {
+        if (frame.DataType() != DataType::Uint16) {
+            throw std::invalid_argument("unsupported data type");
+        }
+        if ((frame.Height() != height) || (frame.Width() != width)) {
+            throw std::invalid_argument("frames have different shapes");
+        }
+        bufs.push_back((const uint16_t *)frame.Buf().get());
+    }
+
+    xt::xarray<float> result =
+        xt::xarray<float>::from_shape({size_t(height), size_t(width)});
+    float *out = result.data();
+
+    // Split pixels into contiguous ranges, one per thread
+    size_t n_px = size_t(height) * width;
+    size_t n_frames = bufs.size();
+    size_t n_threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t chunk = (n_px + n_threads - 1) / n_threads;
+
+    std::vector<std::future<void>> futures;
+    for (size_t begin = 0; begin < n_px; begin += chunk) {
+        size_t end = std::min(begin + chunk, n_px);
+        futures.push_back(std::async(std::launch::async, [&, begin, end]() {
+            if (stat == CorrectionStatistic::Mean) {
+                std::vector<double> sum(end - begin, 0);
+                for (const uint16_t *buf : bufs) {
+                    for (size_t i = begin; i < end; i++) {
+                        sum[i - begin] += buf[i];
+                    }
+                }
+                for (size_t i = begin; i < end; i++) {
+                    out[i] = float(sum[i - begin] / n_frames);
+                }
+                return;
+            }
+
+            std::vector<uint16_t> values(n_frames);
+            auto mid = values.begin() + n_frames / 2;
+            for (size_t i = begin; i < end; i++) {
+                for (size_t k = 0; k < n_frames; k++) {
+                    values[k] = bufs[k][i];
+                }
+                std::nth_element(values.begin(), mid, values.end());
+                if (n_frames % 2 == 1) {
+                    out[i] = *mid;
+                } else {
+                    uint16_t lower = *std::max_element(values.begin(), mid);
+                    out[i] = 0.5f * (float(lower) + float(*mid));
+                }
+            }
+        }));
+    }
+    for (auto &future : futures) {
+        future.get();
+    }
+    return result;
+}
@@ -0,0 +1,69 @@
+#ifndef CORRECTION_H
+#define CORRECTION_H
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include <xtensor/xarray.hpp>
+
+#include "image/imagedata.h"
+#include "utils/hdf5file.h"
+
+enum class CorrectionMapType {
+    Dark,
+    Flat,
+};
+
+enum class CorrectionStatistic {
+    Median,
+    Mean,
+};
+
+// Per-channel dark-frame and flat-field correction:
+//   corrected = (raw - dark) / flat
+// where flat is normalized to a mean of 1. Maps are stored in an HDF5 file in
+// the experiment directory and kept in memory once loaded.
+class ImageCorrection {
+public:
+    ImageCorrection() {}
+    ~ImageCorrection();
+
+    void Open(std::filesystem::path path);
+    void Close();
+
+    void BuildMap(CorrectionMapType type, std::string ch_name,
+                  std::vector<ImageData> frames, CorrectionStatistic stat);
+    void RemoveMaps(std::string ch_name);
+
+    bool HasCorrection(std::string ch_name);
+    std::vector<std::string> ListChannels();
+
+    // Returns a Float32 image. Missing maps are treated as zero dark and
+    // uniform flat.
+    ImageData Apply(std::string ch_name, ImageData im);
+
+private:
+    struct CorrectionMaps {
+        xt::xarray<float> dark;
+        xt::xarray<float> flat;
+        // 1 / flat, so that applying is a multiply
+        xt::xarray<float> gain;
+    };
+
+    std::shared_mutex mutex;
+    std::filesystem::path path;
+    HDF5File *h5file = nullptr;
+    std::map<std::string, std::shared_ptr<const CorrectionMaps>> maps;
+
+    std::shared_ptr<const CorrectionMaps> getMaps(std::string ch_name);
+    void openFile(bool create);
+};
+
+xt::xarray<float> FrameStatistic(std::vector<ImageData> frames,
+                                 CorrectionStatistic stat);
+
+#endif
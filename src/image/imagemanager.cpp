@@ -8,14 +8,30 @@
 
 #include "config.h"
 #include "experimentcontrol.h"
+#include "image/liverecording.h"
 #include "logging.h"
 #include "utils/tifffile.h"
+#include "utils/time_utils.h"
+#include "utils/trace.h"
 #include "version.h"
 
-ImageManager::ImageManager(ExperimentControl *exp) { this->exp = exp; }
+ImageManager::ImageManager(ExperimentControl *exp)
+{
+    this->exp = exp;
+    live_view_consumer =
+        live_frames.Subscribe("live view", LiveReadMode::Latest);
+    writer_thread = std::thread(&ImageManager::runWriter, this);
+}
 
 ImageManager::~ImageManager()
 {
+    {
+        std::lock_guard<std::mutex> lk(pending_mutex);
+        writer_stop = true;
+    }
+    pending_cv.notify_all();
+    writer_thread.join();
+
     std::unique_lock<std::shared_mutex> lk(dataset_mutex);
     for (NDImage *ndimage : dataset) {
         delete ndimage;
@@ -70,6 +86,36 @@ void ImageManager::LoadFromDB()
 
     zipfile.open(exp->ExperimentDir() / "images.zip");
     LOG_DEBUG("zip opened");
+
+    correction.Open(exp->ExperimentDir() / "correction.h5");
+}
+
+void ImageManager::BuildCorrectionMap(CorrectionMapType type,
+                                      std::string ch_name,
+                                      std::string ndimage_name,
+                                      std::string calib_ch,
+                                      CorrectionStatistic stat)
+{
+    NDImage *ndimage = GetNDImage(ndimage_name);
+    if (ndimage == nullptr) {
+        throw std::invalid_argument("ndimage not found");
+    }
+    int i_ch = ndimage->ChannelIndex(calib_ch);
+    if (i_ch < 0) {
+        throw std::invalid_argument("channel not found");
+    }
+
+    // Every z and t of the calibration channel is a frame
+    std::vector<ImageData> frames;
+    for (int i_t = 0; i_t < ndimage->NDimT(); i_t++) {
+        for (int i_z = 0; i_z < ndimage->NDimZ(); i_z++) {
+            if (ndimage->HasData(i_ch, i_z, i_t)) {
+                frames.push_back(ndimage->GetData(i_ch, i_z, i_t));
+            }
+        }
+    }
+
+    correction.BuildMap(type, ch_name, frames, stat);
 }
 
 void ImageManager::writeNDImageRow(NDImage *ndimage)
@@ -92,7 +138,8 @@ void ImageManager::writeNDImageRow(NDImage *ndimage)
     exp->DB()->InsertOrReplaceRow(row);
 }
 
-void ImageManager::writeImageRow(NDImage *ndimage, int i_ch, int i_z, int i_t)
+void ImageManager::writeImageRow(NDImage *ndimage, int i_ch, int i_z, int i_t,
+                                 const nlohmann::ordered_json &metadata)
 {
     ImageRow row = ImageRow{
         .ndimage_name = ndimage->Name(),
@@ -102,23 +149,23 @@ void ImageManager::writeImageRow(NDImage *ndimage, int i_ch, int i_z, int i_t)
         .path = ndimage->relpath_map[{i_ch, i_z, i_t}].string(),
         .exposure_ms = 0,
     };
+    if (metadata.contains("planned_time")) {
+        row.planned_time = metadata["planned_time"].get<std::string>();
+    }
+    if (metadata.contains("timestamp")) {
+        row.acquired_time = metadata["timestamp"].get<std::string>();
+    }
     exp->DB()->InsertOrReplaceRow(row);
 }
 
 void ImageManager::SetLiveViewFrame(ImageData new_frame)
 {
-    std::lock_guard<std::mutex> lk(mutex_live_frame);
-    live_view_frame = new_frame;
-    new_frame_set = true;
-    cv_live_frame.notify_all();
+    live_frames.Publish(new_frame);
 }
 
 ImageData ImageManager::GetNextLiveViewFrame()
 {
-    std::unique_lock<std::mutex> lk(mutex_live_frame);
-    cv_live_frame.wait(lk, [this] { return new_frame_set; });
-    new_frame_set = false;
-    return live_view_frame;
+    return live_frames.Next(live_view_consumer);
 }
 
 std::vector<NDImage *> ImageManager::ListNDImage()
@@ -195,6 +242,7 @@ void ImageManager::NewNDImage(std::string ndimage_name,
     dataset_map[ndimage_name] = ndimage;
 
     // Write to DB
+    std::unique_lock<std::mutex> lk_write(write_mutex);
     exp->DB()->BeginTransaction();
     try {
         writeNDImageRow(ndimage);
@@ -207,6 +255,7 @@ void ImageManager::NewNDImage(std::string ndimage_name,
             "cannot write NDImage to DB: {}, rolled back", e.what()));
     }
 
+    lk_write.unlock();
     lk.unlock();
 
     SendEvent({
@@ -220,6 +269,7 @@ void ImageManager::AddImage(std::string ndimage_name, int i_ch, int i_z,
                             nlohmann::ordered_json metadata)
 
 {
+    utils::TraceSpan span("image", "add image");
     NDImage *ndimage = GetNDImage(ndimage_name);
     if (ndimage == nullptr) {
         throw std::invalid_argument("name not exists");
@@ -240,13 +290,19 @@ void ImageManager::AddImage(std::string ndimage_name, int i_ch, int i_z,
         xt::adapt((uint16_t *)data.Buf().get(), data.size(), xt::no_ownership(),
                   im_shape);
 
+    uint16_t compression = StorageOptions().compression;
+
+    utils::TraceSpan span_encode("image", "encode tiff");
     TiffEncoder tif;
     tif.SetDescription(metadata.dump());
-    tif.SetCompression(COMPRESSION_ZSTD);
+    tif.SetCompression(compression);
     tif.SetArtist(fmt::format("{} <{}>", config.user.name, config.user.email));
     tif.SetSoftware(fmt::format("NikonTiControl {}", gitTagVersion));
     std::string buf = tif.EncodeMono16(im_arr);
+    span_encode.End();
 
+    utils::TraceSpan span_write("image", "write image");
+    std::lock_guard<std::mutex> lk(write_mutex);
     zipfile.AddFile(relpath.string(), buf);
     zipfile.flush();
 
@@ -256,23 +312,142 @@ void ImageManager::AddImage(std::string ndimage_name, int i_ch, int i_z,
     exp->DB()->BeginTransaction();
     try {
         writeNDImageRow(ndimage);
-        writeImageRow(ndimage, i_ch, i_z, i_t);
+        writeImageRow(ndimage, i_ch, i_z, i_t, metadata);
         exp->DB()->Commit();
     } catch (std::exception &e) {
-        dataset.pop_back();
-        dataset_map.erase(ndimage_name);
         exp->DB()->Rollback();
         throw std::runtime_error(fmt::format(
             "cannot write NDImage to DB: {}, rolled back", e.what()));
     }
 
+    span_write.End();
+
     SendEvent({
         .type = EventType::NDImageChanged,
         .value = ndimage_name,
     });
 }
 
+void ImageManager::AddImageAsync(std::string ndimage_name, int i_ch, int i_z,
+                                 int i_t, ImageData data,
+                                 nlohmann::ordered_json metadata)
+{
+    std::unique_lock<std::mutex> lk(pending_mutex);
+    auto can_add = [this] {
+        return (pending_images.size() < storage_options.max_pending_images) ||
+               writer_error;
+    };
+    if (!can_add()) {
+        utils::TraceSpan span("image", "wait pending images");
+        pending_cv.wait(lk, can_add);
+    }
+    if (writer_error) {
+        std::exception_ptr e = writer_error;
+        writer_error = nullptr;
+        std::rethrow_exception(e);
+    }
+    pending_images.push_back(PendingImage{
+        .ndimage_name = ndimage_name,
+        .i_ch = i_ch,
+        .i_z = i_z,
+        .i_t = i_t,
+        .data = data,
+        .metadata = metadata,
+    });
+    lk.unlock();
+    pending_cv.notify_all();
+}
+
+void ImageManager::WaitPendingImages()
+{
+    std::unique_lock<std::mutex> lk(pending_mutex);
+    pending_cv.wait(lk, [this] { return pending_images.empty() && !writing; });
+    if (writer_error) {
+        std::exception_ptr e = writer_error;
+        writer_error = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+int ImageManager::NumPendingImages()
+{
+    std::lock_guard<std::mutex> lk(pending_mutex);
+    return pending_images.size() + (writing ? 1 : 0);
+}
+
+void ImageManager::SetStorageOptions(ImageStorageOptions options)
+{
+    if (options.max_pending_images < 1) {
+        throw std::invalid_argument("max_pending_images must be at least 1");
+    }
+    {
+        std::lock_guard<std::mutex> lk(pending_mutex);
+        storage_options = options;
+    }
+    // More images may be added now
+    pending_cv.notify_all();
+}
+
+ImageStorageOptions ImageManager::StorageOptions()
+{
+    std::lock_guard<std::mutex> lk(pending_mutex);
+    return storage_options;
+}
+
+void ImageManager::runWriter()
+{
+    std::unique_lock<std::mutex> lk(pending_mutex);
+    for (;;) {
+        pending_cv.wait(lk, [this] {
+            return !pending_images.empty() || writer_stop;
+        });
+        if (pending_images.empty()) {
+            return;
+        }
+        PendingImage image = std::move(pending_images.front());
+        pending_images.pop_front();
+        writing = true;
+        lk.unlock();
+
+        utils::StopWatch sw;
+        std::exception_ptr error;
+        try {
+            AddImage(image.ndimage_name, image.i_ch, image.i_z, image.i_t,
+                     image.data, image.metadata);
+            LOG_DEBUG("[{}][{}] Frame saved [{:.1f} ms]", image.ndimage_name,
+                      image.i_ch + 1, sw.Milliseconds());
+        } catch (std::exception &e) {
+            LOG_ERROR("[{}][{}] Failed to save frame: {}", image.ndimage_name,
+                      image.i_ch + 1, e.what());
+            error = std::current_exception();
+        }
+
+        lk.lock();
+        writing = false;
+        if (error && !writer_error) {
+            writer_error = error;
+        }
+        pending_cv.notify_all();
+    }
+}
+
+void ImageManager::ImportRecording(std::filesystem::path index_path,
+                                   std::string ndimage_name)
+{
+    utils::StopWatch sw;
+    LiveRecordingReader reader(index_path);
+    NewNDImage(ndimage_name, {reader.ChannelName()});
+    for (int k = 0; k < reader.NumFrames(); k++) {
+        AddImageAsync(ndimage_name, 0, 0, k, reader.Frame(k),
+                      reader.FrameMetadata(k));
+    }
+    WaitPendingImages();
+    LOG_INFO("[{}] {} frames imported from {} [{:.0f} ms]", ndimage_name,
+             reader.NumFrames(), index_path.string(), sw.Milliseconds());
+}
+
 std::string ImageManager::GetImageFileBuf(std::string name)
 {
+    std::lock_guard<std::mutex> lk(write_mutex);
     return zipfile.GetData(name);
 }
\ No newline at end of file
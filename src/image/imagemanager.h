@@ -1,18 +1,33 @@
 #ifndef DATAMANAGER_H
 #define DATAMANAGER_H
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <filesystem>
 #include <map>
 #include <shared_mutex>
+#include <thread>
 #include <vector>
 
+#include <tiffio.h>
+
 #include "eventstream.h"
+#include "image/correction.h"
 #include "image/imagedata.h"
+#include "image/liveframebuffer.h"
 #include "image/ndimage.h"
 #include "utils/zipfile.h"
 
 class ExperimentControl;
 
+struct ImageStorageOptions {
+    // TIFF compression of saved images, e.g. COMPRESSION_NONE
+    uint16_t compression = COMPRESSION_ZSTD;
+    // Frames waiting to be saved, before AddImageAsync blocks
+    int max_pending_images = 16;
+};
+
 class ImageManager : public EventSender {
 public:
     ImageManager(ExperimentControl *exp);
@@ -20,7 +35,9 @@ public:
     void LoadFromDB();
 
     void SetLiveViewFrame(ImageData new_frame);
+    // Latest frame for the live view display
     ImageData GetNextLiveViewFrame();
+    LiveFrameBuffer *LiveFrames() { return &live_frames; }
 
     std::vector<NDImage *> ListNDImage();
     std::vector<NDImage *> ListNDImage(std::string plate_id,
@@ -32,26 +49,70 @@ public:
                     Site *site = nullptr);
     void AddImage(std::string ndimage_name, int i_ch, int i_z, int i_t,
                   ImageData data, nlohmann::ordered_json metadata);
+    // Save the image in the background, so that acquisition can continue
+    // while it is encoded and written. Images are saved in the order they
+    // are added. An error of a previous image is rethrown here.
+    void AddImageAsync(std::string ndimage_name, int i_ch, int i_z, int i_t,
+                       ImageData data, nlohmann::ordered_json metadata);
+    // Wait until all images added by AddImageAsync are saved
+    void WaitPendingImages();
+    // Images added by AddImageAsync and not saved yet
+    int NumPendingImages();
+
+    void SetStorageOptions(ImageStorageOptions options);
+    ImageStorageOptions StorageOptions();
+
+    // Import frames of a live recording as the time points of an NDImage
+    void ImportRecording(std::filesystem::path index_path,
+                         std::string ndimage_name);
 
     std::string GetImageFileBuf(std::string name);
 
+    ImageCorrection *Correction() { return &correction; }
+    void BuildCorrectionMap(CorrectionMapType type, std::string ch_name,
+                            std::string ndimage_name, std::string calib_ch,
+                            CorrectionStatistic stat);
+
 private:
     ExperimentControl *exp;
     ZipFile zipfile;
 
-    std::mutex mutex_live_frame;
-    std::condition_variable cv_live_frame;
-    bool new_frame_set = false;
-    ImageData live_view_frame;
+    LiveFrameBuffer live_frames;
+    int live_view_consumer;
 
     std::filesystem::path exp_path;
 
+    ImageCorrection correction;
+
     std::shared_mutex dataset_mutex;
     std::vector<NDImage *> dataset;
     std::map<std::string, NDImage *> dataset_map;
 
+    // Serializes writes to the zip file and DB
+    std::mutex write_mutex;
+
+    ImageStorageOptions storage_options;
+
+    struct PendingImage {
+        std::string ndimage_name;
+        int i_ch;
+        int i_z;
+        int i_t;
+        ImageData data;
+        nlohmann::ordered_json metadata;
+    };
+    std::mutex pending_mutex;
+    std::condition_variable pending_cv;
+    std::deque<PendingImage> pending_images;
+    bool writing = false;
+    bool writer_stop = false;
+    std::exception_ptr writer_error;
+    std::thread writer_thread;
+    void runWriter();
+
     void writeNDImageRow(NDImage *ndimage);
-    void writeImageRow(NDImage *ndimage, int i_ch, int i_z, int i_t);
+    void writeImageRow(NDImage *ndimage, int i_ch, int i_z, int i_t,
+                       const nlohmann::ordered_json &metadata);
 };
 
 
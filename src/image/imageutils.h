@@ -1,12 +1,44 @@
 #ifndef IMAGEUTILS_H
 #define IMAGEUTILS_H
 
+#include <cstdint>
+#include <vector>
+
 #include "image/imagedata.h"
 
 namespace im {
 
+enum class FocusMetric {
+    Brenner,
+    Tenengrad,
+    LaplacianVariance,
+};
+
 std::vector<double> Hist(ImageData im);
 
+// Sharpness of a frame, evaluated on every stride-th pixel in both dimensions.
+// Larger is sharper. Only Uint16 frames are supported.
+double FocusScore(ImageData im, FocusMetric metric, int stride = 1);
+
+// Max- and mean-intensity projections of a stack, updated plane by plane so
+// that they are ready as soon as the last plane is added. Only Uint16 planes
+// are supported.
+class Projection {
+public:
+    void Add(ImageData plane);
+    int NumPlanes() const { return n_planes; }
+    ImageData Max();
+    // Rounded to Uint16
+    ImageData Mean();
+
+private:
+    uint32_t height = 0;
+    uint32_t width = 0;
+    int n_planes = 0;
+    std::vector<uint16_t> max;
+    std::vector<uint32_t> sum;
+};
+
 } // namespace im
 
 #endif
@@ -0,0 +1,144 @@
+#include "image/liveframebuffer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "logging.h"
+
+std::string LiveReadModeToString(LiveReadMode mode)
+{
+    switch (mode) {
+    case LiveReadMode::Latest:
+        return "latest";
+    case LiveReadMode::EveryFrame:
+        return "every_frame";
+    default:
+        throw std::invalid_argument("invalid live read mode");
+    }
+}
+
+LiveFrameBuffer::LiveFrameBuffer(int capacity)
+{
+    if (capacity < 1) {
+        throw std::invalid_argument("capacity must be positive");
+    }
+    this->capacity = capacity;
+    ring.resize(capacity);
+}
+
+void LiveFrameBuffer::Publish(ImageData frame)
+{
+    // Only the reference to the buffer is copied under the lock
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        ring[n_published % capacity] = frame;
+        n_published++;
+    }
+    cv.notify_all();
+}
+
+uint64_t LiveFrameBuffer::NumPublished()
+{
+    std::lock_guard<std::mutex> lk(mutex);
+    return n_published;
+}
+
+int LiveFrameBuffer::Subscribe(std::string name, LiveReadMode mode)
+{
+    std::lock_guard<std::mutex> lk(mutex);
+    int consumer_id = next_consumer_id++;
+    consumers[consumer_id] = Consumer{
+        .stats = LiveConsumerStats{.name = name, .mode = mode},
+        .cursor = n_published,
+    };
+    return consumer_id;
+}
+
+void LiveFrameBuffer::Unsubscribe(int consumer_id)
+{
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        auto it = consumers.find(consumer_id);
+        if (it == consumers.end()) {
+            return;
+        }
+        const LiveConsumerStats &stats = it->second.stats;
+        LOG_DEBUG("Live frame consumer {} removed: {} read, {} dropped",
+                  stats.name, stats.n_read, stats.n_dropped);
+        consumers.erase(it);
+    }
+    cv.notify_all();
+}
+
+ImageData LiveFrameBuffer::Next(int consumer_id)
+{
+    std::unique_lock<std::mutex> lk(mutex);
+    if (!consumers.contains(consumer_id)) {
+        throw std::invalid_argument("live frame consumer not found");
+    }
+    cv.wait(lk, [this, consumer_id] { return ready(consumer_id); });
+    return take(consumer_id);
+}
+
+std::optional<ImageData>
+LiveFrameBuffer::NextFor(int consumer_id, std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lk(mutex);
+    if (!consumers.contains(consumer_id)) {
+        throw std::invalid_argument("live frame consumer not found");
+    }
+    if (!cv.wait_for(lk, timeout,
+                     [this, consumer_id] { return ready(consumer_id); }))
+    {
+        return std::nullopt;
+    }
+    return take(consumer_id);
+}
+
+bool LiveFrameBuffer::ready(int consumer_id)
+{
+    auto it = consumers.find(consumer_id);
+    return (it == consumers.end()) || (it->second.cursor < n_published);
+}
+
+ImageData LiveFrameBuffer::take(int consumer_id)
+{
+    auto it = consumers.find(consumer_id);
+    if (it == consumers.end()) {
+        return ImageData();
+    }
+
+    Consumer &consumer = it->second;
+    uint64_t pos;
+    if (consumer.stats.mode == LiveReadMode::Latest) {
+        pos = n_published - 1;
+    } else {
+        uint64_t n_ring = capacity;
+        uint64_t oldest = (n_published > n_ring) ? n_published - n_ring : 0;
+        pos = std::max(consumer.cursor, oldest);
+    }
+    consumer.stats.n_dropped += pos - consumer.cursor;
+    consumer.stats.n_read++;
+    consumer.cursor = pos + 1;
+    return ring[pos % capacity];
+}
+
+std::vector<LiveConsumerStats> LiveFrameBuffer::Stats()
+{
+    std::lock_guard<std::mutex> lk(mutex);
+    std::vector<LiveConsumerStats> result;
+    for (const auto &[consumer_id, consumer] : consumers) {
+        result.push_back(consumer.stats);
+    }
+    return result;
+}
+
+LiveConsumerStats LiveFrameBuffer::Stats(int consumer_id)
+{
+    std::lock_guard<std::mutex> lk(mutex);
+    auto it = consumers.find(consumer_id);
+    if (it == consumers.end()) {
+        throw std::invalid_argument("live frame consumer not found");
+    }
+    return it->second.stats;
+}
@@ -0,0 +1,80 @@
+#ifndef LIVEFRAMEBUFFER_H
+#define LIVEFRAMEBUFFER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "image/imagedata.h"
+
+enum class LiveReadMode {
+    // Skip to the newest frame, for display
+    Latest,
+    // Read frames in order while they are still in the ring, e.g. for a
+    // stream to an API client
+    EveryFrame,
+};
+
+std::string LiveReadModeToString(LiveReadMode mode);
+
+struct LiveConsumerStats {
+    std::string name;
+    LiveReadMode mode;
+    uint64_t n_read = 0;
+    uint64_t n_dropped = 0;
+};
+
+// Ring of the most recent live frames. Every consumer has its own cursor, so
+// that a slow consumer does not take frames from the others. Publishing never
+// waits for consumers: the oldest frame is overwritten when the ring is full
+// and counted as dropped by the consumers that had not read it.
+//
+// An empty frame marks the end of a live stream.
+class LiveFrameBuffer {
+public:
+    LiveFrameBuffer(int capacity = 16);
+
+    void Publish(ImageData frame);
+    uint64_t NumPublished();
+
+    // Consumers start from the next published frame
+    int Subscribe(std::string name, LiveReadMode mode);
+    // Wakes up a pending Next() of the consumer
+    void Unsubscribe(int consumer_id);
+
+    // Blocks until a frame is available. Returns an empty frame at the end of
+    // the live stream, or if the consumer is unsubscribed.
+    ImageData Next(int consumer_id);
+    // As Next(), or nullopt if no frame arrives within the timeout
+    std::optional<ImageData> NextFor(int consumer_id,
+                                     std::chrono::milliseconds timeout);
+
+    std::vector<LiveConsumerStats> Stats();
+    LiveConsumerStats Stats(int consumer_id);
+
+private:
+    int capacity;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<ImageData> ring;
+    uint64_t n_published = 0;
+
+    struct Consumer {
+        LiveConsumerStats stats;
+        // Sequence number of the next frame to read
+        uint64_t cursor = 0;
+    };
+    int next_consumer_id = 0;
+    std::map<int, Consumer> consumers;
+
+    bool ready(int consumer_id);
+    ImageData take(int consumer_id);
+};
+
+#endif
@@ -0,0 +1,316 @@
+#include "image/liverecording.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "logging.h"
+#include "utils/rawfile.h"
+#include "utils/time_utils.h"
+
+static const char *recording_format = "NikonTiCtrl live recording";
+static const uint64_t header_size = RawFileWriter::alignment;
+
+// Frames waiting to be written, before new frames are dropped
+static const uint64_t max_pending_bytes = 1ull << 30;
+// Frames are copied into chunks of this size for each write
+static const uint64_t chunk_bytes = 64ull << 20;
+// Preallocated length of a recording without duration
+static const double default_preallocate_s = 30;
+
+LiveRecorder::LiveRecorder(std::filesystem::path dir, std::string name,
+                           std::string ch_name, uint32_t height,
+                           uint32_t width, double duration_s,
+                           double expected_fps)
+{
+    this->raw_path = dir / (name + ".raw");
+    this->index_path = dir / (name + ".json");
+    this->ch_name = ch_name;
+    this->height = height;
+    this->width = width;
+    this->duration_s = duration_s;
+    frame_bytes = (uint64_t)height * width * sizeof(uint16_t);
+    frame_stride = AlignUp(frame_bytes, RawFileWriter::alignment);
+    stats.name = name;
+    stats.running = true;
+
+    double preallocate_s =
+        (duration_s > 0) ? duration_s : default_preallocate_s;
+    uint64_t n_preallocate = std::ceil(preallocate_s * expected_fps * 1.1) + 1;
+    raw_file = std::make_unique<RawFileWriter>(
+        raw_path, header_size + n_preallocate * frame_stride);
+
+    tp_start = std::chrono::steady_clock::now();
+    writer_thread = std::thread(&LiveRecorder::runWriter, this);
+}
+
+LiveRecorder::~LiveRecorder()
+{
+    Stop();
+    if (writer_thread.joinable()) {
+        writer_thread.join();
+    }
+}
+
+bool LiveRecorder::Accepting() { return accepting; }
+
+void LiveRecorder::AddFrame(ImageData frame,
+                            std::chrono::system_clock::time_point timestamp,
+                            uint64_t frame_number)
+{
+    if (!accepting) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        if (!first_timestamp.has_value()) {
+            first_timestamp = timestamp;
+        }
+        if ((duration_s > 0) &&
+            (std::chrono::duration<double>(timestamp - first_timestamp.value())
+                 .count() >= duration_s))
+        {
+            accepting = false;
+            stop_requested = true;
+        } else if ((frame.DataType() != DataType::Uint16) ||
+                   (frame.BufSize() != frame_bytes) ||
+                   (pending_frames.size() * frame_bytes >= max_pending_bytes))
+        {
+            stats.n_dropped_writer++;
+        } else {
+            pending_frames.push_back(PendingFrame{
+                .data = frame,
+                .timestamp = timestamp,
+                .frame_number = frame_number,
+            });
+        }
+    }
+    cv.notify_all();
+}
+
+void LiveRecorder::AddCameraDrops(uint64_t n)
+{
+    if (!accepting) {
+        return;
+    }
+    std::lock_guard<std::mutex> lk(mutex);
+    stats.n_dropped_camera += n;
+}
+
+void LiveRecorder::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        accepting = false;
+        stop_requested = true;
+    }
+    cv.notify_all();
+}
+
+LiveRecordingStats LiveRecorder::Wait()
+{
+    if (writer_thread.joinable()) {
+        writer_thread.join();
+    }
+    if (writer_error) {
+        std::rethrow_exception(writer_error);
+    }
+    return Stats();
+}
+
+LiveRecordingStats LiveRecorder::Stats()
+{
+    std::lock_guard<std::mutex> lk(mutex);
+    LiveRecordingStats result = stats;
+    if (result.running) {
+        result.elapsed_s = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - tp_start)
+                               .count();
+    }
+    if (result.elapsed_s > 0) {
+        result.fps = result.n_frames / result.elapsed_s;
+    }
+    if (write_s > 0) {
+        result.write_mb_per_s = result.n_frames * frame_bytes / 1e6 / write_s;
+    }
+    return result;
+}
+
+nlohmann::ordered_json LiveRecorder::header()
+{
+    return {
+        {"format", recording_format},
+        {"version", 1},
+        {"name", stats.name},
+        {"channel", ch_name},
+        {"width", width},
+        {"height", height},
+        {"dtype", "uint16"},
+        {"data_offset", header_size},
+        {"frame_bytes", frame_bytes},
+        {"frame_stride", frame_stride},
+    };
+}
+
+void LiveRecorder::writeIndex()
+{
+    LiveRecordingStats final_stats = Stats();
+    nlohmann::ordered_json index = header();
+    index["n_frames"] = final_stats.n_frames;
+    index["n_dropped_camera"] = final_stats.n_dropped_camera;
+    index["n_dropped_writer"] = final_stats.n_dropped_writer;
+    index["frames"] = nlohmann::ordered_json::array();
+    for (const auto &frame : frame_index) {
+        utils::TimePoint timestamp(frame.timestamp);
+        std::chrono::duration<double> t =
+            frame.timestamp - frame_index[0].timestamp;
+        index["frames"].push_back({
+            {"frame_number", frame.frame_number},
+            {"timestamp", timestamp.FormatRFC3339_Local()},
+            {"t_s", t.count()},
+        });
+    }
+
+    std::ofstream ofs(index_path);
+    if (!ofs) {
+        throw std::runtime_error("failed to create recording index");
+    }
+    ofs << index.dump(2);
+}
+
+void LiveRecorder::runWriter()
+{
+    try {
+        AlignedBuffer header_block(header_size);
+        std::string header_str = header().dump();
+        if (header_str.size() >= header_size) {
+            throw std::runtime_error("recording header too long");
+        }
+        std::memset(header_block.Data(), 0, header_size);
+        std::memcpy(header_block.Data(), header_str.data(), header_str.size());
+        raw_file->Write(header_block.Data(), header_size);
+
+        int chunk_frames = std::max<uint64_t>(1, chunk_bytes / frame_stride);
+        AlignedBuffer chunk(chunk_frames * frame_stride);
+        std::memset(chunk.Data(), 0, chunk.Size());
+
+        for (;;) {
+            std::vector<PendingFrame> batch;
+            {
+                std::unique_lock<std::mutex> lk(mutex);
+                cv.wait(lk, [this] {
+                    return stop_requested || !pending_frames.empty();
+                });
+                if (pending_frames.empty()) {
+                    break;
+                }
+                // Take as many frames as fit in a chunk, so that a writer
+                // that falls behind catches up with larger writes
+                while (!pending_frames.empty() && (batch.size() < chunk_frames))
+                {
+                    batch.push_back(std::move(pending_frames.front()));
+                    pending_frames.pop_front();
+                }
+            }
+
+            for (int i = 0; i < batch.size(); i++) {
+                std::memcpy(chunk.Data() + i * frame_stride,
+                            batch[i].data.Buf().get(), frame_bytes);
+            }
+            utils::StopWatch sw;
+            raw_file->Write(chunk.Data(), batch.size() * frame_stride);
+
+            std::lock_guard<std::mutex> lk(mutex);
+            write_s += sw.Milliseconds() / 1000;
+            stats.n_frames += batch.size();
+            for (const auto &frame : batch) {
+                frame_index.push_back(FrameIndex{
+                    .frame_number = frame.frame_number,
+                    .timestamp = frame.timestamp,
+                });
+            }
+        }
+
+        raw_file->Close(header_size + stats.n_frames * frame_stride);
+        writeIndex();
+    } catch (std::exception &e) {
+        LOG_ERROR("[{}] Recording failed: {}", stats.name, e.what());
+        writer_error = std::current_exception();
+        std::lock_guard<std::mutex> lk(mutex);
+        accepting = false;
+        stop_requested = true;
+        pending_frames.clear();
+    }
+
+    std::lock_guard<std::mutex> lk(mutex);
+    stats.running = false;
+    stats.elapsed_s =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                      tp_start)
+            .count();
+    LOG_INFO("[{}] Recording completed: {} frames, {} dropped by camera, {} "
+             "dropped by writer",
+             stats.name, stats.n_frames, stats.n_dropped_camera,
+             stats.n_dropped_writer);
+}
+
+LiveRecordingReader::LiveRecordingReader(std::filesystem::path index_path)
+{
+    std::ifstream ifs(index_path);
+    if (!ifs) {
+        throw std::invalid_argument("recording not found");
+    }
+    nlohmann::ordered_json index = nlohmann::ordered_json::parse(ifs);
+    if (index["format"] != recording_format) {
+        throw std::invalid_argument("not a live recording");
+    }
+    if (index["dtype"] != "uint16") {
+        throw std::invalid_argument("unsupported data type");
+    }
+    name = index["name"].get<std::string>();
+    ch_name = index["channel"].get<std::string>();
+    height = index["height"].get<uint32_t>();
+    width = index["width"].get<uint32_t>();
+    data_offset = index["data_offset"].get<uint64_t>();
+    frame_bytes = index["frame_bytes"].get<uint64_t>();
+    frame_stride = index["frame_stride"].get<uint64_t>();
+    frames = index["frames"];
+    n_frames = frames.size();
+
+    std::filesystem::path raw_path = index_path;
+    raw_path.replace_extension(".raw");
+    raw_file.open(raw_path, std::ios::binary);
+    if (!raw_file) {
+        throw std::runtime_error("failed to open recording data");
+    }
+}
+
+ImageData LiveRecordingReader::Frame(int k)
+{
+    if ((k < 0) || (k >= n_frames)) {
+        throw std::out_of_range("frame out of range");
+    }
+    ImageData data(height, width, DataType::Uint16, ColorType::Mono16);
+    raw_file.seekg(data_offset + k * frame_stride);
+    raw_file.read((char *)data.Buf().get(), frame_bytes);
+    if (!raw_file) {
+        throw std::runtime_error(fmt::format("failed to read frame {}", k));
+    }
+    return data;
+}
+
+nlohmann::ordered_json LiveRecordingReader::FrameMetadata(int k)
+{
+    nlohmann::ordered_json metadata;
+    metadata["channel"] = {{"preset_name", ch_name}};
+    metadata["timestamp"] = frames[k]["timestamp"];
+    metadata["recording"] = {
+        {"name", name},
+        {"frame_number", frames[k]["frame_number"]},
+        {"t_s", frames[k]["t_s"]},
+    };
+    return metadata;
+}
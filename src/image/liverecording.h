@@ -0,0 +1,129 @@
+#ifndef LIVERECORDING_H
+#define LIVERECORDING_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "image/imagedata.h"
+
+class RawFileWriter;
+
+// A recording is two files in the recordings directory of the experiment:
+//   <name>.raw   header block, then frame k at data_offset + k * frame_stride
+//   <name>.json  header, and the frame number and timestamp of every frame
+// Blocks and frames are aligned for unbuffered writes. Only Uint16 frames are
+// supported.
+
+struct LiveRecordingStats {
+    std::string name;
+    bool running = false;
+    uint64_t n_frames = 0;
+    // Overwritten in the camera buffer before they were read
+    uint64_t n_dropped_camera = 0;
+    // Not accepted because the writer fell behind
+    uint64_t n_dropped_writer = 0;
+    double elapsed_s = 0;
+    double fps = 0;
+    double write_mb_per_s = 0;
+};
+
+class LiveRecorder {
+public:
+    // Stops by itself after duration_s of frames, or runs until stopped if 0.
+    // expected_fps is only used to preallocate the file.
+    LiveRecorder(std::filesystem::path dir, std::string name,
+                 std::string ch_name, uint32_t height, uint32_t width,
+                 double duration_s, double expected_fps);
+    ~LiveRecorder();
+
+    // Called by the acquisition thread, never waits for the disk
+    bool Accepting();
+    void AddFrame(ImageData frame,
+                  std::chrono::system_clock::time_point timestamp,
+                  uint64_t frame_number);
+    void AddCameraDrops(uint64_t n);
+
+    // Stops accepting frames. The frames already added are still written.
+    void Stop();
+    // Waits until all frames and the index are written. A write error is
+    // rethrown here.
+    LiveRecordingStats Wait();
+    LiveRecordingStats Stats();
+
+private:
+    std::filesystem::path raw_path;
+    std::filesystem::path index_path;
+    std::string ch_name;
+    uint32_t height;
+    uint32_t width;
+    double duration_s;
+    uint64_t frame_bytes;
+    uint64_t frame_stride;
+
+    struct PendingFrame {
+        ImageData data;
+        std::chrono::system_clock::time_point timestamp;
+        uint64_t frame_number;
+    };
+    struct FrameIndex {
+        uint64_t frame_number;
+        std::chrono::system_clock::time_point timestamp;
+    };
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<PendingFrame> pending_frames;
+    std::atomic<bool> accepting = true;
+    bool stop_requested = false;
+    std::optional<std::chrono::system_clock::time_point> first_timestamp;
+    LiveRecordingStats stats;
+    std::chrono::steady_clock::time_point tp_start;
+    double write_s = 0;
+    std::exception_ptr writer_error;
+    std::vector<FrameIndex> frame_index;
+
+    std::unique_ptr<RawFileWriter> raw_file;
+    std::thread writer_thread;
+    void runWriter();
+    nlohmann::ordered_json header();
+    void writeIndex();
+};
+
+// Reads the frames of a recording back for import
+class LiveRecordingReader {
+public:
+    LiveRecordingReader(std::filesystem::path index_path);
+
+    int NumFrames() { return n_frames; }
+    std::string ChannelName() { return ch_name; }
+    ImageData Frame(int k);
+    nlohmann::ordered_json FrameMetadata(int k);
+
+private:
+    std::string name;
+    std::string ch_name;
+    uint32_t height;
+    uint32_t width;
+    uint64_t data_offset;
+    uint64_t frame_bytes;
+    uint64_t frame_stride;
+    int n_frames;
+    nlohmann::ordered_json frames;
+    std::ifstream raw_file;
+};
+
+#endif
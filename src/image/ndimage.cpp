@@ -119,3 +119,9 @@ ImageData NDImage::GetData(int i_ch, int i_z, int i_t)
         return data;
     }
 }
+
+ImageData NDImage::GetCorrectedData(int i_ch, int i_z, int i_t)
+{
+    ImageData data = GetData(i_ch, i_z, i_t);
+    return image_manager->Correction()->Apply(ChannelName(i_ch), data);
+}
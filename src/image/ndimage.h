@@ -45,6 +45,8 @@ public:
 
     bool HasData(int i_ch, int i_z, int i_t);
     ImageData GetData(int i_ch, int i_z, int i_t);
+    // Float32 image with dark-frame and flat-field correction of the channel
+    ImageData GetCorrectedData(int i_ch, int i_z, int i_t);
 
 private:
     NDImage() {}
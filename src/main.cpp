@@ -7,7 +7,7 @@
 #include <fmt/format.h>
 
 #include "api/api_server.h"
-#include "config.h"
+#include "app.h"
 #include "device/devicehub.h"
 #include "experimentcontrol.h"
 #include "logging.h"
@@ -15,36 +15,6 @@
 #include "utils/time_utils.h"
 #include "version.h"
 
-#include "device/flir/flir_spinnaker.h"
-#include "device/hamamatsu/hamamatsu_dcam.h"
-#include "device/nikon/nikon_ti.h"
-#include "device/prior/prior_proscan.h"
-
-void printEvents(EventStream *stream)
-{
-    Event e;
-    while (stream->Receive(&e)) {
-        switch (e.type) {
-        case EventType::DeviceConnectionStateChanged:
-            LOG_DEBUG("[Event:{}] {}=\"{}\"", EventTypeToString(e.type),
-                      e.device, e.value);
-            break;
-        case EventType::DeviceOperationComplete:
-            LOG_DEBUG("[Event:{}] {}=\"{}\"", EventTypeToString(e.type), e.path,
-                      e.value);
-            break;
-        case EventType::DevicePropertyValueUpdate:
-            if ((e.path.PropertyName() != "XYPosition") &&
-                (e.path.PropertyName() != "RawXYPosition") &&
-                (e.path.PropertyName() != "ZDrivePosition"))
-            {
-                LOG_DEBUG("[Event:{}] {}=\"{}\"", EventTypeToString(e.type),
-                          e.path, e.value);
-            }
-        }
-    }
-}
-
 std::string api_listen_addr = "0.0.0.0:50051";
 
 void sigHandler(int signal)
@@ -65,75 +35,21 @@ void configApp()
     qApp->setStyleSheet(styleSheet);
 }
 
-void initLogger()
-{
-    slog::InitConsole();
-
-    // Write logs to folder
-    // C:\Users\<username>\AppData\Local\NikonTiCtrl
-    char *local_app_data_env = std::getenv("LOCALAPPDATA");
-    if (local_app_data_env != NULL) {
-        std::filesystem::path log_folder =
-            std::filesystem::path(local_app_data_env) / "NikonTiCtrl";
-        if (!std::filesystem::exists(log_folder)) {
-            std::filesystem::create_directory(log_folder);
-        }
-        std::string filename = fmt::format("NikonTiCtrl-{:%Y%m%d-%H%M%S}.log",
-                                           utils::Now().Local());
-        std::filesystem::path log_path = log_folder / filename;
-        slog::DefaultLogger().SetFilename(log_path);
-        LOG_INFO("Writing log to {}", log_path.string());
-    } else {
-        LOG_ERROR("Failed to get LOCALAPPDATA path from environment variables. "
-                  "Log is not written to a file.");
-    }
-}
-
 int main(int argc, char *argv[])
 {
 
     initLogger();
     LOG_INFO("Welcome to NikonTiControl {}", gitTagVersion);
 
-    try {
-        std::filesystem::path systemConfigPath = getSystemConfigPath();
-        if (!std::filesystem::exists(systemConfigPath)) {
-            LOG_FATAL("Cannot find config file at {}",
-                      systemConfigPath.string());
-            return 1;
-        }
-        loadSystemConfig(systemConfigPath);
-        LOG_INFO("  System config loaded from {}", systemConfigPath.string());
-
-        std::filesystem::path userConfigPath = getUserConfigPath();
-        if (!std::filesystem::exists(userConfigPath)) {
-            createDefaultUserConfig(userConfigPath);
-            LOG_WARN("  User config not found. Default config is created.");
-        }
-        loadUserConfig(userConfigPath);
-        LOG_INFO("  User config loaded from {}", userConfigPath.string());
-
-    } catch (std::exception &e) {
-        LOG_FATAL("Failed to load config: {}", e.what());
+    if (!loadConfig()) {
         return 1;
     }
 
-    LOG_INFO("Current user: {}<{}>", config.user.name, config.user.email);
-
     //
     // Add devices
     //
     DeviceHub dev;
-    try {
-        dev.AddDevice("NikonTi", new NikonTi::Microscope);
-        dev.AddDevice("PriorProScan",
-                      new PriorProscan::Proscan("ASRL1::INSTR"));
-        dev.AddCamera("Hamamatsu", new Hamamatsu::DCam);
-        // dev.AddDevice("FLIR", new FLIR::Camera);
-
-    } catch (std::exception &e) {
-        LOG_ERROR("Failed to add device: {}", e.what());
-    }
+    addDevices(dev);
 
     ExperimentControl exp(&dev);
 
@@ -168,22 +84,7 @@ int main(int argc, char *argv[])
     // Connect devices
     //
     std::future<void> connect_devices_future =
-        std::async(std::launch::async, [&] {
-            absl::Status status = dev.ConnectAll();
-            if (!status.ok()) {
-                LOG_ERROR("Connect: {}", status.ToString());
-            } else {
-                LOG_INFO("All connected");
-            }
-
-            // Init properties
-            status = dev.SetProperty("/Hamamatsu/BIT PER CHANNEL", "16");
-            if (!status.ok()) {
-                LOG_ERROR("Init device properties: {}", status.ToString());
-            } else {
-                LOG_INFO("Device initialized");
-            }
-        });
+        std::async(std::launch::async, connectDevices, std::ref(dev));
 
     //
     // Handle exit signal
@@ -196,14 +97,7 @@ int main(int argc, char *argv[])
     //
     int returnCode = app.exec();
 
-    LOG_INFO("Disconnecting devices...");
-    absl::Status status = dev.DisconnectAll();
-    if (!status.ok()) {
-        LOG_ERROR("Disconnect: {}", status.ToString());
-    } else {
-        LOG_INFO("All disconnected");
-    }
-    LOG_INFO("Disconnected");
+    disconnectDevices(dev);
 
     LOG_INFO("Shutting down API Server...");
     api_server.Shutdown();
@@ -0,0 +1,135 @@
+#include <atomic>
+#include <csignal>
+#include <filesystem>
+#include <future>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "api/api_server.h"
+#include "app.h"
+#include "device/devicehub.h"
+#include "experimentcontrol.h"
+#include "logging.h"
+#include "utils/time_utils.h"
+#include "version.h"
+
+// Runs ExperimentControl and the API server without the GUI.
+//
+//   NikonTiControlHeadless [--listen <addr>] [--no-devices]
+//                          [--experiment <dir>]
+//
+// With --no-devices, only data and analysis of the experiment are available,
+// e.g. on an analysis server. Such a server can be built without the vendor
+// SDKs with -DNIKONTICTRL_VENDOR_DEVICES=OFF.
+
+std::string api_listen_addr = "0.0.0.0:50051";
+
+std::atomic<bool> exit_requested = false;
+
+void sigHandler(int signal)
+{
+    std::signal(signal, SIG_DFL);
+    exit_requested = true;
+    exit_requested.notify_all();
+}
+
+void printUsage()
+{
+    fmt::print("Usage: NikonTiControlHeadless [--listen <addr>] "
+               "[--no-devices] [--experiment <dir>]\n");
+}
+
+int main(int argc, char *argv[])
+{
+    utils::StopWatch sw_startup;
+
+    bool no_devices = false;
+    std::filesystem::path exp_dir;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "--listen") && (i + 1 < argc)) {
+            api_listen_addr = argv[++i];
+        } else if (arg == "--no-devices") {
+            no_devices = true;
+        } else if ((arg == "--experiment") && (i + 1 < argc)) {
+            exp_dir = argv[++i];
+        } else {
+            printUsage();
+            return 2;
+        }
+    }
+
+    initLogger();
+    LOG_INFO("Welcome to NikonTiControl {} (headless)", gitTagVersion);
+
+    if (!loadConfig()) {
+        return 1;
+    }
+    double config_ms = sw_startup.Milliseconds();
+
+    //
+    // Add devices
+    //
+    DeviceHub dev;
+    if (no_devices) {
+        LOG_INFO("Running without devices");
+    } else {
+        addDevices(dev);
+    }
+
+    EventStream event_stream;
+    auto print_event_future =
+        std::async(std::launch::async, printEvents, &event_stream);
+    dev.SubscribeEvents(&event_stream);
+
+    ExperimentControl exp(&dev);
+    if (!exp_dir.empty()) {
+        try {
+            exp.OpenExperimentDir(exp_dir);
+            LOG_INFO("Experiment opened at {}", exp_dir.string());
+        } catch (std::exception &e) {
+            LOG_FATAL("Failed to open experiment {}: {}", exp_dir.string(),
+                      e.what());
+            event_stream.Close();
+            print_event_future.wait();
+            return 1;
+        }
+    }
+
+    //
+    // Start API Server
+    //
+    APIServer api_server(api_listen_addr, &exp);
+    auto api_server_future =
+        std::async(std::launch::async, &APIServer::Wait, &api_server);
+    LOG_INFO("Listening {}...", api_listen_addr);
+    double server_ms = sw_startup.Milliseconds();
+
+    //
+    // Connect devices
+    //
+    connectDevices(dev);
+    LOG_INFO("Started in {:.0f} ms (config {:.0f} ms, API server {:.0f} ms, "
+             "devices {:.0f} ms)",
+             sw_startup.Milliseconds(), config_ms, server_ms - config_ms,
+             sw_startup.Milliseconds() - server_ms);
+
+    //
+    // Sleep until the exit signal, without waking up in between
+    //
+    std::signal(SIGINT, sigHandler);
+    std::signal(SIGTERM, sigHandler);
+    exit_requested.wait(false);
+    LOG_INFO("Received exit signal...");
+
+    disconnectDevices(dev);
+
+    LOG_INFO("Shutting down API Server...");
+    api_server.Shutdown();
+    api_server_future.wait();
+
+    event_stream.Close();
+    print_event_future.wait();
+    return 0;
+}
@@ -0,0 +1,241 @@
+#include "sample/focusmap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// Auto model switches to the spline at this number of points
+static const int spline_min_points = 6;
+
+// Regularization of the spline in normalized coordinates. Focus measurements
+// are noisy, so the surface should not pass through every point exactly.
+static const double spline_smoothing = 1e-3;
+
+FocusSurfaceModel FocusSurfaceModelFromString(std::string value)
+{
+    if (value == "auto") {
+        return FocusSurfaceModel::Auto;
+    } else if (value == "plane") {
+        return FocusSurfaceModel::Plane;
+    } else if (value == "thin_plate_spline") {
+        return FocusSurfaceModel::ThinPlateSpline;
+    }
+    throw std::invalid_argument("invalid focus surface model");
+}
+
+std::string FocusSurfaceModelToString(FocusSurfaceModel model)
+{
+    switch (model) {
+    case FocusSurfaceModel::Auto:
+        return "auto";
+    case FocusSurfaceModel::Plane:
+        return "plane";
+    case FocusSurfaceModel::ThinPlateSpline:
+        return "thin_plate_spline";
+    default:
+        throw std::invalid_argument("invalid focus surface model");
+    }
+}
+
+// Solve A x = b in place by Gaussian elimination with partial pivoting.
+// A is n x n in row-major order. Returns false if A is singular.
+static bool solveLinear(std::vector<double> &A, std::vector<double> &b, int n)
+{
+    for (int k = 0; k < n; k++) {
+        int i_max = k;
+        for (int i = k + 1; i < n; i++) {
+            if (std::abs(A[i * n + k]) > std::abs(A[i_max * n + k])) {
+                i_max = i;
+            }
+        }
+        if (std::abs(A[i_max * n + k]) < 1e-12) {
+            return false;
+        }
+        if (i_max != k) {
+            for (int j = 0; j < n; j++) {
+                std::swap(A[k * n + j], A[i_max * n + j]);
+            }
+            std::swap(b[k], b[i_max]);
+        }
+        for (int i = k + 1; i < n; i++) {
+            double f = A[i * n + k] / A[k * n + k];
+            for (int j = k; j < n; j++) {
+                A[i * n + j] -= f * A[k * n + j];
+            }
+            b[i] -= f * b[k];
+        }
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        double sum = b[i];
+        for (int j = i + 1; j < n; j++) {
+            sum -= A[i * n + j] * b[j];
+        }
+        b[i] = sum / A[i * n + i];
+    }
+    return true;
+}
+
+static double tpsKernel(double dx, double dy)
+{
+    double r2 = dx * dx + dy * dy;
+    if (r2 <= 0) {
+        return 0;
+    }
+    // r^2 log(r) = 0.5 r^2 log(r^2)
+    return 0.5 * r2 * std::log(r2);
+}
+
+FocusMap::FocusMap(FocusSurfaceModel model) : model(model) {}
+
+void FocusMap::SetModel(FocusSurfaceModel model)
+{
+    this->model = model;
+    fit();
+}
+
+FocusSurfaceModel FocusMap::Model() const { return model; }
+
+void FocusMap::SetPoint(FocusPoint point)
+{
+    points[point.well_id] = point;
+    fit();
+}
+
+void FocusMap::RemovePoint(std::string well_id)
+{
+    points.erase(well_id);
+    fit();
+}
+
+void FocusMap::Clear()
+{
+    points.clear();
+    fit();
+}
+
+std::vector<FocusPoint> FocusMap::Points() const
+{
+    std::vector<FocusPoint> result;
+    for (const auto &[well_id, point] : points) {
+        result.push_back(point);
+    }
+    return result;
+}
+
+bool FocusMap::Empty() const { return points.empty(); }
+
+void FocusMap::fit()
+{
+    use_spline = false;
+    w.clear();
+    px.clear();
+    py.clear();
+    a[0] = a[1] = a[2] = 0;
+    if (points.empty()) {
+        return;
+    }
+
+    // Normalize coordinates, plate positions are in the order of 1e4-1e5 um
+    double x_min = points.begin()->second.x;
+    double x_max = x_min;
+    double y_min = points.begin()->second.y;
+    double y_max = y_min;
+    double x_sum = 0;
+    double y_sum = 0;
+    for (const auto &[well_id, point] : points) {
+        x_min = std::min(x_min, point.x);
+        x_max = std::max(x_max, point.x);
+        y_min = std::min(y_min, point.y);
+        y_max = std::max(y_max, point.y);
+        x_sum += point.x;
+        y_sum += point.y;
+    }
+    x0 = x_sum / points.size();
+    y0 = y_sum / points.size();
+    scale = std::max({x_max - x_min, y_max - y_min, 1.0});
+    for (const auto &[well_id, point] : points) {
+        px.push_back((point.x - x0) / scale);
+        py.push_back((point.y - y0) / scale);
+    }
+
+    bool want_spline =
+        (model == FocusSurfaceModel::ThinPlateSpline) ||
+        ((model == FocusSurfaceModel::Auto) &&
+         (points.size() >= spline_min_points));
+    if (want_spline && (points.size() >= 3) && fitSpline()) {
+        use_spline = true;
+        return;
+    }
+    fitPlane();
+}
+
+void FocusMap::fitPlane()
+{
+    // Least squares on [1 x y], with a small ridge on the slopes so that one
+    // point, two points or collinear points give the flattest surface
+    std::vector<double> A(9, 0);
+    std::vector<double> b(3, 0);
+    int i = 0;
+    for (const auto &[well_id, point] : points) {
+        double row[3] = {1, px[i], py[i]};
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) {
+                A[r * 3 + c] += row[r] * row[c];
+            }
+            b[r] += row[r] * point.z;
+        }
+        i++;
+    }
+    A[1 * 3 + 1] += 1e-6;
+    A[2 * 3 + 2] += 1e-6;
+    if (!solveLinear(A, b, 3)) {
+        throw std::runtime_error("cannot fit focus plane");
+    }
+    std::copy(b.begin(), b.end(), a);
+}
+
+bool FocusMap::fitSpline()
+{
+    int n = points.size();
+    int m = n + 3;
+    std::vector<double> A(m * m, 0);
+    std::vector<double> b(m, 0);
+
+    int i = 0;
+    for (const auto &[well_id, point] : points) {
+        for (int j = 0; j < n; j++) {
+            A[i * m + j] = tpsKernel(px[i] - px[j], py[i] - py[j]);
+        }
+        A[i * m + i] += spline_smoothing;
+        A[i * m + n] = 1;
+        A[i * m + n + 1] = px[i];
+        A[i * m + n + 2] = py[i];
+        A[n * m + i] = 1;
+        A[(n + 1) * m + i] = px[i];
+        A[(n + 2) * m + i] = py[i];
+        b[i] = point.z;
+        i++;
+    }
+    if (!solveLinear(A, b, m)) {
+        return false;
+    }
+    w.assign(b.begin(), b.begin() + n);
+    std::copy(b.begin() + n, b.end(), a);
+    return true;
+}
+
+std::optional<double> FocusMap::Evaluate(double x, double y) const
+{
+    if (points.empty()) {
+        return std::nullopt;
+    }
+    double u = (x - x0) / scale;
+    double v = (y - y0) / scale;
+    double z = a[0] + a[1] * u + a[2] * v;
+    if (use_spline) {
+        for (int i = 0; i < w.size(); i++) {
+            z += w[i] * tpsKernel(u - px[i], v - py[i]);
+        }
+    }
+    return z;
+}
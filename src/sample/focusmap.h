@@ -0,0 +1,66 @@
+#ifndef FOCUSMAP_H
+#define FOCUSMAP_H
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+enum class FocusSurfaceModel {
+    // Plane until there are enough points for a spline
+    Auto,
+    Plane,
+    ThinPlateSpline,
+};
+
+FocusSurfaceModel FocusSurfaceModelFromString(std::string value);
+std::string FocusSurfaceModelToString(FocusSurfaceModel model);
+
+struct FocusPoint {
+    std::string well_id;
+    // Position relative to the plate origin
+    double x;
+    double y;
+    double z;
+};
+
+// Focus surface of a plate, fitted to Z measured at a sparse set of wells.
+// The surface is refitted whenever a point is added or removed, so that
+// Evaluate() is only a sum over the points.
+class FocusMap {
+public:
+    FocusMap(FocusSurfaceModel model = FocusSurfaceModel::Auto);
+
+    void SetModel(FocusSurfaceModel model);
+    FocusSurfaceModel Model() const;
+
+    // One point per well, a new measurement replaces the old one
+    void SetPoint(FocusPoint point);
+    void RemovePoint(std::string well_id);
+    void Clear();
+    std::vector<FocusPoint> Points() const;
+    bool Empty() const;
+
+    std::optional<double> Evaluate(double x, double y) const;
+
+private:
+    FocusSurfaceModel model;
+    std::map<std::string, FocusPoint> points;
+
+    // Fitted surface in normalized coordinates (x - x0) / scale
+    bool use_spline = false;
+    double x0 = 0;
+    double y0 = 0;
+    double scale = 1;
+    // z = a0 + a1 * x + a2 * y + sum_i w_i * U(|p - p_i|)
+    double a[3] = {0, 0, 0};
+    std::vector<double> w;
+    std::vector<double> px;
+    std::vector<double> py;
+
+    void fit();
+    void fitPlane();
+    bool fitSpline();
+};
+
+#endif
@@ -0,0 +1,316 @@
+#include "sample/pathplanner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+
+// Wells or sites within this distance in Y are in the same row
+static const double row_tolerance_um = 100;
+
+// Candidate neighbors of each site in 2-opt
+static const int two_opt_neighbors = 8;
+static const int two_opt_max_passes = 50;
+
+SiteOrder SiteOrderFromString(std::string value)
+{
+    if (value == "as_created") {
+        return SiteOrder::AsCreated;
+    } else if (value == "serpentine") {
+        return SiteOrder::Serpentine;
+    } else if (value == "nearest_neighbor") {
+        return SiteOrder::NearestNeighbor;
+    } else if (value == "nearest_neighbor_2opt") {
+        return SiteOrder::NearestNeighbor2Opt;
+    }
+    throw std::invalid_argument("invalid site order");
+}
+
+std::string SiteOrderToString(SiteOrder order)
+{
+    switch (order) {
+    case SiteOrder::AsCreated:
+        return "as_created";
+    case SiteOrder::Serpentine:
+        return "serpentine";
+    case SiteOrder::NearestNeighbor:
+        return "nearest_neighbor";
+    case SiteOrder::NearestNeighbor2Opt:
+        return "nearest_neighbor_2opt";
+    default:
+        throw std::invalid_argument("invalid site order");
+    }
+}
+
+double StageSpeedModel::AxisTime(double distance, double speed,
+                                 double accel) const
+{
+    distance = std::abs(distance);
+    if (distance == 0) {
+        return 0;
+    }
+    if (distance < speed * speed / accel) {
+        // Triangular profile, never reaches full speed
+        return 2 * std::sqrt(distance / accel);
+    }
+    return distance / speed + speed / accel;
+}
+
+double StageSpeedModel::MoveTime(Pos2D from, Pos2D to) const
+{
+    double tx = AxisTime(to.x - from.x, speed_x, accel_x);
+    double ty = AxisTime(to.y - from.y, speed_y, accel_y);
+    if ((tx == 0) && (ty == 0)) {
+        return 0;
+    }
+    return std::max(tx, ty) + settle_ms / 1000;
+}
+
+static double distance(Pos2D a, Pos2D b)
+{
+    return std::hypot(b.x - a.x, b.y - a.y);
+}
+
+// Group items into rows by Y, then alternate the direction of X in every
+// row. Returns the indices of items in visit order. row_forward, if given, is
+// set to the direction of the row of each item.
+static std::vector<int> serpentine(const std::vector<Pos2D> &pos,
+                                   bool first_row_forward = true,
+                                   std::vector<bool> *row_forward = nullptr)
+{
+    if (row_forward != nullptr) {
+        row_forward->assign(pos.size(), first_row_forward);
+    }
+    std::vector<int> idx(pos.size());
+    std::iota(idx.begin(), idx.end(), 0);
+    std::stable_sort(idx.begin(), idx.end(),
+                     [&](int a, int b) { return pos[a].y < pos[b].y; });
+
+    std::vector<int> result;
+    bool forward = first_row_forward;
+    size_t row_begin = 0;
+    while (row_begin < idx.size()) {
+        size_t row_end = row_begin + 1;
+        while ((row_end < idx.size()) &&
+               (pos[idx[row_end]].y - pos[idx[row_begin]].y <
+                row_tolerance_um))
+        {
+            row_end++;
+        }
+        std::vector<int> row(idx.begin() + row_begin, idx.begin() + row_end);
+        std::stable_sort(row.begin(), row.end(), [&](int a, int b) {
+            return forward ? pos[a].x < pos[b].x : pos[a].x > pos[b].x;
+        });
+        result.insert(result.end(), row.begin(), row.end());
+        if (row_forward != nullptr) {
+            for (int i : row) {
+                (*row_forward)[i] = forward;
+            }
+        }
+        forward = !forward;
+        row_begin = row_end;
+    }
+    return result;
+}
+
+// Serpentine over rows of wells. Sites within a well follow the direction of
+// the row, so that the last site of a well is close to the next well.
+static std::vector<::Site *> serpentineSites(const std::vector<::Site *> &sites)
+{
+    std::vector<::Well *> wells;
+    std::map<::Well *, std::vector<::Site *>> well_sites;
+    for (const auto &site : sites) {
+        if (!well_sites.contains(site->Well())) {
+            wells.push_back(site->Well());
+        }
+        well_sites[site->Well()].push_back(site);
+    }
+
+    std::vector<Pos2D> well_pos;
+    for (const auto &well : wells) {
+        well_pos.push_back(well->RelativePosition());
+    }
+    std::vector<bool> row_forward;
+    std::vector<int> well_order = serpentine(well_pos, true, &row_forward);
+
+    std::vector<::Site *> result;
+    for (int i_well : well_order) {
+        ::Well *well = wells[i_well];
+        bool forward = row_forward[i_well];
+        std::vector<Pos2D> site_pos;
+        for (const auto &site : well_sites[well]) {
+            site_pos.push_back(site->RelativePosition());
+        }
+        for (int i_site : serpentine(site_pos, forward)) {
+            result.push_back(well_sites[well][i_site]);
+        }
+    }
+    return result;
+}
+
+// Open path through all points, starting at path[0]
+static std::vector<int> nearestNeighbor(const std::vector<Pos2D> &pos,
+                                        const StageSpeedModel &model)
+{
+    int n = pos.size();
+    std::vector<int> path = {0};
+    std::vector<bool> visited(n, false);
+    visited[0] = true;
+    for (int k = 1; k < n; k++) {
+        int last = path.back();
+        int best = -1;
+        double best_t = 0;
+        for (int i = 0; i < n; i++) {
+            if (visited[i]) {
+                continue;
+            }
+            double t = model.MoveTime(pos[last], pos[i]);
+            if ((best < 0) || (t < best_t)) {
+                best = i;
+                best_t = t;
+            }
+        }
+        visited[best] = true;
+        path.push_back(best);
+    }
+    return path;
+}
+
+// Improve an open path with 2-opt moves between each point and its nearest
+// neighbors. path[0] stays in place.
+static void twoOpt(std::vector<int> &path, const std::vector<Pos2D> &pos,
+                   const StageSpeedModel &model)
+{
+    int n = path.size();
+    if (n < 4) {
+        return;
+    }
+    auto cost = [&](int a, int b) {
+        return model.MoveTime(pos[a], pos[b]);
+    };
+
+    int k = std::min(two_opt_neighbors, n - 1);
+    std::vector<std::vector<int>> neighbors(n);
+    for (int a = 0; a < n; a++) {
+        std::vector<std::pair<double, int>> d;
+        for (int b = 0; b < n; b++) {
+            if (b != a) {
+                d.push_back({cost(a, b), b});
+            }
+        }
+        std::partial_sort(d.begin(), d.begin() + k, d.end());
+        for (int i = 0; i < k; i++) {
+            neighbors[a].push_back(d[i].second);
+        }
+    }
+
+    std::vector<int> index(n);
+    auto reverse = [&](int i, int j) {
+        std::reverse(path.begin() + i, path.begin() + j + 1);
+        for (int p = i; p <= j; p++) {
+            index[path[p]] = p;
+        }
+    };
+    for (int p = 0; p < n; p++) {
+        index[path[p]] = p;
+    }
+
+    for (int pass = 0; pass < two_opt_max_passes; pass++) {
+        bool improved = false;
+        for (int i = 0; i < n - 1; i++) {
+            int a = path[i];
+            int b = path[i + 1];
+            double d_ab = cost(a, b);
+            for (int c : neighbors[a]) {
+                double d_ac = cost(a, c);
+                if (d_ac >= d_ab) {
+                    break;
+                }
+                int j = index[c];
+                // Replace a-b and c-d with a-c and b-d, the end of the path
+                // has no outgoing edge
+                if (j > i + 1) {
+                    double d_cd = (j + 1 < n) ? cost(c, path[j + 1]) : 0;
+                    double d_bd = (j + 1 < n) ? cost(b, path[j + 1]) : 0;
+                    if (d_ac + d_bd < d_ab + d_cd - 1e-9) {
+                        reverse(i + 1, j);
+                        improved = true;
+                        break;
+                    }
+                } else if (j < i) {
+                    int d = path[j + 1];
+                    double d_cd = cost(c, d);
+                    double d_bd = cost(b, d);
+                    if (d_ac + d_bd < d_ab + d_cd - 1e-9) {
+                        reverse(j + 1, i);
+                        improved = true;
+                        break;
+                    }
+                }
+            }
+        }
+        if (!improved) {
+            break;
+        }
+    }
+}
+
+SitePath PlanSitePath(std::vector<::Site *> sites, SiteOrder order,
+                      const StageSpeedModel &model, std::optional<Pos2D> start)
+{
+    for (const auto &site : sites) {
+        if (!site->Position().has_value()) {
+            throw std::invalid_argument("position origin of plate is not set");
+        }
+    }
+
+    SitePath result;
+    switch (order) {
+    case SiteOrder::AsCreated:
+        result.sites = sites;
+        break;
+    case SiteOrder::Serpentine:
+        result.sites = serpentineSites(sites);
+        break;
+    case SiteOrder::NearestNeighbor:
+    case SiteOrder::NearestNeighbor2Opt: {
+        // Point 0 is the start, which is either the current stage position
+        // or the first site in the serpentine order
+        std::vector<::Site *> initial = serpentineSites(sites);
+        std::vector<Pos2D> pos;
+        int offset = 0;
+        if (start.has_value()) {
+            pos.push_back(start.value());
+            offset = 1;
+        }
+        for (const auto &site : initial) {
+            pos.push_back(site->Position().value());
+        }
+        if (pos.empty()) {
+            break;
+        }
+        std::vector<int> path = nearestNeighbor(pos, model);
+        if (order == SiteOrder::NearestNeighbor2Opt) {
+            twoOpt(path, pos, model);
+        }
+        for (int i = offset; i < path.size(); i++) {
+            result.sites.push_back(initial[path[i] - offset]);
+        }
+        break;
+    }
+    default:
+        throw std::invalid_argument("invalid site order");
+    }
+
+    std::optional<Pos2D> last = start;
+    for (const auto &site : result.sites) {
+        Pos2D pos = site->Position().value();
+        if (last.has_value()) {
+            result.travel_um += distance(last.value(), pos);
+            result.travel_s += model.MoveTime(last.value(), pos);
+        }
+        last = pos;
+    }
+    return result;
+}
@@ -0,0 +1,49 @@
+#ifndef PATHPLANNER_H
+#define PATHPLANNER_H
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "sample/sample.h"
+
+enum class SiteOrder {
+    // Order of the Plate/Well/Site vectors
+    AsCreated,
+    // Wells row by row in alternating direction
+    Serpentine,
+    NearestNeighbor,
+    // Nearest neighbor followed by 2-opt improvement
+    NearestNeighbor2Opt,
+};
+
+SiteOrder SiteOrderFromString(std::string value);
+std::string SiteOrderToString(SiteOrder order);
+
+// Both axes move at the same time, each with a trapezoidal velocity profile,
+// so the time of a move is the time of the slower axis plus settling. The
+// defaults are typical of the Prior ProScan and should be calibrated.
+struct StageSpeedModel {
+    double speed_x = 5000;    // um/s
+    double speed_y = 5000;    // um/s
+    double accel_x = 50000;   // um/s^2
+    double accel_y = 50000;   // um/s^2
+    double settle_ms = 50;
+
+    double AxisTime(double distance, double speed, double accel) const;
+    double MoveTime(Pos2D from, Pos2D to) const;
+};
+
+struct SitePath {
+    std::vector<::Site *> sites;
+    double travel_um = 0;
+    double travel_s = 0;
+};
+
+// Plan the visit order of sites. All sites must have a position. If start is
+// set, the travel from start to the first site is included.
+SitePath PlanSitePath(std::vector<::Site *> sites, SiteOrder order,
+                      const StageSpeedModel &model,
+                      std::optional<Pos2D> start = std::nullopt);
+
+#endif
@@ -22,12 +22,14 @@ void SampleManager::LoadFromDB()
     }
     plates.clear();
     plate_map.clear();
+    focus_maps.clear();
 
     for (const auto &plate_row : exp->DB()->GetAllPlates()) {
         ::Plate *plate = new ::Plate;
         plate->uuid = plate_row.uuid;
         plate->type = PlateTypeFromString(plate_row.type);
         plate->id = plate_row.plate_id;
+        plate->metadata = plate_row.metadata;
         if (plate_row.pos_origin_x.has_value() &&
             plate_row.pos_origin_y.has_value())
         {
@@ -67,6 +69,23 @@ void SampleManager::LoadFromDB()
         well->sites.push_back(site);
         well->site_map[site->id] = site;
     }
+
+    for (const auto &plate : plates) {
+        FocusSurfaceModel model = FocusSurfaceModel::Auto;
+        if (plate->metadata.contains("focus_surface_model")) {
+            model = FocusSurfaceModelFromString(
+                plate->metadata["focus_surface_model"].get<std::string>());
+        }
+        focus_maps[plate->id] = FocusMap(model);
+    }
+    for (const auto &row : exp->DB()->GetAllFocusPoints()) {
+        focus_maps[row.plate_id].SetPoint(FocusPoint{
+            .well_id = row.well_id,
+            .x = row.rel_pos_x,
+            .y = row.rel_pos_y,
+            .z = row.z,
+        });
+    }
 }
 
 void SampleManager::writePlateRow(const ::Plate *plate)
@@ -464,6 +483,180 @@ void SampleManager::CreateSitesOnCenteredGrid(std::string plate_id,
     });
 }
 
+void SampleManager::SetFocusPoint(std::string plate_id, std::string well_id,
+                                  double x, double y, double z)
+{
+    if (!exp->is_open()) {
+        throw std::invalid_argument("no open experiment");
+    }
+
+    std::unique_lock<std::shared_mutex> lk(plate_mutex);
+
+    ::Plate *plate = get_plate(plate_id);
+    if (plate == nullptr) {
+        throw std::invalid_argument(
+            fmt::format("plate {} does not exists", plate_id));
+    }
+    if (plate->Well(well_id) == nullptr) {
+        throw std::invalid_argument(fmt::format(
+            "well {} does not exists in plate {}", well_id, plate_id));
+    }
+    std::optional<Pos2D> pos_origin = plate->PositionOrigin();
+    if (!pos_origin.has_value()) {
+        throw std::invalid_argument(
+            fmt::format("position origin of plate {} is not set", plate_id));
+    }
+
+    FocusPoint point{
+        .well_id = well_id,
+        .x = x - pos_origin->x,
+        .y = y - pos_origin->y,
+        .z = z,
+    };
+
+    // Write to DB
+    exp->DB()->BeginTransaction();
+    try {
+        exp->DB()->InsertOrReplaceRow(FocusPointRow{
+            .plate_id = plate_id,
+            .well_id = well_id,
+            .rel_pos_x = point.x,
+            .rel_pos_y = point.y,
+            .z = z,
+        });
+        exp->DB()->Commit();
+    } catch (std::exception &e) {
+        exp->DB()->Rollback();
+        throw std::runtime_error(
+            fmt::format("cannot write to DB: {}, rolled back", e.what()));
+    }
+
+    focus_maps[plate_id].SetPoint(point);
+
+    lk.unlock();
+
+    SendEvent({
+        .type = EventType::PlateModified,
+        .value = plate_id,
+    });
+}
+
+void SampleManager::ClearFocusMap(std::string plate_id)
+{
+    if (!exp->is_open()) {
+        throw std::invalid_argument("no open experiment");
+    }
+
+    std::unique_lock<std::shared_mutex> lk(plate_mutex);
+
+    ::Plate *plate = get_plate(plate_id);
+    if (plate == nullptr) {
+        throw std::invalid_argument(
+            fmt::format("plate {} does not exists", plate_id));
+    }
+
+    // Write to DB
+    exp->DB()->BeginTransaction();
+    try {
+        exp->DB()->DeleteFocusPoints(plate_id);
+        exp->DB()->Commit();
+    } catch (std::exception &e) {
+        exp->DB()->Rollback();
+        throw std::runtime_error(
+            fmt::format("cannot write to DB: {}, rolled back", e.what()));
+    }
+
+    focus_maps[plate_id].Clear();
+
+    lk.unlock();
+
+    SendEvent({
+        .type = EventType::PlateModified,
+        .value = plate_id,
+    });
+}
+
+void SampleManager::SetFocusSurfaceModel(std::string plate_id,
+                                         FocusSurfaceModel model)
+{
+    if (!exp->is_open()) {
+        throw std::invalid_argument("no open experiment");
+    }
+
+    std::unique_lock<std::shared_mutex> lk(plate_mutex);
+
+    ::Plate *plate = get_plate(plate_id);
+    if (plate == nullptr) {
+        throw std::invalid_argument(
+            fmt::format("plate {} does not exists", plate_id));
+    }
+
+    // The model is kept in the plate metadata
+    nlohmann::ordered_json old_metadata = plate->metadata;
+    plate->metadata["focus_surface_model"] = FocusSurfaceModelToString(model);
+
+    // Write to DB
+    exp->DB()->BeginTransaction();
+    try {
+        writePlateRow(plate);
+        exp->DB()->Commit();
+    } catch (std::exception &e) {
+        plate->metadata = old_metadata;
+        exp->DB()->Rollback();
+        throw std::runtime_error(
+            fmt::format("cannot write to DB: {}, rolled back", e.what()));
+    }
+
+    focus_maps[plate_id].SetModel(model);
+
+    lk.unlock();
+
+    SendEvent({
+        .type = EventType::PlateModified,
+        .value = plate_id,
+    });
+}
+
+FocusSurfaceModel SampleManager::FocusMapModel(std::string plate_id)
+{
+    std::shared_lock<std::shared_mutex> lk(plate_mutex);
+
+    auto it = focus_maps.find(plate_id);
+    if (it == focus_maps.end()) {
+        return FocusSurfaceModel::Auto;
+    }
+    return it->second.Model();
+}
+
+std::vector<FocusPoint> SampleManager::FocusPoints(std::string plate_id)
+{
+    std::shared_lock<std::shared_mutex> lk(plate_mutex);
+
+    auto it = focus_maps.find(plate_id);
+    if (it == focus_maps.end()) {
+        return {};
+    }
+    return it->second.Points();
+}
+
+std::optional<double> SampleManager::PredictFocusZ(const ::Site *site)
+{
+    if (site == nullptr) {
+        return std::nullopt;
+    }
+    std::shared_lock<std::shared_mutex> lk(plate_mutex);
+
+    // Position relative to the plate origin
+    ::Well *well = site->Well();
+    auto it = focus_maps.find(well->Plate()->ID());
+    if (it == focus_maps.end()) {
+        return std::nullopt;
+    }
+    double x = well->RelativePosition().x + site->RelativePosition().x;
+    double y = well->RelativePosition().y + site->RelativePosition().y;
+    return it->second.Evaluate(x, y);
+}
+
 void SampleManager::SetCurrentPlate(std::string plate_id)
 {
     if (!exp->is_open()) {
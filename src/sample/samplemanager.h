@@ -10,6 +10,7 @@
 
 #include "device/devicehub.h"
 #include "eventstream.h"
+#include "sample/focusmap.h"
 #include "sample/sample.h"
 
 class ExperimentControl;
@@ -40,6 +41,19 @@ public:
                                    std::vector<std::string> well_ids, int n_x,
                                    int n_y, double spacing_x, double spacing_y);
 
+    //
+    // Focus map
+    //
+    // x, y are absolute stage positions. Points are stored relative to the
+    // plate origin, so the map follows the plate if the origin is reset.
+    void SetFocusPoint(std::string plate_id, std::string well_id, double x,
+                       double y, double z);
+    void ClearFocusMap(std::string plate_id);
+    void SetFocusSurfaceModel(std::string plate_id, FocusSurfaceModel model);
+    FocusSurfaceModel FocusMapModel(std::string plate_id);
+    std::vector<FocusPoint> FocusPoints(std::string plate_id);
+    std::optional<double> PredictFocusZ(const ::Site *site);
+
     //
     // Switch sample
     //
@@ -77,6 +91,9 @@ private:
 
     ::Plate *current_plate = nullptr;
 
+    // Keyed by plate ID, guarded by plate_mutex
+    std::map<std::string, FocusMap> focus_maps;
+
     void writePlateRow(const ::Plate *plate);
     void writeWellRow(const ::Well *well);
     void writeSiteRow(const ::Site *well);
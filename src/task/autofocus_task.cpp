@@ -0,0 +1,305 @@
+#include "task/autofocus_task.h"
+#include "experimentcontrol.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <fmt/format.h>
+
+#include "logging.h"
+#include "utils/time_utils.h"
+
+AutofocusTask::AutofocusTask(ExperimentControl *exp)
+{
+    this->exp = exp;
+    this->camera = exp->Devices()->GetCamera();
+}
+
+Status AutofocusTask::PrepareBuffer()
+{
+    int n_buffer_frames = 2;
+
+    utils::StopWatch sw;
+    if (camera->BufferAllocated() < n_buffer_frames) {
+        if (camera->BufferAllocated() > 0) {
+            Status status = camera->ReleaseBuffer();
+            if (!status.ok()) {
+                LOG_ERROR("[{}] Release buffer failed: {}", task_name,
+                          status.ToString());
+                return status;
+            }
+        }
+        Status status = camera->AllocBuffer(n_buffer_frames);
+        if (!status.ok()) {
+            LOG_ERROR("[{}] alloc buffer failed: {}", task_name,
+                      status.ToString());
+            return status;
+        }
+        LOG_DEBUG("[{}] Buffer allocated (n_frame={}) [{:.1f} ms]", task_name,
+                  n_buffer_frames, sw.Milliseconds());
+    }
+    return absl::OkStatus();
+}
+
+Status AutofocusTask::StartAcquisition()
+{
+    // Free-running internal trigger as in live view, so that a new frame is
+    // always on the way while the Z drive moves. The trigger source is
+    // restored afterwards, so the next task does not have to set it again.
+    utils::StopWatch sw;
+    saved_trigger_source.reset();
+    StatusOr<std::string> trigger_source =
+        camera->GetProperty("TRIGGER SOURCE");
+    if (!trigger_source.ok()) {
+        return trigger_source.status();
+    }
+    if (trigger_source.value() != "INTERNAL") {
+        Status status = camera->SetProperty("TRIGGER SOURCE", "INTERNAL");
+        if (!status.ok()) {
+            return status;
+        }
+        saved_trigger_source = trigger_source.value();
+    }
+
+    Status status = camera->StartContinousAcquisition();
+    if (!status.ok()) {
+        restoreTriggerSource();
+        return status;
+    }
+    LOG_DEBUG("[{}] Continous acquisition started [{:.1f} ms]", task_name,
+              sw.Milliseconds());
+    return absl::OkStatus();
+}
+
+Status AutofocusTask::StopAcquisition()
+{
+    utils::StopWatch sw;
+    Status status = camera->StopAcquisition();
+    restoreTriggerSource();
+    if (!status.ok()) {
+        return status;
+    }
+    LOG_DEBUG("[{}] Acquisition stopped [{:.1f} ms]", task_name,
+              sw.Milliseconds());
+    return absl::OkStatus();
+}
+
+void AutofocusTask::restoreTriggerSource()
+{
+    if (!saved_trigger_source.has_value()) {
+        return;
+    }
+    Status status =
+        camera->SetProperty("TRIGGER SOURCE", saved_trigger_source.value());
+    if (!status.ok()) {
+        LOG_ERROR("[{}] Failed to restore trigger source {}: {}", task_name,
+                  saved_trigger_source.value(), status.ToString());
+    }
+    saved_trigger_source.reset();
+}
+
+Status AutofocusTask::MoveZ(double z)
+{
+    Status status =
+        exp->Devices()->SetProperty(z_property, fmt::format("{:.3f}", z));
+    if (!status.ok()) {
+        return status;
+    }
+    return exp->Devices()->WaitPropertyFor(
+        {z_property}, std::chrono::milliseconds(params.z_timeout_ms));
+}
+
+StatusOr<double> AutofocusTask::MeasureAt(double z)
+{
+    int64_t key = std::llround(z * 1000);
+    auto it = scores.find(key);
+    if (it != scores.end()) {
+        return it->second;
+    }
+
+    utils::StopWatch sw;
+    Status status = MoveZ(z);
+    if (!status.ok()) {
+        return status;
+    }
+    double move_ms = sw.Milliseconds();
+
+    // The frame being exposed when the move completes is blurred by the
+    // motion. Skip it and use the next one.
+    sw.Reset();
+    int n_ready = 0;
+    int n_lost = 0;
+    while (n_ready < 2) {
+        status = camera->WaitFrameReady(1000);
+        if (absl::IsDataLoss(status) && (n_lost < 3)) {
+            n_lost++;
+            continue;
+        }
+        if (!status.ok()) {
+            return status;
+        }
+        n_ready++;
+    }
+    StatusOr<ImageData> frame = camera->GetFrame(-1);
+    if (!frame.ok()) {
+        return frame.status();
+    }
+    double frame_ms = sw.Milliseconds();
+
+    sw.Reset();
+    double score = im::FocusScore(frame.value(), params.metric, params.stride);
+    scores[key] = score;
+    LOG_DEBUG("[{}] z={:.3f} score={:.4g} [move {:.1f} ms, frame {:.1f} ms, "
+              "metric {:.1f} ms]",
+              task_name, z, score, move_ms, frame_ms, sw.Milliseconds());
+    return score;
+}
+
+StatusOr<AutofocusResult> AutofocusTask::search(double z_center)
+{
+    //
+    // Coarse scan over the full range
+    //
+    int n_half = std::max(1, (int)std::ceil(params.range_um / 2 /
+                                            params.coarse_step_um));
+    double z_min = z_center - n_half * params.coarse_step_um;
+    double z_max = z_center + n_half * params.coarse_step_um;
+
+    double z_best = z_center;
+    double score_best = -1;
+    for (int i = -n_half; i <= n_half; i++) {
+        double z = z_center + i * params.coarse_step_um;
+        StatusOr<double> score = MeasureAt(z);
+        if (!score.ok()) {
+            return score.status();
+        }
+        if (score.value() > score_best) {
+            z_best = z;
+            score_best = score.value();
+        }
+    }
+    LOG_DEBUG("[{}] Coarse peak at z={:.3f} ({} frames)", task_name, z_best,
+              scores.size());
+
+    //
+    // Refine around the peak, halving the step each round
+    //
+    double step = params.coarse_step_um / 2;
+    for (; step >= params.fine_step_um; step /= 2) {
+        double z_round = z_best;
+        for (double z : {z_round - step, z_round + step}) {
+            if ((z < z_min) || (z > z_max)) {
+                continue;
+            }
+            StatusOr<double> score = MeasureAt(z);
+            if (!score.ok()) {
+                return score.status();
+            }
+            if (score.value() > score_best) {
+                z_best = z;
+                score_best = score.value();
+            }
+        }
+    }
+
+    //
+    // Parabolic interpolation with the neighbours of the last round
+    //
+    step *= 2;
+    double z_final = z_best;
+    auto lower = scores.find(std::llround((z_best - step) * 1000));
+    auto upper = scores.find(std::llround((z_best + step) * 1000));
+    if ((lower != scores.end()) && (upper != scores.end())) {
+        double denom = lower->second - 2 * score_best + upper->second;
+        if (denom < 0) {
+            double offset = step * (lower->second - upper->second) / denom / 2;
+            z_final = z_best + std::clamp(offset, -step, step);
+        }
+    }
+
+    return AutofocusResult{
+        .z = z_final,
+        .score = score_best,
+        .n_frames = (int)scores.size(),
+    };
+}
+
+StatusOr<AutofocusResult> AutofocusTask::Run(Channel channel,
+                                             AutofocusParams params)
+{
+    if ((params.range_um <= 0) || (params.coarse_step_um <= 0) ||
+        (params.fine_step_um <= 0) || (params.stride < 1))
+    {
+        return absl::InvalidArgumentError("invalid autofocus parameters");
+    }
+    this->params = params;
+    scores.clear();
+
+    utils::StopWatch sw_task;
+    StatusOr<std::string> z_value = exp->Devices()->GetProperty(z_property);
+    if (!z_value.ok()) {
+        return z_value.status();
+    }
+    double z_initial = std::stod(z_value.value());
+
+    exp->Channels()->SwitchChannel(channel.preset_name, channel.exposure_ms,
+                                   channel.illumination_intensity);
+    Status status = exp->Channels()->WaitSwitchChannel();
+    if (!status.ok()) {
+        return status;
+    }
+    status = PrepareBuffer();
+    if (!status.ok()) {
+        return status;
+    }
+    status = StartAcquisition();
+    if (!status.ok()) {
+        return status;
+    }
+
+    SendEvent({
+        .type = EventType::TaskMessage,
+        .value = "Autofocus...",
+    });
+
+    StatusOr<AutofocusResult> result;
+    status = exp->Channels()->OpenCurrentShutter();
+    if (status.ok()) {
+        status = exp->Channels()->WaitShutter();
+    }
+    if (status.ok()) {
+        result = search(z_initial);
+        status = result.status();
+    }
+
+    Status shutter_status = exp->Channels()->CloseCurrentShutter();
+    if (!shutter_status.ok()) {
+        LOG_ERROR("[{}] Failed to close shutter: {}", task_name,
+                  shutter_status.ToString());
+    }
+    Status stop_status = StopAcquisition();
+    if (!stop_status.ok()) {
+        LOG_ERROR("[{}] StopAcquisition failed: {}", task_name,
+                  stop_status.ToString());
+    }
+
+    if (!status.ok()) {
+        LOG_ERROR("[{}] Failed: {}. Go back to z={:.3f}", task_name,
+                  status.ToString(), z_initial);
+        Status move_status = MoveZ(z_initial);
+        if (!move_status.ok()) {
+            LOG_ERROR("[{}] Failed to restore z: {}", task_name,
+                      move_status.ToString());
+        }
+        return status;
+    }
+
+    status = MoveZ(result->z);
+    if (!status.ok()) {
+        return status;
+    }
+    LOG_INFO("[{}] Focus at z={:.3f} (from {:.3f}, {} frames) [{:.0f} ms]",
+             task_name, result->z, z_initial, result->n_frames,
+             sw_task.Milliseconds());
+    return result;
+}
@@ -0,0 +1,67 @@
+#ifndef AUTOFOCUS_TASK_H
+#define AUTOFOCUS_TASK_H
+
+#include <map>
+#include <optional>
+#include <string>
+
+#include "channel.h"
+#include "device/devicehub.h"
+#include "device/camera.h"
+#include "eventstream.h"
+#include "image/imagedata.h"
+#include "image/imageutils.h"
+
+class ExperimentControl;
+
+struct AutofocusParams {
+    im::FocusMetric metric = im::FocusMetric::Brenner;
+    // Search range centered at the current position, in um
+    double range_um = 20;
+    double coarse_step_um = 2;
+    // Refinement stops when the step is smaller than this
+    double fine_step_um = 0.25;
+    // Focus metric is evaluated on every stride-th pixel
+    int stride = 4;
+    // Z drive settling timeout for each step
+    int z_timeout_ms = 2000;
+};
+
+struct AutofocusResult {
+    double z;
+    double score;
+    int n_frames;
+};
+
+class AutofocusTask : public EventSender {
+public:
+    AutofocusTask(ExperimentControl *exp);
+
+    StatusOr<AutofocusResult> Run(Channel channel, AutofocusParams params);
+
+protected:
+    Status PrepareBuffer();
+    Status StartAcquisition();
+    Status StopAcquisition();
+    Status MoveZ(double z);
+    StatusOr<double> MeasureAt(double z);
+
+private:
+    ExperimentControl *exp;
+    Camera *camera;
+
+    std::string task_name = "Autofocus";
+    PropertyPath z_property = "/NikonTi/ZDrivePosition";
+
+    AutofocusParams params;
+    // Scores of positions measured in the current run, keyed in units of
+    // 0.001 um to match the precision of the Z drive
+    std::map<int64_t, double> scores;
+    // Trigger source before the run, if it was changed to INTERNAL
+    std::optional<std::string> saved_trigger_source;
+
+    StatusOr<AutofocusResult> search(double z_center);
+    void restoreTriggerSource();
+};
+
+#endif
@@ -1,7 +1,10 @@
 #include "channelcontrol.h"
 
+#include <functional>
+
 #include "config.h"
 #include "logging.h"
+#include "utils/trace.h"
 
 ChannelControl::ChannelControl(DeviceHub *dev)
 {
@@ -10,14 +13,21 @@ ChannelControl::ChannelControl(DeviceHub *dev)
         preset_names.push_back(preset.name);
         preset_map[preset.name] = preset;
 
-        for (const auto &[property, value] : preset.property_value) {
-            required_properties.insert(property);
+        CompiledPreset compiled;
+        compiled.fixed_values = preset.property_value;
+        compiled.illumination_property = preset.illumination_property;
+        compiled.exposure_property = "/Hamamatsu/EXPOSURE TIME";
+        // Set from the arguments of the switch instead
+        compiled.fixed_values.erase(compiled.illumination_property);
+        compiled.fixed_values.erase(compiled.exposure_property);
+        for (const auto &[property, value] : compiled.fixed_values) {
+            compiled.properties.push_back(property);
         }
-        required_properties.insert(preset.shutter_property);
-        required_properties.insert(preset.illumination_property);
-    }
-    for (const auto &property : required_properties) {
-        required_devices.insert(property.DeviceName());
+        if (!compiled.illumination_property.empty()) {
+            compiled.properties.push_back(compiled.illumination_property);
+        }
+        compiled.properties.push_back(compiled.exposure_property);
+        compiled_presets[preset.name] = compiled;
     }
 }
 
@@ -43,37 +53,72 @@ Status ChannelControl::runSwitchChannel(ChannelPreset preset,
     std::unique_lock<std::shared_mutex> lk_shutter(shutter_mutex);
 
     utils::StopWatch sw;
+    utils::TraceSpan span("channel", "switch channel");
 
-    auto snapshot = dev->GetPropertySnapshot(required_devices);
+    const CompiledPreset &compiled = compiled_presets.at(preset.name);
     auto channel_property_value =
-        getChannelPropertyValue(preset, exposure_ms, illumination_intensity);
-    auto diff = diffSnapshotPropertyValue(snapshot, channel_property_value);
+        getChannelPropertyValue(compiled, exposure_ms, illumination_intensity);
+
+    // Fixed values that differ from the last preset are set without reading
+    // them. The other properties are checked against their last known values,
+    // in case they were changed since, e.g. on the microscope.
+    PropertyValueMap diff;
+    std::vector<PropertyPath> verify_list;
+    if (last_preset.has_value()) {
+        diff = getTransition(last_preset.value(), preset.name);
+        for (const auto &property : compiled.properties) {
+            if (!diff.contains(property)) {
+                verify_list.push_back(property);
+            }
+        }
+    } else {
+        verify_list = compiled.properties;
+    }
+    last_preset.reset();
+
+    PropertyValueMap verify_value;
+    for (const auto &property : verify_list) {
+        verify_value[property] = channel_property_value[property];
+    }
+    auto snapshot = dev->GetPropertySnapshot(verify_list);
+    diff.merge(diffSnapshotPropertyValue(snapshot, verify_value));
+
+    auto stages = planSwitchStages(preset, diff);
 
     LOG_DEBUG("Switching to channel {}", preset.name);
     LOG_DEBUG("  Set Shutter=\"{}\"", preset.shutter_property);
-    for (const auto &[property, value] : diff) {
-        LOG_DEBUG("  Set {}=\"{}\"", property, value);
+    for (int i = 0; i < stages.size(); i++) {
+        for (const auto &[property, value] : stages[i]) {
+            LOG_DEBUG("  [{}] Set {}=\"{}\"", i + 1, property, value);
+        }
     }
     current_shutter = preset.shutter_property;
-    Status status = dev->SetProperty(diff);
-    if (!status.ok()) {
-        return absl::UnavailableError(fmt::format(
-            "switch to channel {}: {}", preset.name, status.ToString()));
-    }
 
-    status = dev->WaitPropertyFor(PropertyPathList(diff),
-                                  std::chrono::milliseconds(5000));
-    if (!status.ok()) {
-        std::string message = fmt::format("timeout switching to channel {}: {}",
-                                          preset.name, status.ToString());
-        LOG_ERROR(message);
-        SendEvent({
-            .type = EventType::TaskMessage,
-            .value = message,
-        });
-        return absl::DeadlineExceededError(message);
+    auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(5000);
+    for (const auto &stage : stages) {
+        Status status = dev->SetProperty(stage);
+        if (!status.ok()) {
+            return absl::UnavailableError(fmt::format(
+                "switch to channel {}: {}", preset.name, status.ToString()));
+        }
+
+        status = dev->WaitPropertyUntil(PropertyPathList(stage), deadline);
+        if (!status.ok()) {
+            std::string message =
+                fmt::format("timeout switching to channel {}: {}",
+                            preset.name, status.ToString());
+            LOG_ERROR(message);
+            SendEvent({
+                .type = EventType::TaskMessage,
+                .value = message,
+            });
+            return absl::DeadlineExceededError(message);
+        }
     }
 
+    last_preset = preset.name;
+
     std::string message = fmt::format("Switched to channel {} [{:.0f} ms]",
                                       preset.name, sw.Milliseconds());
     LOG_INFO(message);
@@ -113,6 +158,7 @@ void ChannelControl::SwitchChannel(std::string preset_name, double exposure_ms,
 
 Status ChannelControl::WaitSwitchChannel()
 {
+    utils::TraceSpan span("channel", "wait switch channel");
     return switch_channel_future.get();
 }
 
@@ -172,25 +218,51 @@ Status ChannelControl::WaitShutter()
     if (current_shutter.empty()) {
         return absl::OkStatus();
     }
+    utils::TraceSpan span("channel", "wait shutter");
     return dev->WaitPropertyFor({current_shutter},
                                 std::chrono::milliseconds(300));
 }
 
-PropertyValueMap ChannelControl::getChannelPropertyValue(
-    ChannelPreset preset, double exposure_ms, double illumination_intensity)
+PropertyValueMap
+ChannelControl::getChannelPropertyValue(const CompiledPreset &compiled,
+                                        double exposure_ms,
+                                        double illumination_intensity)
 {
-    auto channel_property_value = preset.property_value;
-    if (!preset.illumination_property.empty()) {
-        channel_property_value[preset.illumination_property] =
+    auto channel_property_value = compiled.fixed_values;
+    if (!compiled.illumination_property.empty()) {
+        channel_property_value[compiled.illumination_property] =
             fmt::format("{:.0f}", std::round(illumination_intensity));
     }
     double exposure_s = exposure_ms / 1000.0;
-    channel_property_value["/Hamamatsu/EXPOSURE TIME"] =
+    channel_property_value[compiled.exposure_property] =
         fmt::format("{:.6g}", exposure_s);
 
     return channel_property_value;
 }
 
+const PropertyValueMap &ChannelControl::getTransition(const std::string &from,
+                                                      const std::string &to)
+{
+    std::lock_guard<std::mutex> lk(transition_mutex);
+    auto key = std::make_pair(from, to);
+    auto it = transition_cache.find(key);
+    if (it != transition_cache.end()) {
+        return it->second;
+    }
+
+    const PropertyValueMap &from_values =
+        compiled_presets.at(from).fixed_values;
+    const PropertyValueMap &to_values = compiled_presets.at(to).fixed_values;
+    PropertyValueMap changed;
+    for (const auto &[property, value] : to_values) {
+        auto it_from = from_values.find(property);
+        if ((it_from == from_values.end()) || (it_from->second != value)) {
+            changed[property] = value;
+        }
+    }
+    return transition_cache.emplace(key, changed).first->second;
+}
+
 PropertyValueMap
 ChannelControl::diffSnapshotPropertyValue(PropertyValueMap snapshot,
                                           PropertyValueMap propery_value)
@@ -206,3 +278,40 @@ ChannelControl::diffSnapshotPropertyValue(PropertyValueMap snapshot,
     }
     return diff;
 }
+
+std::vector<PropertyValueMap>
+ChannelControl::planSwitchStages(const ChannelPreset &preset,
+                                 const PropertyValueMap &diff)
+{
+    // Stage of a property is one after the latest stage of the properties it
+    // is set after. Properties that do not change are already in place.
+    std::map<PropertyPath, int> stage_map;
+    std::function<int(const PropertyPath &)> stage_of =
+        [&](const PropertyPath &property) {
+            auto it_stage = stage_map.find(property);
+            if (it_stage != stage_map.end()) {
+                return it_stage->second;
+            }
+            int stage = 0;
+            auto it = preset.set_after.find(property);
+            if (it != preset.set_after.end()) {
+                for (const auto &dep : it->second) {
+                    if (diff.contains(dep)) {
+                        stage = std::max(stage, stage_of(dep) + 1);
+                    }
+                }
+            }
+            stage_map[property] = stage;
+            return stage;
+        };
+
+    std::vector<PropertyValueMap> stages;
+    for (const auto &[property, value] : diff) {
+        int stage = stage_of(property);
+        if (stages.size() <= stage) {
+            stages.resize(stage + 1);
+        }
+        stages[stage][property] = value;
+    }
+    return stages;
+}
@@ -3,6 +3,8 @@
 
 #include <future>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <shared_mutex>
 #include <string>
@@ -35,8 +37,28 @@ private:
 
     std::vector<std::string> preset_names;
     std::map<std::string, ChannelPreset> preset_map;
-    std::set<std::string> required_devices;
-    std::set<PropertyPath> required_properties;
+
+    // Properties set by a switch to a preset, compiled once from the config
+    struct CompiledPreset {
+        PropertyValueMap fixed_values;
+        // Illumination intensity and exposure, set from the arguments
+        PropertyPath illumination_property;
+        PropertyPath exposure_property;
+        std::vector<PropertyPath> properties;
+    };
+    std::map<std::string, CompiledPreset> compiled_presets;
+
+    // Fixed values of the target preset that differ from the source preset,
+    // keyed by (from, to)
+    std::mutex transition_mutex;
+    std::map<std::pair<std::string, std::string>, PropertyValueMap>
+        transition_cache;
+    const PropertyValueMap &getTransition(const std::string &from,
+                                          const std::string &to);
+
+    // Preset of the last completed switch. Only accessed by runSwitchChannel,
+    // which does not run concurrently.
+    std::optional<std::string> last_preset;
 
     std::shared_mutex channels_mutex;
     std::shared_mutex shutter_mutex;
@@ -47,12 +69,18 @@ private:
     std::future<Status> switch_channel_future;
 
     // helper functions:
-    PropertyValueMap getChannelPropertyValue(ChannelPreset preset,
+    PropertyValueMap getChannelPropertyValue(const CompiledPreset &compiled,
                                              double exposure_ms,
                                              double illumination_intensity);
 
     PropertyValueMap diffSnapshotPropertyValue(PropertyValueMap snapshot,
                                                PropertyValueMap propery_value);
+
+    // Splits the properties to set into stages by the set_after of the preset.
+    // Properties of a stage are set concurrently, after the previous stages
+    // have settled.
+    std::vector<PropertyValueMap>
+    planSwitchStages(const ChannelPreset &preset, const PropertyValueMap &diff);
 };
 
 #endif
@@ -0,0 +1,152 @@
+#include "task/channelplanner.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+// Channels up to this number are ordered by exhaustive search, more by
+// nearest neighbor
+static const int max_exhaustive_channels = 8;
+
+ChannelOrder ChannelOrderFromString(std::string value)
+{
+    if (value == "as_given") {
+        return ChannelOrder::AsGiven;
+    } else if (value == "min_moves") {
+        return ChannelOrder::MinMoves;
+    } else if (value == "ping_pong") {
+        return ChannelOrder::PingPong;
+    }
+    throw std::invalid_argument("invalid channel order");
+}
+
+std::string ChannelOrderToString(ChannelOrder order)
+{
+    switch (order) {
+    case ChannelOrder::AsGiven:
+        return "as_given";
+    case ChannelOrder::MinMoves:
+        return "min_moves";
+    case ChannelOrder::PingPong:
+        return "ping_pong";
+    default:
+        throw std::invalid_argument("invalid channel order");
+    }
+}
+
+double PresetSwitchCost(const ChannelPreset &from, const ChannelPreset &to,
+                        const std::map<PropertyPath, MoveCost> &move_cost)
+{
+    double cost = 0;
+    for (const auto &[property, value] : to.property_value) {
+        auto it_cost = move_cost.find(property);
+        if (it_cost == move_cost.end()) {
+            continue;
+        }
+        auto it_from = from.property_value.find(property);
+        if (it_from == from.property_value.end()) {
+            // Position unknown
+            cost += it_cost->second.base_ms;
+        } else {
+            cost += it_cost->second.Cost(it_from->second, value);
+        }
+    }
+    return cost;
+}
+
+static std::vector<int>
+orderMinMoves(const std::vector<ChannelPreset> &presets,
+              const std::optional<ChannelPreset> &from,
+              const std::map<PropertyPath, MoveCost> &move_cost)
+{
+    int n = presets.size();
+    std::vector<std::vector<double>> cost(n, std::vector<double>(n, 0));
+    std::vector<double> cost_start(n, 0);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (i != j) {
+                cost[i][j] = PresetSwitchCost(presets[i], presets[j],
+                                              move_cost);
+            }
+        }
+        if (from.has_value()) {
+            cost_start[i] = PresetSwitchCost(from.value(), presets[i],
+                                             move_cost);
+        }
+    }
+    auto total_cost = [&](const std::vector<int> &order) {
+        double total = cost_start[order[0]];
+        for (int k = 1; k < n; k++) {
+            total += cost[order[k - 1]][order[k]];
+        }
+        return total;
+    };
+
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+
+    if (n <= max_exhaustive_channels) {
+        // Permutations are visited in lexicographic order and only a strictly
+        // lower cost is taken, so ties keep the order closest to the given one
+        std::vector<int> best_order = order;
+        double best_cost = total_cost(order);
+        while (std::next_permutation(order.begin(), order.end())) {
+            double c = total_cost(order);
+            if (c < best_cost) {
+                best_cost = c;
+                best_order = order;
+            }
+        }
+        return best_order;
+    }
+
+    std::vector<int> result;
+    std::vector<bool> visited(n, false);
+    for (int k = 0; k < n; k++) {
+        int i_best = -1;
+        double best_cost = std::numeric_limits<double>::infinity();
+        for (int i = 0; i < n; i++) {
+            if (visited[i]) {
+                continue;
+            }
+            double c = result.empty() ? cost_start[i] : cost[result.back()][i];
+            if (c < best_cost) {
+                best_cost = c;
+                i_best = i;
+            }
+        }
+        visited[i_best] = true;
+        result.push_back(i_best);
+    }
+    return result;
+}
+
+std::vector<int>
+PlanChannelOrder(const std::vector<ChannelPreset> &presets,
+                 ChannelOrder order,
+                 const std::optional<ChannelPreset> &from,
+                 const std::map<PropertyPath, MoveCost> &move_cost)
+{
+    std::vector<int> result(presets.size());
+    std::iota(result.begin(), result.end(), 0);
+    if (presets.size() < 2) {
+        return result;
+    }
+
+    switch (order) {
+    case ChannelOrder::AsGiven:
+        return result;
+    case ChannelOrder::MinMoves:
+        return orderMinMoves(presets, from, move_cost);
+    case ChannelOrder::PingPong:
+        if (from.has_value() && (from->name == presets.back().name) &&
+            (from->name != presets.front().name))
+        {
+            std::reverse(result.begin(), result.end());
+        }
+        return result;
+    default:
+        throw std::invalid_argument("invalid channel order");
+    }
+}
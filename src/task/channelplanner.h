@@ -0,0 +1,38 @@
+#ifndef CHANNELPLANNER_H
+#define CHANNELPLANNER_H
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "channel.h"
+#include "device/propertypath.h"
+
+enum class ChannelOrder {
+    // Order of the channels in the request
+    AsGiven,
+    // Least total move time of the filter turrets and other slow properties
+    MinMoves,
+    // Reversed at every other acquisition, so that the last channel of one
+    // site is the first channel of the next
+    PingPong,
+};
+
+ChannelOrder ChannelOrderFromString(std::string value);
+std::string ChannelOrderToString(ChannelOrder order);
+
+// Time to switch from one preset to another, the sum over the properties of
+// the target preset that change. Properties without a move cost are free.
+double PresetSwitchCost(const ChannelPreset &from, const ChannelPreset &to,
+                        const std::map<PropertyPath, MoveCost> &move_cost);
+
+// Plan the acquisition order of channels, as indices into presets. If from is
+// set, the switch from it to the first channel is included.
+std::vector<int>
+PlanChannelOrder(const std::vector<ChannelPreset> &presets,
+                 ChannelOrder order,
+                 const std::optional<ChannelPreset> &from,
+                 const std::map<PropertyPath, MoveCost> &move_cost);
+
+#endif
@@ -1,12 +1,20 @@
 #include "task/live_view_task.h"
 #include "experimentcontrol.h"
 
+#include <algorithm>
+
 #include "logging.h"
 
+// Frames in the camera buffer, enough for the recording to catch up when
+// reading is briefly delayed
+static const int live_buffer_frames = 32;
+// Used to preallocate a recording if the camera does not report its rate
+static const double default_frame_rate = 100;
+
 LiveViewTask::LiveViewTask(ExperimentControl *exp)
 {
     this->exp = exp;
-    this->dcam = exp->Devices()->GetHamamatsuDCam();
+    this->camera = exp->Devices()->GetCamera();
 }
 
 bool LiveViewTask::IsRunning() { return is_running; }
@@ -24,11 +32,29 @@ void LiveViewTask::Run()
     }
     is_running = true;
 
+    // Recording starts from the newest frame when a recorder is attached
+    LiveRecorder *last_recorder = nullptr;
+    int32_t n_read = -1;
     try {
         for (;;) {
-            StatusOr<ImageData> frame = GetFrame();
+            std::shared_ptr<LiveRecorder> rec;
+            {
+                std::lock_guard<std::mutex> lk(recorder_mutex);
+                rec = recorder;
+            }
+            if (rec && !rec->Accepting()) {
+                rec = nullptr;
+            }
+            if (rec.get() != last_recorder) {
+                last_recorder = rec.get();
+                n_read = -1;
+            }
+
+            StatusOr<ImageData> frame =
+                rec ? recordFrames(rec.get(), n_read) : GetFrame();
             if (absl::IsCancelled(frame.status())) {
                 is_running = false;
+                stopRecorder();
                 exp->Images()->SetLiveViewFrame(ImageData());
                 return;
             }
@@ -37,8 +63,11 @@ void LiveViewTask::Run()
                          frame.status().ToString());
                 continue;
             }
-            if (!status.ok()) {
-                throw std::runtime_error(status.ToString());
+            if (!frame.ok()) {
+                throw std::runtime_error(frame.status().ToString());
+            }
+            if (frame.value().empty()) {
+                continue;
             }
             exp->Images()->SetLiveViewFrame(frame.value());
         }
@@ -49,6 +78,7 @@ void LiveViewTask::Run()
             LOG_ERROR("StopAcquisition failed: {}", stop_acq_status.ToString());
         }
         is_running = false;
+        stopRecorder();
         exp->Images()->SetLiveViewFrame(ImageData());
         throw e;
     }
@@ -63,17 +93,119 @@ void LiveViewTask::Stop()
     }
 }
 
+void LiveViewTask::StartRecording(std::filesystem::path dir,
+                                  std::string name, std::string ch_name,
+                                  double duration_s)
+{
+    if (!is_running) {
+        throw std::runtime_error("live view is not running");
+    }
+
+    double frame_rate = default_frame_rate;
+    StatusOr<std::string> frame_rate_str =
+        camera->GetProperty("INTERNAL FRAME RATE");
+    if (frame_rate_str.ok()) {
+        frame_rate = std::stod(frame_rate_str.value());
+    }
+
+    std::lock_guard<std::mutex> lk(recorder_mutex);
+    if (recorder && recorder->Stats().running) {
+        throw std::runtime_error("recording in progress");
+    }
+    recorder = std::make_shared<LiveRecorder>(
+        dir, name, ch_name, camera->GetHeight(), camera->GetWidth(), duration_s,
+        frame_rate);
+    LOG_INFO("[{}] Recording {} started at {:.1f} fps", task_name, name,
+             frame_rate);
+}
+
+LiveRecordingStats LiveViewTask::StopRecording()
+{
+    std::shared_ptr<LiveRecorder> rec;
+    {
+        std::lock_guard<std::mutex> lk(recorder_mutex);
+        rec = recorder;
+    }
+    if (!rec) {
+        throw std::runtime_error("no recording");
+    }
+    rec->Stop();
+    return rec->Wait();
+}
+
+std::optional<LiveRecordingStats> LiveViewTask::RecordingStats()
+{
+    std::lock_guard<std::mutex> lk(recorder_mutex);
+    if (!recorder) {
+        return std::nullopt;
+    }
+    return recorder->Stats();
+}
+
+void LiveViewTask::stopRecorder()
+{
+    std::lock_guard<std::mutex> lk(recorder_mutex);
+    if (recorder) {
+        recorder->Stop();
+    }
+}
+
+StatusOr<ImageData> LiveViewTask::recordFrames(LiveRecorder *rec,
+                                               int32_t &n_read)
+{
+    Status status = camera->WaitFrameReady(1000);
+    if (absl::IsCancelled(status)) {
+        return status;
+    }
+    // A frame lost by the camera is not in the frame count. Frames
+    // overwritten before they were read show up as a gap in it.
+    if (absl::IsDataLoss(status)) {
+        rec->AddCameraDrops(1);
+    } else if (!status.ok()) {
+        LOG_ERROR("[{}] WaitFrameReady failed: {}", task_name,
+                  status.ToString());
+        return absl::InternalError("WaitFrameReady failed: " +
+                                   status.ToString());
+    }
+    StatusOr<int32_t> frame_count = camera->GetFrameCount();
+    if (!frame_count.ok()) {
+        return frame_count.status();
+    }
+    int32_t n_buffer = camera->BufferAllocated();
+    if (n_read < 0) {
+        n_read = frame_count.value() - 1;
+    }
+
+    // The oldest frame in the buffer may be overwritten while it is read
+    int32_t first = std::max(n_read, frame_count.value() - n_buffer + 1);
+    if (first > n_read) {
+        rec->AddCameraDrops(first - n_read);
+    }
+    ImageData latest;
+    for (int32_t k = first; k < frame_count.value(); k++) {
+        std::chrono::system_clock::time_point timestamp;
+        StatusOr<ImageData> frame = camera->GetFrame(k % n_buffer, &timestamp);
+        if (!frame.ok()) {
+            return frame.status();
+        }
+        rec->AddFrame(frame.value(), timestamp, k);
+        latest = frame.value();
+    }
+    n_read = frame_count.value();
+    return latest;
+}
+
 Status LiveViewTask::PrepareBuffer()
 {
-    int n_buffer_frames = 2;
+    int n_buffer_frames = live_buffer_frames;
 
     utils::StopWatch sw;
-    if (dcam->BufferAllocated() < n_buffer_frames) {
-        if (dcam->BufferAllocated() > 0) {
+    if (camera->BufferAllocated() < n_buffer_frames) {
+        if (camera->BufferAllocated() > 0) {
             LOG_DEBUG("[{}] Releasing Buffer (n_frame={})...", task_name,
-                      dcam->BufferAllocated());
+                      camera->BufferAllocated());
             sw.Reset();
-            Status status = dcam->ReleaseBuffer();
+            Status status = camera->ReleaseBuffer();
             if (!status.ok()) {
                 LOG_ERROR("[{}] Release buffer failed: {}", task_name,
                           status.ToString());
@@ -83,7 +215,7 @@ Status LiveViewTask::PrepareBuffer()
                       sw.Milliseconds());
         }
         sw.Reset();
-        Status status = dcam->AllocBuffer(n_buffer_frames);
+        Status status = camera->AllocBuffer(n_buffer_frames);
         if (!status.ok()) {
             LOG_ERROR("[{}] alloc buffer failed: {}", task_name,
                       status.ToString());
@@ -101,13 +233,14 @@ Status LiveViewTask::PrepareBuffer()
 Status LiveViewTask::StartAcquisition()
 {
     utils::StopWatch sw;
-    StatusOr<std::string> trigger_source = dcam->GetProperty("TRIGGER SOURCE");
+    StatusOr<std::string> trigger_source =
+        camera->GetProperty("TRIGGER SOURCE");
     if (!trigger_source.ok()) {
         return trigger_source.status();
     }
 
     if (trigger_source.value() != "INTERNAL") {
-        Status status = dcam->SetProperty("TRIGGER SOURCE", "INTERNAL");
+        Status status = camera->SetProperty("TRIGGER SOURCE", "INTERNAL");
         if (!status.ok()) {
             return status;
         }
@@ -119,7 +252,7 @@ Status LiveViewTask::StartAcquisition()
     }
 
     sw.Reset();
-    Status status = dcam->StartContinousAcquisition();
+    Status status = camera->StartContinousAcquisition();
     if (!status.ok()) {
         return status;
     }
@@ -130,7 +263,7 @@ Status LiveViewTask::StartAcquisition()
 
 StatusOr<ImageData> LiveViewTask::GetFrame()
 {
-    Status status = dcam->WaitFrameReady(1000);
+    Status status = camera->WaitFrameReady(1000);
     if (absl::IsCancelled(status) || absl::IsDataLoss(status)) {
         return status;
     }
@@ -142,13 +275,13 @@ StatusOr<ImageData> LiveViewTask::GetFrame()
     }
 
     // Get latest frame
-    return dcam->GetFrame(-1);
+    return camera->GetFrame(-1);
 }
 
 Status LiveViewTask::StopAcquisition()
 {
     utils::StopWatch sw;
-    Status status = dcam->StopAcquisition();
+    Status status = camera->StopAcquisition();
     if (!status.ok()) {
         return status;
     }
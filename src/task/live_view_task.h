@@ -1,11 +1,15 @@
 #ifndef LIVE_VIEW_TASK_H
 #define LIVE_VIEW_TASK_H
 
+#include <memory>
+#include <mutex>
+
 #include "device/devicehub.h"
-#include "device/hamamatsu/hamamatsu_dcam.h"
+#include "device/camera.h"
 #include "eventstream.h"
 #include "image/imagedata.h"
 #include "image/imagemanager.h"
+#include "image/liverecording.h"
 
 class ExperimentControl;
 
@@ -16,6 +20,14 @@ public:
     void Run();
     void Stop();
 
+    // While recording, every frame from the camera is written to the
+    // recording, and the display gets the latest one
+    void StartRecording(std::filesystem::path dir, std::string name,
+                        std::string ch_name, double duration_s);
+    // Waits until the recorded frames are written
+    LiveRecordingStats StopRecording();
+    std::optional<LiveRecordingStats> RecordingStats();
+
 protected:
     Status PrepareBuffer();
     Status StartAcquisition();
@@ -24,10 +36,17 @@ protected:
 
 private:
     ExperimentControl *exp;
-    Hamamatsu::DCam *dcam;
+    Camera *camera;
 
     std::atomic<bool> is_running = false;
     std::string task_name = "LiveView";
+
+    std::mutex recorder_mutex;
+    std::shared_ptr<LiveRecorder> recorder;
+    // Reads every frame since n_read into the recording, and returns the
+    // latest one, or an empty frame if there is no new frame
+    StatusOr<ImageData> recordFrames(LiveRecorder *rec, int32_t &n_read);
+    void stopRecorder();
 };
 
 #endif
\ No newline at end of file
@@ -1,29 +1,33 @@
 #include "task/multi_channel_task.h"
 #include "experimentcontrol.h"
 
+#include <algorithm>
+
 #include <fmt/format.h>
 #include <nlohmann/json.hpp>
 
 #include "logging.h"
 #include "utils/time_utils.h"
+#include "utils/trace.h"
 
 MultiChannelTask::MultiChannelTask(ExperimentControl *exp)
 {
     this->exp = exp;
-    this->dcam = exp->Devices()->GetHamamatsuDCam();
+    this->camera = exp->Devices()->GetCamera();
 }
 
 Status MultiChannelTask::EnableTrigger()
 {
     // Enable trigger
     utils::StopWatch sw_trigger;
-    StatusOr<std::string> trigger_source = dcam->GetProperty("TRIGGER SOURCE");
+    StatusOr<std::string> trigger_source =
+        camera->GetProperty("TRIGGER SOURCE");
     if (!trigger_source.ok()) {
         return trigger_source.status();
     }
 
     if (trigger_source.value() != "SOFTWARE") {
-        Status status = dcam->SetProperty("TRIGGER SOURCE", "SOFTWARE");
+        Status status = camera->SetProperty("TRIGGER SOURCE", "SOFTWARE");
         if (!status.ok()) {
             return status;
         }
@@ -39,12 +43,12 @@ Status MultiChannelTask::EnableTrigger()
 Status MultiChannelTask::PrepareBuffer()
 {
     utils::StopWatch sw;
-    if (dcam->BufferAllocated() < channels.size()) {
-        if (dcam->BufferAllocated() > 0) {
+    if (camera->BufferAllocated() < channels.size()) {
+        if (camera->BufferAllocated() > 0) {
             LOG_DEBUG("[{}] Releasing Buffer (n_frame={})...", ndimage_name,
-                      dcam->BufferAllocated());
+                      camera->BufferAllocated());
             sw.Reset();
-            Status status = dcam->ReleaseBuffer();
+            Status status = camera->ReleaseBuffer();
             if (!status.ok()) {
                 LOG_ERROR("[{}] Release buffer failed: {}", ndimage_name,
                           status.ToString());
@@ -54,7 +58,7 @@ Status MultiChannelTask::PrepareBuffer()
                       sw.Milliseconds());
         }
         sw.Reset();
-        Status status = dcam->AllocBuffer(channels.size());
+        Status status = camera->AllocBuffer(channels.size());
         if (!status.ok()) {
             return status;
         }
@@ -70,7 +74,7 @@ Status MultiChannelTask::PrepareBuffer()
 Status MultiChannelTask::StartAcqusition()
 {
     utils::StopWatch sw;
-    Status status = dcam->StartContinousAcquisition();
+    Status status = camera->StartContinousAcquisition();
     if (!status.ok()) {
         return status;
     }
@@ -80,68 +84,76 @@ Status MultiChannelTask::StartAcqusition()
 }
 
 Status MultiChannelTask::ExposeFrame(int i_ch,
-                                     PropertyValueMap *property_snapshot)
+                                     PropertySnapshotPtr *property_snapshot)
 {
     Channel channel = channels[i_ch];
 
-    utils::StopWatch sw;
-
+    utils::TraceSpan span_open("camera", "shutter open");
     Status status = exp->Channels()->OpenCurrentShutter();
     if (!status.ok()) {
         LOG_ERROR("[{}][{}] Failed to request shutter open: {} [{:.1f} ms]",
-                  ndimage_name, i_ch + 1, status.ToString(), sw.Milliseconds());
+                  ndimage_name, i_ch + 1, status.ToString(),
+                  span_open.Milliseconds());
         return status;
     }
     status = exp->Channels()->WaitShutter();
     if (!status.ok()) {
         LOG_ERROR("[{}][{}] Wait shutter failed: {} [{:.1f} ms]", ndimage_name,
-                  i_ch + 1, status.ToString(), sw.Milliseconds());
+                  i_ch + 1, status.ToString(), span_open.Milliseconds());
         return status;
     }
+    span_open.End();
     LOG_DEBUG("[{}][{}] Shutter turned on [{:.1f} ms]", ndimage_name, i_ch + 1,
-              sw.Milliseconds());
+              span_open.Milliseconds());
 
-    sw.Reset();
-    Status trigger_status = dcam->FireTrigger();
+    utils::TraceSpan span_trigger("camera", "trigger");
+    Status trigger_status = camera->FireTrigger();
+    span_trigger.End();
     if (!trigger_status.ok()) {
         LOG_ERROR("[{}][{}] FireTrigger failed: {}", ndimage_name, i_ch + 1,
                   trigger_status.ToString());
     } else {
         LOG_DEBUG("[{}][{}] Trigger fired [{:.1f} ms]", ndimage_name, i_ch + 1,
-                  sw.Milliseconds());
+                  span_trigger.Milliseconds());
     }
 
-    sw.Reset();
-    *property_snapshot = exp->Devices()->GetPropertySnapshot();
-    LOG_DEBUG("[{}][{}] Device status snapshot got [{:.1f} ms]", ndimage_name,
-              i_ch + 1, sw.Milliseconds());
+    utils::TraceSpan span_snapshot("camera", "property snapshot");
+    *property_snapshot = exp->Devices()->LatestPropertySnapshot();
+    span_snapshot.End();
+    LOG_DEBUG("[{}][{}] Device status snapshot got (version {}) [{:.3f} ms]",
+              ndimage_name, i_ch + 1, (*property_snapshot)->version,
+              span_snapshot.Milliseconds());
 
     if (trigger_status.ok()) {
-        sw.Reset();
-        status = dcam->WaitExposureEnd(channel.exposure_ms + 500);
+        utils::TraceSpan span_exposure("camera", "exposure end");
+        status = camera->WaitExposureEnd(channel.exposure_ms + 500);
         if (!status.ok()) {
             LOG_ERROR("[{}][{}] WaitExposureEnd failed: {}", ndimage_name,
                       i_ch + 1, status.ToString());
         }
+        span_exposure.End();
         sw_exposure_end.Reset();
         LOG_DEBUG("[{}][{}] Exposure completed [{:.1f} ms]", ndimage_name,
-                  i_ch + 1, sw.Milliseconds());
+                  i_ch + 1, span_exposure.Milliseconds());
     }
 
-    sw.Reset();
+    utils::TraceSpan span_close("camera", "shutter close");
     status = exp->Channels()->CloseCurrentShutter();
     if (!status.ok()) {
         LOG_ERROR("[{}][{}] Shutter failed to turn off: {} [{:.1f} ms]",
-                  ndimage_name, i_ch + 1, status.ToString(), sw.Milliseconds());
+                  ndimage_name, i_ch + 1, status.ToString(),
+                  span_close.Milliseconds());
     }
     status = exp->Channels()->WaitShutter();
     if (!status.ok()) {
         LOG_ERROR(
             "[{}][{}] Shutter failed to turn off after waiting: {} [{:.1f} ms]",
-            ndimage_name, i_ch + 1, status.ToString(), sw.Milliseconds());
+            ndimage_name, i_ch + 1, status.ToString(),
+            span_close.Milliseconds());
     }
+    span_close.End();
     LOG_DEBUG("[{}][{}] Shutter turned off [{:.1f} ms]", ndimage_name, i_ch + 1,
-              sw.Milliseconds());
+              span_close.Milliseconds());
 
 
     return status;
@@ -149,10 +161,16 @@ Status MultiChannelTask::ExposeFrame(int i_ch,
 
 StatusOr<ImageData>
 MultiChannelTask::GetFrame(int i_ch,
-                           std::chrono::system_clock::time_point *timestamp)
+                           std::chrono::system_clock::time_point *timestamp,
+                           int i_frame)
 {
+    if (i_frame < 0) {
+        i_frame = i_ch;
+    }
     Channel channel = channels[i_ch];
-    Status status = dcam->WaitFrameReady(1000);
+    utils::TraceSpan span_ready("camera", "frame ready");
+    Status status = camera->WaitFrameReady(1000);
+    span_ready.End();
     if (!status.ok()) {
         // error DCAMERR_LOSTFRAME can happen here in ~1/5000 chance
         // Calling WaitFrameReady again won't help, and can only get
@@ -167,8 +185,9 @@ MultiChannelTask::GetFrame(int i_ch,
                   ndimage_name, i_ch + 1, sw_exposure_end.Milliseconds());
     }
 
-    utils::StopWatch sw;
-    StatusOr<ImageData> frame = dcam->GetFrame(i_ch, timestamp);
+    utils::TraceSpan span_get("camera", "get frame");
+    StatusOr<ImageData> frame = camera->GetFrame(i_frame, timestamp);
+    span_get.End();
     if (!frame.ok()) {
         std::string error_msg =
             fmt::format("[{}][{}] GetFrame failed: {}", ndimage_name, i_ch + 1,
@@ -177,7 +196,7 @@ MultiChannelTask::GetFrame(int i_ch,
         return frame.status();
     }
     LOG_DEBUG("[{}][{}] Get frame [{:.1f} ms]", ndimage_name, i_ch + 1,
-              sw.Milliseconds());
+              span_get.Milliseconds());
 
     return frame.value();
 }
@@ -208,7 +227,7 @@ void MultiChannelTask::StopAcqusition()
     }
 
     sw.Reset();
-    Status status = dcam->StopAcquisition();
+    Status status = camera->StopAcquisition();
     if (!status.ok()) {
         LOG_ERROR("[{}] DCAM StopAcquisition failed: {}", ndimage_name,
                   status.ToString());
@@ -218,18 +237,137 @@ void MultiChannelTask::StopAcqusition()
     }
 }
 
+void MultiChannelTask::SwitchChannelAhead(Channel channel)
+{
+    ClearChannelAhead();
+    exp->Channels()->SwitchChannel(channel.preset_name, channel.exposure_ms,
+                                   channel.illumination_intensity);
+    channel_ahead = channel;
+    LOG_DEBUG("Switching ahead to channel {}", channel.preset_name);
+}
+
+void MultiChannelTask::ClearChannelAhead()
+{
+    if (!channel_ahead.has_value()) {
+        return;
+    }
+    channel_ahead.reset();
+    Status status = exp->Channels()->WaitSwitchChannel();
+    if (!status.ok()) {
+        LOG_WARN("Ignoring error in switching channel ahead: {}",
+                 status.ToString());
+    }
+}
+
+std::vector<int>
+MultiChannelTask::AcquisitionOrder(const std::vector<Channel> &channels,
+                                   ChannelOrder channel_order)
+{
+    std::vector<ChannelPreset> presets;
+    for (const auto &channel : channels) {
+        presets.push_back(exp->Channels()->GetPreset(channel.preset_name));
+    }
+    std::optional<ChannelPreset> from;
+    if (last_preset_name.has_value()) {
+        from = exp->Channels()->GetPreset(last_preset_name.value());
+    }
+    return PlanChannelOrder(presets, channel_order, from,
+                            config.system.move_cost);
+}
+
+nlohmann::ordered_json MultiChannelTask::FrameMetadata(
+    const Channel &channel, std::chrono::system_clock::time_point timestamp,
+    const nlohmann::ordered_json &metadata,
+    const PropertySnapshotPtr &property_snapshot)
+{
+    nlohmann::ordered_json new_metadata;
+    new_metadata["timestamp"] =
+        utils::TimePoint(timestamp).FormatRFC3339_Local();
+    ChannelPreset preset = exp->Channels()->GetPreset(channel.preset_name);
+    new_metadata["channel"] = {
+        {"preset_name", channel.preset_name},
+        {"exposure_ms", channel.exposure_ms},
+    };
+    if (!preset.illumination_property.empty()) {
+        new_metadata["channel"]["illumination_intensity"] =
+            channel.illumination_intensity;
+    }
+
+    for (const auto &[k, v] : metadata.items()) {
+        new_metadata[k] = v;
+    }
+
+    new_metadata["device_property_version"] = property_snapshot->version;
+
+    // Values are sorted by property ID, which differs from run to run, so the
+    // output is sorted by name. A null value is a removed property.
+    std::vector<std::pair<PropertyPath, const std::string *>> changed;
+    if (!property_base) {
+        property_base = property_snapshot;
+        changed.reserve(property_snapshot->values.size());
+        for (const auto &[k, v] : property_snapshot->values) {
+            changed.push_back({k, &v});
+        }
+    } else {
+        new_metadata["device_property_base_version"] = property_base->version;
+        const PropertyValueMap &base = property_base->values;
+        const PropertyValueMap &values = property_snapshot->values;
+        auto it_base = base.begin();
+        auto it = values.begin();
+        while ((it_base != base.end()) || (it != values.end())) {
+            if ((it == values.end()) ||
+                ((it_base != base.end()) && (it_base->first < it->first)))
+            {
+                changed.push_back({it_base->first, nullptr});
+                it_base++;
+            } else if ((it_base == base.end()) ||
+                       (it->first < it_base->first))
+            {
+                changed.push_back({it->first, &it->second});
+                it++;
+            } else {
+                if (it->second != it_base->second) {
+                    changed.push_back({it->first, &it->second});
+                }
+                it_base++;
+                it++;
+            }
+        }
+    }
+    std::sort(changed.begin(), changed.end(),
+              [](const auto &a, const auto &b) {
+                  return PathNameLess()(a.first, b.first);
+              });
+
+    new_metadata["device_property"] = nlohmann::ordered_json::object();
+    for (const auto &[path, value] : changed) {
+        if (value != nullptr) {
+            new_metadata["device_property"][path.ToString()] = *value;
+        } else {
+            new_metadata["device_property"][path.ToString()] = nullptr;
+        }
+    }
+    return new_metadata;
+}
+
+void MultiChannelTask::ResetPropertyBase() { property_base.reset(); }
+
 Status MultiChannelTask::Acquire(std::string ndimage_name,
                                  std::vector<Channel> channels, int i_z,
                                  int i_t, Site *site,
-                                 nlohmann::ordered_json metadata)
+                                 nlohmann::ordered_json metadata,
+                                 std::function<void()> on_last_frame,
+                                 ChannelOrder channel_order)
 {
     if (channels.empty()) {
         throw std::invalid_argument("channel not set");
     }
     this->ndimage_name = ndimage_name;
     this->channels = channels;
+    ResetPropertyBase();
 
     utils::StopWatch sw_task;
+    utils::TraceSpan span_task("task", "multichannel");
     LOG_INFO("[{}] Prepare acquisition", ndimage_name);
 
     //
@@ -240,12 +378,31 @@ Status MultiChannelTask::Acquire(std::string ndimage_name,
         return status;
     }
 
+    std::vector<int> order = AcquisitionOrder(channels, channel_order);
+    if (channel_order != ChannelOrder::AsGiven) {
+        LOG_DEBUG("[{}] Channel order {}: {}", ndimage_name,
+                  ChannelOrderToString(channel_order),
+                  fmt::join(order, ","));
+    }
+
     //
-    // Switch to channel 0
+    // Switch to the first channel, unless the previous acquisition did it
+    // already
     //
-    Channel channel = channels[0];
-    exp->Channels()->SwitchChannel(channel.preset_name, channel.exposure_ms,
-                                   channel.illumination_intensity);
+    Channel channel = channels[order[0]];
+    if (channel_ahead.has_value() &&
+        (channel_ahead->preset_name == channel.preset_name) &&
+        (channel_ahead->exposure_ms == channel.exposure_ms) &&
+        (channel_ahead->illumination_intensity ==
+         channel.illumination_intensity))
+    {
+        channel_ahead.reset();
+    } else {
+        ClearChannelAhead();
+        exp->Channels()->SwitchChannel(channel.preset_name,
+                                       channel.exposure_ms,
+                                       channel.illumination_intensity);
+    }
 
     //
     // Check and allocate camera buffer
@@ -258,10 +415,10 @@ Status MultiChannelTask::Acquire(std::string ndimage_name,
     //
     // Create NDImage
     //
-    DataType dtype = dcam->GetDataType();
-    ColorType ctype = dcam->GetColorType();
-    uint32_t width = dcam->GetWidth();
-    uint32_t height = dcam->GetHeight();
+    DataType dtype = camera->GetDataType();
+    ColorType ctype = camera->GetColorType();
+    uint32_t width = camera->GetWidth();
+    uint32_t height = camera->GetHeight();
     std::vector<std::string> ch_names;
     for (const auto &channel : channels) {
         ch_names.push_back(channel.preset_name);
@@ -288,7 +445,8 @@ Status MultiChannelTask::Acquire(std::string ndimage_name,
     utils::StopWatch sw_channel;
     int i_retry = 0;
     try {
-        for (int i_ch = 0; i_ch < channels.size(); i_ch++) {
+        for (int k = 0; k < order.size(); k++) {
+            int i_ch = order[k];
             if (i_retry > 0) {
                 LOG_INFO("[{}][{}/{}] retry {} ", ndimage_name, i_ch + 1,
                          channels.size(), i_retry);
@@ -309,29 +467,32 @@ Status MultiChannelTask::Acquire(std::string ndimage_name,
                      channels.size(), channel.preset_name);
             SendEvent({
                 .type = EventType::TaskMessage,
-                .value = fmt::format("Acquiring channel {}/{}...", i_ch + 1,
+                .value = fmt::format("Acquiring channel {}/{}...", k + 1,
                                      channels.size()),
             });
 
             sw_frame.Reset();
+            utils::TraceSpan span_frame("task", "multichannel frame");
 
-            PropertyValueMap property_snapshot;
+            PropertySnapshotPtr property_snapshot;
             status = ExposeFrame(i_ch, &property_snapshot);
             if (!status.ok()) {
                 LOG_ERROR("[{}][{}/{}] ExposeFrame failed: {}", ndimage_name,
                           i_ch + 1, channels.size(), status.ToString());
                 goto cleanup;
             }
-            if (i_ch + 1 < channels.size()) {
+            last_preset_name = channel.preset_name;
+            if (k + 1 < order.size()) {
                 sw_channel.Reset();
-                Channel next_channel = channels[i_ch + 1];
+                Channel next_channel = channels[order[k + 1]];
                 exp->Channels()->SwitchChannel(
                     next_channel.preset_name, next_channel.exposure_ms,
                     next_channel.illumination_intensity);
             }
 
             std::chrono::system_clock::time_point timestamp;
-            StatusOr<ImageData> data = GetFrame(i_ch, &timestamp);
+            // Frames are in the camera buffer in the order of acquisition
+            StatusOr<ImageData> data = GetFrame(i_ch, &timestamp, k);
             status = data.status();
             if (!status.ok()) {
                 if (absl::IsDataLoss(status)) {
@@ -345,7 +506,7 @@ Status MultiChannelTask::Acquire(std::string ndimage_name,
                         std::this_thread::sleep_for(
                             std::chrono::milliseconds(500));
                         i_retry++;
-                        i_ch--;
+                        k--;
                         continue;
                     } else {
                         LOG_ERROR("[{}][{}/{}] [Retry {}] GetFrame failed: {}."
@@ -360,31 +521,17 @@ Status MultiChannelTask::Acquire(std::string ndimage_name,
                 goto cleanup;
             }
 
-            nlohmann::ordered_json new_metadata;
-            new_metadata["timestamp"] =
-                utils::TimePoint(timestamp).FormatRFC3339_Local();
-            ChannelPreset preset =
-                exp->Channels()->GetPreset(channel.preset_name);
-            new_metadata["channel"] = {
-                {"preset_name", channel.preset_name},
-                {"exposure_ms", channel.exposure_ms},
-            };
-            if (!preset.illumination_property.empty()) {
-                new_metadata["channel"]["illumination_intensity"] =
-                    channel.illumination_intensity;
-            }
-
-            for (const auto &[k, v] : metadata.items()) {
-                new_metadata[k] = v;
-            }
-
-            for (const auto &[k, v] : property_snapshot) {
-                new_metadata["device_property"][k.ToString()] = v;
+            // Called after the readout rather than the exposure end, so that
+            // a lost frame can still be reacquired at the same position
+            if ((k + 1 == order.size()) && on_last_frame) {
+                on_last_frame();
             }
 
-            exp->Images()->AddImage(ndimage_name, i_ch, i_z, i_t, data.value(),
-                                    new_metadata);
-            LOG_INFO("[{}][{}] Frame completed [{:.0f} ms]", ndimage_name,
+            nlohmann::ordered_json new_metadata =
+                FrameMetadata(channel, timestamp, metadata, property_snapshot);
+            exp->Images()->AddImageAsync(ndimage_name, i_ch, i_z, i_t,
+                                         data.value(), new_metadata);
+            LOG_INFO("[{}][{}] Frame acquired [{:.0f} ms]", ndimage_name,
                      i_ch + 1, sw_frame.Milliseconds());
             i_retry = 0;
         }
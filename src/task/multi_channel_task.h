@@ -2,17 +2,20 @@
 #define MULTI_CHANNEL_TASK_H
 
 #include <filesystem>
+#include <functional>
 #include <future>
 #include <map>
+#include <optional>
 #include <string>
 
 #include "channel.h"
 #include "config.h"
 #include "device/devicehub.h"
-#include "device/hamamatsu/hamamatsu_dcam.h"
+#include "device/camera.h"
 #include "eventstream.h"
 #include "image/imagemanager.h"
 #include "task/channelcontrol.h"
+#include "task/channelplanner.h"
 #include "utils/time_utils.h"
 
 class ExperimentControl;
@@ -21,26 +24,58 @@ class MultiChannelTask : public EventSender {
 public:
     MultiChannelTask(ExperimentControl *exp);
 
+    // Frames are saved in the background, see ImageManager::AddImageAsync.
+    // on_last_frame is called once the last frame is read out of the camera,
+    // so that the caller can start moving to the next site while the
+    // acquisition is stopped and the frames are saved. Channels are acquired
+    // in channel_order, but keep their index in the NDImage.
     Status Acquire(std::string ndimage_name, std::vector<Channel> channels,
                    int i_z, int i_t, Site *site = nullptr,
-                   nlohmann::ordered_json metadata = nullptr);
+                   nlohmann::ordered_json metadata = nullptr,
+                   std::function<void()> on_last_frame = nullptr,
+                   ChannelOrder channel_order = ChannelOrder::AsGiven);
+
+    // Order of the next acquisition of channels, starting from the preset of
+    // the last frame
+    std::vector<int> AcquisitionOrder(const std::vector<Channel> &channels,
+                                      ChannelOrder channel_order);
+
+    // Start switching to the first channel of the next acquisition, which
+    // then skips its own switch
+    void SwitchChannelAhead(Channel channel);
+    void ClearChannelAhead();
 
 protected:
     Status EnableTrigger();
     Status PrepareBuffer();
     Status StartAcqusition();
-    Status ExposeFrame(int i_ch, PropertyValueMap *property_snapshot);
+    Status ExposeFrame(int i_ch, PropertySnapshotPtr *property_snapshot);
+    // i_frame is the index in the camera buffer, i_ch if not set
     StatusOr<ImageData>
-    GetFrame(int i_ch, std::chrono::system_clock::time_point *timestamp);
+    GetFrame(int i_ch, std::chrono::system_clock::time_point *timestamp,
+             int i_frame = -1);
     void StopAcqusition();
+    // The first frame since ResetPropertyBase has all device properties. The
+    // other frames have the properties that changed since the first frame,
+    // with null for those no longer known.
+    nlohmann::ordered_json
+    FrameMetadata(const Channel &channel,
+                  std::chrono::system_clock::time_point timestamp,
+                  const nlohmann::ordered_json &metadata,
+                  const PropertySnapshotPtr &property_snapshot);
+    void ResetPropertyBase();
 
-private:
     ExperimentControl *exp;
-    Hamamatsu::DCam *dcam;
+    Camera *camera;
 
     std::string ndimage_name;
     std::vector<Channel> channels;
 
+private:
+    std::optional<Channel> channel_ahead;
+    std::optional<std::string> last_preset_name;
+    PropertySnapshotPtr property_base;
+
     utils::StopWatch sw_exposure_end;
 };
 
@@ -0,0 +1,474 @@
+#include "task/scan_task.h"
+#include "experimentcontrol.h"
+
+#include <map>
+#include <set>
+
+#include <fmt/format.h>
+
+#include "logging.h"
+#include "utils/trace.h"
+
+std::string ScanStateToString(ScanState state)
+{
+    switch (state) {
+    case ScanState::Idle:
+        return "Idle";
+    case ScanState::Running:
+        return "Running";
+    case ScanState::Paused:
+        return "Paused";
+    case ScanState::Completed:
+        return "Completed";
+    case ScanState::Stopped:
+        return "Stopped";
+    case ScanState::Failed:
+        return "Failed";
+    default:
+        return "";
+    }
+}
+
+ScanTask::ScanTask(ExperimentControl *exp, MultiChannelTask *multichannel_task,
+                   AutofocusTask *autofocus_task)
+{
+    this->exp = exp;
+    this->multichannel_task = multichannel_task;
+    this->autofocus_task = autofocus_task;
+}
+
+void ScanTask::updateProgress(std::function<void(ScanProgress &)> update)
+{
+    std::unique_lock<std::mutex> lk(progress_mutex);
+    update(progress);
+    progress.seq++;
+    progress.elapsed_s = sw_scan.Milliseconds() / 1000;
+    if ((progress.n_sites_done > 0) &&
+        (progress.n_sites_done < progress.n_sites_total))
+    {
+        progress.remaining_s = progress.elapsed_s / progress.n_sites_done *
+                               (progress.n_sites_total - progress.n_sites_done);
+    } else {
+        progress.remaining_s = 0;
+    }
+    ScanProgress p = progress;
+    lk.unlock();
+    progress_cv.notify_all();
+
+    SendEvent({
+        .type = EventType::TaskMessage,
+        .value = fmt::format("Scan {}: {}/{} sites, {:.0f} s remaining. {}",
+                             ScanStateToString(p.state), p.n_sites_done,
+                             p.n_sites_total, p.remaining_s, p.message),
+    });
+}
+
+ScanProgress ScanTask::Progress()
+{
+    std::lock_guard<std::mutex> lk(progress_mutex);
+    return progress;
+}
+
+ScanProgress ScanTask::WaitProgress(uint64_t seq,
+                                    std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lk(progress_mutex);
+    progress_cv.wait_for(lk, timeout, [&] { return progress.seq > seq; });
+    return progress;
+}
+
+void ScanTask::Arm()
+{
+    std::lock_guard<std::mutex> lk(progress_mutex);
+    stop_requested = false;
+    pause_requested = false;
+}
+
+void ScanTask::Pause() { pause_requested = true; }
+
+void ScanTask::Resume()
+{
+    {
+        std::lock_guard<std::mutex> lk(progress_mutex);
+        pause_requested = false;
+    }
+    progress_cv.notify_all();
+}
+
+void ScanTask::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lk(progress_mutex);
+        stop_requested = true;
+    }
+    progress_cv.notify_all();
+}
+
+bool ScanTask::waitIfPaused()
+{
+    if (pause_requested && !stop_requested) {
+        // The stage may be moved while paused
+        multichannel_task->ClearChannelAhead();
+        site_ahead = nullptr;
+
+        LOG_INFO("[{}] Paused", task_name);
+        updateProgress([](ScanProgress &p) {
+            p.state = ScanState::Paused;
+            p.message = "Paused";
+        });
+
+        std::unique_lock<std::mutex> lk(progress_mutex);
+        progress_cv.wait(lk,
+                         [this] { return !pause_requested || stop_requested; });
+        lk.unlock();
+
+        if (!stop_requested) {
+            LOG_INFO("[{}] Resumed", task_name);
+            updateProgress([](ScanProgress &p) {
+                p.state = ScanState::Running;
+                p.message = "Resumed";
+            });
+        }
+    }
+    return !stop_requested;
+}
+
+std::optional<Pos2D> ScanTask::CurrentXY()
+{
+    StatusOr<std::string> value = exp->Devices()->GetProperty(xy_property);
+    if (!value.ok()) {
+        return std::nullopt;
+    }
+    size_t sep = value->find(',');
+    if (sep == std::string::npos) {
+        return std::nullopt;
+    }
+    try {
+        return Pos2D{std::stod(value->substr(0, sep)),
+                     std::stod(value->substr(sep + 1))};
+    } catch (std::exception &e) {
+        return std::nullopt;
+    }
+}
+
+Status ScanTask::StartMoveXY(Pos2D pos)
+{
+    return exp->Devices()->SetProperty(
+        xy_property, fmt::format("{:.1f},{:.1f}", pos.x, pos.y));
+}
+
+Status ScanTask::WaitMoveXY()
+{
+    utils::TraceSpan span("stage", "wait move xy");
+    return exp->Devices()->WaitPropertyFor({xy_property},
+                                           std::chrono::seconds(30));
+}
+
+Status ScanTask::MoveXY(Pos2D pos)
+{
+    utils::StopWatch sw;
+    Status status = StartMoveXY(pos);
+    if (!status.ok()) {
+        return status;
+    }
+    status = WaitMoveXY();
+    if (!status.ok()) {
+        return status;
+    }
+    LOG_DEBUG("[{}] Moved to ({:.1f}, {:.1f}) [{:.1f} ms]", task_name, pos.x,
+              pos.y, sw.Milliseconds());
+    return absl::OkStatus();
+}
+
+Status ScanTask::moveZ(double z)
+{
+    utils::StopWatch sw;
+    Status status = exp->Devices()->SetProperty(z_property,
+                                                fmt::format("{:.3f}", z));
+    if (!status.ok()) {
+        return status;
+    }
+    status = exp->Devices()->WaitPropertyFor({z_property},
+                                             std::chrono::seconds(5));
+    if (!status.ok()) {
+        LOG_ERROR("[{}] Z drive failed to reach focus map: {}", task_name,
+                  status.ToString());
+        return status;
+    }
+    LOG_DEBUG("[{}] Moved Z to focus map z={:.3f} [{:.1f} ms]", task_name, z,
+              sw.Milliseconds());
+    return absl::OkStatus();
+}
+
+Status ScanTask::AcquireSite(const ScanPlan &plan, ::Site *site,
+                             bool first_in_well, ::Site *next_site,
+                             bool next_first_in_well)
+{
+    utils::TraceSpan span("task", "scan site");
+    ::Well *well = site->Well();
+    Pos2D pos = site->Position().value();
+
+    Status status;
+    if (site_ahead == site) {
+        utils::StopWatch sw;
+        status = WaitMoveXY();
+        LOG_DEBUG("[{}] Waited for move to ({:.1f}, {:.1f}) [{:.1f} ms]",
+                  task_name, pos.x, pos.y, sw.Milliseconds());
+    } else {
+        status = MoveXY(pos);
+    }
+    site_ahead = nullptr;
+    if (!status.ok()) {
+        return status;
+    }
+
+    if ((plan.focus_mode == ScanFocusMode::AutofocusPerWell) && first_in_well)
+    {
+        StatusOr<AutofocusResult> focus =
+            autofocus_task->Run(plan.autofocus_channel, plan.autofocus_params);
+        if (focus.ok()) {
+            exp->Samples()->SetFocusPoint(plan.plate_id, well->ID(), pos.x,
+                                          pos.y, focus->z);
+        } else {
+            // Fall back to the focus map from other wells
+            LOG_WARN("[{}] Autofocus failed in well {}: {}", task_name,
+                     well->ID(), focus.status().ToString());
+        }
+    }
+
+    // Move Z to the focus map of the plate without searching. The first
+    // channel is usually switched ahead already.
+    if (plan.focus_mode != ScanFocusMode::None) {
+        std::optional<double> focus_z = exp->Samples()->PredictFocusZ(site);
+        if (focus_z.has_value()) {
+            status = moveZ(focus_z.value());
+            if (!status.ok()) {
+                return status;
+            }
+        }
+    }
+
+    std::function<void()> on_last_frame = nullptr;
+    if (next_site != nullptr) {
+        on_last_frame = [&, next_site, next_first_in_well] {
+            if (stop_requested || pause_requested) {
+                return;
+            }
+            // On failure the move is retried by MoveXY at the next site
+            Status move_status = StartMoveXY(next_site->Position().value());
+            if (!move_status.ok()) {
+                LOG_WARN("[{}] Cannot start moving to next site: {}",
+                         task_name, move_status.ToString());
+                return;
+            }
+            site_ahead = next_site;
+            // Autofocus switches to its own channel
+            if ((plan.focus_mode != ScanFocusMode::AutofocusPerWell) ||
+                !next_first_in_well)
+            {
+                std::vector<int> order = multichannel_task->AcquisitionOrder(
+                    plan.channels, plan.channel_order);
+                multichannel_task->SwitchChannelAhead(
+                    plan.channels[order[0]]);
+            }
+        };
+    }
+
+    std::string ndimage_name = fmt::format("{}{}-{}", plan.ndimage_prefix,
+                                           well->ID(), site->ID());
+    return multichannel_task->Acquire(ndimage_name, plan.channels, 0,
+                                      plan.i_t, site, plan.metadata,
+                                      on_last_frame, plan.channel_order);
+}
+
+Status ScanTask::ResolveSites(const ScanPlan &plan,
+                              std::vector<::Well *> &wells,
+                              std::vector<std::vector<::Site *>> &well_sites)
+{
+    if (plan.channels.empty()) {
+        return absl::InvalidArgumentError("channel not set");
+    }
+    ::Plate *plate = exp->Samples()->Plate(plan.plate_id);
+    if (plate == nullptr) {
+        return absl::NotFoundError(
+            fmt::format("plate {} not found", plan.plate_id));
+    }
+
+    if (plan.well_ids.empty()) {
+        wells = plate->EnabledWells();
+    } else {
+        for (const auto &well_id : plan.well_ids) {
+            ::Well *well = plate->Well(well_id);
+            if (well == nullptr) {
+                return absl::NotFoundError(
+                    fmt::format("well {} not found", well_id));
+            }
+            wells.push_back(well);
+        }
+    }
+
+    for (const auto &well : wells) {
+        std::vector<::Site *> sites;
+        for (const auto &site : well->Sites()) {
+            if (!site->Enabled()) {
+                continue;
+            }
+            if (!site->Position().has_value()) {
+                return absl::FailedPreconditionError(
+                    "position origin of plate is not set");
+            }
+            sites.push_back(site);
+        }
+        well_sites.push_back(sites);
+    }
+    return absl::OkStatus();
+}
+
+StatusOr<SitePath> ScanTask::PlanPath(const ScanPlan &plan)
+{
+    std::vector<::Well *> wells;
+    std::vector<std::vector<::Site *>> well_sites;
+    Status status = ResolveSites(plan, wells, well_sites);
+    if (!status.ok()) {
+        return status;
+    }
+    std::vector<::Site *> sites;
+    for (const auto &s : well_sites) {
+        sites.insert(sites.end(), s.begin(), s.end());
+    }
+
+    utils::StopWatch sw;
+    SitePath path;
+    try {
+        path = PlanSitePath(sites, plan.site_order, plan.speed_model,
+                            CurrentXY());
+    } catch (std::invalid_argument &e) {
+        return absl::InvalidArgumentError(e.what());
+    }
+    LOG_INFO("[{}] Planned {} order of {} sites: {:.1f} mm, {:.0f} s of stage "
+             "travel [{:.1f} ms]",
+             task_name, SiteOrderToString(plan.site_order), sites.size(),
+             path.travel_um / 1000, path.travel_s, sw.Milliseconds());
+    return path;
+}
+
+Status ScanTask::Run(ScanPlan plan)
+{
+    StatusOr<SitePath> path = PlanPath(plan);
+    if (!path.ok()) {
+        updateProgress([&](ScanProgress &p) {
+            p = ScanProgress{.seq = p.seq};
+            p.state = ScanState::Failed;
+            p.message = path.status().ToString();
+        });
+        return path.status();
+    }
+
+    // Sites of a well may be visited out of order, so a well is done when
+    // its last remaining site is done
+    std::map<::Well *, int> well_sites_remaining;
+    for (const auto &site : path->sites) {
+        well_sites_remaining[site->Well()]++;
+    }
+    std::set<::Well *> wells_visited;
+
+    sw_scan.Reset();
+    LOG_INFO("[{}] Scanning plate {}: {} wells, {} sites", task_name,
+             plan.plate_id, well_sites_remaining.size(), path->sites.size());
+    updateProgress([&](ScanProgress &p) {
+        p = ScanProgress{.seq = p.seq};
+        p.state = ScanState::Running;
+        p.n_sites_total = path->sites.size();
+        p.n_wells_total = well_sites_remaining.size();
+        p.predicted_travel_um = path->travel_um;
+        p.predicted_travel_s = path->travel_s;
+        p.message = fmt::format("Started, predicted stage travel {:.1f} mm "
+                                "in {:.0f} s",
+                                path->travel_um / 1000, path->travel_s);
+    });
+
+    Status status;
+    try {
+        for (int i = 0; i < path->sites.size(); i++) {
+            ::Site *site = path->sites[i];
+            ::Well *well = site->Well();
+            if (!waitIfPaused()) {
+                break;
+            }
+            updateProgress([&](ScanProgress &p) {
+                p.well_id = well->ID();
+                p.site_id = site->ID();
+                p.message =
+                    fmt::format("Well {}, site {}", well->ID(), site->ID());
+            });
+
+            bool first_in_well = wells_visited.insert(well).second;
+            ::Site *next_site = nullptr;
+            bool next_first_in_well = false;
+            if (i + 1 < path->sites.size()) {
+                next_site = path->sites[i + 1];
+                next_first_in_well =
+                    !wells_visited.contains(next_site->Well());
+            }
+            status = AcquireSite(plan, site, first_in_well, next_site,
+                                 next_first_in_well);
+            if (!status.ok()) {
+                break;
+            }
+            bool well_done = (--well_sites_remaining[well] == 0);
+            updateProgress([&](ScanProgress &p) {
+                p.n_sites_done++;
+                if (well_done) {
+                    p.n_wells_done++;
+                }
+            });
+        }
+    } catch (std::exception &e) {
+        status = absl::UnknownError(
+            fmt::format("Unexpected exception during scan: {}", e.what()));
+    }
+
+    // Frames of the last sites are still being saved, also after a failure
+    multichannel_task->ClearChannelAhead();
+    site_ahead = nullptr;
+    try {
+        exp->Images()->WaitPendingImages();
+    } catch (std::exception &e) {
+        if (status.ok()) {
+            status = absl::DataLossError(
+                fmt::format("Cannot save images: {}", e.what()));
+        }
+    }
+
+    if (!status.ok()) {
+        LOG_ERROR("[{}] Failed: {} [{:.0f} ms]", task_name, status.ToString(),
+                  sw_scan.Milliseconds());
+        updateProgress([&](ScanProgress &p) {
+            p.state = ScanState::Failed;
+            p.message = status.ToString();
+        });
+        return status;
+    }
+
+    ScanProgress result = Progress();
+    double sites_per_hour =
+        result.n_sites_done / (sw_scan.Milliseconds() / 1000 / 3600);
+    if (stop_requested) {
+        LOG_INFO("[{}] Stopped after {}/{} sites [{:.0f} ms]", task_name,
+                 result.n_sites_done, result.n_sites_total,
+                 sw_scan.Milliseconds());
+        updateProgress([&](ScanProgress &p) {
+            p.state = ScanState::Stopped;
+            p.message = "Stopped";
+        });
+    } else {
+        LOG_INFO("[{}] Completed {} sites ({:.0f} sites/h) [{:.0f} ms]",
+                 task_name, result.n_sites_done, sites_per_hour,
+                 sw_scan.Milliseconds());
+        updateProgress([&](ScanProgress &p) {
+            p.state = ScanState::Completed;
+            p.message = "Completed";
+        });
+    }
+    return absl::OkStatus();
+}
@@ -0,0 +1,144 @@
+#ifndef SCAN_TASK_H
+#define SCAN_TASK_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "channel.h"
+#include "eventstream.h"
+#include "sample/pathplanner.h"
+#include "sample/sample.h"
+#include "task/autofocus_task.h"
+#include "task/multi_channel_task.h"
+#include "utils/time_utils.h"
+
+class ExperimentControl;
+
+enum class ScanFocusMode {
+    // Move Z to the focus map of the plate at every site, if it has points
+    FocusMap,
+    // Autofocus at the first site of every well and add it to the focus map,
+    // other sites of the well use the focus map
+    AutofocusPerWell,
+    // Keep the current Z
+    None,
+};
+
+// Scans are single-plane: every site is acquired once at i_z = 0, at the Z
+// given by focus_mode. Z-stacks are acquired per site with ZStackTask.
+struct ScanPlan {
+    std::string plate_id;
+    // Empty to scan all enabled wells of the plate
+    std::vector<std::string> well_ids;
+    std::vector<Channel> channels;
+    ChannelOrder channel_order = ChannelOrder::AsGiven;
+    int i_t = 0;
+
+    SiteOrder site_order = SiteOrder::AsCreated;
+    StageSpeedModel speed_model;
+
+    ScanFocusMode focus_mode = ScanFocusMode::FocusMap;
+    Channel autofocus_channel;
+    AutofocusParams autofocus_params;
+
+    // NDImage of each site is named <prefix><well_id>-<site_id>
+    std::string ndimage_prefix;
+    nlohmann::ordered_json metadata;
+};
+
+enum class ScanState {
+    Idle,
+    Running,
+    Paused,
+    Completed,
+    Stopped,
+    Failed,
+};
+
+std::string ScanStateToString(ScanState state);
+
+struct ScanProgress {
+    // Increases on every update
+    uint64_t seq = 0;
+    ScanState state = ScanState::Idle;
+    int n_sites_total = 0;
+    int n_sites_done = 0;
+    int n_wells_total = 0;
+    int n_wells_done = 0;
+    std::string well_id;
+    std::string site_id;
+    double elapsed_s = 0;
+    double remaining_s = 0;
+    // Stage travel of the planned path, from the position at start
+    double predicted_travel_um = 0;
+    double predicted_travel_s = 0;
+    std::string message;
+};
+
+class ScanTask : public EventSender {
+public:
+    ScanTask(ExperimentControl *exp, MultiChannelTask *multichannel_task,
+             AutofocusTask *autofocus_task);
+
+    // Order of sites and predicted stage travel, without moving the stage
+    StatusOr<SitePath> PlanPath(const ScanPlan &plan);
+    // Clears pause and stop requests. Called before Run is launched, so that
+    // a stop requested before Run starts is not lost.
+    void Arm();
+    Status Run(ScanPlan plan);
+
+    // Pause and stop take effect between sites
+    void Pause();
+    void Resume();
+    void Stop();
+
+    ScanProgress Progress();
+    // Wait until the progress is newer than seq, or timeout
+    ScanProgress WaitProgress(uint64_t seq, std::chrono::milliseconds timeout);
+
+protected:
+    Status ResolveSites(const ScanPlan &plan, std::vector<::Well *> &wells,
+                        std::vector<std::vector<::Site *>> &well_sites);
+    std::optional<Pos2D> CurrentXY();
+    Status StartMoveXY(Pos2D pos);
+    Status WaitMoveXY();
+    Status MoveXY(Pos2D pos);
+    // The move to next_site and the switch to its first channel start as
+    // soon as the last frame of site is read out
+    Status AcquireSite(const ScanPlan &plan, ::Site *site, bool first_in_well,
+                       ::Site *next_site, bool next_first_in_well);
+
+private:
+    ExperimentControl *exp;
+    MultiChannelTask *multichannel_task;
+    AutofocusTask *autofocus_task;
+
+    std::string task_name = "Scan";
+    PropertyPath xy_property = "/PriorProScan/XYPosition";
+    PropertyPath z_property = "/NikonTi/ZDrivePosition";
+
+    std::atomic<bool> stop_requested = false;
+    std::atomic<bool> pause_requested = false;
+
+    // Site the stage is already moving to
+    ::Site *site_ahead = nullptr;
+
+    std::mutex progress_mutex;
+    std::condition_variable progress_cv;
+    ScanProgress progress;
+    utils::StopWatch sw_scan;
+
+    void updateProgress(std::function<void(ScanProgress &)> update);
+    bool waitIfPaused();
+    Status moveZ(double z);
+};
+
+#endif
@@ -0,0 +1,245 @@
+#include "task/timelapse_task.h"
+#include "experimentcontrol.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+
+#include <fmt/format.h>
+
+#include "logging.h"
+#include "utils/time_utils.h"
+
+OverrunPolicy OverrunPolicyFromString(std::string value)
+{
+    if (value == "skip") {
+        return OverrunPolicy::Skip;
+    } else if (value == "compress") {
+        return OverrunPolicy::Compress;
+    }
+    throw std::invalid_argument("invalid overrun policy");
+}
+
+std::string OverrunPolicyToString(OverrunPolicy policy)
+{
+    switch (policy) {
+    case OverrunPolicy::Skip:
+        return "skip";
+    case OverrunPolicy::Compress:
+        return "compress";
+    default:
+        throw std::invalid_argument("invalid overrun policy");
+    }
+}
+
+TimelapseTask::TimelapseTask(ExperimentControl *exp, ScanTask *scan_task)
+{
+    this->exp = exp;
+    this->scan_task = scan_task;
+}
+
+void TimelapseTask::Arm()
+{
+    std::lock_guard<std::mutex> lk(mutex);
+    stop_requested = false;
+}
+
+void TimelapseTask::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        stop_requested = true;
+    }
+    cv.notify_all();
+    scan_task->Stop();
+}
+
+TimelapseStatus TimelapseTask::GetStatus()
+{
+    std::lock_guard<std::mutex> lk(mutex);
+    TimelapseStatus result = status;
+    if (result.running) {
+        clock::time_point now = clock::now();
+        result.elapsed_s =
+            std::chrono::duration<double>(now - tp_start).count();
+        for (int i = 0; i < result.groups.size(); i++) {
+            if (next_round[i].has_value()) {
+                result.groups[i].next_round_in_s =
+                    std::chrono::duration<double>(next_round[i].value() - now)
+                        .count();
+            }
+        }
+    }
+    return result;
+}
+
+Status TimelapseTask::runRound(TimelapseGroup &group, int i_round,
+                               std::chrono::system_clock::time_point planned)
+{
+    ScanPlan plan = group.plan;
+    plan.i_t = i_round;
+    plan.metadata["planned_time"] =
+        utils::TimePoint(planned).FormatRFC3339_Local();
+
+    std::string message =
+        fmt::format("Time-lapse {} round {}", group.name, i_round + 1);
+    LOG_INFO("[{}] {}", task_name, message);
+    SendEvent({
+        .type = EventType::TaskMessage,
+        .value = message,
+    });
+
+    // Stop() sets stop_requested under the lock before stopping the scan,
+    // so either the round is skipped here or the scan sees the stop
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        if (stop_requested) {
+            return absl::OkStatus();
+        }
+        scan_task->Arm();
+    }
+    return scan_task->Run(plan);
+}
+
+Status TimelapseTask::Run(std::vector<TimelapseGroup> groups,
+                          OverrunPolicy policy)
+{
+    if (groups.empty()) {
+        return absl::InvalidArgumentError("no time-lapse group");
+    }
+    for (const auto &group : groups) {
+        if (group.interval_s <= 0) {
+            return absl::InvalidArgumentError(
+                fmt::format("invalid interval of group {}", group.name));
+        }
+    }
+
+    // Rounds are planned on a fixed grid from the start, so that the time
+    // spent in a round does not shift the following rounds
+    std::chrono::system_clock::time_point tp_start_system =
+        std::chrono::system_clock::now();
+    clock::time_point tp_first = clock::now();
+
+    // (planned time, group, round), earliest first
+    using Round = std::tuple<clock::time_point, int, int>;
+    std::priority_queue<Round, std::vector<Round>, std::greater<Round>> queue;
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        tp_start = tp_first;
+        status = TimelapseStatus{.running = true, .message = "Running"};
+        next_round.clear();
+        for (int i = 0; i < groups.size(); i++) {
+            clock::time_point planned =
+                tp_start + std::chrono::duration_cast<clock::duration>(
+                               std::chrono::duration<double>(
+                                   groups[i].start_offset_s));
+            queue.push({planned, i, 0});
+            next_round.push_back(planned);
+            status.groups.push_back(TimelapseGroupStatus{
+                .name = groups[i].name,
+                .interval_s = groups[i].interval_s,
+            });
+        }
+    }
+    LOG_INFO("[{}] Started with {} groups, overrun policy {}", task_name,
+             groups.size(), OverrunPolicyToString(policy));
+
+    while (!queue.empty()) {
+        auto [planned, i_group, i_round] = queue.top();
+        queue.pop();
+        TimelapseGroup &group = groups[i_group];
+        clock::duration interval = std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double>(group.interval_s));
+
+        {
+            std::unique_lock<std::mutex> lk(mutex);
+            cv.wait_until(lk, planned,
+                          [this] { return stop_requested.load(); });
+        }
+        if (stop_requested) {
+            break;
+        }
+
+        clock::time_point now = clock::now();
+        if ((policy == OverrunPolicy::Skip) && (now - planned >= interval)) {
+            int n_skipped = (now - planned) / interval;
+            bool group_done = (group.n_rounds > 0) &&
+                              (i_round + n_skipped >= group.n_rounds);
+            if (group_done) {
+                n_skipped = group.n_rounds - i_round;
+            }
+            LOG_WARN("[{}] {} skipped {} rounds after round {}", task_name,
+                     group.name, n_skipped, i_round);
+            std::lock_guard<std::mutex> lk(mutex);
+            status.groups[i_group].n_rounds_skipped += n_skipped;
+            if (group_done) {
+                next_round[i_group].reset();
+                continue;
+            }
+            i_round += n_skipped;
+            planned += n_skipped * interval;
+        }
+
+        double late_s = std::chrono::duration<double>(now - planned).count();
+        std::chrono::system_clock::time_point planned_system =
+            tp_start_system +
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                planned - tp_first);
+
+        utils::StopWatch sw;
+        Status round_status = runRound(group, i_round, planned_system);
+        double round_s = sw.Milliseconds() / 1000;
+        if (!round_status.ok()) {
+            LOG_ERROR("[{}] {} round {} failed: {}", task_name, group.name,
+                      i_round + 1, round_status.ToString());
+        }
+
+        bool has_next = (group.n_rounds == 0) || (i_round + 1 < group.n_rounds);
+        if (has_next) {
+            queue.push({planned + interval, i_group, i_round + 1});
+        }
+
+        std::lock_guard<std::mutex> lk(mutex);
+        TimelapseGroupStatus &g = status.groups[i_group];
+        int n = g.n_rounds_done + g.n_rounds_failed;
+        g.mean_round_s = (g.mean_round_s * n + round_s) / (n + 1);
+        g.max_round_s = std::max(g.max_round_s, round_s);
+        g.mean_late_s = (g.mean_late_s * n + late_s) / (n + 1);
+        g.max_late_s = std::max(g.max_late_s, late_s);
+        if (round_status.ok()) {
+            g.n_rounds_done++;
+        } else {
+            g.n_rounds_failed++;
+        }
+        if (has_next) {
+            next_round[i_group] = planned + interval;
+        } else {
+            next_round[i_group].reset();
+        }
+
+        status.busy_s += round_s;
+        status.utilization = 0;
+        for (const auto &group_status : status.groups) {
+            status.utilization +=
+                group_status.mean_round_s / group_status.interval_s;
+        }
+        status.message = fmt::format(
+            "{} round {} completed in {:.0f} s ({:.0f} s late), "
+            "utilization {:.0f}%",
+            group.name, i_round + 1, round_s, late_s,
+            status.utilization * 100);
+        LOG_INFO("[{}] {}", task_name, status.message);
+    }
+
+    std::lock_guard<std::mutex> lk(mutex);
+    status.running = false;
+    status.elapsed_s =
+        std::chrono::duration<double>(clock::now() - tp_start).count();
+    status.message = stop_requested ? "Stopped" : "Completed";
+    LOG_INFO("[{}] {}: {:.0f} s, busy {:.0f} s, utilization {:.0f}%",
+             task_name, status.message, status.elapsed_s, status.busy_s,
+             status.utilization * 100);
+    return absl::OkStatus();
+}
@@ -0,0 +1,99 @@
+#ifndef TIMELAPSE_TASK_H
+#define TIMELAPSE_TASK_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "eventstream.h"
+#include "task/scan_task.h"
+
+class ExperimentControl;
+
+// A plate or a group of wells scanned at a fixed interval
+struct TimelapseGroup {
+    std::string name;
+    // i_t of the plan is set to the round number
+    ScanPlan plan;
+    double interval_s;
+    // 0 to repeat until stopped
+    int n_rounds = 0;
+    // Delay of the first round from the start of the time-lapse
+    double start_offset_s = 0;
+};
+
+enum class OverrunPolicy {
+    // Drop the rounds whose time has passed, and stay on the planned grid
+    Skip,
+    // Run the late rounds back to back until the schedule is caught up
+    Compress,
+};
+
+OverrunPolicy OverrunPolicyFromString(std::string value);
+std::string OverrunPolicyToString(OverrunPolicy policy);
+
+struct TimelapseGroupStatus {
+    std::string name;
+    double interval_s = 0;
+    int n_rounds_done = 0;
+    int n_rounds_skipped = 0;
+    int n_rounds_failed = 0;
+    // Duration of a round and how late it started
+    double mean_round_s = 0;
+    double max_round_s = 0;
+    double mean_late_s = 0;
+    double max_late_s = 0;
+    // Time until the next round, negative if it is late or running, unset
+    // if there are no more rounds
+    std::optional<double> next_round_in_s;
+};
+
+struct TimelapseStatus {
+    bool running = false;
+    double elapsed_s = 0;
+    double busy_s = 0;
+    // Sum of mean round duration / interval over the groups. Above 1, the
+    // rounds cannot keep up with their intervals.
+    double utilization = 0;
+    std::vector<TimelapseGroupStatus> groups;
+    std::string message;
+};
+
+class TimelapseTask : public EventSender {
+public:
+    TimelapseTask(ExperimentControl *exp, ScanTask *scan_task);
+
+    // Clears a stop request. Called before Run is launched.
+    void Arm();
+    // Runs until all groups completed their rounds, or stopped
+    Status Run(std::vector<TimelapseGroup> groups, OverrunPolicy policy);
+    // Stops the current round between sites
+    void Stop();
+
+    TimelapseStatus GetStatus();
+
+private:
+    ExperimentControl *exp;
+    ScanTask *scan_task;
+
+    std::string task_name = "Timelapse";
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::atomic<bool> stop_requested = false;
+
+    using clock = std::chrono::steady_clock;
+    clock::time_point tp_start;
+    // Unset when the group has no more rounds
+    std::vector<std::optional<clock::time_point>> next_round;
+    TimelapseStatus status;
+
+    Status runRound(TimelapseGroup &group, int i_round,
+                    std::chrono::system_clock::time_point planned);
+};
+
+#endif
@@ -0,0 +1,274 @@
+#include "task/zstack_task.h"
+#include "experimentcontrol.h"
+
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include "logging.h"
+#include "utils/time_utils.h"
+
+ZStackTask::ZStackTask(ExperimentControl *exp) : MultiChannelTask(exp) {}
+
+void ZStackTask::saveProjections(const ZStackParams &params, int i_ch,
+                                 int i_t, im::Projection &projection)
+{
+    utils::StopWatch sw;
+    nlohmann::ordered_json metadata;
+    metadata["channel"] = {{"preset_name", channels[i_ch].preset_name}};
+    metadata["projection"] = {
+        {"n_z", projection.NumPlanes()},
+        {"step_um", params.step_um},
+    };
+    if (params.max_projection) {
+        metadata["projection"]["type"] = "max";
+        exp->Images()->AddImageAsync(ndimage_name + "-max", i_ch, 0, i_t,
+                                     projection.Max(), metadata);
+    }
+    if (params.mean_projection) {
+        metadata["projection"]["type"] = "mean";
+        exp->Images()->AddImageAsync(ndimage_name + "-mean", i_ch, 0, i_t,
+                                     projection.Mean(), metadata);
+    }
+    LOG_DEBUG("[{}][{}] Projections completed [{:.1f} ms]", ndimage_name,
+              i_ch + 1, sw.Milliseconds());
+}
+
+Status ZStackTask::acquireStack(const std::vector<double> &z_list,
+                                const ZStackParams &params, int i_t,
+                                const nlohmann::ordered_json &metadata)
+{
+    // (i_z, i_ch) in acquisition order
+    std::vector<std::pair<int, int>> steps;
+    if (params.order == ZStackOrder::ChannelsPerPlane) {
+        for (int i_z = 0; i_z < z_list.size(); i_z++) {
+            for (int i_ch = 0; i_ch < channels.size(); i_ch++) {
+                steps.push_back({i_z, i_ch});
+            }
+        }
+    } else {
+        for (int i_ch = 0; i_ch < channels.size(); i_ch++) {
+            for (int i_z = 0; i_z < z_list.size(); i_z++) {
+                steps.push_back({i_z, i_ch});
+            }
+        }
+    }
+
+    std::vector<im::Projection> projections(channels.size());
+    bool project = params.max_projection || params.mean_projection;
+
+    //
+    // Move to the first plane and channel
+    //
+    auto [i_z_first, i_ch_first] = steps[0];
+    Status status = exp->Devices()->SetProperty(
+        z_property, fmt::format("{:.3f}", z_list[i_z_first]));
+    if (!status.ok()) {
+        return status;
+    }
+    Channel channel = channels[i_ch_first];
+    exp->Channels()->SwitchChannel(channel.preset_name, channel.exposure_ms,
+                                   channel.illumination_intensity);
+    bool switch_pending = true;
+    bool z_pending = true;
+
+    //
+    // Camera stays armed for the whole stack. Frames go to the ring buffer
+    // of the continuous acquisition in order.
+    //
+    int n_buffer = camera->BufferAllocated();
+    status = StartAcqusition();
+    if (status.ok()) {
+        try {
+            for (int k = 0; k < steps.size(); k++) {
+                auto [i_z, i_ch] = steps[k];
+                utils::StopWatch sw_frame;
+
+                if (switch_pending) {
+                    switch_pending = false;
+                    status = exp->Channels()->WaitSwitchChannel();
+                    if (!status.ok()) {
+                        break;
+                    }
+                }
+                if (z_pending) {
+                    z_pending = false;
+                    status = exp->Devices()->WaitPropertyFor(
+                        {z_property},
+                        std::chrono::milliseconds(params.z_timeout_ms));
+                    if (!status.ok()) {
+                        break;
+                    }
+                }
+
+                PropertySnapshotPtr property_snapshot;
+                status = ExposeFrame(i_ch, &property_snapshot);
+                if (!status.ok()) {
+                    break;
+                }
+
+                // Start the next move and switch while this frame is read
+                // out and saved
+                if (k + 1 < steps.size()) {
+                    auto [i_z_next, i_ch_next] = steps[k + 1];
+                    if (i_ch_next != i_ch) {
+                        Channel next = channels[i_ch_next];
+                        exp->Channels()->SwitchChannel(
+                            next.preset_name, next.exposure_ms,
+                            next.illumination_intensity);
+                        switch_pending = true;
+                    }
+                    if (i_z_next != i_z) {
+                        status = exp->Devices()->SetProperty(
+                            z_property,
+                            fmt::format("{:.3f}", z_list[i_z_next]));
+                        if (!status.ok()) {
+                            break;
+                        }
+                        z_pending = true;
+                    }
+                }
+
+                // Lost frames are not retried, since Z has moved on
+                std::chrono::system_clock::time_point timestamp;
+                StatusOr<ImageData> data =
+                    GetFrame(i_ch, &timestamp, k % n_buffer);
+                if (!data.ok()) {
+                    status = data.status();
+                    break;
+                }
+
+                nlohmann::ordered_json new_metadata = FrameMetadata(
+                    channels[i_ch], timestamp, metadata, property_snapshot);
+                new_metadata["zstack"] = {
+                    {"z", z_list[i_z]},
+                    {"step_um", params.step_um},
+                    {"n_z", params.n_z},
+                };
+                exp->Images()->AddImageAsync(ndimage_name, i_ch, i_z, i_t,
+                                             data.value(), new_metadata);
+
+                if (project) {
+                    projections[i_ch].Add(data.value());
+                    if (projections[i_ch].NumPlanes() == params.n_z) {
+                        saveProjections(params, i_ch, i_t, projections[i_ch]);
+                    }
+                }
+                LOG_INFO("[{}][{}] Plane {}/{} acquired [{:.0f} ms]",
+                         ndimage_name, i_ch + 1, i_z + 1, params.n_z,
+                         sw_frame.Milliseconds());
+            }
+        } catch (std::exception &e) {
+            status = absl::UnknownError(fmt::format(
+                "Unexpected exception during acquisition: {}", e.what()));
+        }
+        StopAcqusition();
+    }
+
+    if (switch_pending) {
+        Status switch_status = exp->Channels()->WaitSwitchChannel();
+        if (!switch_status.ok()) {
+            LOG_WARN("[{}] Ignoring error in switching channel: {}",
+                     ndimage_name, switch_status.ToString());
+        }
+    }
+    return status;
+}
+
+Status ZStackTask::Acquire(std::string ndimage_name,
+                           std::vector<Channel> channels, ZStackParams params,
+                           int i_t, Site *site,
+                           nlohmann::ordered_json metadata)
+{
+    if (channels.empty()) {
+        throw std::invalid_argument("channel not set");
+    }
+    if (params.n_z < 1) {
+        throw std::invalid_argument("n_z must be positive");
+    }
+    this->ndimage_name = ndimage_name;
+    this->channels = channels;
+    ResetPropertyBase();
+
+    utils::StopWatch sw_task;
+    LOG_INFO("[{}] Prepare Z-stack", ndimage_name);
+
+    Status status = EnableTrigger();
+    if (!status.ok()) {
+        return status;
+    }
+
+    double z_center;
+    if (params.z_center.has_value()) {
+        z_center = params.z_center.value();
+    } else {
+        StatusOr<std::string> z_value = exp->Devices()->GetProperty(z_property);
+        if (!z_value.ok()) {
+            return z_value.status();
+        }
+        z_center = std::stod(z_value.value());
+    }
+    std::vector<double> z_list;
+    for (int i_z = 0; i_z < params.n_z; i_z++) {
+        z_list.push_back(z_center +
+                         (i_z - (params.n_z - 1) / 2.0) * params.step_um);
+    }
+
+    status = PrepareBuffer();
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::vector<std::string> ch_names;
+    for (const auto &channel : channels) {
+        ch_names.push_back(channel.preset_name);
+    }
+    exp->Images()->NewNDImage(ndimage_name, ch_names, site);
+    if (params.max_projection) {
+        exp->Images()->NewNDImage(ndimage_name + "-max", ch_names, site);
+    }
+    if (params.mean_projection) {
+        exp->Images()->NewNDImage(ndimage_name + "-mean", ch_names, site);
+    }
+
+    LOG_INFO("[{}] Starting Z-stack: {} planes from {:.3f} to {:.3f}",
+             ndimage_name, params.n_z, z_list.front(), z_list.back());
+    SendEvent({
+        .type = EventType::TaskStateChanged,
+        .value = "Running",
+    });
+    status = acquireStack(z_list, params, i_t, metadata);
+
+    // Return to the center of the stack
+    Status z_status = exp->Devices()->SetProperty(
+        z_property, fmt::format("{:.3f}", z_center));
+    if (z_status.ok()) {
+        z_status = exp->Devices()->WaitPropertyFor(
+            {z_property}, std::chrono::milliseconds(params.z_timeout_ms));
+    }
+    if (!z_status.ok()) {
+        LOG_ERROR("[{}] Failed to return Z to {:.3f}: {}", ndimage_name,
+                  z_center, z_status.ToString());
+    }
+
+    double task_elapse_ms = sw_task.Milliseconds();
+    if (!status.ok()) {
+        LOG_ERROR("[{}] Z-stack failed: {} [{:.0f} ms]", ndimage_name,
+                  status.ToString(), task_elapse_ms);
+        return status;
+    }
+    LOG_INFO("[{}] Z-stack completed: {:.0f} ms", ndimage_name,
+             task_elapse_ms);
+    SendEvent({
+        .type = EventType::TaskStateChanged,
+        .value = "Ready",
+    });
+    SendEvent({
+        .type = EventType::TaskMessage,
+        .value = fmt::format("Z-stack {} completed [{:.0f} ms]", ndimage_name,
+                             task_elapse_ms),
+    });
+    return absl::OkStatus();
+}
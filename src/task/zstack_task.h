@@ -0,0 +1,54 @@
+#ifndef ZSTACK_TASK_H
+#define ZSTACK_TASK_H
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "channel.h"
+#include "image/imageutils.h"
+#include "task/multi_channel_task.h"
+
+enum class ZStackOrder {
+    // All channels at a plane before moving Z
+    ChannelsPerPlane,
+    // All planes of a channel before switching channel
+    PlanesPerChannel,
+};
+
+struct ZStackParams {
+    // Planes are centered at z_center, or the current Z if not set
+    std::optional<double> z_center;
+    double step_um = 1;
+    int n_z = 1;
+    ZStackOrder order = ZStackOrder::ChannelsPerPlane;
+
+    // Saved as NDImage <name>-max and <name>-mean
+    bool max_projection = false;
+    bool mean_projection = false;
+
+    int z_timeout_ms = 2000;
+};
+
+// Acquires a stack while the camera stays armed. Z moves and channel switches
+// start as soon as the previous exposure ends, and planes are saved in the
+// background.
+class ZStackTask : public MultiChannelTask {
+public:
+    ZStackTask(ExperimentControl *exp);
+
+    Status Acquire(std::string ndimage_name, std::vector<Channel> channels,
+                   ZStackParams params, int i_t = 0, Site *site = nullptr,
+                   nlohmann::ordered_json metadata = nullptr);
+
+private:
+    std::string z_property = "/NikonTi/ZDrivePosition";
+
+    Status acquireStack(const std::vector<double> &z_list,
+                        const ZStackParams &params, int i_t,
+                        const nlohmann::ordered_json &metadata);
+    void saveProjections(const ZStackParams &params, int i_ch, int i_t,
+                         im::Projection &projection);
+};
+
+#endif
@@ -1,21 +1,41 @@
 #include "hdf5file.h"
 
+#include <algorithm>
 #include <fmt/format.h>
+#include <limits>
 
-HDF5File::HDF5File(std::filesystem::path path)
+HDF5File::HDF5File(std::filesystem::path path, HDF5FileOptions options)
 {
+    this->options = options;
+
+    hid_t fapl_id = H5Pcreate(H5P_FILE_ACCESS);
+    if (fapl_id == H5I_INVALID_HID) {
+        throw std::runtime_error("cannot create file access property");
+    }
+    herr_t status =
+        H5Pset_cache(fapl_id, 0, options.chunk_cache_nslots,
+                     options.chunk_cache_nbytes, options.chunk_cache_w0);
+    if (status < 0) {
+        H5Pclose(fapl_id);
+        throw std::runtime_error(
+            fmt::format("cannot set chunk cache, err={}", status));
+    }
+
     if (!std::filesystem::exists(path)) {
         file_id = H5Fcreate(path.string().c_str(), H5F_ACC_EXCL, H5P_DEFAULT,
-                            H5P_DEFAULT);
+                            fapl_id);
         if (file_id == H5I_INVALID_HID) {
+            H5Pclose(fapl_id);
             throw std::runtime_error("H5Fcreate failed");
         }
     } else {
-        file_id = H5Fopen(path.string().c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+        file_id = H5Fopen(path.string().c_str(), H5F_ACC_RDWR, fapl_id);
         if (file_id == H5I_INVALID_HID) {
+            H5Pclose(fapl_id);
             throw std::runtime_error("H5Fopen failed");
         }
     }
+    H5Pclose(fapl_id);
 }
 
 HDF5File::~HDF5File()
@@ -37,33 +57,86 @@ bool HDF5File::exists_nolock(std::string name)
         throw std::invalid_argument("empty name");
     }
 
-    // recursively determine the existance of parent path
-    size_t pos = name.find_last_of("/");
-    if (!((pos == std::string::npos) || (pos == 0))) {
-        std::string parent_path = name.substr(0, pos);
-        if (!exists_nolock(parent_path)) {
-            return false;
-        }
+    if (known_paths.contains(name)) {
+        return true;
     }
 
-    htri_t status = H5Lexists(file_id, name.c_str(), H5P_DEFAULT);
-    if (status > 0) {
-        return true;
-    } else if (status == 0) {
-        return false;
-    } else {
-        throw std::runtime_error(fmt::format("H5Lexists err={}", status));
+    // Walk down the path once. H5Lexists fails if a parent does not exist.
+    // Components already known to exist are skipped.
+    size_t pos = (name[0] == '/') ? 1 : 0;
+    while (pos <= name.size()) {
+        size_t next = name.find('/', pos);
+        if (next == std::string::npos) {
+            next = name.size();
+        }
+        std::string path = name.substr(0, next);
+        pos = next + 1;
+        if (path.empty() || (path == "/") || known_paths.contains(path)) {
+            continue;
+        }
+
+        htri_t status = H5Lexists(file_id, path.c_str(), H5P_DEFAULT);
+        if (status == 0) {
+            return false;
+        } else if (status < 0) {
+            throw std::runtime_error(fmt::format("H5Lexists err={}", status));
+        }
+        known_paths.insert(path);
     }
+    return true;
 }
 
 void HDF5File::remove(std::string name)
 {
     std::unique_lock<std::mutex> lk(io_mutex);
 
+    remove_nolock(name);
+}
+
+void HDF5File::remove_nolock(std::string name)
+{
     herr_t status = H5Ldelete(file_id, name.c_str(), H5P_DEFAULT);
     if (status < 0) {
         throw std::runtime_error(fmt::format("H5Ldelete err={}", status));
     }
+
+    // Forget the path and everything under it
+    known_paths.erase(name);
+    std::string prefix = name + "/";
+    auto it = known_paths.lower_bound(prefix);
+    while ((it != known_paths.end()) && it->starts_with(prefix)) {
+        it = known_paths.erase(it);
+    }
+}
+
+void HDF5File::add_known_path(std::string name)
+{
+    // The path and all its parents exist after a successful create
+    size_t pos = 0;
+    while ((pos = name.find('/', pos + 1)) != std::string::npos) {
+        known_paths.insert(name.substr(0, pos));
+    }
+    known_paths.insert(name);
+}
+
+std::vector<hsize_t> HDF5File::chunk_shape(std::vector<hsize_t> shape,
+                                           size_t type_size)
+{
+    // Chunks are whole rows (the last dimensions kept full) of about
+    // chunk_target_bytes each. A full-image read touches a handful of chunks
+    // and each chunk fits in the chunk cache.
+    std::vector<hsize_t> c_dims = shape;
+    if (shape.empty()) {
+        return c_dims;
+    }
+
+    size_t row_bytes = type_size;
+    for (size_t i = 1; i < shape.size(); i++) {
+        row_bytes *= shape[i];
+    }
+    hsize_t n_rows = options.chunk_target_bytes / std::max<size_t>(row_bytes, 1);
+    c_dims[0] = std::clamp<hsize_t>(n_rows, 1, std::max<hsize_t>(shape[0], 1));
+    return c_dims;
 }
 
 std::vector<std::string> HDF5File::list(std::string group_name)
@@ -133,17 +206,12 @@ bool HDF5File::is_group(std::string name)
     }
 }
 
-void HDF5File::write(std::string name, StructArray arr)
+hid_t HDF5File::create_compound_type(StructArray &arr)
 {
-    // Overwrite if exists
-    if (exists(name)) {
-        remove(name);
-    }
-
-    std::unique_lock<std::mutex> lk(io_mutex);
-
-    // Create compound type
     hid_t type_id = H5Tcreate(H5T_COMPOUND, arr.ItemSize());
+    if (type_id == H5I_INVALID_HID) {
+        throw std::runtime_error("cannot create compound type");
+    }
     for (const auto &field : arr.Fields()) {
         hid_t member_type_id;
         switch (field.dtype) {
@@ -181,18 +249,59 @@ void HDF5File::write(std::string name, StructArray arr)
         H5Tinsert(type_id, field.name.c_str(), field.offset, member_type_id);
     }
     if (H5Tget_size(type_id) != arr.ItemSize()) {
+        H5Tclose(type_id);
         throw std::runtime_error("H5T size does not match itemsize");
     }
+    return type_id;
+}
+
+hid_t HDF5File::create_packed_type(hid_t type_id)
+{
+    // Compound types are stored packed in the file. The in-memory layout
+    // has alignment padding and is converted by HDF5 on read and write.
+    hid_t file_type_id = H5Tcopy(type_id);
+    if (file_type_id == H5I_INVALID_HID) {
+        throw std::runtime_error("cannot copy compound type");
+    }
+    herr_t status = H5Tpack(file_type_id);
+    if (status < 0) {
+        H5Tclose(file_type_id);
+        throw std::runtime_error(fmt::format("H5Tpack err={}", status));
+    }
+    return file_type_id;
+}
+
+void HDF5File::write(std::string name, StructArray arr)
+{
+    std::unique_lock<std::mutex> lk(io_mutex);
+
+    // Overwrite if exists
+    if (exists_nolock(name)) {
+        remove_nolock(name);
+    }
+
+    hid_t type_id = create_compound_type(arr);
+    hid_t file_type_id;
+    try {
+        file_type_id = create_packed_type(type_id);
+    } catch (std::exception &) {
+        H5Tclose(type_id);
+        throw;
+    }
 
     const hsize_t dims[] = {arr.Size()};
     hid_t space_id = H5Screate_simple(1, dims, NULL);
     if (space_id == H5I_INVALID_HID) {
+        H5Tclose(file_type_id);
+        H5Tclose(type_id);
         throw std::runtime_error("cannot create dataspace");
     }
 
     hid_t lcpl_id = H5Pcreate(H5P_LINK_CREATE);
     if (lcpl_id == H5I_INVALID_HID) {
         H5Sclose(space_id);
+        H5Tclose(file_type_id);
+        H5Tclose(type_id);
         throw std::runtime_error("cannot create link property");
     }
 
@@ -201,24 +310,39 @@ void HDF5File::write(std::string name, StructArray arr)
     if (status < 0) {
         H5Pclose(lcpl_id);
         H5Sclose(space_id);
+        H5Tclose(file_type_id);
+        H5Tclose(type_id);
         throw std::runtime_error(
             fmt::format("cannot set link property, err={}", status));
     }
 
-    hid_t ds_id = H5Dcreate2(file_id, name.c_str(), type_id, space_id, lcpl_id,
-                             H5P_DEFAULT, H5P_DEFAULT);
+    hid_t ds_id = H5Dcreate2(file_id, name.c_str(), file_type_id, space_id,
+                             lcpl_id, H5P_DEFAULT, H5P_DEFAULT);
     if (ds_id == H5I_INVALID_HID) {
         H5Pclose(lcpl_id);
         H5Sclose(space_id);
+        H5Tclose(file_type_id);
+        H5Tclose(type_id);
         throw std::runtime_error("cannot create dataset");
     }
+    add_known_path(name);
 
-    std::string buf = arr.ToBuf();
-    status = H5Dwrite(ds_id, type_id, H5S_ALL, H5S_ALL, H5P_DEFAULT, &buf[0]);
+    // Records are written in place, columns are interleaved first
+    std::string buf;
+    const void *data;
+    if (arr.Layout() == StructArrayLayout::Records) {
+        data = arr.Data();
+    } else {
+        buf = arr.ToBuf();
+        data = buf.data();
+    }
+    status = H5Dwrite(ds_id, type_id, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
     if (status < 0) {
         H5Dclose(ds_id);
         H5Pclose(lcpl_id);
         H5Sclose(space_id);
+        H5Tclose(file_type_id);
+        H5Tclose(type_id);
         throw std::runtime_error(
             fmt::format("cannot write dataset, err={}", status));
     }
@@ -226,6 +350,139 @@ void HDF5File::write(std::string name, StructArray arr)
     H5Dclose(ds_id);
     H5Pclose(lcpl_id);
     H5Sclose(space_id);
+    H5Tclose(file_type_id);
+    H5Tclose(type_id);
+}
+
+hsize_t HDF5File::append(std::string name, StructArray arr,
+                         hsize_t chunk_rows)
+{
+    std::unique_lock<std::mutex> lk(io_mutex);
+
+    hid_t type_id = create_compound_type(arr);
+    herr_t status;
+
+    hid_t ds_id;
+    if (exists_nolock(name)) {
+        ds_id = H5Dopen2(file_id, name.c_str(), H5P_DEFAULT);
+        if (ds_id == H5I_INVALID_HID) {
+            H5Tclose(type_id);
+            throw std::runtime_error("cannot open dataset");
+        }
+    } else {
+        const hsize_t dims[] = {0};
+        const hsize_t maxdims[] = {H5S_UNLIMITED};
+        hid_t space_id = H5Screate_simple(1, dims, maxdims);
+        if (space_id == H5I_INVALID_HID) {
+            H5Tclose(type_id);
+            throw std::runtime_error("cannot create dataspace");
+        }
+
+        hid_t lcpl_id = H5Pcreate(H5P_LINK_CREATE);
+        hid_t dcpl_id = H5Pcreate(H5P_DATASET_CREATE);
+        const hsize_t c_dims[] = {std::max<hsize_t>(chunk_rows, 1)};
+        if ((H5Pset_create_intermediate_group(lcpl_id, 1) < 0) ||
+            (H5Pset_chunk(dcpl_id, 1, c_dims) < 0) ||
+            (H5Pset_shuffle(dcpl_id) < 0) ||
+            (H5Pset_deflate(dcpl_id, options.deflate_level) < 0))
+        {
+            H5Pclose(dcpl_id);
+            H5Pclose(lcpl_id);
+            H5Sclose(space_id);
+            H5Tclose(type_id);
+            throw std::runtime_error("cannot set table properties");
+        }
+
+        hid_t file_type_id;
+        try {
+            file_type_id = create_packed_type(type_id);
+        } catch (std::exception &) {
+            H5Pclose(dcpl_id);
+            H5Pclose(lcpl_id);
+            H5Sclose(space_id);
+            H5Tclose(type_id);
+            throw;
+        }
+        ds_id = H5Dcreate2(file_id, name.c_str(), file_type_id, space_id,
+                           lcpl_id, dcpl_id, H5P_DEFAULT);
+        H5Tclose(file_type_id);
+        H5Pclose(dcpl_id);
+        H5Pclose(lcpl_id);
+        H5Sclose(space_id);
+        if (ds_id == H5I_INVALID_HID) {
+            H5Tclose(type_id);
+            throw std::runtime_error("cannot create dataset");
+        }
+        add_known_path(name);
+    }
+
+    // Extend and write the new rows at the end
+    hid_t space_id = H5Dget_space(ds_id);
+    hsize_t offset;
+    H5Sget_simple_extent_dims(space_id, &offset, NULL);
+    H5Sclose(space_id);
+
+    hsize_t count = arr.Size();
+    if (count == 0) {
+        H5Dclose(ds_id);
+        H5Tclose(type_id);
+        return offset;
+    }
+
+    const hsize_t new_dims[] = {offset + count};
+    status = H5Dset_extent(ds_id, new_dims);
+    if (status < 0) {
+        H5Dclose(ds_id);
+        H5Tclose(type_id);
+        throw std::runtime_error(
+            fmt::format("cannot extend dataset, err={}", status));
+    }
+
+    hid_t file_space_id = H5Dget_space(ds_id);
+    const hsize_t start[] = {offset};
+    const hsize_t dims[] = {count};
+    H5Sselect_hyperslab(file_space_id, H5S_SELECT_SET, start, NULL, dims, NULL);
+    hid_t mem_space_id = H5Screate_simple(1, dims, NULL);
+
+    std::string buf;
+    const void *data;
+    if (arr.Layout() == StructArrayLayout::Records) {
+        data = arr.Data();
+    } else {
+        buf = arr.ToBuf();
+        data = buf.data();
+    }
+    status = H5Dwrite(ds_id, type_id, mem_space_id, file_space_id, H5P_DEFAULT,
+                      data);
+
+    H5Sclose(mem_space_id);
+    H5Sclose(file_space_id);
+    H5Dclose(ds_id);
+    H5Tclose(type_id);
+    if (status < 0) {
+        throw std::runtime_error(
+            fmt::format("cannot write dataset, err={}", status));
+    }
+    return offset;
+}
+
+hsize_t HDF5File::length(std::string name)
+{
+    std::unique_lock<std::mutex> lk(io_mutex);
+
+    hid_t ds_id = H5Dopen2(file_id, name.c_str(), H5P_DEFAULT);
+    if (ds_id == H5I_INVALID_HID) {
+        throw std::runtime_error("cannot open dataset");
+    }
+    hid_t space_id = H5Dget_space(ds_id);
+    hsize_t length = 0;
+    int ndims = H5Sget_simple_extent_dims(space_id, &length, NULL);
+    H5Sclose(space_id);
+    H5Dclose(ds_id);
+    if (ndims != 1) {
+        throw std::runtime_error("unexpected shape");
+    }
+    return length;
 }
 
 void HDF5File::flush()
@@ -239,6 +496,11 @@ void HDF5File::flush()
 }
 
 StructArray HDF5File::read(std::string name)
+{
+    return read(name, 0, std::numeric_limits<hsize_t>::max());
+}
+
+StructArray HDF5File::read(std::string name, hsize_t offset, hsize_t count)
 {
     std::unique_lock<std::mutex> lk(io_mutex);
 
@@ -249,36 +511,45 @@ StructArray HDF5File::read(std::string name)
 
     hid_t space_id = H5Dget_space(ds_id);
     if (space_id == H5I_INVALID_HID) {
+        H5Dclose(ds_id);
         throw std::runtime_error("cannot read data space");
     }
 
     int ndims = H5Sget_simple_extent_ndims(space_id);
     if (ndims != 1) {
+        H5Sclose(space_id);
+        H5Dclose(ds_id);
         throw std::runtime_error("unexpected shape");
     }
     hsize_t length;
     if (H5Sget_simple_extent_dims(space_id, &length, NULL) != ndims) {
+        H5Sclose(space_id);
+        H5Dclose(ds_id);
         throw std::runtime_error("cannot read data length");
     }
 
-    hid_t type_id = H5Dget_type(ds_id);
-    size_t type_size = H5Tget_size(type_id);
-
-    // read data into buffer
-    size_t buf_size = length * type_size;
-    uint8_t *buf = (uint8_t *)malloc(buf_size);
-    herr_t status = H5Dread(ds_id, type_id, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf);
-    if (status < 0) {
+    // select rows [offset, offset + count)
+    if (offset > length) {
+        H5Sclose(space_id);
         H5Dclose(ds_id);
-        throw std::runtime_error("cannot read data");
+        throw std::out_of_range("offset out of range");
     }
-    H5Dclose(ds_id);
+    count = std::min(count, length - offset);
+    const hsize_t start[] = {offset};
+    const hsize_t dims[] = {count};
+    H5Sselect_hyperslab(space_id, H5S_SELECT_SET, start, NULL, dims, NULL);
+    hid_t mem_space_id = H5Screate_simple(1, dims, NULL);
+
+    hid_t type_id = H5Dget_type(ds_id);
 
     // find out fields
     int n_fields = H5Tget_nmembers(type_id);
     std::vector<StructArrayFieldDef> fields;
     for (int i = 0; i < n_fields; i++) {
-        std::string name = std::string(H5Tget_member_name(type_id, i));
+        char *member_name = H5Tget_member_name(type_id, i);
+        std::string name = std::string(member_name);
+        H5free_memory(member_name);
+
         hid_t field_type_id = H5Tget_member_type(type_id, i);
         if (H5Tequal(field_type_id, H5T_NATIVE_FLOAT)) {
             fields.push_back({name, Dtype::float32});
@@ -301,15 +572,29 @@ StructArray HDF5File::read(std::string name)
         } else if (H5Tequal(field_type_id, H5T_NATIVE_INT64)) {
             fields.push_back({name, Dtype::int64});
         } else {
+            H5Tclose(field_type_id);
+            H5Tclose(type_id);
+            H5Sclose(mem_space_id);
+            H5Sclose(space_id);
+            H5Dclose(ds_id);
             throw std::runtime_error("unexpected data type");
         }
+        H5Tclose(field_type_id);
     }
-    StructArray arr(fields, length);
-    if (arr.ItemSize() != type_size) {
-        throw std::runtime_error(
-            "size of array item does not match H5T type size");
+    H5Tclose(type_id);
+
+    // read directly into the record buffer
+    StructArray arr(fields, count, StructArrayLayout::Records);
+    hid_t mem_type_id = create_compound_type(arr);
+    herr_t status = H5Dread(ds_id, mem_type_id, mem_space_id, space_id,
+                            H5P_DEFAULT, arr.Data());
+    H5Tclose(mem_type_id);
+    H5Sclose(mem_space_id);
+    H5Sclose(space_id);
+    H5Dclose(ds_id);
+    if (status < 0) {
+        throw std::runtime_error("cannot read data");
     }
-    arr.FromBuf(std::string((char *)buf, buf_size));
 
     return arr;
-}
\ No newline at end of file
+}
@@ -5,13 +5,26 @@
 #include <fmt/format.h>
 #include <hdf5.h>
 #include <mutex>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "utils/structarray.h"
 
+struct HDF5FileOptions {
+    // Raw data chunk cache, per opened dataset
+    size_t chunk_cache_nslots = 521;
+    size_t chunk_cache_nbytes = 16 * 1024 * 1024;
+    double chunk_cache_w0 = 1.0;
+
+    // Target size of a chunk of compressed datasets
+    size_t chunk_target_bytes = 1024 * 1024;
+    int deflate_level = 4;
+};
+
 class HDF5File {
 public:
-    HDF5File(std::filesystem::path path);
+    HDF5File(std::filesystem::path path, HDF5FileOptions options = {});
     ~HDF5File();
 
     bool exists(std::string name);
@@ -25,22 +38,44 @@ public:
     void write(std::string name, xt::xarray<T> arr, bool compress = false);
 
     StructArray read(std::string name);
+    StructArray read(std::string name, hsize_t offset, hsize_t count);
     void write(std::string name, StructArray arr);
+
+    // Append rows to an extendable, chunked and compressed table. The table
+    // is created on first append. Fields are matched by name, so fields
+    // missing from the table are dropped and fields missing from arr are
+    // left as zero. Returns the row offset of the first appended row.
+    hsize_t append(std::string name, StructArray arr, hsize_t chunk_rows);
+    hsize_t length(std::string name);
+
     void flush();
 
 public:
     std::mutex io_mutex;
     hid_t file_id;
+    HDF5FileOptions options;
+
+    // Paths known to exist, so that repeated checks on the same groups do not
+    // go to the file. Only this process writes to the file.
+    std::set<std::string> known_paths;
 
     bool exists_nolock(std::string name);
+    void remove_nolock(std::string name);
+    void add_known_path(std::string name);
+    std::vector<hsize_t> chunk_shape(std::vector<hsize_t> shape,
+                                     size_t type_size);
+    hid_t create_compound_type(StructArray &arr);
+    hid_t create_packed_type(hid_t type_id);
 };
 
 template <typename T>
 void HDF5File::write(std::string name, xt::xarray<T> arr, bool compress)
 {
+    std::unique_lock<std::mutex> lk(io_mutex);
+
     // Overwrite if exists
-    if (exists(name)) {
-        remove(name);
+    if (exists_nolock(name)) {
+        remove_nolock(name);
     }
 
     hid_t type_id;
@@ -81,8 +116,8 @@ void HDF5File::write(std::string name, xt::xarray<T> arr, bool compress)
         static_assert(!sizeof(T *), "unknown type");
     }
 
-    hid_t space_id =
-        H5Screate_simple(arr.shape().size(), arr.shape().data(), NULL);
+    std::vector<hsize_t> shape(arr.shape().begin(), arr.shape().end());
+    hid_t space_id = H5Screate_simple(shape.size(), shape.data(), NULL);
     if (space_id == H5I_INVALID_HID) {
         throw std::runtime_error("cannot create space");
     }
@@ -96,18 +131,9 @@ void HDF5File::write(std::string name, xt::xarray<T> arr, bool compress)
     herr_t status;
 
     hid_t dcpl_id = H5Pcreate(H5P_DATASET_CREATE);
-    if (compress) {
-        hsize_t c_ndim;
-        hsize_t c_dims[2];
-        if (arr.shape().size() == 1) {
-            c_ndim = 1;
-            c_dims[0] = arr.shape(0);
-        } else {
-            c_ndim = 2;
-            c_dims[0] = arr.shape(0);
-            c_dims[1] = arr.shape(1);
-        }
-        status = H5Pset_chunk(dcpl_id, c_ndim, c_dims);
+    if (compress && (arr.size() > 0)) {
+        std::vector<hsize_t> c_dims = chunk_shape(shape, sizeof(T));
+        status = H5Pset_chunk(dcpl_id, c_dims.size(), c_dims.data());
         if (status < 0) {
             H5Pclose(dcpl_id);
             H5Pclose(lcpl_id);
@@ -116,7 +142,17 @@ void HDF5File::write(std::string name, xt::xarray<T> arr, bool compress)
                 fmt::format("cannot set chunk, err={}", status));
         }
 
-        status = H5Pset_deflate(dcpl_id, 4);
+        // Byte shuffle makes 16-bit label and score images compress better
+        status = H5Pset_shuffle(dcpl_id);
+        if (status < 0) {
+            H5Pclose(dcpl_id);
+            H5Pclose(lcpl_id);
+            H5Sclose(space_id);
+            throw std::runtime_error(
+                fmt::format("cannot set shuffle, err={}", status));
+        }
+
+        status = H5Pset_deflate(dcpl_id, options.deflate_level);
         if (status < 0) {
             H5Pclose(dcpl_id);
             H5Pclose(lcpl_id);
@@ -128,6 +164,7 @@ void HDF5File::write(std::string name, xt::xarray<T> arr, bool compress)
 
     status = H5Pset_create_intermediate_group(lcpl_id, 1);
     if (status < 0) {
+        H5Pclose(dcpl_id);
         H5Pclose(lcpl_id);
         H5Sclose(space_id);
         throw std::runtime_error(
@@ -137,15 +174,18 @@ void HDF5File::write(std::string name, xt::xarray<T> arr, bool compress)
     hid_t ds_id = H5Dcreate2(file_id, name.c_str(), type_id, space_id, lcpl_id,
                              dcpl_id, H5P_DEFAULT);
     if (ds_id == H5I_INVALID_HID) {
+        H5Pclose(dcpl_id);
         H5Pclose(lcpl_id);
         H5Sclose(space_id);
         throw std::runtime_error("cannot create dataset");
     }
+    add_known_path(name);
 
     status =
         H5Dwrite(ds_id, mem_type_id, H5S_ALL, H5S_ALL, H5P_DEFAULT, arr.data());
     if (status < 0) {
         H5Dclose(ds_id);
+        H5Pclose(dcpl_id);
         H5Pclose(lcpl_id);
         H5Sclose(space_id);
         throw std::runtime_error(
@@ -153,12 +193,15 @@ void HDF5File::write(std::string name, xt::xarray<T> arr, bool compress)
     }
 
     H5Dclose(ds_id);
+    H5Pclose(dcpl_id);
     H5Pclose(lcpl_id);
     H5Sclose(space_id);
 }
 
 template <typename T> xt::xarray<T> HDF5File::read(std::string name)
 {
+    std::unique_lock<std::mutex> lk(io_mutex);
+
     hid_t ds_id = H5Dopen2(file_id, name.c_str(), H5P_DEFAULT);
     if (ds_id == H5I_INVALID_HID) {
         throw std::runtime_error("cannot read dataset");
@@ -0,0 +1,192 @@
+#include "rawfile.h"
+
+#include <new>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+RawFileWriter::RawFileWriter(std::filesystem::path filename,
+                             uint64_t preallocate_size)
+{
+    HANDLE h = CreateFileW(filename.wstring().c_str(), GENERIC_WRITE, 0, NULL,
+                           CREATE_ALWAYS,
+                           FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING |
+                               FILE_FLAG_SEQUENTIAL_SCAN,
+                           NULL);
+    if (h == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error(
+            fmt::format("failed to create file: error {}", GetLastError()));
+    }
+    handle = h;
+
+    // Reserve the space without moving the end of file, so the file does not
+    // have to be zero-filled
+    FILE_ALLOCATION_INFO alloc_info;
+    alloc_info.AllocationSize.QuadPart = preallocate_size;
+    if (!SetFileInformationByHandle(h, FileAllocationInfo, &alloc_info,
+                                    sizeof(alloc_info)))
+    {
+        DWORD err = GetLastError();
+        CloseHandle(h);
+        handle = nullptr;
+        throw std::runtime_error(
+            fmt::format("failed to preallocate file: error {}", err));
+    }
+}
+
+RawFileWriter::~RawFileWriter()
+{
+    if (handle != nullptr) {
+        CloseHandle((HANDLE)handle);
+    }
+}
+
+void RawFileWriter::Write(const void *buf, size_t size)
+{
+    if (handle == nullptr) {
+        throw std::runtime_error("file is closed");
+    }
+    if ((size % alignment != 0) || ((uintptr_t)buf % alignment != 0)) {
+        throw std::invalid_argument("unaligned write");
+    }
+    const uint8_t *p = (const uint8_t *)buf;
+    while (size > 0) {
+        DWORD n_to_write = (size > (1 << 30)) ? (1 << 30) : (DWORD)size;
+        DWORD n_written = 0;
+        if (!WriteFile((HANDLE)handle, p, n_to_write, &n_written, NULL)) {
+            throw std::runtime_error(
+                fmt::format("failed to write file: error {}", GetLastError()));
+        }
+        p += n_written;
+        size -= n_written;
+        position += n_written;
+    }
+}
+
+void RawFileWriter::Close(uint64_t size)
+{
+    if (handle == nullptr) {
+        return;
+    }
+    FILE_END_OF_FILE_INFO eof_info;
+    eof_info.EndOfFile.QuadPart = size;
+    BOOL ok = SetFileInformationByHandle((HANDLE)handle, FileEndOfFileInfo,
+                                         &eof_info, sizeof(eof_info));
+    DWORD err = GetLastError();
+    CloseHandle((HANDLE)handle);
+    handle = nullptr;
+    if (!ok) {
+        throw std::runtime_error(
+            fmt::format("failed to set end of file: error {}", err));
+    }
+}
+
+#else
+
+// POSIX: O_DIRECT where available. Without it, the OS cache is used.
+RawFileWriter::RawFileWriter(std::filesystem::path filename,
+                             uint64_t preallocate_size)
+{
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef O_DIRECT
+    flags |= O_DIRECT;
+#endif
+    int fd = ::open(filename.c_str(), flags, 0644);
+#ifdef O_DIRECT
+    // Some file systems, e.g. tmpfs, do not support it
+    if (fd < 0 && errno == EINVAL) {
+        fd = ::open(filename.c_str(), flags & ~O_DIRECT, 0644);
+    }
+#endif
+    if (fd < 0) {
+        throw std::runtime_error(
+            fmt::format("failed to create file: error {}", errno));
+    }
+    handle = new int(fd);
+
+#ifdef __linux__
+    int err = ::posix_fallocate(fd, 0, preallocate_size);
+    if (err != 0) {
+        ::close(fd);
+        delete (int *)handle;
+        handle = nullptr;
+        throw std::runtime_error(
+            fmt::format("failed to preallocate file: error {}", err));
+    }
+#endif
+}
+
+RawFileWriter::~RawFileWriter()
+{
+    if (handle != nullptr) {
+        ::close(*(int *)handle);
+        delete (int *)handle;
+    }
+}
+
+void RawFileWriter::Write(const void *buf, size_t size)
+{
+    if (handle == nullptr) {
+        throw std::runtime_error("file is closed");
+    }
+    if ((size % alignment != 0) || ((uintptr_t)buf % alignment != 0)) {
+        throw std::invalid_argument("unaligned write");
+    }
+    int fd = *(int *)handle;
+    const uint8_t *p = (const uint8_t *)buf;
+    while (size > 0) {
+        size_t n_to_write = (size > (1 << 30)) ? (1 << 30) : size;
+        ssize_t n_written = ::pwrite(fd, p, n_to_write, position);
+        if (n_written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(
+                fmt::format("failed to write file: error {}", errno));
+        }
+        p += n_written;
+        size -= n_written;
+        position += n_written;
+    }
+}
+
+void RawFileWriter::Close(uint64_t size)
+{
+    if (handle == nullptr) {
+        return;
+    }
+    int fd = *(int *)handle;
+    int ret = ::ftruncate(fd, size);
+    int err = errno;
+    ::close(fd);
+    delete (int *)handle;
+    handle = nullptr;
+    if (ret != 0) {
+        throw std::runtime_error(
+            fmt::format("failed to set end of file: error {}", err));
+    }
+}
+
+#endif
+
+AlignedBuffer::AlignedBuffer(size_t size)
+{
+    this->size = AlignUp(size, RawFileWriter::alignment);
+    data = (uint8_t *)::operator new(
+        this->size, std::align_val_t(RawFileWriter::alignment));
+}
+
+AlignedBuffer::~AlignedBuffer()
+{
+    ::operator delete(data, std::align_val_t(RawFileWriter::alignment));
+}
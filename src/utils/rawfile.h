@@ -0,0 +1,50 @@
+#ifndef RAWFILE_H
+#define RAWFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+// Append-only file written without the OS cache. Large sequential writes go
+// straight to the disk instead of competing with acquisition for memory.
+// The file is preallocated, so that writes do not extend it one by one.
+class RawFileWriter {
+public:
+    // Sizes of writes must be multiples of this, and buffers aligned to it
+    static const size_t alignment = 4096;
+
+    RawFileWriter(std::filesystem::path filename, uint64_t preallocate_size);
+    ~RawFileWriter();
+
+    void Write(const void *buf, size_t size);
+    uint64_t Position() { return position; }
+    // Sets the final size of the file, releasing the unused preallocation
+    void Close(uint64_t size);
+
+private:
+    void *handle = nullptr;
+    uint64_t position = 0;
+};
+
+// Buffer aligned for RawFileWriter
+class AlignedBuffer {
+public:
+    AlignedBuffer(size_t size);
+    ~AlignedBuffer();
+    AlignedBuffer(const AlignedBuffer &) = delete;
+    AlignedBuffer &operator=(const AlignedBuffer &) = delete;
+
+    uint8_t *Data() { return data; }
+    size_t Size() { return size; }
+
+private:
+    uint8_t *data;
+    size_t size;
+};
+
+inline uint64_t AlignUp(uint64_t size, uint64_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+#endif
@@ -1,17 +1,51 @@
 #include "structarray.h"
 
+#include <algorithm>
+#include <cstring>
+
+size_t DtypeSize(Dtype dtype)
+{
+    switch (dtype) {
+    case Dtype::float32:
+        return 4;
+    case Dtype::float64:
+        return 8;
+    case Dtype::uint8:
+        return 1;
+    case Dtype::uint16:
+        return 2;
+    case Dtype::uint32:
+        return 4;
+    case Dtype::uint64:
+        return 8;
+    case Dtype::int8:
+        return 1;
+    case Dtype::int16:
+        return 2;
+    case Dtype::int32:
+        return 4;
+    case Dtype::int64:
+        return 8;
+    default:
+        throw std::invalid_argument("unknown type");
+    }
+}
+
 StructArray::StructArray(std::vector<std::string> names, Dtype dtype,
-                         size_t size)
+                         size_t size, StructArrayLayout layout)
 {
     std::vector<StructArrayFieldDef> dtype_fields;
     for (const auto &name : names) {
         dtype_fields.push_back({name, dtype});
     }
+    this->layout = layout;
     init(dtype_fields, size);
 }
 
-StructArray::StructArray(std::vector<StructArrayFieldDef> dtype, size_t size)
+StructArray::StructArray(std::vector<StructArrayFieldDef> dtype, size_t size,
+                         StructArrayLayout layout)
 {
+    this->layout = layout;
     init(dtype, size);
 }
 
@@ -20,207 +54,133 @@ void StructArray::init(std::vector<StructArrayFieldDef> dtype, size_t size)
     this->dtype = dtype;
     this->size = size;
 
+    // Fields are naturally aligned as in a C struct, and the item is padded to
+    // the largest alignment so that every item in the buffer is aligned.
     this->names.reserve(dtype.size());
     size_t offset = 0;
+    size_t max_align = 1;
     for (const auto &field : dtype) {
+        size_t field_size = DtypeSize(field.dtype);
+        offset = (offset + field_size - 1) / field_size * field_size;
+        max_align = std::max(max_align, field_size);
+
+        this->field_index[field.name] = this->fields.size();
         this->names.push_back(field.name);
         this->fields.push_back({field.name, field.dtype, offset});
+        offset += field_size;
+    }
+    this->itemsize = (offset + max_align - 1) / max_align * max_align;
+
+    if (layout == StructArrayLayout::Records) {
+        records.resize(itemsize * size, 0);
+        return;
+    }
+
+    columns.reserve(dtype.size());
+    for (const auto &field : dtype) {
         switch (field.dtype) {
         case Dtype::float32:
-            data[field.name] = xt::xarray<float>(xt::zeros<float>({size}));
-            offset += 4;
+            columns.push_back(xt::xarray<float>(xt::zeros<float>({size})));
             break;
         case Dtype::float64:
-            data[field.name] = xt::xarray<double>(xt::zeros<double>({size}));
-            offset += 8;
+            columns.push_back(xt::xarray<double>(xt::zeros<double>({size})));
             break;
         case Dtype::uint8:
-            data[field.name] = xt::xarray<uint8_t>(xt::zeros<uint8_t>({size}));
-            offset += 1;
+            columns.push_back(xt::xarray<uint8_t>(xt::zeros<uint8_t>({size})));
             break;
         case Dtype::uint16:
-            data[field.name] =
-                xt::xarray<uint16_t>(xt::zeros<uint16_t>({size}));
-            offset += 2;
+            columns.push_back(
+                xt::xarray<uint16_t>(xt::zeros<uint16_t>({size})));
             break;
         case Dtype::uint32:
-            data[field.name] =
-                xt::xarray<uint32_t>(xt::zeros<uint32_t>({size}));
-            offset += 4;
+            columns.push_back(
+                xt::xarray<uint32_t>(xt::zeros<uint32_t>({size})));
             break;
         case Dtype::uint64:
-            data[field.name] =
-                xt::xarray<uint64_t>(xt::zeros<uint64_t>({size}));
-            offset += 8;
+            columns.push_back(
+                xt::xarray<uint64_t>(xt::zeros<uint64_t>({size})));
             break;
         case Dtype::int8:
-            data[field.name] = xt::xarray<int8_t>(xt::zeros<int8_t>({size}));
-            offset += 1;
+            columns.push_back(xt::xarray<int8_t>(xt::zeros<int8_t>({size})));
             break;
         case Dtype::int16:
-            data[field.name] = xt::xarray<int16_t>(xt::zeros<int16_t>({size}));
-            offset += 2;
+            columns.push_back(xt::xarray<int16_t>(xt::zeros<int16_t>({size})));
             break;
         case Dtype::int32:
-            data[field.name] = xt::xarray<int32_t>(xt::zeros<int32_t>({size}));
-            offset += 4;
+            columns.push_back(xt::xarray<int32_t>(xt::zeros<int32_t>({size})));
             break;
         case Dtype::int64:
-            data[field.name] = xt::xarray<int64_t>(xt::zeros<int64_t>({size}));
-            offset += 8;
+            columns.push_back(xt::xarray<int64_t>(xt::zeros<int64_t>({size})));
             break;
         default:
             throw std::invalid_argument("unknown type");
         }
     }
-    this->itemsize = offset;
+}
+
+size_t StructArray::fieldIndex(const std::string &name)
+{
+    auto it = field_index.find(name);
+    if (it == field_index.end()) {
+        throw std::out_of_range("field not found: " + name);
+    }
+    return it->second;
+}
+
+uint8_t *StructArray::Data()
+{
+    if (layout != StructArrayLayout::Records) {
+        throw std::logic_error("Data() requires records layout");
+    }
+    return records.data();
 }
 
 std::string StructArray::ToBuf()
 {
-    size_t buf_size = ItemSize() * Size();
-    uint8_t *buf = (uint8_t *)malloc(buf_size);
-    for (const auto &field : Fields()) {
-        size_t offset = field.offset;
-        if (field.dtype == Dtype::float32) {
-            xt::xarray<float> field_arr = Field<float>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                *(float *)(buf + offset) = field_arr[i];
-                offset += ItemSize();
-            }
-        } else if (field.dtype == Dtype::float64) {
-            xt::xarray<double> field_arr = Field<double>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                *(double *)(buf + offset) = field_arr[i];
-                offset += ItemSize();
-            }
-        } else if (field.dtype == Dtype::uint8) {
-            xt::xarray<uint8_t> field_arr = Field<uint8_t>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                *(uint8_t *)(buf + offset) = field_arr[i];
-                offset += ItemSize();
-            }
-        } else if (field.dtype == Dtype::uint16) {
-            xt::xarray<uint16_t> field_arr = Field<uint16_t>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                *(uint16_t *)(buf + offset) = field_arr[i];
-                offset += ItemSize();
-            }
-        } else if (field.dtype == Dtype::uint32) {
-            xt::xarray<uint32_t> field_arr = Field<uint32_t>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                *(uint32_t *)(buf + offset) = field_arr[i];
-                offset += ItemSize();
-            }
-        } else if (field.dtype == Dtype::uint64) {
-            xt::xarray<uint64_t> field_arr = Field<uint64_t>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                *(uint64_t *)(buf + offset) = field_arr[i];
-                offset += ItemSize();
-            }
-        } else if (field.dtype == Dtype::int8) {
-            xt::xarray<int8_t> field_arr = Field<int8_t>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                *(int8_t *)(buf + offset) = field_arr[i];
-                offset += ItemSize();
-            }
-        } else if (field.dtype == Dtype::int16) {
-            xt::xarray<int16_t> field_arr = Field<int16_t>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                *(int16_t *)(buf + offset) = field_arr[i];
-                offset += ItemSize();
-            }
-        } else if (field.dtype == Dtype::int32) {
-            xt::xarray<int32_t> field_arr = Field<int32_t>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                *(int32_t *)(buf + offset) = field_arr[i];
-                offset += ItemSize();
-            }
-        } else if (field.dtype == Dtype::int64) {
-            xt::xarray<int64_t> field_arr = Field<int64_t>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                *(int64_t *)(buf + offset) = field_arr[i];
-                offset += ItemSize();
-            }
-        } else {
-            throw std::invalid_argument("unknown type");
-        }
+    if (layout == StructArrayLayout::Records) {
+        return std::string((char *)records.data(), records.size());
     }
 
-    return std::string((char *)buf, buf_size);
+    std::string buf;
+    buf.resize(ItemSize() * Size(), 0);
+    for (int i_field = 0; i_field < fields.size(); i_field++) {
+        uint8_t *dst = (uint8_t *)buf.data() + fields[i_field].offset;
+        std::visit(
+            [&](auto &field_arr) {
+                using T =
+                    typename std::decay_t<decltype(field_arr)>::value_type;
+                const T *src = field_arr.data();
+                for (size_t i = 0; i < Size(); i++) {
+                    std::memcpy(dst + i * ItemSize(), &src[i], sizeof(T));
+                }
+            },
+            columns[i_field]);
+    }
+    return buf;
 }
 
-void StructArray::FromBuf(std::string buf_s)
+void StructArray::FromBuf(std::string buf)
 {
-    if (buf_s.size() != ItemSize() * Size()) {
+    if (buf.size() != ItemSize() * Size()) {
         throw std::invalid_argument("unexpected buf size");
     }
 
-    uint8_t *buf = (uint8_t *)&buf_s[0];
-    for (const auto &field : Fields()) {
-        size_t offset = field.offset;
-        if (field.dtype == Dtype::float32) {
-            xt::xarray<float> &field_arr = Field<float>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                field_arr[i] = *(float *)(buf + offset);
-                offset += ItemSize();
-            }
-        } else if (field.dtype == Dtype::float64) {
-            xt::xarray<double> &field_arr = Field<double>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                field_arr[i] = *(double *)(buf + offset);
-                offset += ItemSize();
-            }
-        } else if (field.dtype == Dtype::uint8) {
-            xt::xarray<uint8_t> &field_arr = Field<uint8_t>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                field_arr[i] = *(uint8_t *)(buf + offset);
-                offset += ItemSize();
-            }
-        } else if (field.dtype == Dtype::uint16) {
-            xt::xarray<uint16_t> &field_arr = Field<uint16_t>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                field_arr[i] = *(uint16_t *)(buf + offset);
-                offset += ItemSize();
-            }
-        } else if (field.dtype == Dtype::uint32) {
-            xt::xarray<uint32_t> &field_arr = Field<uint32_t>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                field_arr[i] = *(uint32_t *)(buf + offset);
-                offset += ItemSize();
-            }
-        } else if (field.dtype == Dtype::uint64) {
-            xt::xarray<uint64_t> &field_arr = Field<uint64_t>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                field_arr[i] = *(uint64_t *)(buf + offset);
-                offset += ItemSize();
-            }
-        } else if (field.dtype == Dtype::int8) {
-            xt::xarray<int8_t> &field_arr = Field<int8_t>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                field_arr[i] = *(int8_t *)(buf + offset);
-                offset += ItemSize();
-            }
-        } else if (field.dtype == Dtype::int16) {
-            xt::xarray<int16_t> &field_arr = Field<int16_t>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                field_arr[i] = *(int16_t *)(buf + offset);
-                offset += ItemSize();
-            }
-        } else if (field.dtype == Dtype::int32) {
-            xt::xarray<int32_t> &field_arr = Field<int32_t>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                field_arr[i] = *(int32_t *)(buf + offset);
-                offset += ItemSize();
-            }
-        } else if (field.dtype == Dtype::int64) {
-            xt::xarray<int64_t> &field_arr = Field<int64_t>(field.name);
-            for (int i = 0; i < Size(); i++) {
-                field_arr[i] = *(int64_t *)(buf + offset);
-                offset += ItemSize();
-            }
-        } else {
-            throw std::invalid_argument("unknown type");
-        }
+    if (layout == StructArrayLayout::Records) {
+        std::memcpy(records.data(), buf.data(), buf.size());
+        return;
     }
-}
\ No newline at end of file
+
+    for (int i_field = 0; i_field < fields.size(); i_field++) {
+        const uint8_t *src = (uint8_t *)buf.data() + fields[i_field].offset;
+        std::visit(
+            [&](auto &field_arr) {
+                using T =
+                    typename std::decay_t<decltype(field_arr)>::value_type;
+                T *dst = field_arr.data();
+                for (size_t i = 0; i < Size(); i++) {
+                    std::memcpy(&dst[i], src + i * ItemSize(), sizeof(T));
+                }
+            },
+            columns[i_field]);
+    }
+}
@@ -1,7 +1,9 @@
 #ifndef STRUCTARRAY_H
 #define STRUCTARRAY_H
 
+#include <cstdint>
 #include <map>
+#include <stdexcept>
 #include <string>
 #include <variant>
 #include <vector>
@@ -20,9 +22,14 @@ enum class Dtype {
     int64,
 };
 
+size_t DtypeSize(Dtype dtype);
+template <typename T> constexpr Dtype DtypeOf();
+
 struct StructArrayFieldDef {
     std::string name;
     Dtype dtype;
+
+    bool operator==(const StructArrayFieldDef &) const = default;
 };
 
 struct StructArrayyField {
@@ -31,46 +38,129 @@ struct StructArrayyField {
     size_t offset;
 };
 
+// Columnar keeps one xt::xarray per field.
+// Records keeps a single buffer of items laid out as the C struct with the
+// same fields (naturally aligned), which is also the HDF5 memory type.
+enum class StructArrayLayout {
+    Columnar,
+    Records,
+};
+
+// Strided reference to the values of one field, valid as long as the array
+// is not destroyed or reallocated. Resolve it once, outside of loops.
+template <typename T> class StructArrayFieldRef {
+public:
+    StructArrayFieldRef(uint8_t *base, size_t stride)
+        : base(base), stride(stride)
+    {}
+
+    T &operator[](size_t i) { return *(T *)(base + i * stride); }
+
+private:
+    uint8_t *base;
+    size_t stride;
+};
+
 class StructArray {
 public:
     StructArray();
-    StructArray(std::vector<std::string> names, Dtype dtype, size_t size);
-    StructArray(std::vector<StructArrayFieldDef> dtype, size_t size);
+    StructArray(std::vector<std::string> names, Dtype dtype, size_t size,
+                StructArrayLayout layout = StructArrayLayout::Columnar);
+    StructArray(std::vector<StructArrayFieldDef> dtype, size_t size,
+                StructArrayLayout layout = StructArrayLayout::Columnar);
 
     size_t Size() { return this->size; }
     size_t ItemSize() { return this->itemsize; }
+    StructArrayLayout Layout() { return this->layout; }
 
     const std::vector<StructArrayFieldDef> &DataType() { return this->dtype; }
     const std::vector<StructArrayyField> &Fields() { return this->fields; }
     const std::vector<std::string> &Names() { return this->names; }
 
+    // Columnar layout only
     template <typename T> xt::xarray<T> &Field(std::string name);
 
+    // Both layouts
+    template <typename T> StructArrayFieldRef<T> FieldRef(std::string name);
+
+    // Records layout only. ItemSize() * Size() bytes.
+    uint8_t *Data();
+
     std::string ToBuf();
     void FromBuf(std::string buf);
 
 private:
     void init(std::vector<StructArrayFieldDef> dtype, size_t size);
+    size_t fieldIndex(const std::string &name);
 
     std::vector<StructArrayFieldDef> dtype;
     size_t size = 0;
+    StructArrayLayout layout = StructArrayLayout::Columnar;
 
     std::vector<std::string> names;
     std::vector<StructArrayyField> fields;
+    std::map<std::string, size_t> field_index;
     size_t itemsize = 0;
 
-    std::map<std::string,
-             std::variant<xt::xarray<float>, xt::xarray<double>,
-                          xt::xarray<uint8_t>, xt::xarray<uint16_t>,
-                          xt::xarray<uint32_t>, xt::xarray<uint64_t>,
-                          xt::xarray<int8_t>, xt::xarray<int16_t>,
-                          xt::xarray<int32_t>, xt::xarray<int64_t>>>
-        data;
+    std::vector<std::variant<xt::xarray<float>, xt::xarray<double>,
+                             xt::xarray<uint8_t>, xt::xarray<uint16_t>,
+                             xt::xarray<uint32_t>, xt::xarray<uint64_t>,
+                             xt::xarray<int8_t>, xt::xarray<int16_t>,
+                             xt::xarray<int32_t>, xt::xarray<int64_t>>>
+        columns;
+    std::vector<uint8_t> records;
 };
 
+template <typename T> constexpr Dtype DtypeOf()
+{
+    if constexpr (std::is_same_v<T, float>) {
+        return Dtype::float32;
+    } else if constexpr (std::is_same_v<T, double>) {
+        return Dtype::float64;
+    } else if constexpr (std::is_same_v<T, uint8_t>) {
+        return Dtype::uint8;
+    } else if constexpr (std::is_same_v<T, uint16_t>) {
+        return Dtype::uint16;
+    } else if constexpr (std::is_same_v<T, uint32_t>) {
+        return Dtype::uint32;
+    } else if constexpr (std::is_same_v<T, uint64_t>) {
+        return Dtype::uint64;
+    } else if constexpr (std::is_same_v<T, int8_t>) {
+        return Dtype::int8;
+    } else if constexpr (std::is_same_v<T, int16_t>) {
+        return Dtype::int16;
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+        return Dtype::int32;
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+        return Dtype::int64;
+    } else {
+        static_assert(!sizeof(T *), "unknown type");
+    }
+}
+
 template <typename T> xt::xarray<T> &StructArray::Field(std::string name)
 {
-    return std::get<xt::xarray<T>>(data[name]);
+    if (layout != StructArrayLayout::Columnar) {
+        throw std::logic_error("Field() requires columnar layout");
+    }
+    return std::get<xt::xarray<T>>(columns[fieldIndex(name)]);
+}
+
+template <typename T>
+StructArrayFieldRef<T> StructArray::FieldRef(std::string name)
+{
+    size_t i = fieldIndex(name);
+    if (fields[i].dtype != DtypeOf<T>()) {
+        throw std::invalid_argument(
+            "field type does not match the requested type");
+    }
+
+    if (layout == StructArrayLayout::Records) {
+        return StructArrayFieldRef<T>(records.data() + fields[i].offset,
+                                      itemsize);
+    }
+    return StructArrayFieldRef<T>(
+        (uint8_t *)std::get<xt::xarray<T>>(columns[i]).data(), sizeof(T));
 }
 
 #endif
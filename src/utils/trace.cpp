@@ -0,0 +1,341 @@
+#include "trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#include <nlohmann/json.hpp>
+
+namespace utils {
+
+// Spans kept per thread, the oldest are dropped first. The buffer is
+// allocated with the first span of the thread.
+static const size_t max_thread_events = 16384;
+// Spans kept of all threads that have exited
+static const size_t max_retired_events = 65536;
+// Spans per name in the rolling statistics
+static const size_t max_recent_spans = 1024;
+static const int n_histogram_buckets = 20;
+static const double histogram_first_ms = 0.1;
+
+struct TraceEvent {
+    const char *category;
+    const char *name;
+    int64_t ts_us;
+    int64_t dur_us;
+};
+
+struct RetiredTraceEvent {
+    TraceEvent event;
+    uint32_t tid;
+};
+
+// Fixed ring of the most recent items, allocated once
+template <typename T> struct TraceRing {
+    std::vector<T> items;
+    size_t head = 0;
+    size_t n = 0;
+
+    void Push(const T &item)
+    {
+        items[head] = item;
+        head = (head + 1) % items.size();
+        if (n < items.size()) {
+            n++;
+        }
+    }
+    // From the oldest
+    template <typename F> void ForEach(F f) const
+    {
+        size_t start = (head + items.size() - n) % items.size();
+        for (size_t i = 0; i < n; i++) {
+            f(items[(start + i) % items.size()]);
+        }
+    }
+    void Clear()
+    {
+        head = 0;
+        n = 0;
+    }
+};
+
+struct SpanHistory {
+    uint64_t count = 0;
+    double total_ms = 0;
+    std::vector<double> recent_ms;
+    size_t next = 0;
+};
+
+struct ThreadTraceBuffer {
+    uint32_t tid;
+    std::mutex mutex;
+    TraceRing<TraceEvent> events;
+    // By the category and name pointers, merged by string when read
+    std::map<std::pair<const char *, const char *>, SpanHistory> history;
+};
+
+static std::mutex buffers_mutex;
+static std::vector<std::shared_ptr<ThreadTraceBuffer>> buffers;
+static uint32_t next_tid = 1;
+
+// Statistics and spans of threads that have exited
+static std::mutex stats_mutex;
+static std::map<std::string, SpanHistory> retired_history;
+static TraceRing<RetiredTraceEvent> retired_events;
+
+static void mergeHistory(SpanHistory &into, const SpanHistory &from,
+                         size_t max_recent)
+{
+    into.count += from.count;
+    into.total_ms += from.total_ms;
+    for (double dur_ms : from.recent_ms) {
+        if (into.recent_ms.size() < max_recent) {
+            into.recent_ms.push_back(dur_ms);
+        } else {
+            into.recent_ms[into.next] = dur_ms;
+        }
+        into.next = (into.next + 1) % max_recent;
+    }
+}
+
+static std::string spanName(const char *category, const char *name)
+{
+    return std::string(category) + "/" + name;
+}
+
+// Moves the statistics and spans of a thread to the retired ones when it
+// exits, and drops its buffer
+struct ThreadTraceBufferHolder {
+    std::shared_ptr<ThreadTraceBuffer> buffer;
+
+    ~ThreadTraceBufferHolder()
+    {
+        if (!buffer) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lk(stats_mutex);
+            std::lock_guard<std::mutex> lk_buffer(buffer->mutex);
+            for (const auto &[key, history] : buffer->history) {
+                mergeHistory(retired_history[spanName(key.first, key.second)],
+                             history, max_recent_spans);
+            }
+            buffer->history.clear();
+
+            if (retired_events.items.empty()) {
+                retired_events.items.resize(max_retired_events);
+            }
+            uint32_t tid = buffer->tid;
+            buffer->events.ForEach([tid](const TraceEvent &event) {
+                retired_events.Push({event, tid});
+            });
+            buffer->events.Clear();
+        }
+        std::lock_guard<std::mutex> lk(buffers_mutex);
+        std::erase(buffers, buffer);
+    }
+};
+
+int64_t TraceMicroseconds()
+{
+    static const std::chrono::steady_clock::time_point tp_origin =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - tp_origin)
+        .count();
+}
+
+static ThreadTraceBuffer *threadBuffer()
+{
+    thread_local ThreadTraceBufferHolder holder;
+    std::shared_ptr<ThreadTraceBuffer> &buffer = holder.buffer;
+    if (!buffer) {
+        buffer = std::make_shared<ThreadTraceBuffer>();
+        buffer->events.items.resize(max_thread_events);
+        std::lock_guard<std::mutex> lk(buffers_mutex);
+        buffer->tid = next_tid++;
+        buffers.push_back(buffer);
+    }
+    return buffer.get();
+}
+
+static std::vector<std::shared_ptr<ThreadTraceBuffer>> allBuffers()
+{
+    std::lock_guard<std::mutex> lk(buffers_mutex);
+    return buffers;
+}
+
+static void recordSpan(const char *category, const char *name,
+                       int64_t ts_start, int64_t ts_end)
+{
+    ThreadTraceBuffer *buffer = threadBuffer();
+    std::lock_guard<std::mutex> lk(buffer->mutex);
+    buffer->events.Push(TraceEvent{
+        .category = category,
+        .name = name,
+        .ts_us = ts_start,
+        .dur_us = ts_end - ts_start,
+    });
+
+    auto it = buffer->history.find({category, name});
+    if (it == buffer->history.end()) {
+        it = buffer->history.insert({{category, name}, SpanHistory()}).first;
+        it->second.recent_ms.reserve(max_recent_spans);
+    }
+    SpanHistory &history = it->second;
+    double dur_ms = (ts_end - ts_start) / 1000.0;
+    if (history.recent_ms.size() < max_recent_spans) {
+        history.recent_ms.push_back(dur_ms);
+    } else {
+        history.recent_ms[history.next] = dur_ms;
+    }
+    history.next = (history.next + 1) % max_recent_spans;
+    history.count++;
+    history.total_ms += dur_ms;
+}
+
+TraceSpan::TraceSpan(const char *category, const char *name)
+{
+    this->category = category;
+    this->name = name;
+    ts_start = TraceMicroseconds();
+}
+
+TraceSpan::~TraceSpan() { End(); }
+
+void TraceSpan::End()
+{
+    if (ts_end >= 0) {
+        return;
+    }
+    ts_end = TraceMicroseconds();
+    recordSpan(category, name, ts_start, ts_end);
+}
+
+double TraceSpan::Milliseconds() const
+{
+    int64_t ts = (ts_end >= 0) ? ts_end : TraceMicroseconds();
+    return (ts - ts_start) / 1000.0;
+}
+
+TraceSession::TraceSession(std::string name)
+{
+    this->name = name;
+    ts_start = TraceMicroseconds();
+}
+
+void TraceSession::Save(std::filesystem::path filename)
+{
+    SaveChromeTrace(filename, ts_start, TraceMicroseconds());
+}
+
+void SaveChromeTrace(std::filesystem::path filename, int64_t from_us,
+                     int64_t to_us)
+{
+    std::vector<std::shared_ptr<ThreadTraceBuffer>> all_buffers =
+        allBuffers();
+
+    nlohmann::json events = nlohmann::json::array();
+    auto add_event = [&events, from_us, to_us](const TraceEvent &event,
+                                               uint32_t tid) {
+        if ((event.ts_us < from_us) || (event.ts_us > to_us)) {
+            return;
+        }
+        events.push_back({
+            {"name", event.name},
+            {"cat", event.category},
+            {"ph", "X"},
+            {"ts", event.ts_us},
+            {"dur", event.dur_us},
+            {"pid", 1},
+            {"tid", tid},
+        });
+    };
+    {
+        std::lock_guard<std::mutex> lk(stats_mutex);
+        retired_events.ForEach([&add_event](const RetiredTraceEvent &e) {
+            add_event(e.event, e.tid);
+        });
+    }
+    for (const auto &buffer : all_buffers) {
+        std::lock_guard<std::mutex> lk(buffer->mutex);
+        buffer->events.ForEach([&add_event, &buffer](const TraceEvent &e) {
+            add_event(e, buffer->tid);
+        });
+    }
+
+    std::ofstream ofs(filename);
+    if (!ofs) {
+        throw std::runtime_error("failed to create trace file");
+    }
+    ofs << nlohmann::json{
+        {"traceEvents", events},
+        {"displayTimeUnit", "ms"},
+    };
+}
+
+std::vector<SpanStats> GetSpanStats()
+{
+    // Recent spans of all threads are kept in the merged history
+    std::map<std::string, SpanHistory> span_history;
+    {
+        std::lock_guard<std::mutex> lk(stats_mutex);
+        span_history = retired_history;
+        for (const auto &buffer : allBuffers()) {
+            std::lock_guard<std::mutex> lk_buffer(buffer->mutex);
+            for (const auto &[key, history] : buffer->history) {
+                mergeHistory(span_history[spanName(key.first, key.second)],
+                             history, SIZE_MAX);
+            }
+        }
+    }
+
+    std::vector<SpanStats> result;
+    for (const auto &[name, history] : span_history) {
+        SpanStats stats{
+            .name = name,
+            .count = history.count,
+            .total_ms = history.total_ms,
+            .histogram = std::vector<uint64_t>(n_histogram_buckets, 0),
+        };
+        std::vector<double> recent = history.recent_ms;
+        std::sort(recent.begin(), recent.end());
+        if (!recent.empty()) {
+            auto percentile = [&recent](double p) {
+                return recent[(size_t)(p * (recent.size() - 1))];
+            };
+            stats.p50_ms = percentile(0.5);
+            stats.p90_ms = percentile(0.9);
+            stats.p99_ms = percentile(0.99);
+            stats.max_ms = recent.back();
+        }
+        for (double dur_ms : recent) {
+            int i = 0;
+            double upper = histogram_first_ms;
+            while ((dur_ms >= upper) && (i < n_histogram_buckets - 1)) {
+                upper *= 2;
+                i++;
+            }
+            stats.histogram[i]++;
+        }
+        result.push_back(stats);
+    }
+    return result;
+}
+
+void ClearSpanStats()
+{
+    std::lock_guard<std::mutex> lk(stats_mutex);
+    retired_history.clear();
+    for (const auto &buffer : allBuffers()) {
+        std::lock_guard<std::mutex> lk_buffer(buffer->mutex);
+        buffer->history.clear();
+    }
+}
+
+} // namespace utils
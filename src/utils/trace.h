@@ -0,0 +1,76 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace utils {
+
+// Monotonic time in microseconds since the first call
+int64_t TraceMicroseconds();
+
+struct SpanStats {
+    // <category>/<name>
+    std::string name;
+    uint64_t count = 0;
+    // Over all spans
+    double total_ms = 0;
+    // Over the most recent spans of each thread
+    double p50_ms = 0;
+    double p90_ms = 0;
+    double p99_ms = 0;
+    double max_ms = 0;
+    // Recent spans in buckets [0, 0.1 ms), [0.1, 0.2 ms), [0.2, 0.4 ms),
+    // doubling up to the last bucket, which has no upper bound
+    std::vector<uint64_t> histogram;
+};
+
+// Records the duration of a scope. Spans and their statistics are kept per
+// thread in buffers of fixed size and merged when read, so recording only
+// takes a lock of its own thread and does not allocate once a name has been
+// seen on the thread. When a thread exits, its spans join a single bounded
+// buffer. category and name are not copied and must be string literals.
+class TraceSpan {
+public:
+    TraceSpan(const char *category, const char *name);
+    ~TraceSpan();
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+    // Ends the span before the end of the scope
+    void End();
+    // Elapsed time, or the duration if ended
+    double Milliseconds() const;
+
+private:
+    const char *category;
+    const char *name;
+    int64_t ts_start;
+    int64_t ts_end = -1;
+};
+
+// Spans of all threads from the creation of the session, e.g. for one task
+class TraceSession {
+public:
+    TraceSession(std::string name);
+
+    std::string Name() { return name; }
+    // Chrome Trace Event JSON, for chrome://tracing or Perfetto
+    void Save(std::filesystem::path filename);
+
+private:
+    std::string name;
+    int64_t ts_start;
+};
+
+void SaveChromeTrace(std::filesystem::path filename, int64_t from_us,
+                     int64_t to_us);
+std::vector<SpanStats> GetSpanStats();
+// Starts the statistics over, e.g. between benchmark runs
+void ClearSpanStats();
+
+} // namespace utils
+
+#endif